@@ -67,6 +67,7 @@ CONTRIB_EXTENSIONS = {
     "envoy.tls.key_providers.kae":                              "//contrib/kae/private_key_providers/source:config",
     "envoy.tls.key_providers.cryptomb":                         "//contrib/cryptomb/private_key_providers/source:config",
     "envoy.tls.key_providers.qat":                              "//contrib/qat/private_key_providers/source:config",
+    "envoy.tls.key_providers.offload":                          "//contrib/offload/private_key_providers/source:config",
 
     #
     # Socket interface extensions
@@ -0,0 +1,42 @@
+#include "contrib/offload/private_key_providers/source/config.h"
+
+#include <memory>
+
+#include "envoy/registry/registry.h"
+#include "envoy/server/transport_socket_config.h"
+
+#include "source/common/config/utility.h"
+#include "source/common/protobuf/message_validator_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#include "contrib/envoy/extensions/private_key_providers/offload/v3alpha/offload.pb.h"
+#include "contrib/envoy/extensions/private_key_providers/offload/v3alpha/offload.pb.validate.h"
+#include "contrib/offload/private_key_providers/source/offload_private_key_provider.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+
+Ssl::PrivateKeyMethodProviderSharedPtr
+OffloadPrivateKeyMethodFactory::createPrivateKeyMethodProviderInstance(
+    const envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider& proto_config,
+    Server::Configuration::TransportSocketFactoryContext& private_key_provider_context) {
+  ProtobufTypes::MessagePtr message = std::make_unique<
+      envoy::extensions::private_key_providers::offload::v3alpha::OffloadPrivateKeyMethodConfig>();
+
+  THROW_IF_NOT_OK(Config::Utility::translateOpaqueConfig(
+      proto_config.typed_config(), ProtobufMessage::getNullValidationVisitor(), *message));
+  const auto& conf =
+      MessageUtil::downcastAndValidate<const envoy::extensions::private_key_providers::offload::
+                                           v3alpha::OffloadPrivateKeyMethodConfig&>(
+          *message, private_key_provider_context.messageValidationVisitor());
+  return std::make_shared<OffloadPrivateKeyMethodProvider>(conf, private_key_provider_context);
+}
+
+REGISTER_FACTORY(OffloadPrivateKeyMethodFactory, Ssl::PrivateKeyMethodProviderInstanceFactory);
+
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,351 @@
+#include "contrib/offload/private_key_providers/source/offload_private_key_provider.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "envoy/server/transport_socket_config.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/config/datasource.h"
+#include "source/common/protobuf/utility.h"
+
+#include "openssl/err.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+
+SINGLETON_MANAGER_REGISTRATION(offload_private_key_thread_pool);
+
+OffloadOperation::OffloadOperation(bssl::UniquePtr<EVP_PKEY> pkey, uint16_t signature_algorithm,
+                                   bool decrypt, const uint8_t* in, size_t in_len,
+                                   Ssl::PrivateKeyConnectionCallbacks& cb,
+                                   OffloadCompletionQueueSharedPtr completion_queue)
+    : pkey_(std::move(pkey)), signature_algorithm_(signature_algorithm), decrypt_(decrypt),
+      input_(in, in + in_len), completion_queue_(std::move(completion_queue)), cb_(&cb) {}
+
+void OffloadOperation::execute() {
+  succeeded_ = decrypt_ ? decrypt() : sign();
+  if (!succeeded_) {
+    // Don't leave the errors of the operation on the queue of the thread for the next one.
+    ERR_clear_error();
+  }
+}
+
+bool OffloadOperation::sign() {
+  if (EVP_PKEY_id(pkey_.get()) != SSL_get_signature_algorithm_key_type(signature_algorithm_)) {
+    return false;
+  }
+  const EVP_MD* md = SSL_get_signature_algorithm_digest(signature_algorithm_);
+  if (md == nullptr) {
+    return false;
+  }
+
+  bssl::ScopedEVP_MD_CTX ctx;
+  EVP_PKEY_CTX* pkey_ctx;
+  if (!EVP_DigestSignInit(ctx.get(), &pkey_ctx, md, nullptr, pkey_.get())) {
+    return false;
+  }
+  // `PSS` padding uses a salt as long as the digest, as TLS requires.
+  if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm_) &&
+      (!EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING) ||
+       !EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1))) {
+    return false;
+  }
+
+  size_t out_len = EVP_PKEY_size(pkey_.get());
+  output_.resize(out_len);
+  if (!EVP_DigestSign(ctx.get(), output_.data(), &out_len, input_.data(), input_.size())) {
+    return false;
+  }
+  output_.resize(out_len);
+  return true;
+}
+
+bool OffloadOperation::decrypt() {
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+  if (rsa == nullptr) {
+    return false;
+  }
+
+  size_t out_len;
+  output_.resize(RSA_size(rsa));
+  if (!RSA_decrypt(rsa, &out_len, output_.data(), output_.size(), input_.data(), input_.size(),
+                   RSA_NO_PADDING)) {
+    return false;
+  }
+  output_.resize(out_len);
+  return true;
+}
+
+void OffloadOperation::complete() {
+  done_ = true;
+  if (cb_ != nullptr) {
+    cb_->onPrivateKeyMethodComplete();
+  }
+}
+
+void OffloadCompletionQueue::push(OffloadOperationSharedPtr operation) {
+  absl::MutexLock lock(mutex_);
+  if (dispatcher_ == nullptr) {
+    return;
+  }
+  operations_.push_back(std::move(operation));
+  if (operations_.size() == 1) {
+    dispatcher_->post([self = shared_from_this()]() { self->completeOperations(); });
+  }
+}
+
+void OffloadCompletionQueue::shutdown() {
+  absl::MutexLock lock(mutex_);
+  dispatcher_ = nullptr;
+  operations_.clear();
+}
+
+void OffloadCompletionQueue::completeOperations() {
+  std::vector<OffloadOperationSharedPtr> operations;
+  {
+    absl::MutexLock lock(mutex_);
+    operations.swap(operations_);
+  }
+  for (const OffloadOperationSharedPtr& operation : operations) {
+    operation->complete();
+  }
+}
+
+OffloadThreadPool::OffloadThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                                     uint32_t max_batch_size)
+    : max_batch_size_(max_batch_size) {
+  ENVOY_LOG(debug, "Offload private key thread pool created with {} threads", thread_count);
+  threads_.reserve(thread_count);
+  while (threads_.size() < thread_count) {
+    threads_.push_back(
+        thread_factory.createThread([this]() { worker(); }, Thread::Options{"pkey_offload"}));
+  }
+}
+
+OffloadThreadPool::~OffloadThreadPool() {
+  {
+    absl::MutexLock lock(mutex_);
+    // The providers hold the pool while their connections exist, so the connections of the queued
+    // operations are gone and there is no handshake left to resume.
+    terminate_ = true;
+  }
+  for (Thread::ThreadPtr& thread : threads_) {
+    thread->join();
+  }
+}
+
+void OffloadThreadPool::enqueue(OffloadOperationSharedPtr operation) {
+  absl::MutexLock lock(mutex_);
+  queue_.push_back(std::move(operation));
+}
+
+void OffloadThreadPool::worker() {
+  const auto condition = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue_.empty() || terminate_;
+  };
+  std::vector<OffloadOperationSharedPtr> batch;
+  batch.reserve(max_batch_size_);
+  while (true) {
+    {
+      absl::MutexLock lock(mutex_);
+      mutex_.Await(absl::Condition(&condition));
+      if (terminate_) {
+        return;
+      }
+      // Take the oldest operations first.
+      const auto batch_end = queue_.begin() + std::min<size_t>(queue_.size(), max_batch_size_);
+      batch.assign(std::make_move_iterator(queue_.begin()), std::make_move_iterator(batch_end));
+      queue_.erase(queue_.begin(), batch_end);
+    }
+
+    for (const OffloadOperationSharedPtr& operation : batch) {
+      operation->execute();
+    }
+    for (OffloadOperationSharedPtr& operation : batch) {
+      OffloadCompletionQueue& completion_queue = operation->completionQueue();
+      completion_queue.push(std::move(operation));
+    }
+    batch.clear();
+  }
+}
+
+OffloadPrivateKeyConnection::OffloadPrivateKeyConnection(
+    Ssl::PrivateKeyConnectionCallbacks& cb, bssl::UniquePtr<EVP_PKEY> pkey,
+    OffloadThreadPool& pool, OffloadCompletionQueueSharedPtr completion_queue)
+    : cb_(cb), pkey_(std::move(pkey)), pool_(pool),
+      completion_queue_(std::move(completion_queue)) {}
+
+OffloadPrivateKeyConnection::~OffloadPrivateKeyConnection() {
+  if (operation_ != nullptr) {
+    operation_->cancel();
+  }
+}
+
+ssl_private_key_result_t OffloadPrivateKeyConnection::start(uint16_t signature_algorithm,
+                                                            bool decrypt, const uint8_t* in,
+                                                            size_t in_len) {
+  operation_ = std::make_shared<OffloadOperation>(bssl::UpRef(pkey_), signature_algorithm, decrypt,
+                                                  in, in_len, cb_, completion_queue_);
+  pool_.enqueue(operation_);
+  return ssl_private_key_retry;
+}
+
+ssl_private_key_result_t OffloadPrivateKeyConnection::complete(uint8_t* out, size_t* out_len,
+                                                               size_t max_out) {
+  if (operation_ == nullptr) {
+    return ssl_private_key_failure;
+  }
+  // This can happen if someone calls the top-level SSL function before the operation is handed
+  // back to this thread.
+  if (!operation_->done()) {
+    return ssl_private_key_retry;
+  }
+
+  const OffloadOperationSharedPtr operation = std::move(operation_);
+  if (!operation->succeeded()) {
+    ENVOY_LOG(debug, "Offload: private key operation failed.");
+    return ssl_private_key_failure;
+  }
+  const std::vector<uint8_t>& output = operation->output();
+  if (output.size() > max_out) {
+    return ssl_private_key_failure;
+  }
+  std::copy(output.begin(), output.end(), out);
+  *out_len = output.size();
+  return ssl_private_key_success;
+}
+
+namespace {
+
+OffloadPrivateKeyConnection* getConnection(SSL* ssl) {
+  return ssl == nullptr ? nullptr
+                        : static_cast<OffloadPrivateKeyConnection*>(SSL_get_ex_data(
+                              ssl, OffloadPrivateKeyMethodProvider::connectionIndex()));
+}
+
+ssl_private_key_result_t privateKeySign(SSL* ssl, uint8_t*, size_t*, size_t,
+                                        uint16_t signature_algorithm, const uint8_t* in,
+                                        size_t in_len) {
+  OffloadPrivateKeyConnection* ops = getConnection(ssl);
+  return ops == nullptr ? ssl_private_key_failure
+                        : ops->start(signature_algorithm, false, in, in_len);
+}
+
+ssl_private_key_result_t rsaPrivateKeyDecrypt(SSL* ssl, uint8_t*, size_t*, size_t,
+                                              const uint8_t* in, size_t in_len) {
+  OffloadPrivateKeyConnection* ops = getConnection(ssl);
+  return ops == nullptr ? ssl_private_key_failure : ops->start(0, true, in, in_len);
+}
+
+ssl_private_key_result_t ecdsaPrivateKeyDecrypt(SSL*, uint8_t*, size_t*, size_t, const uint8_t*,
+                                                size_t) {
+  // Expecting to get only signing requests.
+  return ssl_private_key_failure;
+}
+
+ssl_private_key_result_t privateKeyComplete(SSL* ssl, uint8_t* out, size_t* out_len,
+                                            size_t max_out) {
+  OffloadPrivateKeyConnection* ops = getConnection(ssl);
+  return ops == nullptr ? ssl_private_key_failure : ops->complete(out, out_len, max_out);
+}
+
+int createIndex() {
+  int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+  RELEASE_ASSERT(index >= 0, "Failed to get SSL user data index.");
+  return index;
+}
+
+} // namespace
+
+OffloadPrivateKeyMethodProvider::OffloadPrivateKeyMethodProvider(
+    const envoy::extensions::private_key_providers::offload::v3alpha::
+        OffloadPrivateKeyMethodConfig& conf,
+    Server::Configuration::TransportSocketFactoryContext& factory_context) {
+  Server::Configuration::ServerFactoryContext& server_context =
+      factory_context.serverFactoryContext();
+  const std::string private_key = THROW_OR_RETURN_VALUE(
+      Config::DataSource::read(conf.private_key(), false, server_context.api()), std::string);
+
+  bssl::UniquePtr<BIO> bio(
+      BIO_new_mem_buf(const_cast<char*>(private_key.data()), private_key.size()));
+  bssl::UniquePtr<EVP_PKEY> pkey(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  if (pkey == nullptr) {
+    throw EnvoyException("Failed to read private key.");
+  }
+
+  method_ = std::make_shared<SSL_PRIVATE_KEY_METHOD>();
+  method_->sign = privateKeySign;
+  method_->complete = privateKeyComplete;
+  switch (EVP_PKEY_id(pkey.get())) {
+  case EVP_PKEY_RSA:
+    method_->decrypt = rsaPrivateKeyDecrypt;
+    break;
+  case EVP_PKEY_EC:
+    method_->decrypt = ecdsaPrivateKeyDecrypt;
+    break;
+  default:
+    throw EnvoyException("Not supported key type, only EC and RSA are supported.");
+  }
+  pkey_ = std::move(pkey);
+
+  const uint32_t thread_count = PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+      conf, thread_count, std::max(server_context.options().concurrency(), 1U));
+  const uint32_t max_batch_size = PROTOBUF_GET_WRAPPED_OR_DEFAULT(conf, max_batch_size, 8);
+  Api::Api& api = server_context.api();
+  pool_ = server_context.singletonManager().getTyped<OffloadThreadPool>(
+      SINGLETON_MANAGER_REGISTERED_NAME(offload_private_key_thread_pool),
+      [&api, thread_count, max_batch_size] {
+        return std::make_shared<OffloadThreadPool>(api.threadFactory(), thread_count,
+                                                   max_batch_size);
+      });
+
+  tls_ = ThreadLocal::TypedSlot<ThreadLocalCompletionQueue>::makeUnique(
+      server_context.threadLocal());
+  tls_->set([](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ThreadLocalCompletionQueue>(dispatcher);
+  });
+}
+
+void OffloadPrivateKeyMethodProvider::registerPrivateKeyMethod(
+    SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb, Event::Dispatcher&) {
+  if (SSL_get_ex_data(ssl, connectionIndex()) != nullptr) {
+    throw EnvoyException("Not registering the Offload provider twice for same context");
+  }
+
+  ASSERT(tls_->currentThreadRegistered(), "Current thread needs to be registered.");
+
+  SSL_set_ex_data(
+      ssl, connectionIndex(),
+      new OffloadPrivateKeyConnection(cb, bssl::UpRef(pkey_), *pool_, tls_->get()->queue_));
+}
+
+void OffloadPrivateKeyMethodProvider::unregisterPrivateKeyMethod(SSL* ssl) {
+  OffloadPrivateKeyConnection* ops =
+      static_cast<OffloadPrivateKeyConnection*>(SSL_get_ex_data(ssl, connectionIndex()));
+  SSL_set_ex_data(ssl, connectionIndex(), nullptr);
+  delete ops;
+}
+
+bool OffloadPrivateKeyMethodProvider::checkFips() {
+  // The operations are performed by BoringSSL, so the key only needs to pass the pairwise
+  // consistency tests required in FIPS mode.
+  switch (EVP_PKEY_id(pkey_.get())) {
+  case EVP_PKEY_RSA:
+    return RSA_check_fips(EVP_PKEY_get0_RSA(pkey_.get()));
+  case EVP_PKEY_EC:
+    return EC_KEY_check_fips(EVP_PKEY_get0_EC_KEY(pkey_.get()));
+  }
+  return false;
+}
+
+int OffloadPrivateKeyMethodProvider::connectionIndex() {
+  CONSTRUCT_ON_FIRST_USE(int, createIndex());
+}
+
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/api/api.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/ssl/private_key/private_key.h"
+#include "envoy/ssl/private_key/private_key_config.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/common/logger.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "contrib/envoy/extensions/private_key_providers/offload/v3alpha/offload.pb.h"
+#include "openssl/ssl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+
+class OffloadCompletionQueue;
+using OffloadCompletionQueueSharedPtr = std::shared_ptr<OffloadCompletionQueue>;
+
+// OffloadOperation is a sign or decrypt operation of a connection. It is created on the worker
+// thread of the connection, executed on a thread of the pool and completed back on the worker
+// thread.
+class OffloadOperation {
+public:
+  OffloadOperation(bssl::UniquePtr<EVP_PKEY> pkey, uint16_t signature_algorithm, bool decrypt,
+                   const uint8_t* in, size_t in_len, Ssl::PrivateKeyConnectionCallbacks& cb,
+                   OffloadCompletionQueueSharedPtr completion_queue);
+
+  // Performs the operation. Called on a thread of the pool.
+  void execute();
+
+  // Marks the operation as done and resumes the handshake of its connection, unless the connection
+  // is gone. Called on the worker thread.
+  void complete();
+
+  // Called on the worker thread when the connection goes away before the operation completes.
+  void cancel() { cb_ = nullptr; }
+
+  OffloadCompletionQueue& completionQueue() { return *completion_queue_; }
+
+  // The following are only valid on the worker thread once the operation is done.
+  bool done() const { return done_; }
+  bool succeeded() const { return succeeded_; }
+  const std::vector<uint8_t>& output() const { return output_; }
+
+private:
+  bool sign();
+  bool decrypt();
+
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  const uint16_t signature_algorithm_;
+  const bool decrypt_;
+  const std::vector<uint8_t> input_;
+  const OffloadCompletionQueueSharedPtr completion_queue_;
+
+  // Written on a thread of the pool, and read on the worker thread after the completion queue has
+  // handed the operation back.
+  std::vector<uint8_t> output_;
+  bool succeeded_{};
+
+  // Only accessed on the worker thread.
+  Ssl::PrivateKeyConnectionCallbacks* cb_;
+  bool done_{};
+};
+
+using OffloadOperationSharedPtr = std::shared_ptr<OffloadOperation>;
+
+// OffloadCompletionQueue hands the executed operations of a worker thread back to it. The first
+// operation pushed onto an empty queue wakes the worker up, and the worker completes all the
+// operations pushed by then, so that a batch of operations costs a single wakeup.
+class OffloadCompletionQueue : public std::enable_shared_from_this<OffloadCompletionQueue> {
+public:
+  explicit OffloadCompletionQueue(Event::Dispatcher& dispatcher) : dispatcher_(&dispatcher) {}
+
+  // Called on a thread of the pool.
+  void push(OffloadOperationSharedPtr operation) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Called on the worker thread when it stops. Operations pushed afterwards are dropped.
+  void shutdown() ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  void completeOperations() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  absl::Mutex mutex_;
+  Event::Dispatcher* dispatcher_ ABSL_GUARDED_BY(mutex_);
+  std::vector<OffloadOperationSharedPtr> operations_ ABSL_GUARDED_BY(mutex_);
+};
+
+// OffloadThreadPool executes the operations of all offload providers. Each thread takes the queued
+// operations in batches, so that the queue lock is taken once per batch and the results of a batch
+// are handed back to each worker thread together.
+class OffloadThreadPool : public Singleton::Instance,
+                          protected Logger::Loggable<Logger::Id::connection> {
+public:
+  OffloadThreadPool(Thread::ThreadFactory& thread_factory, uint32_t thread_count,
+                    uint32_t max_batch_size);
+  ~OffloadThreadPool() override;
+
+  void enqueue(OffloadOperationSharedPtr operation) ABSL_LOCKS_EXCLUDED(mutex_);
+
+private:
+  void worker() ABSL_LOCKS_EXCLUDED(mutex_);
+
+  const uint32_t max_batch_size_;
+  absl::Mutex mutex_;
+  std::vector<OffloadOperationSharedPtr> queue_ ABSL_GUARDED_BY(mutex_);
+  bool terminate_ ABSL_GUARDED_BY(mutex_){};
+  std::vector<Thread::ThreadPtr> threads_;
+};
+
+using OffloadThreadPoolSharedPtr = std::shared_ptr<OffloadThreadPool>;
+
+// OffloadPrivateKeyConnection maintains the data needed by a given SSL connection.
+class OffloadPrivateKeyConnection : public Logger::Loggable<Logger::Id::connection> {
+public:
+  OffloadPrivateKeyConnection(Ssl::PrivateKeyConnectionCallbacks& cb,
+                              bssl::UniquePtr<EVP_PKEY> pkey, OffloadThreadPool& pool,
+                              OffloadCompletionQueueSharedPtr completion_queue);
+  ~OffloadPrivateKeyConnection();
+
+  ssl_private_key_result_t start(uint16_t signature_algorithm, bool decrypt, const uint8_t* in,
+                                 size_t in_len);
+  ssl_private_key_result_t complete(uint8_t* out, size_t* out_len, size_t max_out);
+
+private:
+  Ssl::PrivateKeyConnectionCallbacks& cb_;
+  const bssl::UniquePtr<EVP_PKEY> pkey_;
+  OffloadThreadPool& pool_;
+  const OffloadCompletionQueueSharedPtr completion_queue_;
+  OffloadOperationSharedPtr operation_;
+};
+
+// OffloadPrivateKeyMethodProvider handles the private key method operations for an SSL socket.
+class OffloadPrivateKeyMethodProvider : public virtual Ssl::PrivateKeyMethodProvider,
+                                        public Logger::Loggable<Logger::Id::connection> {
+public:
+  OffloadPrivateKeyMethodProvider(
+      const envoy::extensions::private_key_providers::offload::v3alpha::
+          OffloadPrivateKeyMethodConfig& config,
+      Server::Configuration::TransportSocketFactoryContext& private_key_provider_context);
+
+  // Ssl::PrivateKeyMethodProvider
+  void registerPrivateKeyMethod(SSL* ssl, Ssl::PrivateKeyConnectionCallbacks& cb,
+                                Event::Dispatcher& dispatcher) override;
+  void unregisterPrivateKeyMethod(SSL* ssl) override;
+  bool checkFips() override;
+  bool isAvailable() override { return true; }
+  Ssl::BoringSslPrivateKeyMethodSharedPtr getBoringSslPrivateKeyMethod() override {
+    return method_;
+  }
+
+  static int connectionIndex();
+
+private:
+  // Thread local data containing the completion queue of each worker thread.
+  struct ThreadLocalCompletionQueue : public ThreadLocal::ThreadLocalObject {
+    explicit ThreadLocalCompletionQueue(Event::Dispatcher& dispatcher)
+        : queue_(std::make_shared<OffloadCompletionQueue>(dispatcher)) {}
+    ~ThreadLocalCompletionQueue() override { queue_->shutdown(); }
+    const OffloadCompletionQueueSharedPtr queue_;
+  };
+
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  OffloadThreadPoolSharedPtr pool_;
+  ThreadLocal::TypedSlotPtr<ThreadLocalCompletionQueue> tls_;
+};
+
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
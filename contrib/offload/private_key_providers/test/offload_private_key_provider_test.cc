@@ -0,0 +1,295 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/registry/registry.h"
+#include "envoy/ssl/private_key/private_key_config.h"
+
+#include "source/common/thread_local/thread_local_impl.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/environment.h"
+#include "test/test_common/utility.h"
+
+#include "contrib/offload/private_key_providers/source/offload_private_key_provider.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/rsa.h"
+#include "openssl/ssl.h"
+
+using testing::Invoke;
+using testing::NiceMock;
+using testing::ReturnRef;
+
+namespace Envoy {
+namespace Extensions {
+namespace PrivateKeyMethodProvider {
+namespace Offload {
+namespace {
+
+class MockPrivateKeyConnectionCallbacks : public Ssl::PrivateKeyConnectionCallbacks {
+public:
+  MOCK_METHOD(void, onPrivateKeyMethodComplete, ());
+};
+
+constexpr absl::string_view RsaKey = "test/common/tls/test_data/san_dns_rsa_1_key.pem";
+constexpr absl::string_view EcdsaKey = "test/common/tls/test_data/san_dns_ecdsa_1_key.pem";
+
+class OffloadPrivateKeyProviderTest : public testing::Test {
+public:
+  OffloadPrivateKeyProviderTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        ssl_ctx_(SSL_CTX_new(TLS_method())) {
+    tls_.registerThread(*dispatcher_, true);
+    ON_CALL(factory_context_.server_context_, api()).WillByDefault(ReturnRef(*api_));
+    ON_CALL(factory_context_.server_context_, threadLocal()).WillByDefault(ReturnRef(tls_));
+  }
+
+  ~OffloadPrivateKeyProviderTest() override {
+    for (bssl::UniquePtr<SSL>& ssl : ssls_) {
+      provider_->unregisterPrivateKeyMethod(ssl.get());
+    }
+    provider_.reset();
+    tls_.shutdownGlobalThreading();
+    tls_.shutdownThread();
+  }
+
+  void createProvider(absl::string_view key_path, uint32_t thread_count = 1,
+                      uint32_t max_batch_size = 8) {
+    const std::string yaml = fmt::format(R"EOF(
+      provider_name: offload
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.private_key_providers.offload.v3alpha.OffloadPrivateKeyMethodConfig
+        private_key: {{ filename: "{{{{ test_rundir }}}}/{}" }}
+        thread_count: {}
+        max_batch_size: {}
+      )EOF",
+                                         key_path, thread_count, max_batch_size);
+    envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider config;
+    TestUtility::loadFromYaml(TestEnvironment::substitute(yaml), config);
+    provider_ = Registry::FactoryRegistry<Ssl::PrivateKeyMethodProviderInstanceFactory>::getFactory(
+                    "offload")
+                    ->createPrivateKeyMethodProviderInstance(config, factory_context_);
+    method_ = provider_->getBoringSslPrivateKeyMethod();
+
+    key_file_ = TestEnvironment::readFileToStringForTest(
+        TestEnvironment::runfilesPath(std::string(key_path)));
+    bssl::UniquePtr<BIO> bio(BIO_new_mem_buf(key_file_.data(), key_file_.size()));
+    pkey_.reset(PEM_read_bio_PrivateKey(bio.get(), nullptr, nullptr, nullptr));
+  }
+
+  // Creates an SSL object registered with the provider.
+  SSL* newSsl(MockPrivateKeyConnectionCallbacks& cb) {
+    ssls_.emplace_back(SSL_new(ssl_ctx_.get()));
+    provider_->registerPrivateKeyMethod(ssls_.back().get(), cb, *dispatcher_);
+    return ssls_.back().get();
+  }
+
+  // Runs the dispatcher until the operation of the connection with the callbacks completes.
+  void waitForCompletion(MockPrivateKeyConnectionCallbacks& cb) {
+    EXPECT_CALL(cb, onPrivateKeyMethodComplete()).WillOnce(Invoke([this]() {
+      dispatcher_->exit();
+    }));
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+
+  // Signs the input on the pool and verifies the signature with the public key.
+  void signAndVerify(uint16_t signature_algorithm) {
+    MockPrivateKeyConnectionCallbacks cb;
+    SSL* ssl = newSsl(cb);
+    EXPECT_EQ(ssl_private_key_retry,
+              method_->sign(ssl, out_, &out_len_, sizeof(out_), signature_algorithm, in_.data(),
+                            in_.size()));
+    waitForCompletion(cb);
+    ASSERT_EQ(ssl_private_key_success, method_->complete(ssl, out_, &out_len_, sizeof(out_)));
+
+    bssl::ScopedEVP_MD_CTX ctx;
+    EVP_PKEY_CTX* pkey_ctx;
+    ASSERT_TRUE(EVP_DigestVerifyInit(ctx.get(), &pkey_ctx,
+                                     SSL_get_signature_algorithm_digest(signature_algorithm),
+                                     nullptr, pkey_.get()));
+    if (SSL_is_signature_algorithm_rsa_pss(signature_algorithm)) {
+      ASSERT_TRUE(EVP_PKEY_CTX_set_rsa_padding(pkey_ctx, RSA_PKCS1_PSS_PADDING));
+      ASSERT_TRUE(EVP_PKEY_CTX_set_rsa_pss_saltlen(pkey_ctx, -1));
+    }
+    EXPECT_TRUE(EVP_DigestVerify(ctx.get(), out_, out_len_, in_.data(), in_.size()));
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  ThreadLocal::InstanceImpl tls_;
+  NiceMock<Server::Configuration::MockTransportSocketFactoryContext> factory_context_;
+  Ssl::PrivateKeyMethodProviderSharedPtr provider_;
+  Ssl::BoringSslPrivateKeyMethodSharedPtr method_;
+  std::string key_file_;
+  bssl::UniquePtr<EVP_PKEY> pkey_;
+  bssl::UniquePtr<SSL_CTX> ssl_ctx_;
+  std::vector<bssl::UniquePtr<SSL>> ssls_;
+
+  const std::vector<uint8_t> in_ = std::vector<uint8_t>(64, 0x7f);
+  uint8_t out_[512] = {0};
+  size_t out_len_ = 0;
+};
+
+TEST_F(OffloadPrivateKeyProviderTest, RsaPssSign) {
+  createProvider(RsaKey);
+  EXPECT_TRUE(provider_->isAvailable());
+  signAndVerify(SSL_SIGN_RSA_PSS_RSAE_SHA256);
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, RsaPkcs1Sign) {
+  createProvider(RsaKey);
+  signAndVerify(SSL_SIGN_RSA_PKCS1_SHA384);
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, EcdsaSign) {
+  createProvider(EcdsaKey);
+  signAndVerify(SSL_SIGN_ECDSA_SECP256R1_SHA256);
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, RsaDecrypt) {
+  createProvider(RsaKey);
+  RSA* rsa = EVP_PKEY_get0_RSA(pkey_.get());
+  // The plaintext must be smaller than the modulus.
+  std::vector<uint8_t> plaintext(RSA_size(rsa), 0x7f);
+  plaintext[0] = 0;
+  std::vector<uint8_t> ciphertext(RSA_size(rsa));
+  size_t ciphertext_len;
+  ASSERT_TRUE(RSA_encrypt(rsa, &ciphertext_len, ciphertext.data(), ciphertext.size(),
+                          plaintext.data(), plaintext.size(), RSA_NO_PADDING));
+
+  MockPrivateKeyConnectionCallbacks cb;
+  SSL* ssl = newSsl(cb);
+  EXPECT_EQ(ssl_private_key_retry, method_->decrypt(ssl, out_, &out_len_, sizeof(out_),
+                                                    ciphertext.data(), ciphertext_len));
+  waitForCompletion(cb);
+  ASSERT_EQ(ssl_private_key_success, method_->complete(ssl, out_, &out_len_, sizeof(out_)));
+  EXPECT_EQ(plaintext, std::vector<uint8_t>(out_, out_ + out_len_));
+}
+
+// The operation is not complete until it is handed back to the worker thread, and the output must
+// fit in the buffer of BoringSSL.
+TEST_F(OffloadPrivateKeyProviderTest, CompleteBeforeDoneAndShortBuffer) {
+  createProvider(RsaKey);
+  MockPrivateKeyConnectionCallbacks cb;
+  SSL* ssl = newSsl(cb);
+  EXPECT_EQ(ssl_private_key_failure, method_->complete(ssl, out_, &out_len_, sizeof(out_)));
+  EXPECT_EQ(ssl_private_key_retry, method_->sign(ssl, out_, &out_len_, sizeof(out_),
+                                                 SSL_SIGN_RSA_PSS_RSAE_SHA256, in_.data(),
+                                                 in_.size()));
+  EXPECT_EQ(ssl_private_key_retry, method_->complete(ssl, out_, &out_len_, sizeof(out_)));
+  waitForCompletion(cb);
+  EXPECT_EQ(ssl_private_key_failure, method_->complete(ssl, out_, &out_len_, 16));
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, SignatureAlgorithmOfOtherKeyTypeFails) {
+  createProvider(RsaKey);
+  MockPrivateKeyConnectionCallbacks cb;
+  SSL* ssl = newSsl(cb);
+  EXPECT_EQ(ssl_private_key_retry, method_->sign(ssl, out_, &out_len_, sizeof(out_),
+                                                 SSL_SIGN_ECDSA_SECP256R1_SHA256, in_.data(),
+                                                 in_.size()));
+  waitForCompletion(cb);
+  EXPECT_EQ(ssl_private_key_failure, method_->complete(ssl, out_, &out_len_, sizeof(out_)));
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, EcdsaDecryptFails) {
+  createProvider(EcdsaKey);
+  MockPrivateKeyConnectionCallbacks cb;
+  SSL* ssl = newSsl(cb);
+  EXPECT_EQ(ssl_private_key_failure,
+            method_->decrypt(ssl, out_, &out_len_, sizeof(out_), in_.data(), in_.size()));
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, UnregisteredSslFails) {
+  createProvider(RsaKey);
+  bssl::UniquePtr<SSL> ssl(SSL_new(ssl_ctx_.get()));
+  EXPECT_EQ(ssl_private_key_failure,
+            method_->sign(ssl.get(), out_, &out_len_, sizeof(out_), SSL_SIGN_RSA_PSS_RSAE_SHA256,
+                          in_.data(), in_.size()));
+  EXPECT_EQ(ssl_private_key_failure, method_->complete(ssl.get(), out_, &out_len_, sizeof(out_)));
+  EXPECT_EQ(ssl_private_key_failure, method_->complete(nullptr, out_, &out_len_, sizeof(out_)));
+}
+
+// Operations of many connections are executed in batches and all complete.
+TEST_F(OffloadPrivateKeyProviderTest, Batches) {
+  createProvider(EcdsaKey, 2, 3);
+  constexpr uint32_t Connections = 10;
+  std::vector<std::unique_ptr<MockPrivateKeyConnectionCallbacks>> callbacks;
+  std::vector<SSL*> ssls;
+  uint32_t completions = 0;
+  for (uint32_t i = 0; i < Connections; ++i) {
+    callbacks.push_back(std::make_unique<MockPrivateKeyConnectionCallbacks>());
+    EXPECT_CALL(*callbacks.back(), onPrivateKeyMethodComplete()).WillOnce(Invoke([&]() {
+      if (++completions == Connections) {
+        dispatcher_->exit();
+      }
+    }));
+    ssls.push_back(newSsl(*callbacks.back()));
+    EXPECT_EQ(ssl_private_key_retry, method_->sign(ssls.back(), out_, &out_len_, sizeof(out_),
+                                                   SSL_SIGN_ECDSA_SECP256R1_SHA256, in_.data(),
+                                                   in_.size()));
+  }
+  dispatcher_->run(Event::Dispatcher::RunType::Block);
+  for (SSL* ssl : ssls) {
+    EXPECT_EQ(ssl_private_key_success, method_->complete(ssl, out_, &out_len_, sizeof(out_)));
+  }
+}
+
+// The handshake of a connection that is gone is not resumed.
+TEST_F(OffloadPrivateKeyProviderTest, UnregisterBeforeCompletion) {
+  createProvider(RsaKey);
+  MockPrivateKeyConnectionCallbacks gone_cb;
+  EXPECT_CALL(gone_cb, onPrivateKeyMethodComplete()).Times(0);
+  SSL* gone_ssl = newSsl(gone_cb);
+  EXPECT_EQ(ssl_private_key_retry, method_->sign(gone_ssl, out_, &out_len_, sizeof(out_),
+                                                 SSL_SIGN_RSA_PSS_RSAE_SHA256, in_.data(),
+                                                 in_.size()));
+  provider_->unregisterPrivateKeyMethod(gone_ssl);
+  ssls_.erase(ssls_.begin());
+
+  // The single thread of the pool executes the operations in order, so the operation of the
+  // connection that is gone is handed back no later than this one.
+  MockPrivateKeyConnectionCallbacks cb;
+  SSL* ssl = newSsl(cb);
+  EXPECT_EQ(ssl_private_key_retry, method_->sign(ssl, out_, &out_len_, sizeof(out_),
+                                                 SSL_SIGN_RSA_PSS_RSAE_SHA256, in_.data(),
+                                                 in_.size()));
+  waitForCompletion(cb);
+  EXPECT_EQ(ssl_private_key_success, method_->complete(ssl, out_, &out_len_, sizeof(out_)));
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, RegisterTwiceFails) {
+  createProvider(RsaKey);
+  MockPrivateKeyConnectionCallbacks cb;
+  SSL* ssl = newSsl(cb);
+  EXPECT_THROW_WITH_MESSAGE(provider_->registerPrivateKeyMethod(ssl, cb, *dispatcher_),
+                            EnvoyException,
+                            "Not registering the Offload provider twice for same context");
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, Fips) {
+  createProvider(RsaKey);
+  EXPECT_TRUE(provider_->checkFips());
+}
+
+TEST_F(OffloadPrivateKeyProviderTest, InvalidKey) {
+  envoy::extensions::transport_sockets::tls::v3::PrivateKeyProvider config;
+  TestUtility::loadFromYaml(R"EOF(
+    provider_name: offload
+    typed_config:
+      "@type": type.googleapis.com/envoy.extensions.private_key_providers.offload.v3alpha.OffloadPrivateKeyMethodConfig
+      private_key: { inline_string: "not a key" }
+  )EOF",
+                            config);
+  EXPECT_THROW_WITH_MESSAGE(
+      Registry::FactoryRegistry<Ssl::PrivateKeyMethodProviderInstanceFactory>::getFactory("offload")
+          ->createPrivateKeyMethodProviderInstance(config, factory_context_),
+      EnvoyException, "Failed to read private key.");
+}
+
+} // namespace
+} // namespace Offload
+} // namespace PrivateKeyMethodProvider
+} // namespace Extensions
+} // namespace Envoy
@@ -134,6 +134,8 @@ public:
   void set(uint64_t) override {}
   void sub(uint64_t) override {}
   uint64_t value() const override { return original_.value(); }
+  // The original gauge is latched by the snapshot being wrapped.
+  bool latchChanged() override { return true; }
   void setParentValue(uint64_t) override {}
   ImportMode importMode() const override { return original_.importMode(); }
   void mergeImportMode(ImportMode) override {}
@@ -286,6 +288,7 @@ public:
   void set(uint64_t) override {}
   void sub(uint64_t) override {}
   uint64_t value() const override { return value_; }
+  bool latchChanged() override { return true; }
   void setParentValue(uint64_t) override {}
   ImportMode importMode() const override { return ImportMode::NeverImport; }
   void mergeImportMode(ImportMode) override {}
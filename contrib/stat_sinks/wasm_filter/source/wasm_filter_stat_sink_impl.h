@@ -113,6 +113,11 @@ public:
   const std::vector<std::reference_wrapper<const Stats::Gauge>>& gauges() override {
     return enriched_gauges_;
   }
+  // Updates of the original gauges are not tracked through the plugin, so every gauge is reported
+  // as changed.
+  const std::vector<std::reference_wrapper<const Stats::Gauge>>& changedGauges() override {
+    return enriched_gauges_;
+  }
   const std::vector<std::reference_wrapper<const Stats::ParentHistogram>>& histograms() override {
     return enriched_histograms_;
   }
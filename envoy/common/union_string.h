@@ -125,6 +125,17 @@ public:
                    absl::get<InlinedStringVector>(buffer_).begin(), unary_op);
   }
 
+  /**
+   * Transforms the inlined vector data in place using the given BufferOperation, which is called
+   * once with the data and size of the whole buffer.
+   * @param buffer_op the operation to be performed on the buffer.
+   */
+  template <typename BufferOperation> void inlineTransformBuffer(BufferOperation&& buffer_op) {
+    ASSERT(type() == Type::Inline);
+    InlinedStringVector& buffer = getInVec(buffer_);
+    buffer_op(buffer.data(), buffer.size());
+  }
+
   /**
    * Trim trailing whitespaces from the InlinedString. Only supported by the "Inline" InlinedString
    * representation.
@@ -60,6 +60,37 @@ public:
    */
   virtual Protobuf::Value formatValue(const Context& context,
                                       const StreamInfo::StreamInfo& stream_info) const PURE;
+
+  /**
+   * Append the value formatted like format() to the output. Providers override this to write
+   * their value without allocating an intermediate string.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the string the value is appended to.
+   * @return bool whether there is a value. Nothing is appended if there is none.
+   */
+  virtual bool formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                        std::string& output) const {
+    const absl::optional<std::string> value = format(context, stream_info);
+    if (!value.has_value()) {
+      return false;
+    }
+    output.append(value.value());
+    return true;
+  }
+
+  /**
+   * Append the value formatted like formatValue() to the output, serialized as JSON. Providers
+   * override this to write their value without building a Protobuf::Value.
+   * @param context supplies the formatter context.
+   * @param stream_info supplies the stream info.
+   * @param output supplies the string the JSON value is appended to.
+   * @return bool whether the provider supports it. Nothing is appended if it does not, and the
+   *         caller should serialize formatValue() instead.
+   */
+  virtual bool formatValueTo(const Context&, const StreamInfo::StreamInfo&, std::string&) const {
+    return false;
+  }
 };
 
 using FormatterProviderPtr = std::unique_ptr<FormatterProvider>;
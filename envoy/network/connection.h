@@ -396,6 +396,12 @@ public:
    */
   virtual bool startSecureTransport() PURE;
 
+  /**
+   * @return whether the data of the connection can be moved to and from its socket without going
+   *         through its transport socket. See TransportSocket::canSpliceData().
+   */
+  virtual bool canSpliceData() const PURE;
+
   /**
    *  @return absl::optional<std::chrono::milliseconds> An optional of the most recent round-trip
    *  time of the connection. If the platform does not support this, then an empty optional is
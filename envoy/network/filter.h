@@ -220,6 +220,13 @@ public:
    */
   virtual bool startUpstreamSecureTransport() PURE;
 
+  /**
+   * @return whether this filter is the only filter of the connection, with no other read filter
+   *         and no write filter. Only then can the filter move the data of the connection without
+   *         passing it through the filter chain.
+   */
+  virtual bool isOnlyFilter() PURE;
+
   /**
    * Control the filter close status for read filters.
    *
@@ -201,6 +201,13 @@ public:
    */
   virtual bool startSecureTransport() PURE;
 
+  /**
+   * @return whether the data of the connection can be moved to and from its socket without going
+   *         through the transport socket, e.g. with splice(2). This is only true for transport
+   *         sockets that read and write the data unmodified and do nothing else with it.
+   */
+  virtual bool canSpliceData() const { return false; }
+
   /**
    * Try to configure the connection's initial congestion window.
    * The operation is advisory - the connection may not support it, even if it's supported, it may
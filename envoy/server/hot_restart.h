@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <string>
 
 #include "envoy/common/pure.h"
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/stats/store.h"
 #include "envoy/thread/thread.h"
@@ -104,6 +106,16 @@ public:
    */
   virtual ServerStatsFromParent mergeParentStatsIfAny(Stats::StoreRoot& stats_store) PURE;
 
+  using TlsSessionCb =
+      std::function<void(absl::string_view id, absl::string_view session, SystemTime expire_time)>;
+
+  /**
+   * Retrieve the sessions of the shared TLS session cache of our parent process.
+   * Does nothing if there is not currently a parent, or if it has no shared TLS session cache.
+   * @param cb called with the ID, the serialization and the expiration time of each session.
+   */
+  virtual void getParentTlsSessions(const TlsSessionCb& cb) PURE;
+
   /**
    * Shutdown the half of our hot restarter that acts as a parent.
    */
@@ -96,6 +96,11 @@ public:
    */
   virtual bool skipHotRestartParentStats() const PURE;
 
+  /**
+   * @return bool don't get the cached TLS sessions from the parent.
+   */
+  virtual bool skipHotRestartTlsSessions() const PURE;
+
   /**
    * @return const std::string& the dynamic base id output file.
    */
@@ -227,6 +232,18 @@ public:
    */
   virtual uint64_t fileFlushMinSizeKB() const PURE;
 
+  /**
+   * @return uint64_t the size in kilobytes of the buffer each thread writes each log file through,
+   *         or 0 if log files are written through a single buffer.
+   */
+  virtual uint64_t fileFlushThreadBufferKB() const PURE;
+
+  /**
+   * @return uint64_t the size in kilobytes of the TLS session cache shared by all server contexts,
+   *         or 0 if each server context caches its own sessions.
+   */
+  virtual uint64_t tlsSessionCacheSizeKB() const PURE;
+
   /**
    * @return const std::string& the server's cluster.
    */
@@ -33,6 +33,15 @@ public:
    */
   virtual const std::vector<std::reference_wrapper<const Gauge>>& gauges() PURE;
 
+  /**
+   * Sinks that only report the metrics that changed since the previous flush can use this instead
+   * of gauges(). Counters that did not change have a zero delta, and histograms that did not change
+   * have no samples in their interval statistics.
+   * @return the gauges of gauges() that were updated since the previous snapshot. Implementations
+   *         that do not track updates may return all the gauges.
+   */
+  virtual const std::vector<std::reference_wrapper<const Gauge>>& changedGauges() PURE;
+
   /**
    * @return a snapshot of all histograms.
    */
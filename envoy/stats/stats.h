@@ -107,12 +107,14 @@ public:
    * Flags:
    * Used: used by all stats types to figure out whether they have been used.
    * Logic...: used by gauges to cache how they should be combined with a parent's value.
+   * Changed: used by gauges to track whether they have been updated since they were last latched.
    */
   struct Flags {
     static constexpr uint8_t Used = 0x01;
     static constexpr uint8_t LogicAccumulate = 0x02;
     static constexpr uint8_t NeverImport = 0x04;
     static constexpr uint8_t Hidden = 0x08;
+    static constexpr uint8_t Changed = 0x10;
   };
   virtual SymbolTable& symbolTable() PURE;
   virtual const SymbolTable& constSymbolTable() const PURE;
@@ -167,6 +169,14 @@ public:
   }
   virtual uint64_t value() const PURE;
 
+  /**
+   * Clears the indicator of whether this gauge has been updated. This is called once per stats
+   * flush so that sinks can skip the gauges that did not change since the previous flush.
+   *
+   * @return true if the gauge was updated since it was created or since the previous call.
+   */
+  virtual bool latchChanged() PURE;
+
   /**
    * Sets a value from a hot-restart parent. This parent contribution must be
    * kept distinct from the child value, so that when we erase the value it
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/common/optref.h"
 #include "envoy/extensions/filters/network/tcp_proxy/v3/tcp_proxy.pb.h"
 #include "envoy/http/filter.h"
 #include "envoy/http/header_evaluator.h"
@@ -181,6 +182,12 @@ public:
    * @return the failure reason of the local close.
    */
   virtual absl::string_view localCloseReason() const { return ""; }
+
+  /**
+   * @return the upstream connection if the data is written to it as is, e.g. it is not tunneled,
+   *         or an empty reference otherwise.
+   */
+  virtual OptRef<Network::Connection> rawConnection() { return {}; }
 };
 
 using GenericConnPoolPtr = std::unique_ptr<GenericConnPool>;
@@ -281,12 +281,15 @@ public:
    *                       update. It can be overridden by setting `remove_ignored` to true while
    *                       calling removeCluster(). This is useful for clusters whose lifecycle
    *                       is managed with custom implementation, e.g., DFP clusters.
+   * @param config_hash the hash of the cluster configuration, as computed by MessageUtil::hash(),
+   *                    if the caller already computed it.
    * @return true if the action results in an add/update of a cluster, an error
    * status if the config is invalid.
    */
   virtual absl::StatusOr<bool>
   addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
-                     const std::string& version_info, const bool avoid_cds_removal = false) PURE;
+                     const std::string& version_info, const bool avoid_cds_removal = false,
+                     absl::optional<uint64_t> config_hash = absl::nullopt) PURE;
 
   /**
    * Set a callback that will be invoked when all primary clusters have been initialized.
@@ -1062,6 +1062,12 @@ public:
    */
   virtual float peekaheadRatio() const PURE;
 
+  /**
+   * @return the adaptive preconnect configuration, if adaptive preconnecting is enabled.
+   */
+  virtual OptRef<const envoy::config::cluster::v3::Cluster::PreconnectPolicy::AdaptivePreconnect>
+  adaptivePreconnect() const PURE;
+
   /**
    * @return soft limit on size of the cluster's connections read and write buffers.
    */
@@ -10,6 +10,7 @@
 #include "source/common/common/lock_guard.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_map.h"
 
 namespace Envoy {
 namespace AccessLog {
@@ -17,8 +18,21 @@ namespace {
 static constexpr Filesystem::FlagSet default_flags{1 << Filesystem::File::Operation::Write |
                                                    1 << Filesystem::File::Operation::Create |
                                                    1 << Filesystem::File::Operation::Append};
+
+std::atomic<uint64_t> next_thread_buffered_file_id{0};
 } // namespace
 
+AccessLogManagerImpl::AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec,
+                                           uint64_t min_flush_size_kb, Api::Api& api,
+                                           Event::Dispatcher& dispatcher,
+                                           Thread::BasicLockable& lock, Stats::Store& stats_store,
+                                           uint64_t thread_buffer_size_kb)
+    : file_flush_interval_msec_(file_flush_interval_msec),
+      file_min_flush_size_kb_(min_flush_size_kb), api_(api), dispatcher_(dispatcher), lock_(lock),
+      file_stats_{ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
+                                        POOL_GAUGE_PREFIX(stats_store, "filesystem."))},
+      thread_buffer_size_kb_(thread_buffer_size_kb) {}
+
 AccessLogManagerImpl::~AccessLogManagerImpl() {
   for (auto& [log_key, log_file_ptr] : access_logs_) {
     ENVOY_LOG(debug, "destroying access logger {}", log_key);
@@ -47,10 +61,21 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
                                                   open_result.err_->getErrorDetails()));
   }
 
-  auto [it, insert_success] = access_logs_.emplace(
-      file_name, std::make_shared<AccessLogFileImpl>(
-                     std::move(file), dispatcher_, lock_, file_stats_, file_flush_interval_msec_,
-                     file_min_flush_size_kb_, api_.threadFactory()));
+  AccessLogFileSharedPtr log_file;
+  if (thread_buffer_size_kb_ > 0) {
+    if (flusher_ == nullptr) {
+      flusher_ = std::make_unique<AccessLogFlusher>(api_.threadFactory(),
+                                                    file_flush_interval_msec_, file_stats_);
+    }
+    log_file = std::make_shared<ThreadBufferedAccessLogFile>(
+        std::move(file), lock_, file_stats_, *flusher_, thread_buffer_size_kb_,
+        file_min_flush_size_kb_);
+  } else {
+    log_file = std::make_shared<AccessLogFileImpl>(std::move(file), dispatcher_, lock_,
+                                                   file_stats_, file_flush_interval_msec_,
+                                                   file_min_flush_size_kb_, api_.threadFactory());
+  }
+  auto [it, insert_success] = access_logs_.emplace(file_name, std::move(log_file));
   // Insertion was successful because the key wasn't found in the map or else
   // the value would have been previously returned.
   ASSERT(insert_success);
@@ -230,5 +255,244 @@ void AccessLogFileImpl::createFlushStructures() {
                                                Thread::Options{"AccessLogFlush"});
 }
 
+AccessLogRing::AccessLogRing(uint64_t capacity)
+    : capacity_(capacity), buffer_(new char[capacity]) {}
+
+bool AccessLogRing::push(absl::string_view data) {
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  // Acquire the consumer's reads of the bytes it released.
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  if (data.size() > capacity_ - (tail - head)) {
+    dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return false;
+  }
+
+  const uint64_t offset = tail % capacity_;
+  const uint64_t first = std::min<uint64_t>(data.size(), capacity_ - offset);
+  memcpy(buffer_.get() + offset, data.data(), first);
+  memcpy(buffer_.get(), data.data() + first, data.size() - first);
+  // Release the bytes to the consumer.
+  tail_.store(tail + data.size(), std::memory_order_release);
+  writes_.store(writes_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  return true;
+}
+
+uint64_t AccessLogRing::size() const {
+  return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed);
+}
+
+absl::InlinedVector<absl::string_view, 2> AccessLogRing::readable() const {
+  const uint64_t head = head_.load(std::memory_order_relaxed);
+  const uint64_t tail = tail_.load(std::memory_order_acquire);
+  absl::InlinedVector<absl::string_view, 2> slices;
+  if (head == tail) {
+    return slices;
+  }
+  const uint64_t offset = head % capacity_;
+  const uint64_t first = std::min<uint64_t>(tail - head, capacity_ - offset);
+  slices.emplace_back(buffer_.get() + offset, first);
+  if (first < tail - head) {
+    slices.emplace_back(buffer_.get(), tail - head - first);
+  }
+  return slices;
+}
+
+void AccessLogRing::consume(uint64_t length) {
+  ASSERT(length <= size());
+  head_.store(head_.load(std::memory_order_relaxed) + length, std::memory_order_release);
+}
+
+uint64_t AccessLogRing::takeWrites() {
+  const uint64_t writes = writes_.load(std::memory_order_relaxed);
+  const uint64_t taken = writes - writes_taken_;
+  writes_taken_ = writes;
+  return taken;
+}
+
+uint64_t AccessLogRing::takeDropped() {
+  const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+  const uint64_t taken = dropped - dropped_taken_;
+  dropped_taken_ = dropped;
+  return taken;
+}
+
+AccessLogFlusher::AccessLogFlusher(Thread::ThreadFactory& thread_factory,
+                                   std::chrono::milliseconds flush_interval_msec,
+                                   AccessLogFileStats& stats)
+    : flush_interval_msec_(flush_interval_msec), stats_(stats) {
+  flush_thread_ = thread_factory.createThread([this]() -> void { flushThreadFunc(); },
+                                              Thread::Options{"AccessLogFlush"});
+}
+
+AccessLogFlusher::~AccessLogFlusher() {
+  {
+    Thread::LockGuard lock(wakeup_lock_);
+    exit_ = true;
+    wakeup_event_.notifyOne();
+  }
+  flush_thread_->join();
+}
+
+void AccessLogFlusher::add(AccessLogFile& file) {
+  Thread::LockGuard lock(files_lock_);
+  files_.insert(&file);
+}
+
+void AccessLogFlusher::remove(AccessLogFile& file) {
+  Thread::LockGuard lock(files_lock_);
+  files_.erase(&file);
+}
+
+void AccessLogFlusher::wakeup() {
+  // Writers that find a wake up pending only read the flag, and so do not contend on it.
+  if (wakeup_pending_.load(std::memory_order_relaxed) || wakeup_pending_.exchange(true)) {
+    return;
+  }
+  Thread::LockGuard lock(wakeup_lock_);
+  wakeup_ = true;
+  wakeup_event_.notifyOne();
+}
+
+void AccessLogFlusher::flushThreadFunc() {
+  while (true) {
+    {
+      Thread::LockGuard lock(wakeup_lock_);
+      if (!wakeup_ && !exit_ &&
+          wakeup_event_.waitFor(wakeup_lock_, flush_interval_msec_) ==
+              Thread::CondVar::WaitStatus::Timeout) {
+        stats_.flushed_by_timer_.inc();
+      }
+      if (exit_) {
+        return;
+      }
+      wakeup_ = false;
+    }
+    wakeup_pending_.store(false);
+
+    Thread::LockGuard lock(files_lock_);
+    for (AccessLogFile* file : files_) {
+      file->flush();
+    }
+  }
+}
+
+ThreadBufferedAccessLogFile::ThreadBufferedAccessLogFile(
+    Filesystem::FilePtr&& file, Thread::BasicLockable& lock, AccessLogFileStats& stats,
+    AccessLogFlusher& flusher, uint64_t thread_buffer_size_kb, uint64_t min_flush_size_kb)
+    : id_(next_thread_buffered_file_id++), file_(std::move(file)), file_lock_(lock),
+      stats_(stats), flusher_(flusher), ring_capacity_(thread_buffer_size_kb * 1024),
+      wakeup_size_(std::min(min_flush_size_kb * 1024, ring_capacity_ / 2)) {
+  flusher_.add(*this);
+}
+
+ThreadBufferedAccessLogFile::~ThreadBufferedAccessLogFile() {
+  flusher_.remove(*this);
+  flush();
+  {
+    Thread::LockGuard flush_lock(flush_lock_);
+    stats_.write_total_buffered_.sub(buffered_bytes_);
+  }
+  if (file_->isOpen()) {
+    const Api::IoCallBoolResult result = file_->close();
+    ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
+                                             result.err_->getErrorDetails()));
+  }
+}
+
+AccessLogRing& ThreadBufferedAccessLogFile::threadRing() {
+  // The rings are owned by their file and only weakly referenced by the threads. File ids are
+  // never reused, so the rings of destroyed files are never looked up, and their entries are
+  // pruned whenever the thread adds a ring.
+  struct ThreadRing {
+    std::weak_ptr<AccessLogRing> owned_;
+    AccessLogRing* ring_;
+  };
+  thread_local absl::flat_hash_map<uint64_t, ThreadRing> thread_rings;
+  if (const auto it = thread_rings.find(id_); it != thread_rings.end()) {
+    return *it->second.ring_;
+  }
+
+  absl::erase_if(thread_rings, [](const auto& entry) { return entry.second.owned_.expired(); });
+  auto ring = std::make_shared<AccessLogRing>(ring_capacity_);
+  {
+    Thread::LockGuard lock(rings_lock_);
+    rings_.push_back(ring);
+  }
+  thread_rings.emplace(id_, ThreadRing{ring, ring.get()});
+  return *ring;
+}
+
+void ThreadBufferedAccessLogFile::write(absl::string_view data) {
+  AccessLogRing& ring = threadRing();
+  if (!ring.push(data) || ring.size() >= wakeup_size_) {
+    flusher_.wakeup();
+  }
+}
+
+void ThreadBufferedAccessLogFile::reopen() {
+  reopen_file_ = true;
+  flusher_.wakeup();
+}
+
+void ThreadBufferedAccessLogFile::reopenFile() {
+  if (file_->isOpen()) {
+    const Api::IoCallBoolResult result = file_->close();
+    ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
+                                             result.err_->getErrorDetails()));
+  }
+  const Api::IoCallBoolResult open_result = file_->open(default_flags);
+  if (!open_result.return_value_) {
+    stats_.reopen_failed_.inc();
+    // Retry on the next flush.
+    reopen_file_ = true;
+  }
+}
+
+void ThreadBufferedAccessLogFile::flush() {
+  Thread::LockGuard flush_lock(flush_lock_);
+  if (reopen_file_.exchange(false)) {
+    reopenFile();
+  }
+
+  std::vector<AccessLogRing*> rings;
+  {
+    Thread::LockGuard lock(rings_lock_);
+    rings.reserve(rings_.size());
+    for (const auto& ring : rings_) {
+      rings.push_back(ring.get());
+    }
+  }
+
+  // Write the rings of all threads under one acquisition of the lock. As in AccessLogFileImpl,
+  // the rings are drained even if the file is not open.
+  Thread::LockGuard file_lock(file_lock_);
+  uint64_t buffered_bytes = 0;
+  for (AccessLogRing* ring : rings) {
+    stats_.write_buffered_.add(ring->takeWrites());
+    stats_.write_dropped_.add(ring->takeDropped());
+    uint64_t length = 0;
+    for (absl::string_view slice : ring->readable()) {
+      const Api::IoCallSizeResult result = file_->write(slice);
+      if (result.ok() && result.return_value_ == static_cast<ssize_t>(slice.size())) {
+        stats_.write_completed_.inc();
+      } else {
+        stats_.write_failed_.inc();
+      }
+      length += slice.size();
+    }
+    ring->consume(length);
+    buffered_bytes += ring->size();
+  }
+
+  // The writers do not update write_total_buffered, so that they do not contend on it. It is
+  // brought up to date with the data left in the rings on each flush instead.
+  if (buffered_bytes > buffered_bytes_) {
+    stats_.write_total_buffered_.add(buffered_bytes - buffered_bytes_);
+  } else {
+    stats_.write_total_buffered_.sub(buffered_bytes_ - buffered_bytes);
+  }
+  buffered_bytes_ = buffered_bytes;
+}
+
 } // namespace AccessLog
 } // namespace Envoy
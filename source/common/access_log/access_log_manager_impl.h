@@ -2,7 +2,10 @@
 
 #include <sys/types.h>
 
+#include <atomic>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
 #include "envoy/api/api.h"
@@ -15,6 +18,8 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/thread.h"
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/container/node_hash_map.h"
 
 namespace Envoy {
@@ -24,6 +29,7 @@ namespace Envoy {
   COUNTER(reopen_failed)                                                                           \
   COUNTER(write_buffered)                                                                          \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
   GAUGE(write_total_buffered, Accumulate)
 
@@ -33,15 +39,14 @@ struct AccessLogFileStats {
 
 namespace AccessLog {
 
+class AccessLogFlusher;
+
 class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::Id::main> {
 public:
   AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec,
                        uint64_t min_flush_size_kb, Api::Api& api, Event::Dispatcher& dispatcher,
-                       Thread::BasicLockable& lock, Stats::Store& stats_store)
-      : file_flush_interval_msec_(file_flush_interval_msec),
-        file_min_flush_size_kb_(min_flush_size_kb), api_(api), dispatcher_(dispatcher), lock_(lock),
-        file_stats_{ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
-                                          POOL_GAUGE_PREFIX(stats_store, "filesystem."))} {}
+                       Thread::BasicLockable& lock, Stats::Store& stats_store,
+                       uint64_t thread_buffer_size_kb = 0);
   ~AccessLogManagerImpl() override;
 
   // AccessLog::AccessLogManager
@@ -56,6 +61,10 @@ private:
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
   AccessLogFileStats file_stats_;
+  // If non-zero, files are written through per thread buffers of this size.
+  const uint64_t thread_buffer_size_kb_;
+  // Flushes the files written through per thread buffers, created with the first of them.
+  std::unique_ptr<AccessLogFlusher> flusher_;
   absl::node_hash_map<std::string, AccessLogFileSharedPtr> access_logs_;
 };
 
@@ -135,5 +144,131 @@ private:
   AccessLogFileStats& stats_;
 };
 
+/**
+ * A ring of bytes written by a single producer thread and read by a single consumer at a time,
+ * without either of them blocking.
+ */
+class AccessLogRing {
+public:
+  explicit AccessLogRing(uint64_t capacity);
+
+  /**
+   * Appends data to the ring. Must only be called from the producer thread.
+   * @return false if the ring does not have room for the data, which is then dropped.
+   */
+  bool push(absl::string_view data);
+
+  /**
+   * @return the number of bytes pushed and not yet consumed.
+   */
+  uint64_t size() const;
+
+  /**
+   * @return the data pushed and not yet consumed, in up to two slices. It stays valid until it is
+   *         consumed. Must only be called by the consumer.
+   */
+  absl::InlinedVector<absl::string_view, 2> readable() const;
+
+  /**
+   * Releases the first length bytes returned by readable(). Must only be called by the consumer.
+   */
+  void consume(uint64_t length);
+
+  /**
+   * @return the number of pushes, and of dropped pushes, since the last call. Must only be called
+   *         by the consumer.
+   */
+  uint64_t takeWrites();
+  uint64_t takeDropped();
+
+private:
+  const uint64_t capacity_;
+  const std::unique_ptr<char[]> buffer_;
+  // The positions of the consumer and producer, as counts of bytes consumed and pushed.
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> tail_{0};
+  std::atomic<uint64_t> writes_{0};
+  std::atomic<uint64_t> dropped_{0};
+  uint64_t writes_taken_{0};
+  uint64_t dropped_taken_{0};
+};
+
+/**
+ * A single thread that flushes a set of access log files, when the flush interval elapses or when
+ * woken up by a write.
+ */
+class AccessLogFlusher {
+public:
+  AccessLogFlusher(Thread::ThreadFactory& thread_factory,
+                   std::chrono::milliseconds flush_interval_msec, AccessLogFileStats& stats);
+  ~AccessLogFlusher();
+
+  /**
+   * Adds or removes a file to flush. Once remove() returns the file is no longer flushed.
+   */
+  void add(AccessLogFile& file);
+  void remove(AccessLogFile& file);
+
+  /**
+   * Wakes up the flush thread, from any thread. Does not block when a wake up is already pending.
+   */
+  void wakeup();
+
+private:
+  void flushThreadFunc();
+
+  const std::chrono::milliseconds flush_interval_msec_;
+  AccessLogFileStats& stats_;
+  // Held while files are flushed, so that they can't be removed meanwhile.
+  Thread::MutexBasicLockable files_lock_;
+  absl::flat_hash_set<AccessLogFile*> files_ ABSL_GUARDED_BY(files_lock_);
+  Thread::MutexBasicLockable wakeup_lock_;
+  Thread::CondVar wakeup_event_;
+  bool wakeup_ ABSL_GUARDED_BY(wakeup_lock_){false};
+  bool exit_ ABSL_GUARDED_BY(wakeup_lock_){false};
+  std::atomic<bool> wakeup_pending_{false};
+  Thread::ThreadPtr flush_thread_;
+};
+
+/**
+ * An access log file that each thread writes to through its own ring, so that writers never
+ * contend on a lock or block. A write that does not fit in the ring of its thread is dropped.
+ * The rings are flushed by an AccessLogFlusher shared by all such files.
+ */
+class ThreadBufferedAccessLogFile : public AccessLogFile {
+public:
+  ThreadBufferedAccessLogFile(Filesystem::FilePtr&& file, Thread::BasicLockable& lock,
+                              AccessLogFileStats& stats, AccessLogFlusher& flusher,
+                              uint64_t thread_buffer_size_kb, uint64_t min_flush_size_kb);
+  ~ThreadBufferedAccessLogFile() override;
+
+  // AccessLog::AccessLogFile
+  void write(absl::string_view data) override;
+  void reopen() override;
+  void flush() override;
+
+private:
+  AccessLogRing& threadRing();
+  void reopenFile();
+
+  // Identifies the file in the per thread ring lookup. Never reused.
+  const uint64_t id_;
+  Filesystem::FilePtr file_;
+  // Serializes disk writes with other files writing to the same file, as in AccessLogFileImpl.
+  Thread::BasicLockable& file_lock_;
+  AccessLogFileStats& stats_;
+  AccessLogFlusher& flusher_;
+  const uint64_t ring_capacity_;
+  // The size of a ring at which its writer wakes up the flusher.
+  const uint64_t wakeup_size_;
+  std::atomic<bool> reopen_file_{false};
+  // Held by the consumer of the rings, the flusher or a synchronous flush, and to reopen the file.
+  Thread::MutexBasicLockable flush_lock_;
+  // The bytes left in the rings after the last flush, as accounted in write_total_buffered.
+  uint64_t buffered_bytes_ ABSL_GUARDED_BY(flush_lock_){0};
+  Thread::MutexBasicLockable rings_lock_;
+  std::vector<std::shared_ptr<AccessLogRing>> rings_ ABSL_GUARDED_BY(rings_lock_);
+};
+
 } // namespace AccessLog
 } // namespace Envoy
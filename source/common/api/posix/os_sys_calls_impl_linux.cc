@@ -4,7 +4,9 @@
 
 #include "source/common/api/os_sys_calls_impl_linux.h"
 
+#include <fcntl.h>
 #include <sched.h>
+#include <unistd.h>
 
 #include <cerrno>
 
@@ -22,5 +24,16 @@ SysCallIntResult LinuxOsSysCallsImpl::setns(int fd, int nstype) const {
   return {rc, errno};
 }
 
+SysCallIntResult LinuxOsSysCallsImpl::pipe2(int pipefd[2], int flags) {
+  const int rc = ::pipe2(pipefd, flags);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
+SysCallSizeResult LinuxOsSysCallsImpl::splice(int fd_in, int fd_out, size_t len,
+                                              unsigned int flags) {
+  const ssize_t rc = ::splice(fd_in, nullptr, fd_out, nullptr, len, flags);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
 } // namespace Api
 } // namespace Envoy
@@ -19,10 +19,6 @@ namespace {
 constexpr uint64_t CopyThreshold = 512;
 } // namespace
 
-thread_local absl::InlinedVector<Slice::StoragePtr,
-                                 OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_max_>
-    OwnedImpl::OwnedImplReservationSlicesOwnerMultiple::free_list_;
-
 uint64_t Slice::prepend(const void* data, uint64_t size) {
   const uint8_t* src = static_cast<const uint8_t*>(data);
   uint64_t copy_size;
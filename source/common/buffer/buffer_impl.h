@@ -9,6 +9,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
 
+#include "source/common/buffer/slice_storage_cache.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
@@ -37,11 +38,13 @@ namespace Buffer {
 class Slice {
 public:
   using Reservation = RawSlice;
-  using StoragePtr = std::unique_ptr<uint8_t[]>;
+  using StoragePtr = SliceStorageCache::StoragePtr;
 
   struct SizedStorage {
     StoragePtr mem_;
     size_t len_{};
+    // The slice storage cache of the thread that allocated mem_, if any.
+    SliceStorageCache* cache_{};
   };
 
   /**
@@ -57,7 +60,8 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_cache_(SliceStorageCache::threadLocal()),
+        storage_(SliceStorageCache::allocateLocal(storage_cache_, capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -73,8 +77,8 @@ public:
    * @param account the account to charge.
    */
   Slice(SizedStorage storage, uint64_t used_size, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(storage.len_), storage_(std::move(storage.mem_)), base_(storage_.get()),
-        reservable_(used_size) {
+      : capacity_(storage.len_), storage_cache_(storage.cache_), storage_(std::move(storage.mem_)),
+        base_(storage_.get()), reservable_(used_size) {
     ASSERT(sliceSize(capacity_) == capacity_);
     ASSERT(reservable_ <= capacity_);
 
@@ -97,6 +101,7 @@ public:
 
   Slice(Slice&& rhs) noexcept {
     capacity_ = rhs.capacity_;
+    storage_cache_ = rhs.storage_cache_;
     storage_ = std::move(rhs.storage_);
     base_ = rhs.base_;
     data_ = rhs.data_;
@@ -114,8 +119,10 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      releaseStorage();
 
       capacity_ = rhs.capacity_;
+      storage_cache_ = rhs.storage_cache_;
       storage_ = std::move(rhs.storage_);
       base_ = rhs.base_;
       data_ = rhs.data_;
@@ -142,6 +149,7 @@ public:
     if (releasor_) {
       releasor_();
     }
+    releaseStorage();
   }
 
   /**
@@ -365,7 +373,19 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    SliceStorageCache* cache = SliceStorageCache::threadLocal();
+    return {SliceStorageCache::allocateLocal(cache, slice_size), static_cast<size_t>(slice_size),
+            cache};
+  }
+
+private:
+  /**
+   * Return the owned storage, if any, to the slice storage cache of the calling thread.
+   */
+  void releaseStorage() {
+    if (storage_ != nullptr) {
+      SliceStorageCache::releaseLocal(std::move(storage_), capacity_, storage_cache_);
+    }
   }
 
 protected:
@@ -373,6 +393,10 @@ protected:
    * of the slice to the end of the Reservable section. */
   uint64_t capacity_ = 0;
 
+  /** The slice storage cache of the thread that allocated storage_, if any. Only used to count
+   * the slices released on another thread. */
+  SliceStorageCache* storage_cache_{nullptr};
+
   /** Backing storage for mutable slices which own their own storage. This storage should never be
    * accessed directly; access base_ instead. */
   StoragePtr storage_;
@@ -763,16 +787,15 @@ private:
 
   struct OwnedImplReservationSlicesOwnerMultiple : public OwnedImplReservationSlicesOwner {
   public:
-    static constexpr uint32_t free_list_max_ = Buffer::Reservation::MAX_SLICES_;
-
-    OwnedImplReservationSlicesOwnerMultiple() : free_list_ref_(free_list_) {}
+    OwnedImplReservationSlicesOwnerMultiple() : cache_(SliceStorageCache::threadLocal()) {}
     ~OwnedImplReservationSlicesOwnerMultiple() override {
+      if (cache_ == nullptr) {
+        return;
+      }
       for (auto r = owned_storages_.rbegin(); r != owned_storages_.rend(); r++) {
         if (r->mem_ != nullptr) {
           ASSERT(r->len_ == Slice::default_slice_size_);
-          if (free_list_ref_.size() < free_list_max_) {
-            free_list_ref_.push_back(std::move(r->mem_));
-          }
+          cache_->release(std::move(r->mem_), r->len_);
         }
       }
     }
@@ -780,10 +803,9 @@ private:
     Slice::SizedStorage newStorage() {
       ASSERT(Slice::sliceSize(Slice::default_slice_size_) == Slice::default_slice_size_);
 
-      Slice::SizedStorage storage{nullptr, Slice::default_slice_size_};
-      if (!free_list_ref_.empty()) {
-        storage.mem_ = std::move(free_list_ref_.back());
-        free_list_ref_.pop_back();
+      Slice::SizedStorage storage{nullptr, Slice::default_slice_size_, cache_};
+      if (cache_ != nullptr) {
+        storage.mem_ = cache_->allocate(Slice::default_slice_size_);
       } else {
         storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
       }
@@ -798,14 +820,10 @@ private:
     absl::InlinedVector<Slice::SizedStorage, Buffer::Reservation::MAX_SLICES_> owned_storages_;
 
   private:
-    // Thread local resolving introduces additional overhead. Initialize this reference once when
-    // constructing the owner to reduce thread local resolving to improve performance.
-    absl::InlinedVector<Slice::StoragePtr, free_list_max_>& free_list_ref_;
-
-    // Simple thread local cache to reduce unnecessary memory allocation and release. This cache
-    // is currently only used for multiple slices reservation because of the additional overhead
-    // that thread local resolving would introduce.
-    static thread_local absl::InlinedVector<Slice::StoragePtr, free_list_max_> free_list_;
+    // Thread local resolving introduces additional overhead. Resolve the slice storage cache of
+    // this thread once when constructing the owner to reduce thread local resolving to improve
+    // performance.
+    SliceStorageCache* const cache_;
   };
 
   struct OwnedImplReservationSlicesOwnerSingle : public OwnedImplReservationSlicesOwner {
@@ -0,0 +1,110 @@
+#include "source/common/buffer/slice_storage_cache.h"
+
+#include "source/common/common/macros.h"
+#include "source/common/runtime/runtime_features.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+// Slices may be destroyed by thread local or static objects that outlive the thread local cache.
+// This flag is trivially destructible, so it can still be read once the cache is gone.
+thread_local bool cache_destroyed = false;
+
+// The caches of all the live threads, and the stats of the caches of the threads that have exited.
+struct CacheRegistry {
+  absl::Mutex mutex_;
+  absl::flat_hash_set<const SliceStorageCache*> caches_ ABSL_GUARDED_BY(mutex_);
+  SliceStorageCache::Stats exited_ ABSL_GUARDED_BY(mutex_);
+};
+
+CacheRegistry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(CacheRegistry); }
+
+void accumulate(SliceStorageCache::Stats& total, const SliceStorageCache::Stats& stats) {
+  total.hits_ += stats.hits_;
+  total.misses_ += stats.misses_;
+  total.overflows_ += stats.overflows_;
+  total.cross_thread_frees_ += stats.cross_thread_frees_;
+  total.cached_bytes_ += stats.cached_bytes_;
+}
+
+} // namespace
+
+SliceStorageCache::SliceStorageCache()
+    : enabled_(
+          Runtime::runtimeFeatureEnabled("envoy.reloadable_features.buffer_slice_storage_cache")) {
+  CacheRegistry& caches = registry();
+  absl::MutexLock lock(&caches.mutex_);
+  caches.caches_.insert(this);
+}
+
+SliceStorageCache::~SliceStorageCache() {
+  cache_destroyed = true;
+  clear();
+  CacheRegistry& caches = registry();
+  absl::MutexLock lock(&caches.mutex_);
+  caches.caches_.erase(this);
+  accumulate(caches.exited_, stats());
+}
+
+SliceStorageCache* SliceStorageCache::threadLocal() {
+  if (cache_destroyed) {
+    return nullptr;
+  }
+  static thread_local SliceStorageCache cache;
+  return &cache;
+}
+
+SliceStorageCache::StoragePtr SliceStorageCache::allocateLocal(SliceStorageCache* cache,
+                                                               uint64_t size) {
+  if (cache == nullptr || !cache->enabled_) {
+    return StoragePtr{new uint8_t[size]};
+  }
+  return cache->allocate(size);
+}
+
+void SliceStorageCache::releaseLocal(StoragePtr&& storage, uint64_t size,
+                                     const SliceStorageCache* owner) {
+  SliceStorageCache* cache = threadLocal();
+  if (cache == nullptr || !cache->enabled_) {
+    storage.reset();
+    return;
+  }
+  if (owner != nullptr && owner != cache) {
+    add(cache->stats_.cross_thread_frees_, 1);
+  }
+  cache->release(std::move(storage), size);
+}
+
+SliceStorageCache::Stats SliceStorageCache::totalStats() {
+  CacheRegistry& caches = registry();
+  absl::MutexLock lock(&caches.mutex_);
+  Stats total = caches.exited_;
+  for (const SliceStorageCache* cache : caches.caches_) {
+    accumulate(total, cache->stats());
+  }
+  return total;
+}
+
+void SliceStorageCache::clear() {
+  for (FreeList& free_list : free_lists_) {
+    free_list.clear();
+  }
+  stats_.cached_bytes_.store(0, std::memory_order_relaxed);
+}
+
+SliceStorageCache::Stats SliceStorageCache::stats() const {
+  Stats stats;
+  stats.hits_ = stats_.hits_.load(std::memory_order_relaxed);
+  stats.misses_ = stats_.misses_.load(std::memory_order_relaxed);
+  stats.overflows_ = stats_.overflows_.load(std::memory_order_relaxed);
+  stats.cross_thread_frees_ = stats_.cross_thread_frees_.load(std::memory_order_relaxed);
+  stats.cached_bytes_ = stats_.cached_bytes_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/container/inlined_vector.h"
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * A per-thread cache of slice storage blocks. Blocks of the common slice sizes (4KB, 16KB and
+ * 64KB) released on a thread are kept in a small free list of that thread and handed out again to
+ * the next slice of the same size created on that thread. This avoids a round trip through the
+ * heap for every slice of a busy connection, and keeps the recycled memory local to the worker
+ * that keeps touching it. Blocks of other sizes always come from the heap.
+ *
+ * Every block is an ordinary heap allocation of its full size, so a block can be released on any
+ * thread and to either the cache or the heap. Slices release their storage to the heap instead of
+ * the cache when the envoy.reloadable_features.buffer_slice_storage_cache runtime guard is off.
+ * The guard is latched when the cache of a thread is created, so that it is not looked up on every
+ * allocation.
+ */
+class SliceStorageCache : NonCopyable {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  static constexpr uint64_t SmallBlockSize = 4 * 1024;
+  static constexpr uint64_t MediumBlockSize = 16 * 1024;
+  static constexpr uint64_t LargeBlockSize = 64 * 1024;
+
+  struct Stats {
+    // Allocations of a cached size served from the free lists.
+    uint64_t hits_{};
+    // Allocations of a cached size that had to go to the heap.
+    uint64_t misses_{};
+    // Released blocks of a cached size returned to the heap because their free list was full.
+    uint64_t overflows_{};
+    // Blocks released by slices on a thread other than the one that allocated them.
+    uint64_t cross_thread_frees_{};
+    // Bytes currently held by the free lists.
+    uint64_t cached_bytes_{};
+  };
+
+  ~SliceStorageCache();
+
+  /**
+   * @return the cache of the calling thread, or nullptr if the calling thread is exiting and its
+   *         cache has already been destroyed.
+   */
+  static SliceStorageCache* threadLocal();
+
+  /**
+   * @return whether slices recycle their storage through this cache.
+   */
+  bool enabled() const { return enabled_; }
+
+  /**
+   * Allocate a block for a slice from the cache of the calling thread, or from the heap if the
+   * thread has no cache anymore or its cache is disabled.
+   * @param cache the cache of the calling thread, as returned by threadLocal().
+   * @param size the size of the block in bytes.
+   * @return the block.
+   */
+  static StoragePtr allocateLocal(SliceStorageCache* cache, uint64_t size);
+
+  /**
+   * Release the block of a slice to the cache of the calling thread, or to the heap if the thread
+   * has no cache anymore or its cache is disabled.
+   * @param storage the block to release.
+   * @param size the size the block was allocated with.
+   * @param owner the cache of the thread that allocated the block, if any.
+   */
+  static void releaseLocal(StoragePtr&& storage, uint64_t size, const SliceStorageCache* owner);
+
+  /**
+   * @return the sum of the stats of the caches of all threads, including the threads that have
+   *         exited. May be called from any thread.
+   */
+  static Stats totalStats();
+
+  /**
+   * @param size the size of the block in bytes.
+   * @return a block of the given size.
+   */
+  StoragePtr allocate(uint64_t size) {
+    FreeList* free_list = freeList(size);
+    if (free_list != nullptr) {
+      if (!free_list->empty()) {
+        StoragePtr storage = std::move(free_list->back());
+        free_list->pop_back();
+        add(stats_.hits_, 1);
+        subtract(stats_.cached_bytes_, size);
+        return storage;
+      }
+      add(stats_.misses_, 1);
+    }
+    return StoragePtr{new uint8_t[size]};
+  }
+
+  /**
+   * @param storage the block to release.
+   * @param size the size the block was allocated with.
+   */
+  void release(StoragePtr&& storage, uint64_t size) {
+    FreeList* free_list = freeList(size);
+    if (free_list == nullptr) {
+      storage.reset();
+      return;
+    }
+    if (free_list->size() >= maxBlocks(size)) {
+      add(stats_.overflows_, 1);
+      storage.reset();
+      return;
+    }
+    free_list->push_back(std::move(storage));
+    add(stats_.cached_bytes_, size);
+  }
+
+  /**
+   * Return all the cached blocks to the heap.
+   */
+  void clear();
+
+  /**
+   * @return the stats of this cache.
+   */
+  Stats stats() const;
+
+private:
+  // Each size class keeps at most this many blocks, so a thread caches at most 320KB.
+  static constexpr uint32_t MaxSmallBlocks = 16;
+  static constexpr uint32_t MaxMediumBlocks = 8;
+  static constexpr uint32_t MaxLargeBlocks = 2;
+
+  using FreeList = absl::InlinedVector<StoragePtr, MaxSmallBlocks>;
+
+  // The stats are only written by the thread of the cache, and read by any thread through
+  // totalStats().
+  struct AtomicStats {
+    std::atomic<uint64_t> hits_{};
+    std::atomic<uint64_t> misses_{};
+    std::atomic<uint64_t> overflows_{};
+    std::atomic<uint64_t> cross_thread_frees_{};
+    std::atomic<uint64_t> cached_bytes_{};
+  };
+
+  SliceStorageCache();
+
+  // Only the thread of the cache writes its stats, so a relaxed load and store avoid the cost of
+  // an atomic read-modify-write on the data path.
+  static void add(std::atomic<uint64_t>& stat, uint64_t delta) {
+    stat.store(stat.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  }
+  static void subtract(std::atomic<uint64_t>& stat, uint64_t delta) {
+    stat.store(stat.load(std::memory_order_relaxed) - delta, std::memory_order_relaxed);
+  }
+
+  FreeList* freeList(uint64_t size) {
+    switch (size) {
+    case SmallBlockSize:
+      return &free_lists_[0];
+    case MediumBlockSize:
+      return &free_lists_[1];
+    case LargeBlockSize:
+      return &free_lists_[2];
+    default:
+      return nullptr;
+    }
+  }
+
+  static constexpr uint32_t maxBlocks(uint64_t size) {
+    return size == SmallBlockSize    ? MaxSmallBlocks
+           : size == MediumBlockSize ? MaxMediumBlocks
+                                     : MaxLargeBlocks;
+  }
+
+  const bool enabled_;
+  std::array<FreeList, 3> free_lists_;
+  AtomicStats stats_;
+};
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+
+/**
+ * A lookup table for a small set of string keys that is known when the table is compiled, such as
+ * the names of the O(1) headers. The table uses a perfect hash: every key has a slot of its own, so
+ * a lookup reads a few characters of the key, computes the slot, and does a single comparison,
+ * whether the key is present or not.
+ *
+ * The hash combines the key length with the characters at four positions. compile() picks two of
+ * the positions so that they tell all the keys apart, and then searches for a multiplier that maps
+ * the keys to distinct slots. If no such positions or multiplier are found, compile() fails and the
+ * caller should use a general purpose map, e.g. CompiledStringMap, instead.
+ */
+template <class Value> class PerfectHashStringMap {
+public:
+  // The caller owns the string-views during `compile`.
+  using KV = std::pair<absl::string_view, Value>;
+
+  /**
+   * Returns the value with a matching key, or the default value (typically nullptr) if the key was
+   * not present or the map was not compiled successfully.
+   * @param key the key to look up.
+   */
+  Value find(absl::string_view key) const {
+    if (key.empty() || slots_.empty()) {
+      return {};
+    }
+    // Empty slots have an empty key, which never matches.
+    const Slot& slot = slots_[slotOf(key)];
+    if (slot.key_.size() != key.size() || memcmp(slot.key_.data(), key.data(), key.size())) {
+      return {};
+    }
+    return slot.value_;
+  }
+
+  /**
+   * Construct the lookup table. This is a multi-pass operation, intended to be done once.
+   * @param contents a vector of key->value pairs. The keys must be distinct and not empty. The
+   *                 map takes copies of the key strings, so the string_views can be invalidated
+   *                 once compile has completed.
+   * @return whether a perfect hash was found for the keys. If not, the map stays empty.
+   */
+  bool compile(const std::vector<KV>& contents) {
+    slots_.clear();
+    keys_.clear();
+    if (contents.empty() || !choosePositions(contents)) {
+      return false;
+    }
+    std::vector<uint64_t> hashes;
+    hashes.reserve(contents.size());
+    for (const KV& kv : contents) {
+      hashes.push_back(hash(kv.first));
+    }
+    // Try table sizes between 2x and 8x the number of keys, so that a random multiplier has a good
+    // chance of finding a perfect hash while the slots still fit in a few cache lines.
+    uint32_t bits = 1;
+    while ((size_t{1} << bits) < 2 * contents.size()) {
+      ++bits;
+    }
+    for (const uint32_t max_bits = bits + 2; bits <= max_bits; ++bits) {
+      std::vector<bool> used(size_t{1} << bits);
+      uint64_t state = 0;
+      for (uint32_t attempt = 0; attempt < MaxAttemptsPerSize; ++attempt) {
+        const uint64_t multiplier = nextMultiplier(state);
+        std::fill(used.begin(), used.end(), false);
+        bool collision = false;
+        for (const uint64_t h : hashes) {
+          const size_t slot = (h * multiplier) >> (64 - bits);
+          if (used[slot]) {
+            collision = true;
+            break;
+          }
+          used[slot] = true;
+        }
+        if (!collision) {
+          multiplier_ = multiplier;
+          shift_ = 64 - bits;
+          slots_.resize(size_t{1} << bits);
+          // Reserve up front so that the keys do not move once the slots refer to them.
+          keys_.reserve(contents.size());
+          for (const KV& kv : contents) {
+            keys_.emplace_back(kv.first);
+            slots_[slotOf(kv.first)] = {keys_.back(), kv.second};
+          }
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @return the number of slots in the table, or 0 if it was not compiled successfully.
+   */
+  size_t slots() const { return slots_.size(); }
+
+private:
+  struct Slot {
+    absl::string_view key_;
+    Value value_{};
+  };
+
+  static constexpr uint32_t MaxAttemptsPerSize = 100000;
+
+  /**
+   * The hash packs the length of the key and its characters at four positions into an integer:
+   * the first and the last character, the character at forward_ and the character at backward_
+   * from the end. The last two positions are clamped to the key, so the hash reads in bounds for
+   * any non-empty key.
+   */
+  uint64_t hash(absl::string_view key) const {
+    const size_t last = key.size() - 1;
+    return key.size() | charAt(key, 0) << 8 | charAt(key, last) << 16 |
+           charAt(key, std::min(forward_, last)) << 24 |
+           charAt(key, last - std::min(backward_, last)) << 32;
+  }
+
+  static uint64_t charAt(absl::string_view key, size_t index) {
+    return static_cast<uint8_t>(key[index]);
+  }
+
+  size_t slotOf(absl::string_view key) const { return (hash(key) * multiplier_) >> shift_; }
+
+  /**
+   * Chooses the forward and backward positions of the characters that are hashed, greedily picking
+   * the forward position that tells the most keys apart first.
+   * @return whether the hash tells all the keys apart.
+   */
+  bool choosePositions(const std::vector<KV>& contents) {
+    size_t longest = 0;
+    for (const KV& kv : contents) {
+      if (kv.first.empty() || kv.first.size() > 255) {
+        return false;
+      }
+      longest = std::max(longest, kv.first.size());
+    }
+    for (size_t* position : {&forward_, &backward_}) {
+      size_t best_position = 0;
+      size_t best_distinct = 0;
+      for (*position = 0; *position < longest; ++*position) {
+        const size_t distinct = distinctHashes(contents);
+        if (distinct > best_distinct) {
+          best_position = *position;
+          best_distinct = distinct;
+        }
+      }
+      *position = best_position;
+      if (best_distinct == contents.size()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  size_t distinctHashes(const std::vector<KV>& contents) const {
+    absl::flat_hash_set<uint64_t> hashes;
+    for (const KV& kv : contents) {
+      hashes.insert(hash(kv.first));
+    }
+    return hashes.size();
+  }
+
+  // A deterministic sequence of odd multipliers (splitmix64), so that the table layout does not
+  // change from one run to the next.
+  static uint64_t nextMultiplier(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return (z ^ (z >> 31)) | 1;
+  }
+
+  size_t forward_{0};
+  size_t backward_{0};
+  uint64_t multiplier_{0};
+  uint32_t shift_{0};
+  std::vector<Slot> slots_;
+  std::vector<std::string> keys_;
+};
+
+} // namespace Envoy
@@ -92,6 +92,47 @@ CompiledGoogleReMatcher::CompiledGoogleReMatcher(
   }
 }
 
+namespace {
+re2::RE2::Options quietOptions() {
+  re2::RE2::Options options;
+  options.set_log_errors(false);
+  return options;
+}
+} // namespace
+
+GoogleReMatcherSet::GoogleReMatcherSet() : set_(quietOptions(), re2::RE2::ANCHOR_BOTH) {}
+
+absl::StatusOr<int> GoogleReMatcherSet::add(absl::string_view pattern) {
+  ASSERT(!compiled_);
+  std::string error;
+  const int position = set_.Add(pattern, &error);
+  if (position < 0) {
+    return absl::InvalidArgumentError(error);
+  }
+  ++size_;
+  return position;
+}
+
+absl::Status GoogleReMatcherSet::compile() {
+  ASSERT(!compiled_);
+  if (!set_.Compile()) {
+    return absl::ResourceExhaustedError(
+        fmt::format("unable to compile a set of {} RE2 patterns", size_));
+  }
+  compiled_ = true;
+  return absl::OkStatus();
+}
+
+bool GoogleReMatcherSet::match(absl::string_view value, std::vector<int>& matches) const {
+  ASSERT(compiled_);
+  re2::RE2::Set::ErrorInfo error_info;
+  if (set_.Match(value, &matches, &error_info)) {
+    return true;
+  }
+  // No match is reported as kNoError, anything else means the set could not be evaluated.
+  return error_info.kind == re2::RE2::Set::kNoError;
+}
+
 absl::StatusOr<CompiledMatcherPtr> GoogleReEngine::matcher(const std::string& regex) const {
   return CompiledGoogleReMatcher::createAndSizeCheck(regex);
 }
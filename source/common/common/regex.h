@@ -13,6 +13,7 @@
 #include "source/common/stats/symbol_table.h"
 
 #include "re2/re2.h"
+#include "re2/set.h"
 #include "xds/type/matcher/v3/regex.pb.h"
 
 namespace Envoy {
@@ -67,6 +68,47 @@ public:
       : CompiledGoogleReMatcher(regex) {}
 };
 
+/**
+ * A set of RE2 patterns that are evaluated against a value in a single pass. Each pattern has to
+ * match the whole value, as with CompiledGoogleReMatcher::match().
+ */
+class GoogleReMatcherSet {
+public:
+  GoogleReMatcherSet();
+
+  /**
+   * Adds a pattern to the set. Must not be called after compile().
+   * @param pattern the RE2 pattern.
+   * @return the position of the pattern in the set, as reported by match().
+   */
+  absl::StatusOr<int> add(absl::string_view pattern);
+
+  /**
+   * Compiles the set. Must be called once, after all patterns have been added.
+   * @return an error if the patterns do not fit in the RE2 memory budget of the set.
+   */
+  absl::Status compile();
+
+  /**
+   * @return the number of patterns in the set.
+   */
+  size_t size() const { return size_; }
+
+  /**
+   * Collects the positions of all patterns that match the value, in no particular order.
+   * @param value the value to match.
+   * @param matches receives the positions of the matching patterns.
+   * @return false if the set could not be evaluated (e.g. the RE2 DFA ran out of memory). The
+   *         caller then has to evaluate the patterns individually.
+   */
+  bool match(absl::string_view value, std::vector<int>& matches) const;
+
+private:
+  re2::RE2::Set set_;
+  size_t size_{};
+  bool compiled_{};
+};
+
 class GoogleReEngine : public Engine {
 public:
   absl::StatusOr<CompiledMatcherPtr> matcher(const std::string& regex) const override;
@@ -1,10 +1,14 @@
 #include "source/common/conn_pool/conn_pool_base.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "envoy/server/overload/load_shed_point.h"
 
 #include "source/common/common/assert.h"
 #include "source/common/common/debug_recursion_checker.h"
 #include "source/common/network/transport_socket_options_impl.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stats/timespan_impl.h"
 #include "source/common/upstream/upstream_impl.h"
@@ -21,6 +25,53 @@ int64_t currentUnusedCapacity(const std::list<ActiveClientPtr>& connecting_clien
 }
 } // namespace
 
+StreamArrivalEstimator::StreamArrivalEstimator(std::chrono::milliseconds rate_window,
+                                               std::chrono::milliseconds peak_window,
+                                               uint32_t max_anticipated_streams)
+    : rate_window_(std::chrono::duration<double>(rate_window).count()),
+      peak_window_(std::chrono::duration<double>(peak_window).count()),
+      max_anticipated_streams_(max_anticipated_streams) {}
+
+void StreamArrivalEstimator::onStream(MonotonicTime now) {
+  weighted_streams_ = weightedStreams(now) + 1;
+  peak_streams_ = std::max(peakStreams(now), weighted_streams_);
+  last_stream_ = now;
+}
+
+void StreamArrivalEstimator::onConnected(std::chrono::milliseconds connect_time) {
+  // Each connection accounts for a quarter of the average, so that a handshake that got slower is
+  // noticed after a few connections while a single slow handshake does not dominate.
+  const double sample = std::chrono::duration<double>(connect_time).count();
+  connect_time_ = connect_time_ < 0 ? sample : connect_time_ + (sample - connect_time_) / 4;
+}
+
+uint32_t StreamArrivalEstimator::anticipatedStreams(MonotonicTime now) const {
+  if (connect_time_ < 0) {
+    return 0;
+  }
+  // The peak rate keeps the anticipated streams up after an idle period, so that the first streams
+  // of a burst preconnect for the rest of it.
+  const double streams =
+      std::max(weightedStreams(now), peakStreams(now)) / rate_window_ * connect_time_;
+  return static_cast<uint32_t>(std::min<double>(std::round(streams), max_anticipated_streams_));
+}
+
+double StreamArrivalEstimator::weightedStreams(MonotonicTime now) const {
+  if (now <= last_stream_) {
+    return weighted_streams_;
+  }
+  const double age = std::chrono::duration<double>(now - last_stream_).count();
+  return weighted_streams_ * std::exp(-age / rate_window_);
+}
+
+double StreamArrivalEstimator::peakStreams(MonotonicTime now) const {
+  if (now <= last_stream_) {
+    return peak_streams_;
+  }
+  const double age = std::chrono::duration<double>(now - last_stream_).count();
+  return peak_streams_ * std::exp(-age / peak_window_);
+}
+
 std::string ConnPoolImplBase::dumpState() const { return fmt::format("State: {}", *this); }
 
 void ConnPoolImplBase::assertCapacityCountsAreCorrect() {
@@ -62,6 +113,15 @@ ConnPoolImplBase::ConnPoolImplBase(
           Server::LoadShedPointName::get().ConnectionPoolNewConnection)),
       skip_pending_overflow_on_active_rq_(Runtime::runtimeFeatureEnabled(
           "envoy.reloadable_features.skip_pending_overflow_count_on_active_rq")) {
+  const auto adaptive_preconnect = host_->cluster().adaptivePreconnect();
+  if (adaptive_preconnect.has_value()) {
+    stream_arrival_estimator_.emplace(
+        std::chrono::milliseconds(
+            PROTOBUF_GET_MS_OR_DEFAULT(adaptive_preconnect.ref(), rate_window, 1000)),
+        std::chrono::milliseconds(
+            PROTOBUF_GET_MS_OR_DEFAULT(adaptive_preconnect.ref(), peak_window, 60000)),
+        PROTOBUF_GET_WRAPPED_OR_DEFAULT(adaptive_preconnect.ref(), max_anticipated_streams, 100));
+  }
   ENVOY_LOG_ONCE_IF(trace, create_new_connection_load_shed_ == nullptr,
                     "LoadShedPoint envoy.load_shed_points.connection_pool_new_connection is not "
                     "found. Is it configured?");
@@ -146,15 +206,23 @@ bool ConnPoolImplBase::shouldCreateNewConnection(float global_preconnect_ratio)
     // Local preconnect does not need to anticipate a stream. It is called as
     // new streams are established or torn down and simply attempts to maintain
     // the correct ratio of streams and anticipated capacity.
+    //
+    // With adaptive preconnect, it also provisions for the streams that are expected to arrive
+    // while a new connection is established.
+    const uint32_t anticipated_streams = anticipatedStreams();
     bool result =
         shouldConnect(pending_streams_.size(), num_active_streams_,
-                      connecting_and_connected_stream_capacity_, perUpstreamPreconnectRatio());
+                      connecting_and_connected_stream_capacity_, perUpstreamPreconnectRatio()) ||
+        (anticipated_streams > 0 &&
+         shouldConnect(pending_streams_.size() + anticipated_streams, num_active_streams_,
+                       connecting_and_connected_stream_capacity_, 1.0));
     ENVOY_LOG(trace,
               "per-upstream shouldCreateNewConnection returns {} for pending {} active {} "
-              "connecting_and_connected_capacity {} connecting_capacity {} ratio {}",
+              "connecting_and_connected_capacity {} connecting_capacity {} ratio {} "
+              "anticipated {}",
               result, pending_streams_.size(), num_active_streams_,
               connecting_and_connected_stream_capacity_, connecting_stream_capacity_,
-              perUpstreamPreconnectRatio());
+              perUpstreamPreconnectRatio(), anticipated_streams);
     return result;
   }
 }
@@ -163,6 +231,17 @@ float ConnPoolImplBase::perUpstreamPreconnectRatio() const {
   return host_->cluster().perUpstreamPreconnectRatio();
 }
 
+uint32_t ConnPoolImplBase::anticipatedStreams() const {
+  // As with the preconnect ratio, only preconnect while the pool has traffic, so that an idle pool
+  // can still be drained and deleted. The estimator remembers the peak rate, so the first stream
+  // after an idle period preconnects for the burst it may start.
+  if (!stream_arrival_estimator_.has_value() ||
+      (pending_streams_.empty() && num_active_streams_ == 0)) {
+    return 0;
+  }
+  return stream_arrival_estimator_->anticipatedStreams(dispatcher_.approximateMonotonicTime());
+}
+
 ConnPoolImplBase::ConnectionResult ConnPoolImplBase::tryCreateNewConnections() {
   ConnPoolImplBase::ConnectionResult result;
   // Somewhat arbitrarily cap the number of connections preconnected due to new
@@ -330,6 +409,10 @@ ConnectionPool::Cancellable* ConnPoolImplBase::newStreamImpl(AttachContext& cont
   ASSERT(!deferred_deleting_, dumpState());
   assertCapacityCountsAreCorrect();
 
+  if (stream_arrival_estimator_.has_value()) {
+    stream_arrival_estimator_->onStream(dispatcher_.approximateMonotonicTime());
+  }
+
   if (!ready_clients_.empty()) {
     ActiveClient& client = *ready_clients_.front();
     ENVOY_CONN_LOG(debug, "using existing fully connected connection", client);
@@ -652,6 +735,9 @@ void ConnPoolImplBase::onConnectionEvent(ActiveClient& client, absl::string_view
     ENVOY_BUG(connecting_stream_capacity_ >= client.currentUnusedCapacity(), dumpState());
     connecting_stream_capacity_ -= client.currentUnusedCapacity();
     client.has_handshake_completed_ = true;
+    if (stream_arrival_estimator_.has_value()) {
+      stream_arrival_estimator_->onConnected(client.conn_connect_ms_->elapsed());
+    }
     client.conn_connect_ms_->complete();
     client.conn_connect_ms_.reset();
     if (client.state() == ActiveClient::State::Connecting ||
@@ -738,8 +824,14 @@ bool ConnPoolImplBase::connectingConnectionIsExcess(const ActiveClient& client)
   // If preconnect ratio is set, it also factors in the anticipated load based on both queued
   // streams and active streams, and makes sure the connecting capacity would still be sufficient to
   // serve that even with the most recent client removed.
-  return (pending_streams_.size() + num_active_streams_) * perUpstreamPreconnectRatio() <=
-         (connecting_stream_capacity_ - client.currentUnusedCapacity() + num_active_streams_);
+  //
+  // With adaptive preconnect, the connecting capacity must also cover the streams that are expected
+  // to arrive while a new connection is established.
+  const size_t streams = pending_streams_.size() + num_active_streams_;
+  const int64_t capacity =
+      connecting_stream_capacity_ - client.currentUnusedCapacity() + num_active_streams_;
+  return streams * perUpstreamPreconnectRatio() <= capacity &&
+         static_cast<int64_t>(streams + anticipatedStreams()) <= capacity;
 }
 
 void ConnPoolImplBase::onPendingStreamCancel(PendingStream& stream,
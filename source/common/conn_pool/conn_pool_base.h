@@ -1,6 +1,9 @@
 #pragma once
 
+#include <chrono>
+
 #include "envoy/common/conn_pool.h"
+#include "envoy/common/time.h"
 #include "envoy/event/dispatcher.h"
 #include "envoy/network/connection.h"
 #include "envoy/server/overload/overload_manager.h"
@@ -12,6 +15,7 @@
 #include "source/common/common/linked_object.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "fmt/ostream.h"
 
 namespace Envoy {
@@ -179,6 +183,45 @@ using PendingStreamPtr = std::unique_ptr<PendingStream>;
 
 using ActiveClientPtr = std::unique_ptr<ActiveClient>;
 
+// Estimates how many streams arrive at a connection pool while one of its connections is being
+// established, from moving averages of the arrival rate of the streams and of the connect time.
+// The rate is the larger of the recent rate and of the peak rate, which decays more slowly, so that
+// a burst after an idle period is anticipated from the rate of the previous bursts.
+class StreamArrivalEstimator {
+public:
+  StreamArrivalEstimator(std::chrono::milliseconds rate_window,
+                         std::chrono::milliseconds peak_window, uint32_t max_anticipated_streams);
+
+  // Called when a stream arrives at the pool.
+  void onStream(MonotonicTime now);
+
+  // Called when a connection of the pool is established.
+  void onConnected(std::chrono::milliseconds connect_time);
+
+  // Returns the number of streams expected to arrive while a new connection is established, up to
+  // the maximum number of anticipated streams. This is 0 until the first connection is established.
+  uint32_t anticipatedStreams(MonotonicTime now) const;
+
+private:
+  // The stream count decayed to `now`.
+  double weightedStreams(MonotonicTime now) const;
+  // The peak stream count decayed to `now`.
+  double peakStreams(MonotonicTime now) const;
+
+  // In seconds.
+  const double rate_window_;
+  const double peak_window_;
+  const uint32_t max_anticipated_streams_;
+  // The streams that arrived until last_stream_, each weighted by exp(-age / rate_window_). In
+  // steady state this is the arrival rate times rate_window_.
+  double weighted_streams_{0};
+  // The highest weighted_streams_ so far, weighted by exp(-age / peak_window_).
+  double peak_streams_{0};
+  MonotonicTime last_stream_;
+  // Moving average of the connect time in seconds, or negative before the first connection.
+  double connect_time_{-1};
+};
+
 // Base class that handles stream queueing logic shared between connection pool implementations.
 class ConnPoolImplBase : protected Logger::Loggable<Logger::Id::pool> {
 public:
@@ -349,6 +392,10 @@ protected:
 
   float perUpstreamPreconnectRatio() const;
 
+  // The streams expected to arrive while a new connection is established, if adaptive preconnect
+  // is enabled and the pool has pending or active streams.
+  uint32_t anticipatedStreams() const;
+
   ConnectionPool::Cancellable*
   addPendingStream(Envoy::ConnectionPool::PendingStreamPtr&& pending_stream) {
     LinkedList::moveIntoList(std::move(pending_stream), pending_streams_);
@@ -421,6 +468,8 @@ private:
   Event::SchedulableCallbackPtr upstream_ready_cb_;
   Common::DebugRecursionChecker recursion_checker_;
   Server::LoadShedPoint* create_new_connection_load_shed_{nullptr};
+  // Set if adaptive preconnect is enabled for the cluster.
+  absl::optional<StreamArrivalEstimator> stream_arrival_estimator_;
 
 protected:
   bool skip_pending_overflow_on_active_rq_;
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/strip.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Event {
+
+// The dispatcher of each worker thread is named after the index of the worker, e.g. "worker_3".
+constexpr absl::string_view WorkerNamePrefix = "worker_";
+
+/**
+ * @param index the index of a worker.
+ * @return the name of the dispatcher of the worker.
+ */
+inline std::string workerName(uint32_t index) { return absl::StrCat(WorkerNamePrefix, index); }
+
+/**
+ * @param name the name of a dispatcher.
+ * @return the index of the worker that runs the dispatcher, or nullopt if the dispatcher does not
+ *         belong to a worker, e.g. the main thread dispatcher.
+ */
+inline absl::optional<uint32_t> workerIndex(absl::string_view name) {
+  uint32_t index;
+  if (absl::ConsumePrefix(&name, WorkerNamePrefix) && absl::SimpleAtoi(name, &index)) {
+    return index;
+  }
+  return absl::nullopt;
+}
+
+} // namespace Event
+} // namespace Envoy
@@ -82,6 +82,30 @@ Protobuf::Value HeaderFormatter::formatValue(OptRef<const Http::HeaderMap> heade
   return ValueUtil::stringValue(std::string(val));
 }
 
+bool HeaderFormatter::formatTo(OptRef<const Http::HeaderMap> headers, std::string& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    return false;
+  }
+
+  output.append(
+      SubstitutionFormatUtils::truncateStringView(header->value().getStringView(), max_length_));
+  return true;
+}
+
+void HeaderFormatter::formatValueTo(OptRef<const Http::HeaderMap> headers,
+                                    std::string& output) const {
+  const Http::HeaderEntry* header = findHeader(headers);
+  if (!header) {
+    SubstitutionFormatUtils::appendJsonString(absl::nullopt, output);
+    return;
+  }
+
+  SubstitutionFormatUtils::appendJsonString(
+      SubstitutionFormatUtils::truncateStringView(header->value().getStringView(), max_length_),
+      output);
+}
+
 ResponseHeaderFormatter::ResponseHeaderFormatter(absl::string_view main_header,
                                                  absl::string_view alternative_header,
                                                  absl::optional<size_t> max_length)
@@ -97,6 +121,17 @@ Protobuf::Value ResponseHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseHeaders());
 }
 
+bool ResponseHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                       std::string& output) const {
+  return HeaderFormatter::formatTo(context.responseHeaders(), output);
+}
+
+bool ResponseHeaderFormatter::formatValueTo(const Context& context, const StreamInfo::StreamInfo&,
+                                            std::string& output) const {
+  HeaderFormatter::formatValueTo(context.responseHeaders(), output);
+  return true;
+}
+
 RequestHeaderFormatter::RequestHeaderFormatter(absl::string_view main_header,
                                                absl::string_view alternative_header,
                                                absl::optional<size_t> max_length)
@@ -112,6 +147,17 @@ Protobuf::Value RequestHeaderFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.requestHeaders());
 }
 
+bool RequestHeaderFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                      std::string& output) const {
+  return HeaderFormatter::formatTo(context.requestHeaders(), output);
+}
+
+bool RequestHeaderFormatter::formatValueTo(const Context& context, const StreamInfo::StreamInfo&,
+                                           std::string& output) const {
+  HeaderFormatter::formatValueTo(context.requestHeaders(), output);
+  return true;
+}
+
 ResponseTrailerFormatter::ResponseTrailerFormatter(absl::string_view main_header,
                                                    absl::string_view alternative_header,
                                                    absl::optional<size_t> max_length)
@@ -127,6 +173,17 @@ Protobuf::Value ResponseTrailerFormatter::formatValue(const Context& context,
   return HeaderFormatter::formatValue(context.responseTrailers());
 }
 
+bool ResponseTrailerFormatter::formatTo(const Context& context, const StreamInfo::StreamInfo&,
+                                        std::string& output) const {
+  return HeaderFormatter::formatTo(context.responseTrailers(), output);
+}
+
+bool ResponseTrailerFormatter::formatValueTo(const Context& context, const StreamInfo::StreamInfo&,
+                                             std::string& output) const {
+  HeaderFormatter::formatValueTo(context.responseTrailers(), output);
+  return true;
+}
+
 HeadersByteSizeFormatter::HeadersByteSizeFormatter(const HeaderType header_type)
     : header_type_(header_type) {}
 
@@ -797,6 +797,26 @@ public:
 
     return ValueUtil::numberValue(millis.value());
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      return false;
+    }
+
+    absl::StrAppend(&output, millis.value());
+    return true;
+  }
+  bool formatValueTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                     std::string& output) const override {
+    const auto millis = extractMillis(stream_info);
+    if (!millis) {
+      SubstitutionFormatUtils::appendJsonString(absl::nullopt, output);
+    } else {
+      SubstitutionFormatUtils::appendJsonNumber(millis.value(), output);
+    }
+    return true;
+  }
 
 private:
   absl::optional<int64_t> extractMillis(const StreamInfo::StreamInfo& stream_info) const {
@@ -827,6 +847,16 @@ public:
   Protobuf::Value formatValue(const StreamInfo::StreamInfo& stream_info) const override {
     return ValueUtil::numberValue(field_extractor_(stream_info));
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                std::string& output) const override {
+    absl::StrAppend(&output, field_extractor_(stream_info));
+    return true;
+  }
+  bool formatValueTo(const Context&, const StreamInfo::StreamInfo& stream_info,
+                     std::string& output) const override {
+    SubstitutionFormatUtils::appendJsonNumber(field_extractor_(stream_info), output);
+    return true;
+  }
 
 private:
   FieldExtractor field_extractor_;
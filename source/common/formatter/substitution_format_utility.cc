@@ -5,6 +5,7 @@
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/utility.h"
+#include "source/common/json/json_streamer.h"
 #include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 #include "source/common/stream_info/utility.h"
@@ -73,6 +74,21 @@ const Protobuf::Value& SubstitutionFormatUtils::unspecifiedValue() {
   return ValueUtil::nullValue();
 }
 
+void SubstitutionFormatUtils::appendJsonString(absl::optional<absl::string_view> value,
+                                               std::string& output) {
+  Json::StringStreamer streamer(output);
+  if (value.has_value()) {
+    streamer.addString(value.value());
+  } else {
+    streamer.addNull();
+  }
+}
+
+void SubstitutionFormatUtils::appendJsonNumber(double value, std::string& output) {
+  Json::StringStreamer streamer(output);
+  streamer.addNumber(value);
+}
+
 bool SubstitutionFormatUtils::truncate(std::string& str, absl::optional<size_t> max_length) {
   if (!max_length) {
     return false;
@@ -61,6 +61,17 @@ public:
   static absl::string_view truncateStringView(absl::string_view str,
                                               absl::optional<size_t> max_length);
 
+  /**
+   * Append a value to a JSON output, serialized as formatValue() serializes it: a string, or the
+   * unspecified value if there is none.
+   */
+  static void appendJsonString(absl::optional<absl::string_view> value, std::string& output);
+
+  /**
+   * Append a number to a JSON output, serialized as formatValue() serializes it.
+   */
+  static void appendJsonNumber(double value, std::string& output);
+
   /**
    * Parse a header subcommand of the form: X?Y .
    * Will populate a main_header and an optional alternative header if specified.
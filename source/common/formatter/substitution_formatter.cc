@@ -353,6 +353,65 @@ SubstitutionFormatParser::parse(absl::string_view format,
   return formatters;
 }
 
+CompiledFormat::CompiledFormat(std::vector<FormatterProviderPtr>&& providers)
+    : providers_(std::move(providers)) {
+  for (const FormatterProviderPtr& provider : providers_) {
+    const auto* literal = dynamic_cast<const PlainStringFormatter*>(provider.get());
+    if (literal == nullptr) {
+      segments_.push_back(Segment{EMPTY_STRING, provider.get()});
+      // A guess at the size of a value, most are short.
+      size_hint_ += 32;
+      continue;
+    }
+    if (!segments_.empty() && segments_.back().provider_ == nullptr) {
+      segments_.back().literal_.append(literal->str());
+    } else {
+      segments_.push_back(Segment{literal->str(), nullptr});
+    }
+    size_hint_ += literal->str().size();
+  }
+}
+
+void CompiledFormat::formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                              bool omit_empty_values, std::string& output) const {
+  for (const Segment& segment : segments_) {
+    if (segment.provider_ == nullptr) {
+      output.append(segment.literal_);
+      continue;
+    }
+    // Add the formatted value if there is one. Otherwise add a default value
+    // of "-" if omit_empty_values is not set.
+    if (!segment.provider_->formatTo(context, stream_info, output) && !omit_empty_values) {
+      output.append(DefaultUnspecifiedValueStringView);
+    }
+  }
+}
+
+void CompiledFormat::formatJsonStringTo(const Context& context,
+                                        const StreamInfo::StreamInfo& stream_info,
+                                        bool omit_empty_values, std::string& output) const {
+  std::string sanitize;
+  for (const Segment& segment : segments_) {
+    if (segment.provider_ == nullptr) {
+      output.append(Json::sanitize(sanitize, segment.literal_));
+      continue;
+    }
+    const size_t value_start = output.size();
+    if (!segment.provider_->formatTo(context, stream_info, output)) {
+      // Add the empty value. This needn't be sanitized.
+      output.append(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueStringView);
+      continue;
+    }
+    // Sanitize the value in place. Most values need no escaping, in which case it is kept as is.
+    const absl::string_view value = absl::string_view(output).substr(value_start);
+    const absl::string_view sanitized = Json::sanitize(sanitize, value);
+    if (sanitized.data() != value.data()) {
+      output.resize(value_start);
+      output.append(sanitized);
+    }
+  }
+}
+
 absl::StatusOr<std::unique_ptr<FormatterImpl>>
 FormatterImpl::create(absl::string_view format, bool omit_empty_values,
                       const CommandParsers& command_parsers) {
@@ -366,49 +425,23 @@ FormatterImpl::create(absl::string_view format, bool omit_empty_values,
 std::string FormatterImpl::format(const Context& context,
                                   const StreamInfo::StreamInfo& stream_info) const {
   std::string log_line;
-  log_line.reserve(256);
-
-  for (const auto& provider : providers_) {
-    const absl::optional<std::string> bit = provider->format(context, stream_info);
-    // Add the formatted value if there is one. Otherwise add a default value
-    // of "-" if omit_empty_values_ is not set.
-    if (bit.has_value()) {
-      log_line += bit.value();
-    } else if (!omit_empty_values_) {
-      log_line += DefaultUnspecifiedValueStringView;
-    }
-  }
-
+  log_line.reserve(std::max<size_t>(256, compiled_format_->sizeHint()));
+  compiled_format_->formatTo(context, stream_info, omit_empty_values_, log_line);
   return log_line;
 }
 
-void stringValueToLogLine(const JsonFormatterImpl::Formatters& formatters, const Context& context,
-                          const StreamInfo::StreamInfo& info, std::string& log_line,
-                          std::string& sanitize, bool omit_empty_values) {
-  log_line.push_back('"'); // Start the JSON string.
-  for (const JsonFormatterImpl::Formatter& formatter : formatters) {
-    const absl::optional<std::string> value = formatter->format(context, info);
-    if (!value.has_value()) {
-      // Add the empty value. This needn't be sanitized.
-      log_line.append(omit_empty_values ? EMPTY_STRING : DefaultUnspecifiedValueStringView);
-      continue;
-    }
-    // Sanitize the string value and add it to the buffer. The string value will not be quoted
-    // since we handle the quoting by ourselves at the outer level.
-    log_line.append(Json::sanitize(sanitize, value.value()));
-  }
-  log_line.push_back('"'); // End the JSON string.
-}
-
 JsonFormatterImpl::JsonFormatterImpl(const Protobuf::Struct& struct_format, bool omit_empty_values,
                                      const CommandParsers& commands)
     : omit_empty_values_(omit_empty_values) {
   for (JsonFormatBuilder::FormatElement& element : JsonFormatBuilder().fromStruct(struct_format)) {
     if (element.is_template_) {
-      parsed_elements_.emplace_back(
-          THROW_OR_RETURN_VALUE(SubstitutionFormatParser::parse(element.value_, commands),
-                                std::vector<FormatterProviderPtr>));
+      CompiledFormat& compiled_format =
+          absl::get<CompiledFormat>(parsed_elements_.emplace_back(CompiledFormat(
+              THROW_OR_RETURN_VALUE(SubstitutionFormatParser::parse(element.value_, commands),
+                                    std::vector<FormatterProviderPtr>))));
+      size_hint_ += compiled_format.sizeHint();
     } else {
+      size_hint_ += element.value_.size();
       parsed_elements_.emplace_back(std::move(element.value_));
     }
   }
@@ -417,8 +450,7 @@ JsonFormatterImpl::JsonFormatterImpl(const Protobuf::Struct& struct_format, bool
 std::string JsonFormatterImpl::format(const Context& context,
                                       const StreamInfo::StreamInfo& info) const {
   std::string log_line;
-  log_line.reserve(2048);
-  std::string sanitize; // Helper to serialize the value to log line.
+  log_line.reserve(std::max<size_t>(2048, size_hint_));
 
   for (const ParsedFormatElement& element : parsed_elements_) {
     // 1. Handle the raw string element.
@@ -429,17 +461,19 @@ std::string JsonFormatterImpl::format(const Context& context,
       continue;
     }
 
-    ASSERT(absl::holds_alternative<Formatters>(element));
-    const Formatters& formatters = absl::get<Formatters>(element);
-    ASSERT(!formatters.empty());
+    ASSERT(absl::holds_alternative<CompiledFormat>(element));
+    const CompiledFormat& compiled_format = absl::get<CompiledFormat>(element);
+    const FormatterProvider* provider = compiled_format.singleProvider();
 
-    if (formatters.size() != 1) {
-      // 2. Handle the formatter element with multiple or zero providers.
-      stringValueToLogLine(formatters, context, info, log_line, sanitize, omit_empty_values_);
-    } else {
+    if (provider == nullptr) {
+      // 2. Handle the formatter element with literals or multiple providers, which is a string.
+      log_line.push_back('"'); // Start the JSON string.
+      compiled_format.formatJsonStringTo(context, info, omit_empty_values_, log_line);
+      log_line.push_back('"'); // End the JSON string.
+    } else if (!provider->formatValueTo(context, info, log_line)) {
       // 3. Handle the formatter element with a single provider and value
       //    type needs to be kept.
-      const auto value = formatters[0]->formatValue(context, info);
+      const auto value = provider->formatValue(context, info);
       Json::Utility::appendValueToString(value, log_line);
     }
   }
@@ -30,7 +30,10 @@ namespace Formatter {
  */
 class PlainStringFormatter : public FormatterProvider {
 public:
-  PlainStringFormatter(absl::string_view str) { str_.set_string_value(str); }
+  PlainStringFormatter(absl::string_view str) {
+    str_.set_string_value(str);
+    Json::Utility::appendValueToString(str_, json_);
+  }
 
   // FormatterProvider
   absl::optional<std::string> format(const Context&, const StreamInfo::StreamInfo&) const override {
@@ -39,9 +42,23 @@ public:
   Protobuf::Value formatValue(const Context&, const StreamInfo::StreamInfo&) const override {
     return str_;
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo&,
+                std::string& output) const override {
+    output.append(str_.string_value());
+    return true;
+  }
+  bool formatValueTo(const Context&, const StreamInfo::StreamInfo&,
+                     std::string& output) const override {
+    output.append(json_);
+    return true;
+  }
+
+  const std::string& str() const { return str_.string_value(); }
 
 private:
   Protobuf::Value str_;
+  // The value serialized as JSON.
+  std::string json_;
 };
 
 /**
@@ -49,19 +66,34 @@ private:
  */
 class PlainNumberFormatter : public FormatterProvider {
 public:
-  PlainNumberFormatter(double num) { num_.set_number_value(num); }
+  PlainNumberFormatter(double num) : str_(absl::StrFormat("%g", num)) {
+    num_.set_number_value(num);
+    Json::Utility::appendValueToString(num_, json_);
+  }
 
   // FormatterProvider
   absl::optional<std::string> format(const Context&, const StreamInfo::StreamInfo&) const override {
-    std::string str = absl::StrFormat("%g", num_.number_value());
-    return str;
+    return str_;
   }
   Protobuf::Value formatValue(const Context&, const StreamInfo::StreamInfo&) const override {
     return num_;
   }
+  bool formatTo(const Context&, const StreamInfo::StreamInfo&,
+                std::string& output) const override {
+    output.append(str_);
+    return true;
+  }
+  bool formatValueTo(const Context&, const StreamInfo::StreamInfo&,
+                     std::string& output) const override {
+    output.append(json_);
+    return true;
+  }
 
 private:
   Protobuf::Value num_;
+  const std::string str_;
+  // The value serialized as JSON.
+  std::string json_;
 };
 
 /**
@@ -75,6 +107,54 @@ public:
 
 inline constexpr absl::string_view DefaultUnspecifiedValueStringView = "-";
 
+/**
+ * A format compiled into the sequence of literals and providers that build a line. Adjacent
+ * literals are fused into one, and literals are appended without going through their provider. The
+ * output is reserved upfront and providers append their values to it directly, so formatting a line
+ * allocates no intermediate strings for the providers that support it.
+ */
+class CompiledFormat {
+public:
+  explicit CompiledFormat(std::vector<FormatterProviderPtr>&& providers);
+
+  /**
+   * Append the formatted line to the output.
+   * @param omit_empty_values whether to omit the values of providers without a value, instead of
+   *        writing the unspecified value for them.
+   */
+  void formatTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                bool omit_empty_values, std::string& output) const;
+
+  /**
+   * Append the formatted line to the output as a sanitized JSON string, without the quotes.
+   */
+  void formatJsonStringTo(const Context& context, const StreamInfo::StreamInfo& stream_info,
+                          bool omit_empty_values, std::string& output) const;
+
+  /**
+   * @return the provider of the format, if it consists of a single provider.
+   */
+  const FormatterProvider* singleProvider() const {
+    return segments_.size() == 1 ? segments_[0].provider_ : nullptr;
+  }
+
+  /**
+   * @return an estimate of the size of a formatted line.
+   */
+  size_t sizeHint() const { return size_hint_; }
+
+private:
+  struct Segment {
+    // Either the literal or the provider is set.
+    std::string literal_;
+    const FormatterProvider* provider_{};
+  };
+
+  std::vector<FormatterProviderPtr> providers_;
+  std::vector<Segment> segments_;
+  size_t size_hint_{};
+};
+
 /**
  * Composite formatter implementation.
  */
@@ -96,12 +176,12 @@ protected:
       : omit_empty_values_(omit_empty_values) {
     auto providers_or_error = SubstitutionFormatParser::parse(format, command_parsers);
     SET_AND_RETURN_IF_NOT_OK(providers_or_error.status(), creation_status);
-    providers_ = std::move(*providers_or_error);
+    compiled_format_.emplace(std::move(*providers_or_error));
   }
 
 private:
   const bool omit_empty_values_;
-  std::vector<FormatterProviderPtr> providers_;
+  absl::optional<CompiledFormat> compiled_format_;
 };
 
 class JsonFormatterImpl : public Formatter {
@@ -118,8 +198,9 @@ public:
 
 private:
   const bool omit_empty_values_;
-  using ParsedFormatElement = absl::variant<std::string, Formatters>;
+  using ParsedFormatElement = absl::variant<std::string, CompiledFormat>;
   std::vector<ParsedFormatElement> parsed_elements_;
+  size_t size_hint_{};
 };
 
 } // namespace Formatter
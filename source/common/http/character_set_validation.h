@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdint>
+#include <cstring>
 
 // A set of tables for validating that a character is in a specific
 // character set. Used to validate RFC compliance for various HTTP protocol elements.
@@ -49,6 +50,32 @@ inline constexpr std::array<uint32_t, 8> kGenericHeaderNameCharTable = {
     0b00000000000000000000000000000000,
 };
 
+// Header value character table.
+// From RFC 9110, https://www.rfc-editor.org/rfc/rfc9110.html#section-5.5:
+//
+// SPELLCHECKER(off)
+// field-value    = *field-content
+// field-content  = field-vchar
+//                  [ 1*( SP / HTAB / field-vchar ) field-vchar ]
+// field-vchar    = VCHAR / obs-text
+// obs-text       = %x80-FF
+// SPELLCHECKER(on)
+inline constexpr std::array<uint32_t, 8> kGenericHeaderValueCharTable = {
+    // control characters
+    0b00000000010000000000000000000000,
+    // !"#$%&'()*+,-./0123456789:;<=>?
+    0b11111111111111111111111111111111,
+    //@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\]^_
+    0b11111111111111111111111111111111,
+    //`abcdefghijklmnopqrstuvwxyz{|}~
+    0b11111111111111111111111111111110,
+    // extended ascii
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+};
+
 // A URI query and fragment character table. From RFC 3986:
 // https://datatracker.ietf.org/doc/html/rfc3986#section-3.4
 //
@@ -72,5 +99,80 @@ inline constexpr std::array<uint32_t, 8> kUriQueryAndFragmentCharTable = {
     0b00000000000000000000000000000000,
 };
 
+// The helpers below process 8 bytes at a time in a uint64_t ("SIMD within a register"). For every
+// byte, the per-byte arithmetic never carries into the next byte, so each result has bit 7 of a
+// byte set exactly when the byte matches, independent of the host byte order.
+namespace CharacterSetWord {
+
+inline constexpr uint64_t repeat(uint8_t byte) { return 0x0101010101010101ULL * byte; }
+
+inline constexpr uint64_t HighBits = repeat(0x80);
+inline constexpr uint64_t LowBits = repeat(0x7f);
+
+inline uint64_t load(const char* data) {
+  uint64_t word;
+  memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+// Sets bit 7 of every byte of `word` that is equal to `byte`.
+inline constexpr uint64_t bytesEqualTo(uint64_t word, uint8_t byte) {
+  const uint64_t x = word ^ repeat(byte);
+  return ~(((x & LowBits) + LowBits) | x) & HighBits;
+}
+
+// Sets bit 7 of every byte of `word` that is less than `byte`, which must be at most 0x80.
+inline constexpr uint64_t bytesLessThan(uint64_t word, uint8_t byte) {
+  return ~(((word & LowBits) + repeat(0x80 - byte)) | word) & HighBits;
+}
+
+} // namespace CharacterSetWord
+
+/**
+ * Checks that all characters of a header value are allowed by kGenericHeaderValueCharTable, that
+ * is that the value has no control characters other than HTAB. Equivalent to testing every
+ * character against the table, but checks 8 characters per step.
+ * @param data the header value.
+ * @param size the size of the header value.
+ * @return true if all characters are valid.
+ */
+inline bool headerValueCharsAreValid(const char* data, size_t size) {
+  using namespace CharacterSetWord;
+  uint64_t invalid = 0;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    const uint64_t word = load(data + i);
+    invalid |= (bytesLessThan(word, 0x20) & ~bytesEqualTo(word, '\t')) | bytesEqualTo(word, 0x7f);
+  }
+  bool is_valid = invalid == 0;
+  for (; i < size; ++i) {
+    is_valid &= testCharInTable(kGenericHeaderValueCharTable, data[i]);
+  }
+  return is_valid;
+}
+
+/**
+ * Converts the ASCII uppercase letters of a buffer to lowercase in place, 8 characters per step.
+ * All other characters, including non-ASCII ones, are left unchanged.
+ * @param data the buffer.
+ * @param size the size of the buffer.
+ */
+inline void asciiToLowerInPlace(char* data, size_t size) {
+  using namespace CharacterSetWord;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word = load(data + i);
+    const uint64_t upper = ~bytesLessThan(word, 'A') & bytesLessThan(word, 'Z' + 1);
+    // Uppercase letters have bit 5 clear, setting it turns them into lowercase.
+    word |= upper >> 2;
+    memcpy(data + i, &word, sizeof(word));
+  }
+  for (; i < size; ++i) {
+    if (data[i] >= 'A' && data[i] <= 'Z') {
+      data[i] |= 0x20;
+    }
+  }
+}
+
 } // namespace Http
 } // namespace Envoy
@@ -124,10 +124,8 @@ template <> HeaderMapImpl::StaticLookupTable<RequestHeaderMap>::StaticLookupTabl
   const auto handle =
       CustomInlineHeaderRegistry::getInlineHeader<RequestHeaderMap::header_map_type>(
           Headers::get().Host);
-  input.emplace_back(
-      Headers::get().HostLegacy.get(), [handle](HeaderMapImpl& h) -> StaticLookupResponse {
-        return {&h.inlineHeaders()[handle.value().it_->second], &handle.value().it_->first};
-      });
+  input.emplace_back(Headers::get().HostLegacy.get(),
+                     Entry{&handle.value().it_->first, handle.value().it_->second});
   compile(std::move(input));
 }
 
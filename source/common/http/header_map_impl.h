@@ -13,6 +13,7 @@
 
 #include "source/common/common/compiled_string_map.h"
 #include "source/common/common/non_copyable.h"
+#include "source/common/common/perfect_hash_string_map.h"
 #include "source/common/common/utility.h"
 #include "source/common/http/headers.h"
 
@@ -133,8 +134,8 @@ protected:
   using HeaderNode = std::list<HeaderEntryImpl>::iterator;
 
   /**
-   * This is the static lookup table that is used to determine whether a header is one of the O(1)
-   * headers. This uses a trie for lookup time at most equal to the size of the incoming string.
+   * This is the result of the static lookup table that is used to determine whether a header is one
+   * of the O(1) headers.
    */
   struct StaticLookupResponse {
     HeaderEntryImpl** entry_;
@@ -142,11 +143,18 @@ protected:
   };
 
   /**
-   * Base class for a static lookup table that converts a string key into an O(1) header.
+   * Base class for a static lookup table that converts a string key into an O(1) header. The
+   * table uses a perfect hash of the registered header names, including the custom inline headers,
+   * and falls back to a trie if no perfect hash is found for them.
    */
-  template <class Interface>
-  struct StaticLookupTable
-      : public CompiledStringMap<std::function<StaticLookupResponse(HeaderMapImpl&)>> {
+  template <class Interface> struct StaticLookupTable {
+    // The index of the header in the inline header array, and its registered name.
+    struct Entry {
+      const LowerCaseString* key_{};
+      size_t index_{};
+    };
+    using KV = std::pair<absl::string_view, Entry>;
+
     StaticLookupTable();
 
     std::vector<KV> finalizedTable() {
@@ -156,13 +164,22 @@ protected:
       std::vector<KV> input;
       input.reserve(size_);
       for (const auto& header : headers) {
-        input.emplace_back(header.first.get(), [&header](HeaderMapImpl& h) -> StaticLookupResponse {
-          return {&h.inlineHeaders()[header.second], &header.first};
-        });
+        input.emplace_back(header.first.get(), Entry{&header.first, header.second});
       }
       return input;
     }
 
+    void compile(std::vector<KV> input) {
+      use_perfect_hash_ = perfect_hash_map_.compile(input);
+      if (!use_perfect_hash_) {
+        compiled_map_.compile(std::move(input));
+      }
+    }
+
+    Entry find(absl::string_view key) const {
+      return use_perfect_hash_ ? perfect_hash_map_.find(key) : compiled_map_.find(key);
+    }
+
     static size_t size() {
       // The size of the lookup table is finalized when the singleton lookup table is created. This
       // allows for late binding of custom headers as well as envoy header prefix changes. This
@@ -176,14 +193,17 @@ protected:
 
     static absl::optional<StaticLookupResponse> lookup(HeaderMapImpl& header_map,
                                                        absl::string_view key) {
-      const auto& entry = ConstSingleton<StaticLookupTable>::get().find(key);
-      if (entry != nullptr) {
-        return entry(header_map);
+      const Entry entry = ConstSingleton<StaticLookupTable>::get().find(key);
+      if (entry.key_ != nullptr) {
+        return StaticLookupResponse{&header_map.inlineHeaders()[entry.index_], entry.key_};
       } else {
         return absl::nullopt;
       }
     }
 
+    PerfectHashStringMap<Entry> perfect_hash_map_;
+    CompiledStringMap<Entry> compiled_map_;
+    bool use_perfect_hash_{};
     // This is the size of the number of callbacks; in the case of Requests,
     // this is one smaller than the number of entries in the lookup table,
     // because of legacy `host` mapping to the same thing as `:authority`.
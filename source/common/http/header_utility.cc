@@ -20,7 +20,6 @@
 #ifdef ENVOY_ENABLE_HTTP_DATAGRAMS
 #include "quiche/common/structured_headers.h"
 #endif
-#include "quiche/http2/adapter/header_validator.h"
 
 namespace Envoy {
 namespace Http {
@@ -125,8 +124,7 @@ HeaderUtility::createHeaderData(const envoy::config::route::v3::HeaderMatcher& c
 }
 
 bool HeaderUtility::headerValueIsValid(const absl::string_view header_value) {
-  return http2::adapter::HeaderValidator::IsValidHeaderValue(header_value,
-                                                             http2::adapter::ObsTextOption::kAllow);
+  return headerValueCharsAreValid(header_value.data(), header_value.size());
 }
 
 bool HeaderUtility::headerNameIsValid(absl::string_view header_key) {
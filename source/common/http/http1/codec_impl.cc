@@ -17,6 +17,7 @@
 #include "source/common/common/statusor.h"
 #include "source/common/common/utility.h"
 #include "source/common/grpc/common.h"
+#include "source/common/http/character_set_validation.h"
 #include "source/common/http/exception.h"
 #include "source/common/http/header_utility.h"
 #include "source/common/http/headers.h"
@@ -561,7 +562,7 @@ Status ConnectionImpl::completeCurrentHeader() {
     if (formatter.has_value()) {
       formatter->processKey(current_header_field_.getStringView());
     }
-    current_header_field_.inlineTransform([](char c) { return absl::ascii_tolower(c); });
+    current_header_field_.inlineTransformBuffer(asciiToLowerInPlace);
 
     headers_or_trailers.addViaMove(std::move(current_header_field_),
                                    std::move(current_header_value_));
@@ -10,7 +10,7 @@ class IoUringWorkerFactoryImpl : public IoUringWorkerFactory {
 public:
   IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                            uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                           ThreadLocal::SlotAllocator& tls);
+                           bool enable_submission_batching, ThreadLocal::SlotAllocator& tls);
 
   OptRef<IoUringWorker> getIoUringWorker() override;
 
@@ -22,6 +22,7 @@ private:
   const bool use_submission_queue_polling_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  const bool enable_submission_batching_;
   ThreadLocal::TypedSlot<IoUringWorker> tls_;
 };
 
@@ -1,5 +1,7 @@
 #include "source/common/io/io_uring_worker_impl.h"
 
+#include "absl/strings/str_cat.h"
+
 namespace Envoy {
 namespace Io {
 
@@ -60,14 +62,20 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                                     Event::Dispatcher& dispatcher)
+                                     Event::Dispatcher& dispatcher,
+                                     bool enable_submission_batching)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, dispatcher,
+                        enable_submission_batching) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
-                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
+                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher,
+                                     bool enable_submission_batching)
     : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
       write_timeout_ms_(write_timeout_ms), dispatcher_(dispatcher) {
+  if (enable_submission_batching) {
+    submit_batch_cb_ = dispatcher_.createSchedulableCallback([this]() { io_uring_->submit(); });
+  }
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -83,6 +91,13 @@ IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer
 IoUringWorkerImpl::~IoUringWorkerImpl() {
   ENVOY_LOG(trace, "destruct io uring worker, existing sockets = {}", sockets_.size());
 
+  // The dispatcher is not running anymore, so the requests submitted below must not wait for the
+  // batch callback.
+  if (submit_batch_cb_ != nullptr) {
+    submit_batch_cb_.reset();
+    io_uring_->submit();
+  }
+
   for (auto& socket : sockets_) {
     if (socket->getStatus() != Closed) {
       socket->close(false);
@@ -134,6 +149,18 @@ IoUringSocketEntry& IoUringWorkerImpl::addSocket(IoUringSocketEntryPtr&& socket)
   return *sockets_.back();
 }
 
+void IoUringWorkerImpl::prepareSubmission(absl::string_view operation,
+                                          absl::FunctionRef<IoUringResult()> prepare) {
+  if (prepare() == IoUringResult::Failed) {
+    // The submission queue is full. Flush it right away even if the submission is delayed,
+    // otherwise no entry can be freed for this request.
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    flushSubmissions();
+    RELEASE_ASSERT(prepare() == IoUringResult::Ok, absl::StrCat("unable to prepare ", operation));
+  }
+  submit();
+}
+
 Request*
 IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
                                         const Network::Address::InstanceConstSharedPtr& address) {
@@ -141,14 +168,9 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
 
   ENVOY_LOG(trace, "submit connect request, fd = {}, req = {}", socket.fd(), fmt::ptr(req));
 
-  auto res = io_uring_->prepareConnect(socket.fd(), address, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareConnect(socket.fd(), address, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare connect");
-  }
-  submit();
+  prepareSubmission("connect", [&]() {
+    return io_uring_->prepareConnect(socket.fd(), address, req);
+  });
   return req;
 }
 
@@ -157,14 +179,9 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
 
   ENVOY_LOG(trace, "submit read request, fd = {}, read req = {}", socket.fd(), fmt::ptr(req));
 
-  auto res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare readv");
-  }
-  submit();
+  prepareSubmission("readv", [&]() {
+    return io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
+  });
   return req;
 }
 
@@ -174,14 +191,9 @@ Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
 
   ENVOY_LOG(trace, "submit write request, fd = {}, req = {}", socket.fd(), fmt::ptr(req));
 
-  auto res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare writev");
-  }
-  submit();
+  prepareSubmission("writev", [&]() {
+    return io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
+  });
   return req;
 }
 
@@ -190,14 +202,9 @@ Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
 
   ENVOY_LOG(trace, "submit close request, fd = {}, close req = {}", socket.fd(), fmt::ptr(req));
 
-  auto res = io_uring_->prepareClose(socket.fd(), req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareClose(socket.fd(), req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare close");
-  }
-  submit();
+  prepareSubmission("close", [&]() {
+    return io_uring_->prepareClose(socket.fd(), req);
+  });
   return req;
 }
 
@@ -207,14 +214,9 @@ Request* IoUringWorkerImpl::submitCancelRequest(IoUringSocket& socket, Request*
   ENVOY_LOG(trace, "submit cancel request, fd = {}, cancel req = {}, req to cancel = {}",
             socket.fd(), fmt::ptr(req), fmt::ptr(request_to_cancel));
 
-  auto res = io_uring_->prepareCancel(request_to_cancel, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareCancel(request_to_cancel, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
-  }
-  submit();
+  prepareSubmission("cancel", [&]() {
+    return io_uring_->prepareCancel(request_to_cancel, req);
+  });
   return req;
 }
 
@@ -224,14 +226,9 @@ Request* IoUringWorkerImpl::submitShutdownRequest(IoUringSocket& socket, int how
   ENVOY_LOG(trace, "submit shutdown request, fd = {}, shutdown req = {}", socket.fd(),
             fmt::ptr(req));
 
-  auto res = io_uring_->prepareShutdown(socket.fd(), how, req);
-  if (res == IoUringResult::Failed) {
-    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
-    res = io_uring_->prepareShutdown(socket.fd(), how, req);
-    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
-  }
-  submit();
+  prepareSubmission("shutdown", [&]() {
+    return io_uring_->prepareShutdown(socket.fd(), how, req);
+  });
   return req;
 }
 
@@ -297,13 +294,28 @@ void IoUringWorkerImpl::onFileEvent() {
     delete req;
   });
   delay_submit_ = false;
-  submit();
+  flushSubmissions();
 }
 
 void IoUringWorkerImpl::submit() {
-  if (!delay_submit_) {
-    io_uring_->submit();
+  if (delay_submit_) {
+    return;
+  }
+  if (submit_batch_cb_ != nullptr) {
+    // Coalesce all the requests prepared in this event loop iteration into one submission.
+    if (!submit_batch_cb_->enabled()) {
+      submit_batch_cb_->scheduleCallbackCurrentIteration();
+    }
+    return;
+  }
+  io_uring_->submit();
+}
+
+void IoUringWorkerImpl::flushSubmissions() {
+  if (submit_batch_cb_ != nullptr) {
+    submit_batch_cb_->cancel();
   }
+  io_uring_->submit();
 }
 
 IoUringServerSocket::IoUringServerSocket(os_fd_t fd, IoUringWorkerImpl& parent,
@@ -1,12 +1,16 @@
 #pragma once
 
 #include "envoy/common/io/io_uring.h"
+#include "envoy/event/schedulable_cb.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
 #include "source/common/io/io_uring_impl.h"
 
+#include "absl/functional/function_ref.h"
+#include "absl/strings/string_view.h"
+
 namespace Envoy {
 namespace Io {
 
@@ -32,9 +36,9 @@ class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger:
 public:
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    Event::Dispatcher& dispatcher, bool enable_submission_batching = false);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                    Event::Dispatcher& dispatcher);
+                    Event::Dispatcher& dispatcher, bool enable_submission_batching = false);
   ~IoUringWorkerImpl() override;
 
   // IoUringWorker
@@ -69,6 +73,11 @@ protected:
   IoUringSocketEntry& addSocket(IoUringSocketEntryPtr&& socket);
   void onFileEvent();
   void submit();
+  // Submit all the prepared requests to the kernel immediately.
+  void flushSubmissions();
+  // Prepare a request with the given function and submit it. If the submission queue is full,
+  // it is flushed and the request is prepared again.
+  void prepareSubmission(absl::string_view operation, absl::FunctionRef<IoUringResult()> prepare);
 
   // The iouring instance.
   IoUringPtr io_uring_;
@@ -84,6 +93,9 @@ protected:
   // The IoUringWorker will delay the submit the requests which are submitted in request completion
   // callback.
   bool delay_submit_{false};
+  // When submission batching is enabled, this callback submits all the requests prepared during
+  // the current event loop iteration with a single system call. Null if batching is disabled.
+  Event::SchedulableCallbackPtr submit_batch_cb_;
 };
 
 class IoUringSocketEntry : public IoUringSocket,
@@ -18,6 +18,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
 #include "source/common/config/utility.h"
+#include "source/common/event/worker_name.h"
 #include "source/common/network/filter_matcher.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/listen_socket_impl.h"
@@ -424,7 +425,7 @@ ListenerManagerImpl::ListenerManagerImpl(Instance& server,
 
   for (uint32_t i = 0; i < server.options().concurrency(); i++) {
     workers_.emplace_back(worker_factory.createWorker(
-        i, server.overloadManager(), server.nullOverloadManager(), absl::StrCat("worker_", i)));
+        i, server.overloadManager(), server.nullOverloadManager(), Event::workerName(i)));
     ENVOY_LOG(debug, "starting worker: {}", i);
   }
 }
@@ -172,6 +172,9 @@ private:
       parent_.host_description_ = host;
     }
     bool startUpstreamSecureTransport() override { return parent_.startUpstreamSecureTransport(); }
+    bool isOnlyFilter() override {
+      return parent_.upstream_filters_.size() == 1 && parent_.downstream_filters_.empty();
+    }
 
     FilterManagerImpl& parent_;
     ReadFilterSharedPtr filter_;
@@ -323,6 +323,8 @@ bool MultiConnectionBaseImpl::startSecureTransport() {
   return ret;
 }
 
+bool MultiConnectionBaseImpl::canSpliceData() const { return connections_[0]->canSpliceData(); }
+
 absl::optional<std::chrono::milliseconds> MultiConnectionBaseImpl::lastRoundTripTime() const {
   // Note, this might change before connect finishes.
   return connections_[0]->lastRoundTripTime();
@@ -97,6 +97,8 @@ public:
   void setBufferLimits(uint32_t limit) override;
   void setBufferHighWatermarkTimeout(std::chrono::milliseconds timeout) override;
   bool startSecureTransport() override;
+  // Note, this might change before connect finishes.
+  bool canSpliceData() const override;
   absl::optional<std::chrono::milliseconds> lastRoundTripTime() const override;
   void configureInitialCongestionWindow(uint64_t, std::chrono::microseconds) override {}
   absl::optional<uint64_t> congestionWindowInBytes() const override;
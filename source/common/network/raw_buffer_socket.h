@@ -23,6 +23,7 @@ public:
   IoResult doWrite(Buffer::Instance& buffer, bool end_stream) override;
   Ssl::ConnectionInfoConstSharedPtr ssl() const override { return nullptr; }
   bool startSecureTransport() override { return false; }
+  bool canSpliceData() const override { return true; }
   void configureInitialCongestionWindow(uint64_t, std::chrono::microseconds) override {}
 
 protected:
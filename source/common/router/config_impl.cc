@@ -1474,7 +1474,10 @@ RegexRouteEntryImpl::RegexRouteEntryImpl(
     ProtobufMessage::ValidationVisitor& validator, absl::Status& creation_status)
     : RouteEntryImplBase(vhost, route, factory_context, validator, creation_status),
       path_matcher_(
-          Matchers::PathMatcher::createSafeRegex(route.match().safe_regex(), factory_context)) {
+          Matchers::PathMatcher::createSafeRegex(route.match().safe_regex(), factory_context)),
+      uses_google_re2_(route.match().safe_regex().has_google_re2() ||
+                       dynamic_cast<const Regex::GoogleReEngine*>(
+                           &factory_context.regexEngine()) != nullptr) {
   ASSERT(route.match().path_specifier_case() ==
          envoy::config::route::v3::RouteMatch::PathSpecifierCase::kSafeRegex);
   // The createSafeRegex function never returns nullptr.
@@ -1793,9 +1796,72 @@ VirtualHostImpl::VirtualHostImpl(const envoy::config::route::v3::VirtualHost& vi
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+    if (routes_.size() >= RoutePathIndex::MinRoutesToIndex &&
+        Runtime::runtimeFeatureEnabled("envoy.reloadable_features.route_path_index")) {
+      buildRoutePathIndex();
+    }
   }
 }
 
+void VirtualHostImpl::buildRoutePathIndex() {
+  auto index = std::make_unique<RoutePathIndex>();
+  for (uint32_t i = 0; i < routes_.size(); ++i) {
+    const RouteEntryImplBase& route = *routes_[i];
+    const bool ignore_case = !route.case_sensitive();
+    switch (route.matchType()) {
+    case PathMatchType::Exact:
+      index->addExact(route.matcher(), ignore_case, i);
+      break;
+    case PathMatchType::Prefix:
+      index->addPrefix(route.matcher(), ignore_case, i);
+      break;
+    case PathMatchType::PathSeparatedPrefix:
+      index->addPathSeparatedPrefix(route.matcher(), ignore_case, i);
+      break;
+    case PathMatchType::Regex: {
+      const auto* regex_route = dynamic_cast<const RegexRouteEntryImpl*>(&route);
+      if (regex_route != nullptr && regex_route->usesGoogleRe2()) {
+        index->addRegex(route.matcher(), i);
+      } else {
+        index->addUnindexed(i);
+      }
+      break;
+    }
+    case PathMatchType::None:
+    case PathMatchType::Template:
+      index->addUnindexed(i);
+      break;
+    }
+  }
+  index->finalize();
+  // Nothing to gain if every route has to be evaluated anyway.
+  if (index->indexedRoutes() > 0) {
+    route_path_index_ = std::move(index);
+  }
+}
+
+RouteConstSharedPtr
+VirtualHostImpl::getRouteFromIndex(const RouteMatchContext& route_match_context,
+                                   const StreamInfo::StreamInfo& stream_info,
+                                   uint64_t random_value) const {
+  ASSERT(route_path_index_ != nullptr);
+  // Exact and prefix routes match against the sanitized path with query and fragment removed,
+  // while path separated prefix routes use the sanitized path without query. See the matches()
+  // implementations of the route entries.
+  const absl::string_view path =
+      Http::PathUtil::removeQueryAndFragment(route_match_context.sanitizedPath());
+  RouteConstSharedPtr route_entry;
+  route_path_index_->forEachCandidate(
+      path, route_match_context.sanitizedPathWithoutQuery(), [&](uint32_t index) {
+        route_entry = routes_[index]->matches(route_match_context, stream_info, random_value);
+        return route_entry == nullptr;
+      });
+  if (route_entry == nullptr) {
+    ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  }
+  return route_entry;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
     const RouteCallback& cb, const RouteMatchContext& route_match_context,
     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
@@ -1889,6 +1955,13 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
+  // The path index prunes routes that cannot match the path. Requests without a path only match
+  // CONNECT routes and route callbacks need to observe the full route list, so both of these
+  // fall back to the ordered evaluation.
+  if (route_path_index_ != nullptr && cb == nullptr && headers.Path() != nullptr) {
+    return getRouteFromIndex(route_match_context, stream_info, random_value);
+  }
+
   // Check for a route that matches the request.
   return getRouteFromRoutes(cb, route_match_context, stream_info, random_value, routes_);
 }
@@ -37,6 +37,7 @@
 #include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/router/per_filter_config.h"
 #include "source/common/router/retry_policy_impl.h"
+#include "source/common/router/route_path_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
@@ -479,12 +480,19 @@ public:
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  void buildRoutePathIndex();
+  RouteConstSharedPtr getRouteFromIndex(const RouteMatchContext& route_match_context,
+                                        const StreamInfo::StreamInfo& stream_info,
+                                        uint64_t random_value) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   absl::InlinedVector<RouteEntryImplBaseConstSharedPtr, 2> routes_;
+  // Index over the path criteria of routes_. Only built for large route lists.
+  RoutePathIndexConstPtr route_path_index_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -677,6 +685,7 @@ public:
 
   bool matchRoute(const RouteMatchContext& route_match_context,
                   const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
+  bool case_sensitive() const { return case_sensitive_; }
   absl::Status validateClusters(const Upstream::ClusterManager& cluster_manager) const;
 
   // Router::RouteEntry
@@ -866,7 +875,6 @@ protected:
 
   std::unique_ptr<ConnectConfig> connect_config_;
 
-  bool case_sensitive() const { return case_sensitive_; }
   RouteConstSharedPtr clusterEntry(const Http::RequestHeaderMap& headers,
                                    const StreamInfo::StreamInfo& stream_info,
                                    uint64_t random_value) const;
@@ -1152,8 +1160,12 @@ public:
                       Server::Configuration::ServerFactoryContext& factory_context,
                       ProtobufMessage::ValidationVisitor& validator, absl::Status& creation_status);
 
+  // Whether the path regex is evaluated by RE2, and can therefore be part of a RE2 regex set.
+  bool usesGoogleRe2() const { return uses_google_re2_; }
+
 private:
   const Matchers::PathMatcherConstSharedPtr path_matcher_;
+  const bool uses_google_re2_;
 };
 
 /**
@@ -0,0 +1,132 @@
+#include "source/common/router/route_path_index.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+
+#include "absl/strings/ascii.h"
+
+namespace Envoy {
+namespace Router {
+
+void RoutePathIndex::PrefixTable::add(absl::string_view prefix, uint32_t index) {
+  IndexList* list = tree_.find(prefix);
+  if (list == nullptr) {
+    storage_.push_back(std::make_unique<IndexList>());
+    list = storage_.back().get();
+    tree_.add(prefix, list);
+  }
+  ASSERT(list->empty() || list->back() < index);
+  list->push_back(index);
+}
+
+void RoutePathIndex::PrefixTable::collect(absl::string_view path,
+                                          CandidateList& candidates) const {
+  if (storage_.empty()) {
+    return;
+  }
+  for (const IndexList* list : tree_.findMatchingPrefixes(path)) {
+    candidates.insert(candidates.end(), list->begin(), list->end());
+  }
+}
+
+void RoutePathIndex::Tables::collect(absl::string_view path, absl::string_view separated_path,
+                                     CandidateList& candidates) const {
+  if (!exact_.empty()) {
+    const auto it = exact_.find(path);
+    if (it != exact_.end()) {
+      candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+  }
+  prefix_.collect(path, candidates);
+  path_separated_prefix_.collect(separated_path, candidates);
+}
+
+void RoutePathIndex::addExact(absl::string_view path, bool ignore_case, uint32_t index) {
+  if (ignore_case) {
+    case_insensitive_.exact_[absl::AsciiStrToLower(path)].push_back(index);
+  } else {
+    case_sensitive_.exact_[std::string(path)].push_back(index);
+  }
+  ++indexed_routes_;
+}
+
+void RoutePathIndex::addPrefix(absl::string_view prefix, bool ignore_case, uint32_t index) {
+  if (ignore_case) {
+    case_insensitive_.prefix_.add(absl::AsciiStrToLower(prefix), index);
+  } else {
+    case_sensitive_.prefix_.add(prefix, index);
+  }
+  ++indexed_routes_;
+}
+
+void RoutePathIndex::addPathSeparatedPrefix(absl::string_view prefix, bool ignore_case,
+                                            uint32_t index) {
+  if (ignore_case) {
+    case_insensitive_.path_separated_prefix_.add(absl::AsciiStrToLower(prefix), index);
+  } else {
+    case_sensitive_.path_separated_prefix_.add(prefix, index);
+  }
+  ++indexed_routes_;
+}
+
+void RoutePathIndex::addRegex(absl::string_view pattern, uint32_t index) {
+  if (regex_set_ == nullptr) {
+    regex_set_ = std::make_unique<Regex::GoogleReMatcherSet>();
+  }
+  const absl::StatusOr<int> position = regex_set_->add(pattern);
+  if (!position.ok()) {
+    addUnindexed(index);
+    return;
+  }
+  ASSERT(static_cast<size_t>(*position) == regex_indices_.size());
+  regex_indices_.push_back(index);
+  ++indexed_routes_;
+}
+
+void RoutePathIndex::finalize() {
+  if (regex_set_ == nullptr) {
+    return;
+  }
+  if (!regex_indices_.empty() && regex_set_->compile().ok()) {
+    return;
+  }
+  // The regex set could not be built, evaluate the regex routes individually instead.
+  unindexed_.insert(unindexed_.end(), regex_indices_.begin(), regex_indices_.end());
+  std::sort(unindexed_.begin(), unindexed_.end());
+  indexed_routes_ -= regex_indices_.size();
+  regex_indices_.clear();
+  regex_set_.reset();
+}
+
+void RoutePathIndex::addUnindexed(uint32_t index) {
+  ASSERT(unindexed_.empty() || unindexed_.back() < index);
+  unindexed_.push_back(index);
+}
+
+void RoutePathIndex::findIndexedCandidates(absl::string_view path,
+                                           absl::string_view separated_path,
+                                           CandidateList& candidates) const {
+  case_sensitive_.collect(path, separated_path, candidates);
+  if (!case_insensitive_.empty()) {
+    const std::string lower_path = absl::AsciiStrToLower(path);
+    const std::string lower_separated_path =
+        separated_path == path ? lower_path : absl::AsciiStrToLower(separated_path);
+    case_insensitive_.collect(lower_path, lower_separated_path, candidates);
+  }
+  if (regex_set_ != nullptr) {
+    std::vector<int> matches;
+    if (regex_set_->match(path, matches)) {
+      for (const int position : matches) {
+        candidates.push_back(regex_indices_[position]);
+      }
+    } else {
+      candidates.insert(candidates.end(), regex_indices_.begin(), regex_indices_.end());
+    }
+  }
+  // Every route is stored under exactly one key, so there are no duplicates to remove.
+  std::sort(candidates.begin(), candidates.end());
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/common/radix_tree.h"
+#include "source/common/common/regex.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * An index over the path criteria of an ordered route list. The index is used to prune routes
+ * whose path criterion cannot match a request path, so that route selection does not need to
+ * evaluate every route of a large virtual host. Exact path routes are kept in a hash map and prefix
+ * routes in a radix tree, one set of tables for case sensitive and one for case insensitive
+ * matchers. RE2 regex routes are evaluated together in a single pass of a regex set. Routes whose
+ * path criterion cannot be indexed (URI template, CONNECT, other regex engines, ...) are always
+ * reported as candidates.
+ *
+ * The index only narrows the list of candidates. Every candidate still has to be evaluated with
+ * its full match logic (headers, query parameters, runtime, etc.), in config order, to preserve
+ * first-match-wins semantics.
+ */
+class RoutePathIndex {
+public:
+  // Below this number of routes a linear scan is at least as fast as an index lookup.
+  static constexpr size_t MinRoutesToIndex = 16;
+
+  using CandidateList = absl::InlinedVector<uint32_t, 8>;
+
+  /**
+   * Adds an exact path route. Routes must be added in increasing config order.
+   * @param path the exact path of the route.
+   * @param ignore_case whether the path is matched case insensitively.
+   * @param index the position of the route in the route list.
+   */
+  void addExact(absl::string_view path, bool ignore_case, uint32_t index);
+
+  /**
+   * Adds a prefix route. Routes must be added in increasing config order.
+   * @param prefix the path prefix of the route.
+   * @param ignore_case whether the prefix is matched case insensitively.
+   * @param index the position of the route in the route list.
+   */
+  void addPrefix(absl::string_view prefix, bool ignore_case, uint32_t index);
+
+  /**
+   * Adds a path separated prefix route. Routes must be added in increasing config order.
+   * @param prefix the path prefix of the route.
+   * @param ignore_case whether the prefix is matched case insensitively.
+   * @param index the position of the route in the route list.
+   */
+  void addPathSeparatedPrefix(absl::string_view prefix, bool ignore_case, uint32_t index);
+
+  /**
+   * Adds an RE2 regex route, matched against the whole path. Routes must be added in increasing
+   * config order.
+   * @param pattern the RE2 pattern of the route.
+   * @param index the position of the route in the route list.
+   */
+  void addRegex(absl::string_view pattern, uint32_t index);
+
+  /**
+   * Must be called once after all routes have been added and before any lookup.
+   */
+  void finalize();
+
+  /**
+   * Adds a route whose path criterion cannot be indexed. Such a route is a candidate for every
+   * request. Routes must be added in increasing config order.
+   * @param index the position of the route in the route list.
+   */
+  void addUnindexed(uint32_t index);
+
+  /**
+   * @return the number of routes that are served from the index tables.
+   */
+  size_t indexedRoutes() const { return indexed_routes_; }
+
+  /**
+   * @return the number of routes that are evaluated for every request.
+   */
+  size_t unindexedRoutes() const { return unindexed_.size(); }
+
+  /**
+   * @return the number of regex routes that are evaluated through the regex set.
+   */
+  size_t regexSetRoutes() const { return regex_set_ != nullptr ? regex_indices_.size() : 0; }
+
+  /**
+   * Invokes a callback with the index of every route whose path criterion may match, in config
+   * order, until the callback returns false.
+   * @param path the request path with query and fragment removed, used for exact and prefix
+   *        routes.
+   * @param separated_path the path used for path separated prefix routes.
+   * @param cb the callback invoked with each candidate index. Returning false stops the iteration.
+   */
+  template <class Callback>
+  void forEachCandidate(absl::string_view path, absl::string_view separated_path,
+                        Callback cb) const {
+    CandidateList indexed;
+    findIndexedCandidates(path, separated_path, indexed);
+
+    // Both lists are sorted, so merging them yields the candidates in config order.
+    auto indexed_it = indexed.begin();
+    auto unindexed_it = unindexed_.begin();
+    while (indexed_it != indexed.end() || unindexed_it != unindexed_.end()) {
+      uint32_t next;
+      if (unindexed_it == unindexed_.end() ||
+          (indexed_it != indexed.end() && *indexed_it < *unindexed_it)) {
+        next = *indexed_it++;
+      } else {
+        next = *unindexed_it++;
+      }
+      if (!cb(next)) {
+        return;
+      }
+    }
+  }
+
+  /**
+   * Collects, sorted by config order, the indices of all indexed routes whose path criterion may
+   * match. Unindexed routes are not included.
+   */
+  void findIndexedCandidates(absl::string_view path, absl::string_view separated_path,
+                             CandidateList& candidates) const;
+
+private:
+  using IndexList = absl::InlinedVector<uint32_t, 1>;
+
+  class PrefixTable {
+  public:
+    void add(absl::string_view prefix, uint32_t index);
+    void collect(absl::string_view path, CandidateList& candidates) const;
+    bool empty() const { return storage_.empty(); }
+
+  private:
+    RadixTree<IndexList*> tree_;
+    std::vector<std::unique_ptr<IndexList>> storage_;
+  };
+
+  struct Tables {
+    void collect(absl::string_view path, absl::string_view separated_path,
+                 CandidateList& candidates) const;
+    bool empty() const {
+      return exact_.empty() && prefix_.empty() && path_separated_prefix_.empty();
+    }
+
+    absl::flat_hash_map<std::string, IndexList> exact_;
+    PrefixTable prefix_;
+    PrefixTable path_separated_prefix_;
+  };
+
+  Tables case_sensitive_;
+  Tables case_insensitive_;
+  // Regex set position to route index.
+  std::vector<uint32_t> regex_indices_;
+  std::unique_ptr<Regex::GoogleReMatcherSet> regex_set_;
+  std::vector<uint32_t> unindexed_;
+  size_t indexed_routes_{};
+};
+
+using RoutePathIndexConstPtr = std::unique_ptr<const RoutePathIndex>;
+
+} // namespace Router
+} // namespace Envoy
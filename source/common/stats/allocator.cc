@@ -25,37 +25,44 @@ namespace Stats {
 const char Allocator::DecrementToZeroSyncPoint[] = "decrement-zero";
 
 Allocator::~Allocator() {
-  ASSERT(counters_.empty());
-  ASSERT(gauges_.empty());
+  for (Shard& shard : shards_) {
+    Thread::LockGuard lock(shard.mutex_);
+    ASSERT(shard.counters_.empty());
+    ASSERT(shard.gauges_.empty());
 
 #ifndef NDEBUG
-  // Move deleted stats into the sets for the ASSERTs in removeFromSetLockHeld to function.
-  for (auto& counter : deleted_counters_) {
-    auto insertion = counters_.insert(counter.get());
-    // Assert that there were no duplicates.
-    ASSERT(insertion.second);
-  }
-  for (auto& gauge : deleted_gauges_) {
-    auto insertion = gauges_.insert(gauge.get());
-    // Assert that there were no duplicates.
-    ASSERT(insertion.second);
-  }
-  for (auto& text_readout : deleted_text_readouts_) {
-    auto insertion = text_readouts_.insert(text_readout.get());
-    // Assert that there were no duplicates.
-    ASSERT(insertion.second);
-  }
+    // Move deleted stats into the sets for the ASSERTs in removeFromSetLockHeld to function.
+    for (auto& counter : shard.deleted_counters_) {
+      auto insertion = shard.counters_.insert(counter.get());
+      // Assert that there were no duplicates.
+      ASSERT(insertion.second);
+    }
+    for (auto& gauge : shard.deleted_gauges_) {
+      auto insertion = shard.gauges_.insert(gauge.get());
+      // Assert that there were no duplicates.
+      ASSERT(insertion.second);
+    }
+    for (auto& text_readout : shard.deleted_text_readouts_) {
+      auto insertion = shard.text_readouts_.insert(text_readout.get());
+      // Assert that there were no duplicates.
+      ASSERT(insertion.second);
+    }
 #endif
+  }
 }
 
 #ifndef ENVOY_CONFIG_COVERAGE
 void Allocator::debugPrint() {
-  Thread::LockGuard lock(mutex_);
-  for (Counter* counter : counters_) {
-    ENVOY_LOG_MISC(info, "counter: {}", symbolTable().toString(counter->statName()));
+  AllShardsLockGuard lock(*this);
+  for (const Shard& shard : shards_) {
+    for (Counter* counter : shard.counters_) {
+      ENVOY_LOG_MISC(info, "counter: {}", symbolTable().toString(counter->statName()));
+    }
   }
-  for (Gauge* gauge : gauges_) {
-    ENVOY_LOG_MISC(info, "gauge: {}", symbolTable().toString(gauge->statName()));
+  for (const Shard& shard : shards_) {
+    for (Gauge* gauge : shard.gauges_) {
+      ENVOY_LOG_MISC(info, "gauge: {}", symbolTable().toString(gauge->statName()));
+    }
   }
 }
 #endif
@@ -92,22 +99,23 @@ public:
   // RefcountInterface
   void incRefCount() override { ++ref_count_; }
   bool decRefCount() override {
-    // We must, unfortunately, hold the allocator's lock when decrementing the
-    // refcount. Otherwise another thread may simultaneously try to allocate the
-    // same name'd stat after we decrement it, and we'll wind up with a
-    // dtor/update race. To avoid this we must hold the lock until the stat is
-    // removed from the map.
+    // We must, unfortunately, hold the lock of the stat's allocator shard when
+    // decrementing the refcount. Otherwise another thread may simultaneously try
+    // to allocate the same name'd stat after we decrement it, and we'll wind up
+    // with a dtor/update race. To avoid this we must hold the lock until the stat
+    // is removed from the map.
     //
     // It might be worth thinking about a race-free way to decrement ref-counts
     // without a lock, for the case where ref_count > 2, and we don't need to
     // destruct anything. But it seems preferable at to be conservative here,
     // as stats will only go out of scope when a scope is destructed (during
     // xDS) or during admin stats operations.
-    Thread::LockGuard lock(alloc_.mutex_);
+    Allocator::Shard& shard = alloc_.shardFor(this->statName());
+    Thread::LockGuard lock(shard.mutex_);
     ASSERT(ref_count_ >= 1);
     if (--ref_count_ == 0) {
       alloc_.sync().syncPoint(Allocator::DecrementToZeroSyncPoint);
-      removeFromSetLockHeld();
+      removeFromSetLockHeld(shard);
       return true;
     }
     return false;
@@ -118,8 +126,10 @@ public:
    * We must atomically remove the counter/gauges from the allocator's sets when
    * our ref-count decrement hits zero. The counters and gauges are held in
    * distinct sets so we virtualize this removal helper.
+   * @param shard the allocator shard holding this stat.
    */
-  virtual void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) PURE;
+  virtual void removeFromSetLockHeld(Allocator::Shard& shard)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_) PURE;
 
 protected:
   Allocator& alloc_;
@@ -130,9 +140,9 @@ protected:
   // but these are always in transition to ref-count 2 or higher, and thus
   // cannot race with a decrement to zero.
   //
-  // However, we must hold alloc_.mutex_ when decrementing ref_count_ so that
-  // when it hits zero we can atomically remove it from alloc_.counters_ or
-  // alloc_.gauges_. We leave it atomic to avoid taking the lock on increment.
+  // However, we must hold the shard mutex when decrementing ref_count_ so that
+  // when it hits zero we can atomically remove it from the shard's counters_ or
+  // gauges_. We leave it atomic to avoid taking the lock on increment.
   std::atomic<uint32_t> ref_count_{0};
 
   std::atomic<uint16_t> flags_{0};
@@ -144,10 +154,11 @@ public:
               StatNameTagSpan stat_name_tags)
       : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {}
 
-  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
-    const size_t count = alloc_.counters_.erase(statName());
+  void removeFromSetLockHeld(Allocator::Shard& shard)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_) override {
+    const size_t count = shard.counters_.erase(statName());
     ASSERT(count == 1);
-    alloc_.sinked_counters_.erase(this);
+    shard.sinked_counters_.erase(this);
   }
 
   // Stats::Counter
@@ -173,6 +184,8 @@ public:
   GaugeImpl(StatName name, Allocator& alloc, StatName tag_extracted_name,
             StatNameTagSpan stat_name_tags, ImportMode import_mode)
       : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {
+    // A new gauge is reported by the next flush even if it is never updated.
+    flags_ |= Flags::Changed;
     switch (import_mode) {
     case ImportMode::Accumulate:
       flags_ |= Flags::LogicAccumulate;
@@ -193,29 +206,32 @@ public:
     }
   }
 
-  void removeFromSetLockHeld() override ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) {
-    const size_t count = alloc_.gauges_.erase(statName());
+  void removeFromSetLockHeld(Allocator::Shard& shard) override
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_) {
+    const size_t count = shard.gauges_.erase(statName());
     ASSERT(count == 1);
-    alloc_.sinked_gauges_.erase(this);
+    shard.sinked_gauges_.erase(this);
   }
 
   // Stats::Gauge
   void add(uint64_t amount) override {
     child_value_ += amount;
-    flags_ |= Flags::Used;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
     child_value_ = value;
-    flags_ |= Flags::Used;
+    flags_ |= Flags::Used | Flags::Changed;
   }
   void sub(uint64_t amount) override {
     ASSERT(child_value_ >= amount);
     ASSERT(used() || amount == 0);
     child_value_ -= amount;
+    flags_ |= Flags::Changed;
   }
   uint64_t value() const override { return child_value_ + parent_value_; }
+  bool latchChanged() override { return flags_.fetch_and(~Flags::Changed) & Flags::Changed; }
 
   // TODO(diazalan): Rename importMode and to more generic name
   ImportMode importMode() const override {
@@ -252,7 +268,7 @@ public:
       // we clear the accumulated value.
       parent_value_ = 0;
       flags_ &= ~Flags::Used;
-      flags_ |= Flags::NeverImport;
+      flags_ |= Flags::NeverImport | Flags::Changed;
       break;
     case ImportMode::HiddenAccumulate:
       ASSERT(current == ImportMode::Uninitialized);
@@ -262,7 +278,10 @@ public:
     }
   }
 
-  void setParentValue(uint64_t value) override { parent_value_ = value; }
+  void setParentValue(uint64_t value) override {
+    parent_value_ = value;
+    flags_ |= Flags::Changed;
+  }
 
 private:
   std::atomic<uint64_t> parent_value_{0};
@@ -275,10 +294,11 @@ public:
                   StatNameTagSpan stat_name_tags)
       : StatsSharedImpl(name, alloc, tag_extracted_name, stat_name_tags) {}
 
-  void removeFromSetLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(alloc_.mutex_) override {
-    const size_t count = alloc_.text_readouts_.erase(statName());
+  void removeFromSetLockHeld(Allocator::Shard& shard)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_) override {
+    const size_t count = shard.text_readouts_.erase(statName());
     ASSERT(count == 1);
-    alloc_.sinked_text_readouts_.erase(this);
+    shard.sinked_text_readouts_.erase(this);
   }
 
   // Stats::TextReadout
@@ -300,18 +320,19 @@ private:
 
 CounterSharedPtr Allocator::makeCounter(StatName name, StatName tag_extracted_name,
                                         StatNameTagSpan stat_name_tags) {
-  Thread::LockGuard lock(mutex_);
-  ASSERT(gauges_.find(name) == gauges_.end());
-  ASSERT(text_readouts_.find(name) == text_readouts_.end());
-  auto iter = counters_.find(name);
-  if (iter != counters_.end()) {
+  Shard& shard = shardFor(name);
+  Thread::LockGuard lock(shard.mutex_);
+  ASSERT(shard.gauges_.find(name) == shard.gauges_.end());
+  ASSERT(shard.text_readouts_.find(name) == shard.text_readouts_.end());
+  auto iter = shard.counters_.find(name);
+  if (iter != shard.counters_.end()) {
     return {*iter};
   }
   auto counter = CounterSharedPtr(makeCounterInternal(name, tag_extracted_name, stat_name_tags));
-  counters_.insert(counter.get());
+  shard.counters_.insert(counter.get());
   // Add counter to sinked_counters_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeCounter(*counter)) {
-    auto val = sinked_counters_.insert(counter.get());
+    auto val = shard.sinked_counters_.insert(counter.get());
     ASSERT(val.second);
   }
   return counter;
@@ -319,19 +340,20 @@ CounterSharedPtr Allocator::makeCounter(StatName name, StatName tag_extracted_na
 
 GaugeSharedPtr Allocator::makeGauge(StatName name, StatName tag_extracted_name,
                                     StatNameTagSpan stat_name_tags, Gauge::ImportMode import_mode) {
-  Thread::LockGuard lock(mutex_);
-  ASSERT(counters_.find(name) == counters_.end());
-  ASSERT(text_readouts_.find(name) == text_readouts_.end());
-  auto iter = gauges_.find(name);
-  if (iter != gauges_.end()) {
+  Shard& shard = shardFor(name);
+  Thread::LockGuard lock(shard.mutex_);
+  ASSERT(shard.counters_.find(name) == shard.counters_.end());
+  ASSERT(shard.text_readouts_.find(name) == shard.text_readouts_.end());
+  auto iter = shard.gauges_.find(name);
+  if (iter != shard.gauges_.end()) {
     return {*iter};
   }
   auto gauge =
       GaugeSharedPtr(new GaugeImpl(name, *this, tag_extracted_name, stat_name_tags, import_mode));
-  gauges_.insert(gauge.get());
+  shard.gauges_.insert(gauge.get());
   // Add gauge to sinked_gauges_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeGauge(*gauge)) {
-    auto val = sinked_gauges_.insert(gauge.get());
+    auto val = shard.sinked_gauges_.insert(gauge.get());
     ASSERT(val.second);
   }
   return gauge;
@@ -339,30 +361,35 @@ GaugeSharedPtr Allocator::makeGauge(StatName name, StatName tag_extracted_name,
 
 TextReadoutSharedPtr Allocator::makeTextReadout(StatName name, StatName tag_extracted_name,
                                                 StatNameTagSpan stat_name_tags) {
-  Thread::LockGuard lock(mutex_);
-  ASSERT(counters_.find(name) == counters_.end());
-  ASSERT(gauges_.find(name) == gauges_.end());
-  auto iter = text_readouts_.find(name);
-  if (iter != text_readouts_.end()) {
+  Shard& shard = shardFor(name);
+  Thread::LockGuard lock(shard.mutex_);
+  ASSERT(shard.counters_.find(name) == shard.counters_.end());
+  ASSERT(shard.gauges_.find(name) == shard.gauges_.end());
+  auto iter = shard.text_readouts_.find(name);
+  if (iter != shard.text_readouts_.end()) {
     return {*iter};
   }
   auto text_readout =
       TextReadoutSharedPtr(new TextReadoutImpl(name, *this, tag_extracted_name, stat_name_tags));
-  text_readouts_.insert(text_readout.get());
+  shard.text_readouts_.insert(text_readout.get());
   // Add text_readout to sinked_text_readouts_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeTextReadout(*text_readout)) {
-    auto val = sinked_text_readouts_.insert(text_readout.get());
+    auto val = shard.sinked_text_readouts_.insert(text_readout.get());
     ASSERT(val.second);
   }
   return text_readout;
 }
 
 bool Allocator::isMutexLockedForTest() {
-  bool locked = mutex_.tryLock();
-  if (locked) {
-    mutex_.unlock();
+  for (Shard& shard : shards_) {
+    bool locked = shard.mutex_.tryLock();
+    if (locked) {
+      shard.mutex_.unlock();
+    } else {
+      return true;
+    }
   }
-  return !locked;
+  return false;
 }
 
 Counter* Allocator::makeCounterInternal(StatName name, StatName tag_extracted_name,
@@ -370,54 +397,91 @@ Counter* Allocator::makeCounterInternal(StatName name, StatName tag_extracted_na
   return new CounterImpl(name, *this, tag_extracted_name, stat_name_tags);
 }
 
-void Allocator::forEachCounter(SizeFn f_size, StatFn<Counter> f_stat) const {
-  Thread::LockGuard lock(mutex_);
+// The iteration functions below hold all the shard mutexes, which the thread safety analysis
+// cannot follow through AllShardsLockGuard.
+void Allocator::forEachCounter(SizeFn f_size,
+                               StatFn<Counter> f_stat) const ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  AllShardsLockGuard lock(*this);
   if (f_size != nullptr) {
-    f_size(counters_.size());
+    size_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.counters_.size();
+    }
+    f_size(size);
   }
-  for (auto& counter : counters_) {
-    f_stat(*counter);
+  for (const Shard& shard : shards_) {
+    for (auto& counter : shard.counters_) {
+      f_stat(*counter);
+    }
   }
 }
 
-void Allocator::forEachGauge(SizeFn f_size, StatFn<Gauge> f_stat) const {
-  Thread::LockGuard lock(mutex_);
+void Allocator::forEachGauge(SizeFn f_size,
+                             StatFn<Gauge> f_stat) const ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  AllShardsLockGuard lock(*this);
   if (f_size != nullptr) {
-    f_size(gauges_.size());
+    size_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.gauges_.size();
+    }
+    f_size(size);
   }
-  for (auto& gauge : gauges_) {
-    f_stat(*gauge);
+  for (const Shard& shard : shards_) {
+    for (auto& gauge : shard.gauges_) {
+      f_stat(*gauge);
+    }
   }
 }
 
-void Allocator::forEachTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const {
-  Thread::LockGuard lock(mutex_);
+void Allocator::forEachTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const
+    ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  AllShardsLockGuard lock(*this);
   if (f_size != nullptr) {
-    f_size(text_readouts_.size());
+    size_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.text_readouts_.size();
+    }
+    f_size(size);
   }
-  for (auto& text_readout : text_readouts_) {
-    f_stat(*text_readout);
+  for (const Shard& shard : shards_) {
+    for (auto& text_readout : shard.text_readouts_) {
+      f_stat(*text_readout);
+    }
   }
 }
 
-void Allocator::forEachSinkedCounter(SizeFn f_size, StatFn<Counter> f_stat) const {
+void Allocator::forEachSinkedCounter(SizeFn f_size,
+                                     StatFn<Counter> f_stat) const ABSL_NO_THREAD_SAFETY_ANALYSIS {
   if (sink_predicates_ != nullptr) {
-    Thread::LockGuard lock(mutex_);
-    f_size(sinked_counters_.size());
-    for (auto counter : sinked_counters_) {
-      f_stat(*counter);
+    AllShardsLockGuard lock(*this);
+    size_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.sinked_counters_.size();
+    }
+    f_size(size);
+    for (const Shard& shard : shards_) {
+      for (auto counter : shard.sinked_counters_) {
+        f_stat(*counter);
+      }
     }
   } else {
     forEachCounter(f_size, f_stat);
   }
 }
 
-void Allocator::forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const {
+void Allocator::forEachSinkedGauge(SizeFn f_size,
+                                   StatFn<Gauge> f_stat) const ABSL_NO_THREAD_SAFETY_ANALYSIS {
   if (sink_predicates_ != nullptr) {
-    Thread::LockGuard lock(mutex_);
-    f_size(sinked_gauges_.size());
-    for (auto gauge : sinked_gauges_) {
-      f_stat(*gauge);
+    AllShardsLockGuard lock(*this);
+    size_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.sinked_gauges_.size();
+    }
+    f_size(size);
+    for (const Shard& shard : shards_) {
+      for (auto gauge : shard.sinked_gauges_) {
+        f_stat(*gauge);
+      }
     }
   } else {
     forEachGauge(f_size, [&f_stat](Gauge& gauge) {
@@ -428,86 +492,99 @@ void Allocator::forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const {
   }
 }
 
-void Allocator::forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const {
+void Allocator::forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const
+    ABSL_NO_THREAD_SAFETY_ANALYSIS {
   if (sink_predicates_ != nullptr) {
-    Thread::LockGuard lock(mutex_);
-    f_size(sinked_text_readouts_.size());
-    for (auto text_readout : sinked_text_readouts_) {
-      f_stat(*text_readout);
+    AllShardsLockGuard lock(*this);
+    size_t size = 0;
+    for (const Shard& shard : shards_) {
+      size += shard.sinked_text_readouts_.size();
+    }
+    f_size(size);
+    for (const Shard& shard : shards_) {
+      for (auto text_readout : shard.sinked_text_readouts_) {
+        f_stat(*text_readout);
+      }
     }
   } else {
     forEachTextReadout(f_size, f_stat);
   }
 }
 
-void Allocator::setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) {
-  Thread::LockGuard lock(mutex_);
+void Allocator::setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates)
+    ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  AllShardsLockGuard lock(*this);
   ASSERT(sink_predicates_ == nullptr);
   sink_predicates_ = std::move(sink_predicates);
-  sinked_counters_.clear();
-  sinked_gauges_.clear();
-  sinked_text_readouts_.clear();
-  // Add counters to the set of sinked counters.
-  for (auto& counter : counters_) {
-    if (sink_predicates_->includeCounter(*counter)) {
-      sinked_counters_.emplace(counter);
+  for (Shard& shard : shards_) {
+    shard.sinked_counters_.clear();
+    shard.sinked_gauges_.clear();
+    shard.sinked_text_readouts_.clear();
+    // Add counters to the set of sinked counters.
+    for (auto& counter : shard.counters_) {
+      if (sink_predicates_->includeCounter(*counter)) {
+        shard.sinked_counters_.emplace(counter);
+      }
     }
-  }
-  // Add gauges to the set of sinked gauges.
-  for (auto& gauge : gauges_) {
-    if (sink_predicates_->includeGauge(*gauge)) {
-      sinked_gauges_.insert(gauge);
+    // Add gauges to the set of sinked gauges.
+    for (auto& gauge : shard.gauges_) {
+      if (sink_predicates_->includeGauge(*gauge)) {
+        shard.sinked_gauges_.insert(gauge);
+      }
     }
-  }
-  // Add text_readouts to the set of sinked text readouts.
-  for (auto& text_readout : text_readouts_) {
-    if (sink_predicates_->includeTextReadout(*text_readout)) {
-      sinked_text_readouts_.insert(text_readout);
+    // Add text_readouts to the set of sinked text readouts.
+    for (auto& text_readout : shard.text_readouts_) {
+      if (sink_predicates_->includeTextReadout(*text_readout)) {
+        shard.sinked_text_readouts_.insert(text_readout);
+      }
     }
   }
 }
 
 void Allocator::markCounterForDeletion(const CounterSharedPtr& counter) {
-  Thread::LockGuard lock(mutex_);
-  auto iter = counters_.find(counter->statName());
-  if (iter == counters_.end()) {
+  Shard& shard = shardFor(counter->statName());
+  Thread::LockGuard lock(shard.mutex_);
+  auto iter = shard.counters_.find(counter->statName());
+  if (iter == shard.counters_.end()) {
     // This has already been marked for deletion.
     return;
   }
   ASSERT(counter.get() == *iter);
   // Duplicates are ASSERTed in ~Allocator. These might occur if there was
   // a race bug in reference counting, causing a stat to be double-deleted.
-  deleted_counters_.emplace_back(*iter);
-  counters_.erase(iter);
-  sinked_counters_.erase(counter.get());
+  shard.deleted_counters_.emplace_back(*iter);
+  shard.counters_.erase(iter);
+  shard.sinked_counters_.erase(counter.get());
 }
 
 void Allocator::markGaugeForDeletion(const GaugeSharedPtr& gauge) {
-  Thread::LockGuard lock(mutex_);
-  auto iter = gauges_.find(gauge->statName());
-  if (iter == gauges_.end()) {
+  Shard& shard = shardFor(gauge->statName());
+  Thread::LockGuard lock(shard.mutex_);
+  auto iter = shard.gauges_.find(gauge->statName());
+  if (iter == shard.gauges_.end()) {
     // This has already been marked for deletion.
     return;
   }
   ASSERT(gauge.get() == *iter);
   // Duplicates are ASSERTed in ~Allocator.
-  deleted_gauges_.emplace_back(*iter);
-  gauges_.erase(iter);
-  sinked_gauges_.erase(gauge.get());
+  shard.deleted_gauges_.emplace_back(*iter);
+  shard.gauges_.erase(iter);
+  shard.sinked_gauges_.erase(gauge.get());
 }
 
 void Allocator::markTextReadoutForDeletion(const TextReadoutSharedPtr& text_readout) {
-  Thread::LockGuard lock(mutex_);
-  auto iter = text_readouts_.find(text_readout->statName());
-  if (iter == text_readouts_.end()) {
+  Shard& shard = shardFor(text_readout->statName());
+  Thread::LockGuard lock(shard.mutex_);
+  auto iter = shard.text_readouts_.find(text_readout->statName());
+  if (iter == shard.text_readouts_.end()) {
     // This has already been marked for deletion.
     return;
   }
   ASSERT(text_readout.get() == *iter);
   // Duplicates are ASSERTed in ~Allocator.
-  deleted_text_readouts_.emplace_back(*iter);
-  text_readouts_.erase(iter);
-  sinked_text_readouts_.erase(text_readout.get());
+  shard.deleted_text_readouts_.emplace_back(*iter);
+  shard.text_readouts_.erase(iter);
+  shard.sinked_text_readouts_.erase(text_readout.get());
 }
 
 } // namespace Stats
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include "envoy/stats/sink.h"
@@ -15,7 +16,9 @@ namespace Envoy {
 namespace Stats {
 
 /**
- * Helper class for Store to manage memory for statistics.
+ * Helper class for Store to manage memory for statistics. Stats are spread over a fixed number of
+ * shards by the hash of their name, each guarded by its own mutex, so that stats with different
+ * names can be created and released concurrently.
  */
 class Allocator {
 public:
@@ -90,10 +93,13 @@ public:
   Thread::ThreadSynchronizer& sync() { return sync_; }
 
   /**
-   * @return whether the allocator's mutex is locked, exposed for testing purposes.
+   * @return whether any of the allocator's mutexes is locked, exposed for testing purposes.
    */
   bool isMutexLockedForTest();
 
+  // The number of independently locked shards the stats are spread over.
+  static constexpr uint32_t NumShards = 16;
+
   /**
    * Mark rejected stats as deleted by moving them to a different vector, so they don't show up
    * when iterating over stats, but prevent crashes when trying to access references to them.
@@ -115,39 +121,74 @@ private:
   friend class GaugeImpl;
   friend class TextReadoutImpl;
 
-  // A mutex is needed here to protect both the stats_ object from both
-  // alloc() and free() operations. Although alloc() operations are called under existing locking,
-  // free() operations are made from the destructors of the individual stat objects, which are not
-  // protected by locks.
-  mutable Thread::MutexBasicLockable mutex_;
-
-  StatSet<Counter> counters_ ABSL_GUARDED_BY(mutex_);
-  StatSet<Gauge> gauges_ ABSL_GUARDED_BY(mutex_);
-  StatSet<TextReadout> text_readouts_ ABSL_GUARDED_BY(mutex_);
-
   template <typename StatType> using StatPointerSet = absl::flat_hash_set<StatType*>;
-  // Stat pointers that participate in the flush to sink process.
-  StatPointerSet<Counter> sinked_counters_ ABSL_GUARDED_BY(mutex_);
-  StatPointerSet<Gauge> sinked_gauges_ ABSL_GUARDED_BY(mutex_);
-  StatPointerSet<TextReadout> sinked_text_readouts_ ABSL_GUARDED_BY(mutex_);
 
-  // Predicates used to filter stats to be flushed.
+  struct Shard {
+    // A mutex is needed here to protect the stat sets from both alloc() and free() operations.
+    // Although alloc() operations are called under existing locking, free() operations are made
+    // from the destructors of the individual stat objects, which are not protected by locks.
+    mutable Thread::MutexBasicLockable mutex_;
+
+    StatSet<Counter> counters_ ABSL_GUARDED_BY(mutex_);
+    StatSet<Gauge> gauges_ ABSL_GUARDED_BY(mutex_);
+    StatSet<TextReadout> text_readouts_ ABSL_GUARDED_BY(mutex_);
+
+    // Stat pointers that participate in the flush to sink process.
+    StatPointerSet<Counter> sinked_counters_ ABSL_GUARDED_BY(mutex_);
+    StatPointerSet<Gauge> sinked_gauges_ ABSL_GUARDED_BY(mutex_);
+    StatPointerSet<TextReadout> sinked_text_readouts_ ABSL_GUARDED_BY(mutex_);
+
+    // Retain storage for deleted stats; these are no longer in maps because
+    // the matcher-pattern was established after they were created. Since the
+    // stats are held by reference in code that expects them to be there, we
+    // can't actually delete the stats.
+    //
+    // It seems like it would be better to have each client that expects a stat
+    // to exist to hold it as (e.g.) a CounterSharedPtr rather than a Counter&
+    // but that would be fairly complex to change.
+    std::vector<CounterSharedPtr> deleted_counters_ ABSL_GUARDED_BY(mutex_);
+    std::vector<GaugeSharedPtr> deleted_gauges_ ABSL_GUARDED_BY(mutex_);
+    std::vector<TextReadoutSharedPtr> deleted_text_readouts_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  /**
+   * Holds the mutexes of all the shards, always acquired in shard order, for operations that need
+   * a consistent view of all the stats.
+   */
+  class AllShardsLockGuard {
+  public:
+    explicit AllShardsLockGuard(const Allocator& alloc) ABSL_NO_THREAD_SAFETY_ANALYSIS
+        : alloc_(alloc) {
+      for (const Shard& shard : alloc_.shards_) {
+        shard.mutex_.lock();
+      }
+    }
+    ~AllShardsLockGuard() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+      for (auto shard = alloc_.shards_.rbegin(); shard != alloc_.shards_.rend(); ++shard) {
+        shard->mutex_.unlock();
+      }
+    }
+
+  private:
+    const Allocator& alloc_;
+  };
+
+  Shard& shardFor(StatName name) {
+    // The low bits of the hash also select the slot within the shard's sets, so the shard is
+    // picked from the high bits to keep them independent.
+    return shards_[(name.hash() >> 32) % NumShards];
+  }
+
+  // Predicates used to filter stats to be flushed. Written while holding all shard mutexes, read
+  // while holding at least one.
   std::unique_ptr<SinkPredicates> sink_predicates_;
   SymbolTable& symbol_table_;
 
   Thread::ThreadSynchronizer sync_;
 
-  // Retain storage for deleted stats; these are no longer in maps because
-  // the matcher-pattern was established after they were created. Since the
-  // stats are held by reference in code that expects them to be there, we
-  // can't actually delete the stats.
-  //
-  // It seems like it would be better to have each client that expects a stat
-  // to exist to hold it as (e.g.) a CounterSharedPtr rather than a Counter&
-  // but that would be fairly complex to change.
-  std::vector<CounterSharedPtr> deleted_counters_ ABSL_GUARDED_BY(mutex_);
-  std::vector<GaugeSharedPtr> deleted_gauges_ ABSL_GUARDED_BY(mutex_);
-  std::vector<TextReadoutSharedPtr> deleted_text_readouts_ ABSL_GUARDED_BY(mutex_);
+  // Declared last, as the deleted stats retained in the shards are released when the shards are
+  // destroyed, which needs the rest of the allocator.
+  std::array<Shard, NumShards> shards_;
 };
 
 } // namespace Stats
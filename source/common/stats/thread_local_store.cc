@@ -1,5 +1,6 @@
 #include "source/common/stats/thread_local_store.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <list>
@@ -26,6 +27,7 @@ namespace Stats {
 const char ThreadLocalStoreImpl::DeleteScopeSync[] = "delete-scope";
 const char ThreadLocalStoreImpl::IterateScopeSync[] = "iterate-scope";
 const char ThreadLocalStoreImpl::MainDispatcherCleanupSync[] = "main-dispatcher-cleanup";
+const char ThreadLocalStoreImpl::MakeStatSync[] = "make-stat";
 
 ThreadLocalStoreImpl::ThreadLocalStoreImpl(Allocator& alloc)
     : alloc_(alloc), tag_producer_(std::make_unique<TagProducerImpl>()),
@@ -63,7 +65,11 @@ void ThreadLocalStoreImpl::setHistogramSettings(HistogramSettingsConstPtr&& hist
 }
 
 void ThreadLocalStoreImpl::setStatsMatcher(StatsMatcherPtr&& stats_matcher) {
+  // The matcher is swapped under lock_ so that stats being allocated outside of the lock are
+  // re-checked against it before they are added to the central cache.
+  Thread::LockGuard lock(lock_);
   stats_matcher_ = std::move(stats_matcher);
+  ++stats_matcher_generation_;
   if (stats_matcher_->acceptsAll()) {
     return;
   }
@@ -72,7 +78,6 @@ void ThreadLocalStoreImpl::setStatsMatcher(StatsMatcherPtr&& stats_matcher) {
   // constructed prior to the stat-matcher, and those add stats
   // in the default_scope. There should be no requests, so there will
   // be no copies in TLS caches.
-  Thread::LockGuard lock(lock_);
   const uint32_t first_histogram_index = deleted_histograms_.size();
   iterateScopesLockHeld([this](const ScopeImplSharedPtr& scope) ABSL_EXCLUSIVE_LOCKS_REQUIRED(
                             lock_) -> bool {
@@ -526,55 +531,82 @@ StatType& ThreadLocalStoreImpl::ScopeImpl::safeMakeStat(
     }
   }
 
-  // We must now look in the central store so we must be locked. We grab a reference to the
-  // central store location. It might contain nothing. In this case, we allocate a new stat.
+  // We must now look in the central store so we must be locked. If the central store has no
+  // entry, we allocate a new stat.
+  uint64_t matcher_generation;
+  {
+    Thread::LockGuard lock(parent_.lock_);
+    matcher_generation = parent_.stats_matcher_generation_;
+    auto iter = central_cache_map.find(full_stat_name);
+    if (iter != central_cache_map.end()) {
+      return insertTlsCache(*iter->second, tls_cache);
+    }
+    if (parent_.checkAndRememberRejection(full_stat_name, fast_reject_result,
+                                          central_rejected_stats, tls_rejected_stats,
+                                          effectiveMatcher()) ||
+        centralCacheFullLockHeld<StatType>(central_cache_map)) {
+      return null_stat;
+    }
+  }
+
+  // Tag extraction and allocation are done without holding the store lock, so that stats can be
+  // created concurrently from multiple threads. The allocator de-duplicates stats by name, so a
+  // stat created concurrently by another thread is the same object.
+  StatNameTagHelper tag_helper(parent_, name_no_tags, stat_name_tags);
+  RefcountPtr<StatType> stat = make_stat(parent_.alloc_, full_stat_name,
+                                         tag_helper.tagExtractedName(), tag_helper.statNameTags());
+  ASSERT(stat != nullptr);
+  parent_.sync_.syncPoint(MakeStatSync);
+
   Thread::LockGuard lock(parent_.lock_);
   auto iter = central_cache_map.find(full_stat_name);
-  RefcountPtr<StatType>* central_ref = nullptr;
-  if (iter != central_cache_map.end()) {
-    central_ref = &(iter->second);
-  } else if (parent_.checkAndRememberRejection(full_stat_name, fast_reject_result,
-                                               central_rejected_stats, tls_rejected_stats,
-                                               effectiveMatcher())) {
-    return null_stat;
-  } else {
-    // Stat creation here. Check limits.
-    if constexpr (std::is_same_v<StatType, Counter>) {
-      if (limits_.max_counters.has_value() &&
-          central_cache_map.size() >= limits_.max_counters.value()) {
-        parent_.counters_overflow_->inc();
-        return null_stat;
-      }
-    } else if constexpr (std::is_same_v<StatType, Gauge>) {
-      if (limits_.max_gauges.has_value() &&
-          central_cache_map.size() >= limits_.max_gauges.value()) {
-        parent_.gauges_overflow_->inc();
-        return null_stat;
-      }
-    } else {
-      // TextReadouts are currently not limited, but we must ensure they are the only
-      // other type being handled. This static_assert will trigger a compilation error
-      // if a new StatType is introduced in the future, forcing the developer to
-      // explicitly decide how to handle its limits.
-      static_assert(std::is_same_v<StatType, TextReadout>, "Unexpected StatType");
+  if (iter == central_cache_map.end()) {
+    // The stats matcher may have been replaced, and another thread may have filled the central
+    // store, while the lock was released.
+    if ((matcher_generation != parent_.stats_matcher_generation_ &&
+         parent_.checkAndRememberRejection(full_stat_name, scopeFastRejects(full_stat_name),
+                                           central_rejected_stats, tls_rejected_stats,
+                                           effectiveMatcher())) ||
+        centralCacheFullLockHeld<StatType>(central_cache_map)) {
+      return null_stat;
     }
-    StatNameTagHelper tag_helper(parent_, name_no_tags, stat_name_tags);
+    iter = central_cache_map.emplace(stat->statName(), stat).first;
+  }
+  return insertTlsCache(*iter->second, tls_cache);
+}
 
-    RefcountPtr<StatType> stat = make_stat(
-        parent_.alloc_, full_stat_name, tag_helper.tagExtractedName(), tag_helper.statNameTags());
-    ASSERT(stat != nullptr);
-    central_ref = &central_cache_map[stat->statName()];
-    *central_ref = stat;
+template <class StatType>
+bool ThreadLocalStoreImpl::ScopeImpl::centralCacheFullLockHeld(
+    const StatNameHashMap<RefcountPtr<StatType>>& central_cache_map) const {
+  if constexpr (std::is_same_v<StatType, Counter>) {
+    if (limits_.max_counters.has_value() &&
+        central_cache_map.size() >= limits_.max_counters.value()) {
+      parent_.counters_overflow_->inc();
+      return true;
+    }
+  } else if constexpr (std::is_same_v<StatType, Gauge>) {
+    if (limits_.max_gauges.has_value() && central_cache_map.size() >= limits_.max_gauges.value()) {
+      parent_.gauges_overflow_->inc();
+      return true;
+    }
+  } else {
+    // TextReadouts are currently not limited, but we must ensure they are the only
+    // other type being handled. This static_assert will trigger a compilation error
+    // if a new StatType is introduced in the future, forcing the developer to
+    // explicitly decide how to handle its limits.
+    static_assert(std::is_same_v<StatType, TextReadout>, "Unexpected StatType");
   }
+  return false;
+}
 
+template <class StatType>
+StatType& ThreadLocalStoreImpl::ScopeImpl::insertTlsCache(StatType& stat,
+                                                           StatRefMap<StatType>* tls_cache) {
   // If we have a TLS cache, insert the stat.
-  StatType& ret = **central_ref;
   if (tls_cache) {
-    tls_cache->insert(std::make_pair(ret.statName(), std::reference_wrapper<StatType>(ret)));
+    tls_cache->insert(std::make_pair(stat.statName(), std::reference_wrapper<StatType>(stat)));
   }
-
-  // Finally we return the reference.
-  return ret;
+  return stat;
 }
 
 Counter& ThreadLocalStoreImpl::ScopeImpl::counterFromStatNameWithTags(
@@ -867,9 +899,14 @@ Histogram& ThreadLocalStoreImpl::tlsHistogram(ParentHistogramImpl& parent, uint6
 
   StatNameTagHelper tag_helper(*this, parent.statName(), absl::nullopt);
 
-  TlsHistogramSharedPtr hist_tls_ptr(
-      new ThreadLocalHistogramImpl(parent.statName(), parent.unit(), tag_helper.tagExtractedName(),
-                                   tag_helper.statNameTags(), symbolTable(), parent.bins()));
+  // Only histograms kept in the TLS cache are ever merged through beginMerge(), so only those
+  // may hold back values.
+  const bool batch_values =
+      tls_histogram != nullptr &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.batch_tls_histogram_values");
+  TlsHistogramSharedPtr hist_tls_ptr(new ThreadLocalHistogramImpl(
+      parent.statName(), parent.unit(), tag_helper.tagExtractedName(), tag_helper.statNameTags(),
+      symbolTable(), parent.bins(), batch_values));
 
   parent.addTlsHistogram(hist_tls_ptr);
 
@@ -884,9 +921,11 @@ ThreadLocalHistogramImpl::ThreadLocalHistogramImpl(StatName name, Histogram::Uni
                                                    StatName tag_extracted_name,
                                                    StatNameTagSpan stat_name_tags,
                                                    SymbolTable& symbol_table,
-                                                   absl::optional<uint32_t> bins)
+                                                   absl::optional<uint32_t> bins,
+                                                   bool batch_values)
     : HistogramImplHelper(name, tag_extracted_name, stat_name_tags, symbol_table), unit_(unit),
-      used_(false), created_thread_id_(std::this_thread::get_id()), symbol_table_(symbol_table) {
+      batch_values_(batch_values), used_(false), created_thread_id_(std::this_thread::get_id()),
+      symbol_table_(symbol_table) {
   histograms_[0] = bins ? hist_alloc_nbins(bins.value()) : hist_alloc();
   histograms_[1] = bins ? hist_alloc_nbins(bins.value()) : hist_alloc();
 }
@@ -899,10 +938,31 @@ ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
 
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
-  hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  if (batch_values_) {
+    pending_values_[num_pending_values_++] = value;
+    if (num_pending_values_ == MaxPendingValues) {
+      flushPendingValues();
+    }
+  } else {
+    hist_insert_intscale(histograms_[current_active_], value, 0, 1);
+  }
   used_ = true;
 }
 
+void ThreadLocalHistogramImpl::flushPendingValues() {
+  if (num_pending_values_ == 0) {
+    return;
+  }
+  const auto end = pending_values_.begin() + num_pending_values_;
+  std::sort(pending_values_.begin(), end);
+  for (auto it = pending_values_.begin(); it != end;) {
+    const auto run_end = std::upper_bound(it, end, *it);
+    hist_insert_intscale(histograms_[current_active_], *it, 0, run_end - it);
+    it = run_end;
+  }
+  num_pending_values_ = 0;
+}
+
 void ThreadLocalHistogramImpl::merge(histogram_t* target) {
   histogram_t** other_histogram = &histograms_[otherHistogramIndex()];
   hist_accumulate(target, other_histogram, 1);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -37,7 +38,7 @@ class ThreadLocalHistogramImpl : public HistogramImplHelper {
 public:
   ThreadLocalHistogramImpl(StatName name, Histogram::Unit unit, StatName tag_extracted_name,
                            StatNameTagSpan stat_name_tags, SymbolTable& symbol_table,
-                           absl::optional<uint32_t> bins);
+                           absl::optional<uint32_t> bins, bool batch_values);
   ~ThreadLocalHistogramImpl() override;
 
   void merge(histogram_t* target);
@@ -47,8 +48,9 @@ public:
    * not have to lock the histogram in high throughput TLS writes.
    */
   void beginMerge() {
-    // This switches the current_active_ between 1 and 0.
     ASSERT(std::this_thread::get_id() == created_thread_id_);
+    flushPendingValues();
+    // This switches the current_active_ between 1 and 0.
     current_active_ = otherHistogramIndex();
   }
 
@@ -67,10 +69,21 @@ public:
   bool hidden() const override { return false; }
 
 private:
+  // Number of recorded values buffered before they are inserted into the active histogram.
+  static constexpr uint32_t MaxPendingValues = 16;
+
+  // Inserts the buffered values into the active histogram. Values are sorted first so that runs of
+  // equal values, which are common for latencies in milliseconds, are inserted in one bucket
+  // lookup.
+  void flushPendingValues();
+
   const Histogram::Unit unit_;
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_{0};
   histogram_t* histograms_[2];
+  const bool batch_values_;
+  uint32_t num_pending_values_{0};
+  std::array<uint64_t, MaxPendingValues> pending_values_;
   std::atomic<bool> used_;
   const std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -166,6 +179,7 @@ public:
   static const char DeleteScopeSync[];
   static const char IterateScopeSync[];
   static const char MainDispatcherCleanupSync[];
+  static const char MakeStatSync[];
 
   ThreadLocalStoreImpl(Allocator& alloc);
   ~ThreadLocalStoreImpl() override;
@@ -423,6 +437,21 @@ private:
                            MakeStatFn<StatType> make_stat, StatRefMap<StatType>* tls_cache,
                            StatNameHashSet* tls_rejected_stats, StatType& null_stat);
 
+    /**
+     * Checks whether the central cache map of a scope reached the configured limit for its stat
+     * type, counting the overflow if so.
+     */
+    template <class StatType>
+    bool centralCacheFullLockHeld(const StatNameHashMap<RefcountPtr<StatType>>& central_cache_map)
+        const ABSL_EXCLUSIVE_LOCKS_REQUIRED(parent_.lock_);
+
+    /**
+     * Adds a stat to the TLS cache of the calling thread, if any.
+     * @return the stat.
+     */
+    template <class StatType>
+    static StatType& insertTlsCache(StatType& stat, StatRefMap<StatType>* tls_cache);
+
     template <class StatType>
     using StatTypeOptConstRef = absl::optional<std::reference_wrapper<const StatType>>;
 
@@ -585,6 +614,9 @@ private:
   std::vector<std::reference_wrapper<Sink>> timer_sinks_;
   TagProducerPtr tag_producer_;
   StatsMatcherPtr stats_matcher_;
+  // Bumped each time stats_matcher_ is replaced, so that stats allocated outside of lock_ can
+  // detect a matcher change and be re-checked before they are published.
+  uint64_t stats_matcher_generation_ ABSL_GUARDED_BY(lock_){0};
   HistogramSettingsConstPtr histogram_settings_;
   std::atomic<bool> threading_ever_initialized_{false};
   std::atomic<bool> shutting_down_{false};
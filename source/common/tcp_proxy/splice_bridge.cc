@@ -0,0 +1,185 @@
+#include "source/common/tcp_proxy/splice_bridge.h"
+
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/utility.h"
+
+#if defined(__linux__)
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace TcpProxy {
+
+#if defined(__linux__)
+
+namespace {
+
+// The most data requested from a single splice call. Pipes hold 64KB by default.
+constexpr size_t MaxSpliceSize = 64 * 1024;
+// The most data a direction moves per event, so that a busy connection does not starve the other
+// connections of the worker.
+constexpr uint64_t MaxBytesPerEvent = 16 * MaxSpliceSize;
+
+} // namespace
+
+SpliceBridgePtr SpliceBridge::create(Event::Dispatcher& dispatcher, Network::IoHandle& downstream,
+                                     Network::IoHandle& upstream, Callbacks& callbacks) {
+  if (!SOCKET_VALID(downstream.fdDoNotUse()) || !SOCKET_VALID(upstream.fdDoNotUse())) {
+    // Not OS sockets, e.g. user space sockets of internal listeners.
+    return nullptr;
+  }
+  SpliceBridgePtr bridge(new SpliceBridge(callbacks));
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  for (Pipe* pipe : {&bridge->downstream_to_upstream_, &bridge->upstream_to_downstream_}) {
+    const Api::SysCallIntResult result =
+        Api::LinuxOsSysCallsSingleton::get().pipe2(pipe->fds_.data(), O_NONBLOCK | O_CLOEXEC);
+    if (result.return_value_ != 0) {
+      ENVOY_LOG(debug, "splice: failed to create a pipe: {}", errorDetails(result.errno_));
+      return nullptr;
+    }
+  }
+  for (auto [socket, duplicate] : {std::make_pair(&downstream, &bridge->downstream_),
+                                   std::make_pair(&upstream, &bridge->upstream_)}) {
+    const Api::SysCallSocketResult result = os_sys_calls.duplicate(socket->fdDoNotUse());
+    if (!SOCKET_VALID(result.return_value_)) {
+      ENVOY_LOG(debug, "splice: failed to duplicate a socket: {}", errorDetails(result.errno_));
+      return nullptr;
+    }
+    *duplicate = result.return_value_;
+  }
+
+  bridge->downstream_to_upstream_.source_ = bridge->downstream_;
+  bridge->downstream_to_upstream_.destination_ = bridge->upstream_;
+  bridge->upstream_to_downstream_.source_ = bridge->upstream_;
+  bridge->upstream_to_downstream_.destination_ = bridge->downstream_;
+
+  // Both sockets are already writable, so the first events pick up any data that arrived before
+  // the bridge was created.
+  SpliceBridge* raw_bridge = bridge.get();
+  const auto on_event = [raw_bridge](uint32_t) {
+    raw_bridge->onSocketEvent();
+    return absl::OkStatus();
+  };
+  bridge->downstream_event_ = dispatcher.createFileEvent(
+      bridge->downstream_, on_event, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+  bridge->upstream_event_ = dispatcher.createFileEvent(
+      bridge->upstream_, on_event, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+  return bridge;
+}
+
+SpliceBridge::~SpliceBridge() {
+  downstream_event_.reset();
+  upstream_event_.reset();
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  for (const os_fd_t fd : {downstream_, upstream_}) {
+    if (SOCKET_VALID(fd)) {
+      os_sys_calls.close(fd);
+    }
+  }
+}
+
+SpliceBridge::Pipe::~Pipe() {
+  for (const int fd : fds_) {
+    if (fd != -1) {
+      Api::OsSysCallsSingleton::get().close(fd);
+    }
+  }
+}
+
+SpliceBridge::PumpResult SpliceBridge::Pipe::pump(uint64_t& bytes_read) {
+  auto& os_sys_calls = Api::LinuxOsSysCallsSingleton::get();
+  const auto would_block = [](int error) {
+    return error == SOCKET_ERROR_AGAIN || error == SOCKET_ERROR_INTR;
+  };
+  uint64_t bytes_moved = 0;
+  bool progress = true;
+  while (progress) {
+    if (bytes_moved >= MaxBytesPerEvent) {
+      return PumpResult::Yield;
+    }
+    progress = false;
+    if (bytes_in_pipe_ > 0) {
+      const Api::SysCallSizeResult result = os_sys_calls.splice(
+          fds_[0], destination_, bytes_in_pipe_, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+      if (result.return_value_ > 0) {
+        bytes_in_pipe_ -= result.return_value_;
+        bytes_moved += result.return_value_;
+        progress = true;
+      } else if (result.return_value_ < 0 && !would_block(result.errno_)) {
+        ENVOY_LOG(debug, "splice: write failed: {}", errorDetails(result.errno_));
+        return PumpResult::Failed;
+      }
+    }
+    if (!end_stream_) {
+      // A full pipe fails with EAGAIN like a source without data. Either way the pipe is drained
+      // again once the destination is writable, which retries the source.
+      const Api::SysCallSizeResult result =
+          os_sys_calls.splice(source_, fds_[1], MaxSpliceSize, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+      if (result.return_value_ > 0) {
+        bytes_in_pipe_ += result.return_value_;
+        bytes_read += result.return_value_;
+        progress = true;
+      } else if (result.return_value_ == 0) {
+        end_stream_ = true;
+      } else if (!would_block(result.errno_)) {
+        ENVOY_LOG(debug, "splice: read failed: {}", errorDetails(result.errno_));
+        return PumpResult::Failed;
+      }
+    }
+  }
+  if (end_stream_ && bytes_in_pipe_ == 0 && !shutdown_) {
+    // Ignore the result. This can only fail if the connection failed, which the next event of the
+    // destination reports.
+    Api::OsSysCallsSingleton::get().shutdown(destination_, ENVOY_SHUT_WR);
+    shutdown_ = true;
+  }
+  return PumpResult::Ok;
+}
+
+void SpliceBridge::onSocketEvent() {
+  uint64_t downstream_bytes = 0;
+  uint64_t upstream_bytes = 0;
+  const PumpResult downstream_result = downstream_to_upstream_.pump(downstream_bytes);
+  const PumpResult upstream_result = upstream_to_downstream_.pump(upstream_bytes);
+  if (downstream_bytes > 0) {
+    callbacks_.onSplicedDownstreamData(downstream_bytes);
+  }
+  if (upstream_bytes > 0) {
+    callbacks_.onSplicedUpstreamData(upstream_bytes);
+  }
+
+  if (downstream_result == PumpResult::Failed || upstream_result == PumpResult::Failed) {
+    callbacks_.onSpliceDone(true);
+    return;
+  }
+  if (downstream_to_upstream_.shutdown_ && upstream_to_downstream_.shutdown_) {
+    callbacks_.onSpliceDone(false);
+    return;
+  }
+  if (downstream_result == PumpResult::Yield || upstream_result == PumpResult::Yield) {
+    // The sockets may not trigger another event, continue in the next iteration of the loop.
+    downstream_event_->activate(Event::FileReadyType::Read);
+  }
+}
+
+#else
+
+// splice(2) is Linux only. No bridge is ever created, so the data is always proxied through the
+// filter.
+SpliceBridgePtr SpliceBridge::create(Event::Dispatcher&, Network::IoHandle&, Network::IoHandle&,
+                                     Callbacks&) {
+  return nullptr;
+}
+
+SpliceBridge::~SpliceBridge() = default;
+
+SpliceBridge::Pipe::~Pipe() = default;
+
+#endif
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/platform.h"
+#include "envoy/common/pure.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/file_event.h"
+#include "envoy/network/io_handle.h"
+
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+/**
+ * Moves the data of a proxied connection between the downstream and the upstream socket inside
+ * the kernel, with splice(2) through one pipe per direction, instead of reading it into and
+ * writing it out of Envoy buffers. Only supported on Linux.
+ *
+ * The bridge watches duplicates of both sockets, so both connections must be read disabled and
+ * have no buffered data while it is active, and it must be destroyed when either connection
+ * closes. A direction only reads from its source while its pipe has room, so at most a pipe's
+ * worth of data is in flight per direction, and a destination that does not keep up pushes back
+ * on its source like a write buffer above its high watermark. Once a source reaches end of stream
+ * and its pipe is drained, the destination is shut down for writing.
+ */
+class SpliceBridge : Logger::Loggable<Logger::Id::filter> {
+public:
+  class Callbacks {
+  public:
+    virtual ~Callbacks() = default;
+
+    /**
+     * Called when data was read from the downstream socket to be written to the upstream socket.
+     * The bridge must not be destroyed from the data callbacks.
+     * @param bytes the number of bytes read.
+     */
+    virtual void onSplicedDownstreamData(uint64_t bytes) PURE;
+
+    /**
+     * Called when data was read from the upstream socket to be written to the downstream socket.
+     * @param bytes the number of bytes read.
+     */
+    virtual void onSplicedUpstreamData(uint64_t bytes) PURE;
+
+    /**
+     * Called once both directions reached end of stream, or when reading from or writing to a
+     * socket failed. The bridge does nothing after this call, and may be destroyed from it.
+     * @param failed whether a socket failed.
+     */
+    virtual void onSpliceDone(bool failed) PURE;
+  };
+
+  /**
+   * @param dispatcher the dispatcher of the connections.
+   * @param downstream the socket of the downstream connection.
+   * @param upstream the socket of the upstream connection.
+   * @param callbacks the callbacks to notify of data and of the end of the connection.
+   * @return the bridge, or nullptr if splice is not supported or the bridge could not be set up.
+   */
+  static std::unique_ptr<SpliceBridge> create(Event::Dispatcher& dispatcher,
+                                              Network::IoHandle& downstream,
+                                              Network::IoHandle& upstream, Callbacks& callbacks);
+
+  ~SpliceBridge();
+
+private:
+  // Yield means that the direction moved its share of data for this event and has more to move.
+  enum class PumpResult { Ok, Yield, Failed };
+
+  // One direction of the connection.
+  struct Pipe {
+    ~Pipe();
+
+    /**
+     * Moves as much data as possible from the source through the pipe to the destination.
+     * @param bytes_read incremented by the number of bytes read from the source.
+     */
+    PumpResult pump(uint64_t& bytes_read);
+
+    // The sockets are owned by the bridge.
+    os_fd_t source_{INVALID_SOCKET};
+    os_fd_t destination_{INVALID_SOCKET};
+    // The read and write ends of the pipe.
+    std::array<int, 2> fds_{-1, -1};
+    uint64_t bytes_in_pipe_{};
+    bool end_stream_{};
+    bool shutdown_{};
+  };
+
+  SpliceBridge(Callbacks& callbacks) : callbacks_(callbacks) {}
+
+  void onSocketEvent();
+
+  Callbacks& callbacks_;
+  // Duplicates of the sockets of the connections, so that the bridge can watch them without
+  // interfering with the file events of the connections.
+  os_fd_t downstream_{INVALID_SOCKET};
+  os_fd_t upstream_{INVALID_SOCKET};
+  Event::FileEventPtr downstream_event_;
+  Event::FileEventPtr upstream_event_;
+  Pipe downstream_to_upstream_;
+  Pipe upstream_to_downstream_;
+};
+
+using SpliceBridgePtr = std::unique_ptr<SpliceBridge>;
+
+} // namespace TcpProxy
+} // namespace Envoy
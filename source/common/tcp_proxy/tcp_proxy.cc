@@ -226,7 +226,8 @@ Config::Config(const envoy::extensions::filters::network::tcp_proxy::v3::TcpProx
                                  envoy::config::core::v3::TrafficDirection::INBOUND
                              ? Network::DrainDirection::InboundOnly
                              : Network::DrainDirection::All),
-      check_drain_close_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, check_drain_close, false)) {
+      check_drain_close_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, check_drain_close, false)),
+      splice_data_(config.splice_data()) {
   upstream_drain_manager_slot_->set([](Event::Dispatcher&) {
     ThreadLocal::ThreadLocalObjectSharedPtr drain_manager =
         std::make_shared<UpstreamDrainManager>();
@@ -1228,6 +1229,7 @@ void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
   if (event == Network::ConnectionEvent::LocalClose ||
       event == Network::ConnectionEvent::RemoteClose) {
     downstream_closed_ = true;
+    splice_bridge_.reset();
     // Cancel the potential odcds callback.
     cluster_discovery_handle_ = nullptr;
   }
@@ -1296,6 +1298,7 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
+    splice_bridge_.reset();
     // Propagate the upstream local close reason to the downstream stream info's upstreamInfo.
     if (upstream_) {
       getStreamInfo().upstreamInfo()->setUpstreamLocalCloseReason(upstream_->localCloseReason());
@@ -1382,7 +1385,10 @@ void Filter::onUpstreamConnection() {
   // 1. Buffer overflow when receive_before_connect is enabled (tracked by
   // read_disabled_due_to_buffer_)
   // 2. In establishUpstreamConnection() when receive_before_connect is disabled
-  if (read_disabled_due_to_buffer_) {
+  // If the data is spliced, both connections stay read disabled and the splice bridge moves it.
+  if (maybeStartSplice()) {
+    config_->stats().downstream_cx_spliced_.inc();
+  } else if (read_disabled_due_to_buffer_) {
     read_callbacks_->connection().readDisable(false);
     read_disabled_due_to_buffer_ = false;
   } else if (!receive_before_connect_) {
@@ -1417,6 +1423,65 @@ void Filter::onUpstreamConnection() {
   }
 }
 
+bool Filter::maybeStartSplice() {
+  // Reads must still be disabled, with no data buffered, and the data must not need to be seen by
+  // the filter. The drain close checks are driven by the data passing through the filter. Spliced
+  // data bypasses the other filters of the downstream connection, so there must be none.
+  if (!config_->spliceData() || receive_before_connect_ || config_->checkDrainClose() ||
+      !read_callbacks_->isOnlyFilter()) {
+    return false;
+  }
+  // Spliced data also bypasses the transport sockets of both connections, so they must pass the
+  // data through unmodified.
+  OptRef<Network::Connection> upstream_connection = upstream_->rawConnection();
+  Network::Connection& downstream_connection = read_callbacks_->connection();
+  if (!upstream_connection.has_value() || !downstream_connection.canSpliceData() ||
+      !upstream_connection->canSpliceData()) {
+    return false;
+  }
+  splice_bridge_ = SpliceBridge::create(
+      downstream_connection.dispatcher(), downstream_connection.getSocket()->ioHandle(),
+      upstream_connection->getSocket()->ioHandle(), *this);
+  if (splice_bridge_ == nullptr) {
+    return false;
+  }
+  ENVOY_CONN_LOG(debug, "splicing data to the upstream connection", downstream_connection);
+  upstream_->readDisable(true);
+  return true;
+}
+
+// Spliced data is accounted for as if it passed through both connections and their filters. The
+// stats of the downstream connection are set in initialize(), and the stats of the upstream
+// connection are the traffic stats of its cluster.
+void Filter::onSplicedDownstreamData(uint64_t bytes) {
+  config_->stats().downstream_cx_rx_bytes_total_.add(bytes);
+  getStreamInfo().addBytesReceived(bytes);
+  getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(bytes);
+  read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_tx_bytes_total_.add(bytes);
+  upstream_->rawConnection()->streamInfo().addBytesSent(bytes);
+  getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(bytes);
+  resetIdleTimer();
+}
+
+void Filter::onSplicedUpstreamData(uint64_t bytes) {
+  read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_rx_bytes_total_.add(bytes);
+  upstream_->rawConnection()->streamInfo().addBytesReceived(bytes);
+  getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes);
+  config_->stats().downstream_cx_tx_bytes_total_.add(bytes);
+  getStreamInfo().addBytesSent(bytes);
+  getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes);
+  resetIdleTimer();
+}
+
+void Filter::onSpliceDone(bool failed) {
+  ENVOY_CONN_LOG(debug, "splicing {}", read_callbacks_->connection(),
+                 failed ? "failed" : "reached end of stream in both directions");
+  splice_bridge_.reset();
+  // Both directions were shut down or failed, so there is nothing left to flush. This also closes
+  // the upstream connection.
+  read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
@@ -34,6 +34,7 @@
 #include "source/common/network/hash_policy.h"
 #include "source/common/network/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
+#include "source/common/tcp_proxy/splice_bridge.h"
 #include "source/common/tcp_proxy/upstream.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/od_cds_api_impl.h"
@@ -62,6 +63,7 @@ constexpr absl::string_view ReceiveBeforeConnectKey = "envoy.tcp_proxy.receive_b
   COUNTER(downstream_cx_drain_close)                                                               \
   COUNTER(downstream_cx_no_route)                                                                  \
   COUNTER(downstream_cx_rx_bytes_total)                                                            \
+  COUNTER(downstream_cx_spliced)                                                                   \
   COUNTER(downstream_cx_total)                                                                     \
   COUNTER(downstream_cx_tx_bytes_total)                                                            \
   COUNTER(downstream_flow_control_paused_reading_total)                                            \
@@ -380,6 +382,7 @@ public:
 
   const absl::optional<uint32_t>& maxEarlyDataBytes() const { return max_early_data_bytes_; }
   bool checkDrainClose() const { return check_drain_close_; }
+  bool spliceData() const { return splice_data_; }
   const Network::DrainDecision& drainDecision() const { return drain_decision_; }
   Network::DrainDirection drainCloseScope() const { return drain_close_scope_; }
 
@@ -441,6 +444,7 @@ private:
   const Network::DrainDecision& drain_decision_;
   const Network::DrainDirection drain_close_scope_{};
   const bool check_drain_close_{false};
+  const bool splice_data_{false};
 };
 
 using ConfigSharedPtr = std::shared_ptr<Config>;
@@ -467,7 +471,8 @@ private:
 class Filter : public Network::ReadFilter,
                public Upstream::LoadBalancerContextBase,
                protected Logger::Loggable<Logger::Id::filter>,
-               public GenericConnectionPoolCallbacks {
+               public GenericConnectionPoolCallbacks,
+               public SpliceBridge::Callbacks {
 public:
   Filter(ConfigSharedPtr config, Upstream::ClusterManager& cluster_manager);
   ~Filter() override;
@@ -487,6 +492,11 @@ public:
                             absl::string_view failure_reason,
                             Upstream::HostDescriptionConstSharedPtr host) override;
 
+  // SpliceBridge::Callbacks
+  void onSplicedDownstreamData(uint64_t bytes) override;
+  void onSplicedUpstreamData(uint64_t bytes) override;
+  void onSpliceDone(bool failed) override;
+
   // Upstream::LoadBalancerContext
   const Router::MetadataMatchCriteria* metadataMatchCriteria() override;
   absl::optional<uint64_t> computeHashKey() override {
@@ -700,6 +710,7 @@ protected:
   void onUpstreamEvent(Network::ConnectionEvent event);
   void maybeCloseDownstreamForDrainClose();
   void onUpstreamConnection();
+  bool maybeStartSplice();
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
@@ -739,6 +750,9 @@ protected:
   // This will be non-null from when an upstream connection is attempted until
   // it either succeeds or fails.
   std::unique_ptr<GenericConnPool> generic_conn_pool_;
+  // Moves the data between the connections in the kernel once the upstream is connected, if
+  // enabled. Reset when either connection closes.
+  SpliceBridgePtr splice_bridge_;
   // Time the filter first attempted to connect to the upstream after the
   // cluster is discovered. Capture the first time as the filter may try multiple times to connect
   // to the upstream.
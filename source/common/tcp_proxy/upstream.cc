@@ -113,6 +113,13 @@ absl::string_view TcpUpstream::localCloseReason() const {
   return "";
 }
 
+OptRef<Network::Connection> TcpUpstream::rawConnection() {
+  if (upstream_conn_data_ != nullptr) {
+    return upstream_conn_data_->connection();
+  }
+  return {};
+}
+
 StreamInfo::DetectedCloseType TcpUpstream::detectedCloseType() const {
   if (upstream_conn_data_ != nullptr &&
       upstream_conn_data_->connection().streamInfo().upstreamInfo()) {
@@ -131,6 +131,12 @@ ServerContextImpl::ServerContextImpl(
         });
   }
 
+  if (factory_context.options().tlsSessionCacheSizeKB() > 0 &&
+      !config.disableStatefulSessionResumption() &&
+      !config.capabilities().handles_session_resumption) {
+    session_cache_ = SessionCacheImpl::get(factory_context);
+  }
+
   // Compute the session context ID hash. We use all the certificate identities,
   // since we should have a common ID for session resumption no matter what cert
   // is used. We do this early because it can fail.
@@ -186,6 +192,26 @@ ServerContextImpl::ServerContextImpl(
 
     if (config.disableStatefulSessionResumption()) {
       SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(), SSL_SESS_CACHE_OFF);
+    } else if (session_cache_ != nullptr) {
+      // Keep sessions in the shared cache instead of the internal cache of the SSL_CTX, so that
+      // they can be resumed on any context with the same session ID context, including the
+      // contexts that replace this one.
+      SSL_CTX_set_session_cache_mode(ctx.ssl_ctx_.get(),
+                                     SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL);
+      SSL_CTX_sess_set_new_cb(ctx.ssl_ctx_.get(), [](SSL* ssl, SSL_SESSION* session) -> int {
+        static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+            ->storeSession(session);
+        // The session is serialized, so no reference to it is kept.
+        return 0;
+      });
+      SSL_CTX_sess_set_get_cb(
+          ctx.ssl_ctx_.get(),
+          [](SSL* ssl, const uint8_t* id, int id_len, int* out_copy) -> SSL_SESSION* {
+            // The caller takes the reference of the deserialized session.
+            *out_copy = 0;
+            return static_cast<ServerContextImpl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)))
+                ->lookupSession(ssl, id, id_len);
+          });
     }
 
     if (config.sessionTimeout() && !config.capabilities().handles_session_resumption) {
@@ -335,6 +361,38 @@ ServerContextImpl::generateHashForSessionContextId(const std::vector<std::string
   return session_id;
 }
 
+void ServerContextImpl::storeSession(SSL_SESSION* session) {
+  unsigned id_length = 0;
+  const uint8_t* id = SSL_SESSION_get_id(session, &id_length);
+  // Sessions that are only resumed with tickets have no ID.
+  if (id_length == 0) {
+    return;
+  }
+  uint8_t* data = nullptr;
+  size_t data_length = 0;
+  if (!SSL_SESSION_to_bytes(session, &data, &data_length)) {
+    return;
+  }
+  bssl::UniquePtr<uint8_t> data_ptr(data);
+  session_cache_->insert(
+      absl::string_view(reinterpret_cast<const char*>(id), id_length),
+      absl::string_view(reinterpret_cast<const char*>(data), data_length),
+      SystemTime(std::chrono::seconds(SSL_SESSION_get_time(session) +
+                                      SSL_SESSION_get_timeout(session))));
+}
+
+SSL_SESSION* ServerContextImpl::lookupSession(SSL* ssl, const uint8_t* id, int id_len) {
+  const absl::optional<std::string> data =
+      session_cache_->lookup(absl::string_view(reinterpret_cast<const char*>(id), id_len));
+  if (!data.has_value()) {
+    return nullptr;
+  }
+  // BoringSSL checks that the session matches the session ID context of this context before
+  // resuming it.
+  return SSL_SESSION_from_bytes(reinterpret_cast<const uint8_t*>(data->data()), data->size(),
+                                SSL_get_SSL_CTX(ssl));
+}
+
 int ServerContextImpl::sessionTicketProcess(SSL*, uint8_t* key_name, uint8_t* iv,
                                             EVP_CIPHER_CTX* ctx, HMAC_CTX* hmac_ctx, int encrypt) {
   const EVP_MD* hmac = EVP_sha256();
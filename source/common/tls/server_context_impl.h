@@ -25,6 +25,7 @@
 #include "source/common/tls/context_manager_impl.h"
 #include "source/common/tls/default_tls_certificate_selector.h"
 #include "source/common/tls/ocsp/ocsp.h"
+#include "source/common/tls/session_cache_impl.h"
 #include "source/common/tls/stats.h"
 
 #include "absl/synchronization/mutex.h"
@@ -74,6 +75,10 @@ public:
                            HMAC_CTX* hmac_ctx, int encrypt);
   bool hasSessionTicketKeys() const { return !session_ticket_keys_.empty(); }
 
+  // Store and look up the sessions of the shared session cache, if enabled.
+  void storeSession(SSL_SESSION* session);
+  SSL_SESSION* lookupSession(SSL* ssl, const uint8_t* id, int id_len);
+
 protected:
   ServerContextImpl(
       Stats::Scope& scope, const Envoy::Ssl::ServerContextConfig& config,
@@ -92,6 +97,7 @@ private:
 
   Ssl::TlsCertificateSelectorPtr tls_certificate_selector_;
   const std::vector<Envoy::Ssl::ServerContextConfig::SessionTicketKey> session_ticket_keys_;
+  SessionCacheImplSharedPtr session_cache_;
 
 protected:
   const Ssl::ServerContextConfig::OcspStaplePolicy ocsp_staple_policy_;
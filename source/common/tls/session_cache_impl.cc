@@ -0,0 +1,106 @@
+#include "source/common/tls/session_cache_impl.h"
+
+#include "source/common/common/hash.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+SINGLETON_MANAGER_REGISTRATION(tls_session_cache);
+
+SessionCacheImpl::SessionCacheImpl(uint64_t max_size_bytes, TimeSource& time_source,
+                                   Stats::Scope& scope)
+    : max_shard_size_bytes_(max_size_bytes / NumShards), time_source_(time_source),
+      stats_{ALL_TLS_SESSION_CACHE_STATS(POOL_COUNTER_PREFIX(scope, "tls_session_cache."),
+                                         POOL_GAUGE_PREFIX(scope, "tls_session_cache."))} {}
+
+SessionCacheImplSharedPtr
+SessionCacheImpl::get(Server::Configuration::CommonFactoryContext& context) {
+  // Pinned, so that sessions outlive the server contexts that created them.
+  return context.singletonManager().getTyped<SessionCacheImpl>(
+      SINGLETON_MANAGER_REGISTERED_NAME(tls_session_cache),
+      [&context] {
+        return std::make_shared<SessionCacheImpl>(context.options().tlsSessionCacheSizeKB() * 1024,
+                                                  context.timeSource(), context.serverScope());
+      },
+      true);
+}
+
+SessionCacheImplSharedPtr SessionCacheImpl::getIfExists(Singleton::Manager& singleton_manager) {
+  return singleton_manager.getTyped<SessionCacheImpl>(
+      SINGLETON_MANAGER_REGISTERED_NAME(tls_session_cache));
+}
+
+void SessionCacheImpl::insert(absl::string_view id, absl::string_view session,
+                              SystemTime expire_time) {
+  const uint64_t entry_size_bytes = sizeBytes(id, session);
+  if (entry_size_bytes > max_shard_size_bytes_) {
+    return;
+  }
+
+  Shard& shard = shardFor(id);
+  absl::MutexLock lock(shard.mutex_);
+  if (auto it = shard.index_.find(id); it != shard.index_.end()) {
+    erase(shard, it->second);
+  }
+  while (shard.size_bytes_ + entry_size_bytes > max_shard_size_bytes_) {
+    erase(shard, std::prev(shard.entries_.end()));
+    stats_.evicted_.inc();
+  }
+
+  shard.entries_.push_front(Entry{std::string(id), std::string(session), expire_time});
+  shard.index_.emplace(shard.entries_.front().id_, shard.entries_.begin());
+  shard.size_bytes_ += entry_size_bytes;
+  stats_.sessions_.inc();
+  stats_.size_bytes_.add(entry_size_bytes);
+}
+
+absl::optional<std::string> SessionCacheImpl::lookup(absl::string_view id) {
+  Shard& shard = shardFor(id);
+  absl::MutexLock lock(shard.mutex_);
+  auto it = shard.index_.find(id);
+  if (it == shard.index_.end()) {
+    stats_.miss_.inc();
+    return absl::nullopt;
+  }
+  if (it->second->expire_time_ <= time_source_.systemTime()) {
+    erase(shard, it->second);
+    stats_.miss_.inc();
+    return absl::nullopt;
+  }
+
+  shard.entries_.splice(shard.entries_.begin(), shard.entries_, it->second);
+  stats_.hit_.inc();
+  return it->second->session_;
+}
+
+void SessionCacheImpl::iterate(const SessionCb& cb) const {
+  const SystemTime now = time_source_.systemTime();
+  for (const Shard& shard : shards_) {
+    absl::MutexLock lock(shard.mutex_);
+    for (auto it = shard.entries_.rbegin(); it != shard.entries_.rend(); ++it) {
+      if (it->expire_time_ > now) {
+        cb(it->id_, it->session_, it->expire_time_);
+      }
+    }
+  }
+}
+
+SessionCacheImpl::Shard& SessionCacheImpl::shardFor(absl::string_view id) {
+  return shards_[HashUtil::xxHash64(id) % NumShards];
+}
+
+void SessionCacheImpl::erase(Shard& shard, std::list<Entry>::iterator it) {
+  const uint64_t entry_size_bytes = sizeBytes(it->id_, it->session_);
+  shard.index_.erase(it->id_);
+  shard.entries_.erase(it);
+  shard.size_bytes_ -= entry_size_bytes;
+  stats_.sessions_.dec();
+  stats_.size_bytes_.sub(entry_size_bytes);
+}
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/common/time.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+
+/**
+ * All TLS session cache stats. @see stats_macros.h
+ */
+#define ALL_TLS_SESSION_CACHE_STATS(COUNTER, GAUGE)                                                \
+  COUNTER(evicted)                                                                                 \
+  COUNTER(hit)                                                                                     \
+  COUNTER(miss)                                                                                    \
+  GAUGE(sessions, NeverImport)                                                                     \
+  GAUGE(size_bytes, NeverImport)
+
+/**
+ * Struct definition for all TLS session cache stats. @see stats_macros.h
+ */
+struct TlsSessionCacheStats {
+  ALL_TLS_SESSION_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * A cache of serialized TLS sessions, keyed by session ID, that is shared by the server contexts
+ * of all listeners and outlives them. The cache is split into shards by session ID so that workers
+ * rarely contend on a lock, and each shard evicts its least recently used sessions to stay within
+ * its share of the size of the cache.
+ */
+class SessionCacheImpl : public Singleton::Instance {
+public:
+  static constexpr uint32_t NumShards = 16;
+
+  SessionCacheImpl(uint64_t max_size_bytes, TimeSource& time_source, Stats::Scope& scope);
+
+  /**
+   * @return the cache of the server, created with the size of --tls-session-cache-size-kb.
+   */
+  static std::shared_ptr<SessionCacheImpl>
+  get(Server::Configuration::CommonFactoryContext& context);
+
+  /**
+   * @return the cache of the server, or nullptr if no server context has created it.
+   */
+  static std::shared_ptr<SessionCacheImpl> getIfExists(Singleton::Manager& singleton_manager);
+
+  /**
+   * Insert a session, replacing any session with the same ID. A session larger than a shard is not
+   * inserted.
+   * @param id supplies the session ID.
+   * @param session supplies the serialized session.
+   * @param expire_time supplies the time after which the session may no longer be resumed.
+   */
+  void insert(absl::string_view id, absl::string_view session, SystemTime expire_time);
+
+  /**
+   * @return the serialized session with the given ID, unless it is absent or expired.
+   */
+  absl::optional<std::string> lookup(absl::string_view id);
+
+  using SessionCb =
+      std::function<void(absl::string_view id, absl::string_view session, SystemTime expire_time)>;
+
+  /**
+   * Call the callback for each unexpired session, from the least to the most recently used in each
+   * shard, so that inserting them in the same order preserves which ones are evicted first.
+   */
+  void iterate(const SessionCb& cb) const;
+
+  /**
+   * @return the size that a session takes up in the cache.
+   */
+  static uint64_t sizeBytes(absl::string_view id, absl::string_view session) {
+    return sizeof(Entry) + id.size() + session.size();
+  }
+
+  const TlsSessionCacheStats& stats() const { return stats_; }
+
+private:
+  struct Entry {
+    std::string id_;
+    std::string session_;
+    SystemTime expire_time_;
+  };
+
+  struct Shard {
+    mutable absl::Mutex mutex_;
+    // The most recently used sessions are at the front.
+    std::list<Entry> entries_ ABSL_GUARDED_BY(mutex_);
+    // Keyed by views of the IDs of the entries.
+    absl::flat_hash_map<absl::string_view, std::list<Entry>::iterator>
+        index_ ABSL_GUARDED_BY(mutex_);
+    uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){};
+  };
+
+  Shard& shardFor(absl::string_view id);
+  void erase(Shard& shard, std::list<Entry>::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+
+  const uint64_t max_shard_size_bytes_;
+  TimeSource& time_source_;
+  TlsSessionCacheStats stats_;
+  std::array<Shard, NumShards> shards_;
+};
+
+using SessionCacheImplSharedPtr = std::shared_ptr<SessionCacheImpl>;
+
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -1,5 +1,7 @@
 #include "source/common/upstream/cds_api_helper.h"
 
+#include <atomic>
+
 #include "envoy/common/exception.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/config/endpoint/v3/endpoint.pb.h"
@@ -7,12 +9,51 @@
 
 #include "source/common/common/fmt.h"
 #include "source/common/config/resource_name.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/flat_hash_set.h"
 
 namespace Envoy {
 namespace Upstream {
+namespace {
+
+// Updates with fewer clusters are hashed on the main thread only, as starting threads would cost
+// more than it saves.
+constexpr size_t MinClustersPerHashThread = 256;
+constexpr uint32_t MaxHashThreads = 8;
+// The number of clusters a hashing thread claims at a time.
+constexpr size_t HashBatchSize = 64;
+
+} // namespace
+
+std::vector<uint64_t>
+CdsApiHelper::hashClusters(const std::vector<const envoy::config::cluster::v3::Cluster*>& clusters,
+                           Thread::ThreadFactory& thread_factory, uint32_t max_threads) {
+  std::vector<uint64_t> hashes(clusters.size());
+  std::atomic<size_t> next_batch{0};
+  const auto hash_batches = [&clusters, &hashes, &next_batch]() {
+    for (size_t begin = next_batch.fetch_add(HashBatchSize); begin < clusters.size();
+         begin = next_batch.fetch_add(HashBatchSize)) {
+      const size_t end = std::min(begin + HashBatchSize, clusters.size());
+      for (size_t i = begin; i < end; ++i) {
+        hashes[i] = MessageUtil::hash(*clusters[i]);
+      }
+    }
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(max_threads, clusters.size() / MinClustersPerHashThread);
+  std::vector<Thread::ThreadPtr> threads;
+  for (size_t i = 1; i < thread_count; ++i) {
+    threads.push_back(thread_factory.createThread(hash_batches, Thread::Options{"cds_hash"}));
+  }
+  hash_batches();
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  return hashes;
+}
 
 std::pair<uint32_t, std::vector<std::string>>
 CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& added_resources,
@@ -30,12 +71,26 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
       "{}: response indicates {} added/updated cluster(s), {} removed cluster(s); applying changes",
       name_, added_resources.size(), removed_resources.size());
 
+  // Hashing the configurations is the only part of applying clusters that does not need the main
+  // thread, and it is most of the work of updates that leave most clusters unchanged.
+  std::vector<uint64_t> config_hashes;
+  if (thread_factory_ != nullptr && added_resources.size() >= 2 * MinClustersPerHashThread) {
+    std::vector<const envoy::config::cluster::v3::Cluster*> clusters;
+    clusters.reserve(added_resources.size());
+    for (const auto& resource : added_resources) {
+      clusters.push_back(
+          &dynamic_cast<const envoy::config::cluster::v3::Cluster&>(resource.get().resource()));
+    }
+    config_hashes = hashClusters(clusters, *thread_factory_, MaxHashThreads);
+  }
+
   std::vector<std::string> exception_msgs;
   absl::flat_hash_set<std::string> cluster_names(added_resources.size());
   bool any_applied = false;
   uint32_t added_or_updated = 0;
   uint32_t skipped = 0;
-  for (const auto& resource : added_resources) {
+  for (size_t i = 0; i < added_resources.size(); ++i) {
+    const auto& resource = added_resources[i];
     // Holds a reference to the name of the currently parsed cluster resource.
     // This is needed for the CATCH clause below.
     absl::string_view cluster_name = EMPTY_STRING;
@@ -49,7 +104,9 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
             fmt::format("{}: duplicate cluster {} found", cluster_name, cluster_name));
         continue;
       }
-      auto update_or_error = cm_.addOrUpdateCluster(cluster, resource.get().version());
+      auto update_or_error = cm_.addOrUpdateCluster(
+          cluster, resource.get().version(), /*avoid_cds_removal=*/false,
+          config_hashes.empty() ? absl::nullopt : absl::make_optional(config_hashes[i]));
       if (!update_or_error.status().ok()) {
         exception_msgs.push_back(
             fmt::format("{}: {}", cluster_name, update_or_error.status().message()));
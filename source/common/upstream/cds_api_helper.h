@@ -3,8 +3,10 @@
 #include <string>
 #include <vector>
 
+#include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/config/subscription.h"
 #include "envoy/config/xds_manager.h"
+#include "envoy/thread/thread.h"
 #include "envoy/upstream/cluster_manager.h"
 
 #include "source/common/common/logger.h"
@@ -19,8 +21,14 @@ namespace Upstream {
  */
 class CdsApiHelper : Logger::Loggable<Logger::Id::upstream> {
 public:
-  CdsApiHelper(ClusterManager& cm, Config::XdsManager& xds_manager, std::string name)
-      : cm_(cm), xds_manager_(xds_manager), name_(std::move(name)) {}
+  /**
+   * @param thread_factory if set, large updates hash the configurations of their clusters on
+   *        additional threads before applying them.
+   */
+  CdsApiHelper(ClusterManager& cm, Config::XdsManager& xds_manager, std::string name,
+               Thread::ThreadFactory* thread_factory = nullptr)
+      : cm_(cm), xds_manager_(xds_manager), name_(std::move(name)),
+        thread_factory_(thread_factory) {}
   /**
    * onConfigUpdate handles the addition and removal of clusters by notifying the ClusterManager
    * about the cluster changes. It closely follows the onConfigUpdate API from
@@ -38,10 +46,23 @@ public:
                  const std::string& system_version_info);
   const std::string versionInfo() const { return system_version_info_; }
 
+  /**
+   * Computes the configuration hashes of clusters, as MessageUtil::hash() does, on the calling
+   * thread and on up to `max_threads - 1` additional threads.
+   * @param clusters the clusters to hash.
+   * @param thread_factory the factory of the additional threads.
+   * @param max_threads the maximum number of threads to hash on, including the calling thread.
+   * @return the hashes, in the order of the clusters.
+   */
+  static std::vector<uint64_t>
+  hashClusters(const std::vector<const envoy::config::cluster::v3::Cluster*>& clusters,
+               Thread::ThreadFactory& thread_factory, uint32_t max_threads);
+
 private:
   ClusterManager& cm_;
   Config::XdsManager& xds_manager_;
   const std::string name_;
+  Thread::ThreadFactory* const thread_factory_;
   std::string system_version_info_;
 };
 
@@ -0,0 +1,44 @@
+#include "source/common/upstream/cluster_config_pool.h"
+
+#include "envoy/singleton/manager.h"
+
+namespace Envoy {
+namespace Upstream {
+
+SINGLETON_MANAGER_REGISTRATION(cluster_config_pool);
+
+ClusterConfigPool::ClusterConfigPool(Stats::Scope& scope)
+    : stats_{ALL_CLUSTER_CONFIG_POOL_STATS(
+          POOL_COUNTER_PREFIX(scope, "cluster_manager.config_pool."))} {}
+
+ClusterConfigPoolSharedPtr
+ClusterConfigPool::get(Server::Configuration::ServerFactoryContext& context) {
+  // Pinned, as clusters only use the pool while they are created.
+  return context.singletonManager().getTyped<ClusterConfigPool>(
+      SINGLETON_MANAGER_REGISTERED_NAME(cluster_config_pool),
+      [&context] { return std::make_shared<ClusterConfigPool>(context.serverScope()); }, true);
+}
+
+void ClusterConfigPool::onLookup(ObjectType type, bool hit) {
+  switch (type) {
+  case ObjectType::Metadata:
+    (hit ? stats_.metadata_dedup_hit_ : stats_.metadata_dedup_miss_).inc();
+    return;
+  case ObjectType::ProtocolOptions:
+    (hit ? stats_.protocol_options_dedup_hit_ : stats_.protocol_options_dedup_miss_).inc();
+    return;
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+}
+
+void ClusterConfigPool::maybeRemoveExpiredObjects() {
+  // Amortize the removal of the objects of removed clusters over the insertions.
+  if (objects_.size() < 2 * objects_after_removal_ + 16) {
+    return;
+  }
+  absl::erase_if(objects_, [](const auto& object) { return object.second.expired(); });
+  objects_after_removal_ = objects_.size();
+}
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "envoy/server/factory_context.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/statusor.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * All cluster config pool stats. @see stats_macros.h
+ */
+#define ALL_CLUSTER_CONFIG_POOL_STATS(COUNTER)                                                     \
+  COUNTER(metadata_dedup_hit)                                                                      \
+  COUNTER(metadata_dedup_miss)                                                                     \
+  COUNTER(protocol_options_dedup_hit)                                                              \
+  COUNTER(protocol_options_dedup_miss)
+
+/**
+ * Struct definition for all cluster config pool stats. @see stats_macros.h
+ */
+struct ClusterConfigPoolStats {
+  ALL_CLUSTER_CONFIG_POOL_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Interns the immutable objects that clusters build from their config, so that the clusters with
+ * identical configs share one instance of them instead of building their own. An object is
+ * interned for as long as a cluster holds it. Must only be used from the main thread, the objects
+ * may be released from any thread.
+ */
+class ClusterConfigPool : public Singleton::Instance {
+public:
+  enum class ObjectType { Metadata, ProtocolOptions };
+
+  explicit ClusterConfigPool(Stats::Scope& scope);
+
+  /**
+   * @return the pool of the server, created on first use.
+   */
+  static std::shared_ptr<ClusterConfigPool>
+  get(Server::Configuration::ServerFactoryContext& context);
+
+  /**
+   * @param type the type of the object, which determines its stats. Keys of different types never
+   *        collide.
+   * @param key a key of the content of the config the object is built from.
+   * @param create_cb builds the object, if no live object is interned with the key.
+   * @param matches_cb if set, whether an interned object matches the config, for keys that are
+   *        hashes of the config.
+   * @return the object interned with the key, or else the object built by create_cb, which is
+   *         interned with the key unless it is nullptr.
+   */
+  template <class T>
+  absl::StatusOr<std::shared_ptr<const T>>
+  getOrCreate(ObjectType type, absl::string_view key,
+              const std::function<absl::StatusOr<std::shared_ptr<const T>>()>& create_cb,
+              const std::function<bool(const T&)>& matches_cb = nullptr) {
+    const std::string object_key = absl::StrCat(static_cast<int>(type), "|", key);
+    auto it = objects_.find(object_key);
+    if (it != objects_.end()) {
+      std::shared_ptr<const T> object = std::static_pointer_cast<const T>(it->second.lock());
+      if (object != nullptr && (matches_cb == nullptr || matches_cb(*object))) {
+        onLookup(type, true);
+        return object;
+      }
+    }
+
+    onLookup(type, false);
+    absl::StatusOr<std::shared_ptr<const T>> object_or_error = create_cb();
+    RETURN_IF_NOT_OK_REF(object_or_error.status());
+    if (object_or_error.value() != nullptr) {
+      objects_[object_key] = object_or_error.value();
+      maybeRemoveExpiredObjects();
+    }
+    return object_or_error;
+  }
+
+  const ClusterConfigPoolStats& stats() const { return stats_; }
+
+private:
+  void onLookup(ObjectType type, bool hit);
+  void maybeRemoveExpiredObjects();
+
+  ClusterConfigPoolStats stats_;
+  absl::flat_hash_map<std::string, std::weak_ptr<const void>> objects_;
+  // The number of objects after expired objects were last removed.
+  size_t objects_after_removal_{};
+};
+
+using ClusterConfigPoolSharedPtr = std::shared_ptr<ClusterConfigPool>;
+
+} // namespace Upstream
+} // namespace Envoy
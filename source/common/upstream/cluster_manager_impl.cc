@@ -28,6 +28,7 @@
 #include "source/common/config/null_grpc_mux_impl.h"
 #include "source/common/config/utility.h"
 #include "source/common/config/xds_resource.h"
+#include "source/common/event/worker_name.h"
 #include "source/common/grpc/async_client_manager_impl.h"
 #include "source/common/http/async_client_impl.h"
 #include "source/common/http/http1/conn_pool.h"
@@ -331,7 +332,7 @@ ClusterManagerImpl::ClusterManagerImpl(const envoy::config::bootstrap::v3::Boots
           std::make_shared<SharedPool::ObjectSharedPool<
               const envoy::config::cluster::v3::Cluster::CommonLbConfig, MessageUtil, MessageUtil>>(
               dispatcher_)),
-      shutdown_(false) {
+      shutdown_(false), worker_count_(context.options().concurrency()) {
   if (auto admin = context.admin(); admin.has_value()) {
     config_tracker_entry_ = admin->getConfigTracker().add(
         "clusters", [this](const Matchers::StringMatcher& name_matcher) {
@@ -726,7 +727,8 @@ void ClusterManagerImpl::applyUpdates(ClusterManagerCluster& cluster, uint32_t p
 absl::StatusOr<bool>
 ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
                                        const std::string& version_info,
-                                       const bool avoid_cds_removal) {
+                                       const bool avoid_cds_removal,
+                                       absl::optional<uint64_t> config_hash) {
   // First we need to see if this new config is new or an update to an existing dynamic cluster.
   // We don't allow updates to statically configured clusters in the main configuration. We check
   // both the warming clusters and the active clusters to see if we need an update or the update
@@ -734,7 +736,7 @@ ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cluster
   const std::string& cluster_name = cluster.name();
   const auto existing_active_cluster = active_clusters_.find(cluster_name);
   const auto existing_warming_cluster = warming_clusters_.find(cluster_name);
-  const uint64_t new_hash = MessageUtil::hash(cluster);
+  const uint64_t new_hash = config_hash.has_value() ? *config_hash : MessageUtil::hash(cluster);
   if (existing_warming_cluster != warming_clusters_.end()) {
     // If the cluster is the same as the warming cluster of the same name, block the update.
     if (existing_warming_cluster->second->blockUpdate(new_hash)) {
@@ -1506,9 +1508,25 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::updateHost
     HostMapConstSharedPtr cross_priority_host_map) {
   ENVOY_LOG(debug, "membership update for TLS cluster {} added {} removed {}", name,
             hosts_added.size(), hosts_removed.size());
-  priority_set_.updateHosts(priority, std::move(update_hosts_params), std::move(locality_weights),
-                            hosts_added, hosts_removed, weighted_priority_health,
-                            overprovisioning_factor, std::move(cross_priority_host_map));
+  if (host_subset_.has_value()) {
+    // The hosts that enter or leave the subset of this thread are not necessarily the hosts
+    // added to or removed from the cluster, e.g. if the subset falls back to all the hosts.
+    PrioritySet::UpdateHostsParams subset_params = host_subset_->filter(update_hosts_params);
+    HostVector subset_hosts_added;
+    HostVector subset_hosts_removed;
+    WorkerHostSubset::diff(priority < priority_set_.hostSetsPerPriority().size()
+                               ? priority_set_.hostSetsPerPriority()[priority]->hosts()
+                               : HostVector(),
+                           *subset_params.hosts, subset_hosts_added, subset_hosts_removed);
+    priority_set_.updateHosts(priority, std::move(subset_params), std::move(locality_weights),
+                              subset_hosts_added, subset_hosts_removed, weighted_priority_health,
+                              overprovisioning_factor, std::move(cross_priority_host_map));
+  } else {
+    priority_set_.updateHosts(priority, std::move(update_hosts_params),
+                              std::move(locality_weights), hosts_added, hosts_removed,
+                              weighted_priority_health, overprovisioning_factor,
+                              std::move(cross_priority_host_map));
+  }
   // If an LB is thread aware, create a new worker local LB on membership changes.
   if (lb_factory_ != nullptr && lb_factory_->recreateOnHostChange()) {
     ENVOY_LOG(debug, "re-creating local LB for TLS cluster {}", name);
@@ -1750,7 +1768,9 @@ ClusterManagerImpl::dumpClusterConfigs(const Matchers::StringMatcher& name_match
 ClusterManagerImpl::ThreadLocalClusterManagerImpl::ThreadLocalClusterManagerImpl(
     ClusterManagerImpl& parent, Event::Dispatcher& dispatcher,
     const absl::optional<LocalClusterParams>& local_cluster_params)
-    : parent_(parent), thread_local_dispatcher_(dispatcher), cdm_(dispatcher.name(), *this),
+    : parent_(parent), thread_local_dispatcher_(dispatcher),
+      worker_index_(Event::workerIndex(dispatcher.name())),
+      cdm_(dispatcher.name(), *this),
       local_stats_(generateStats(*parent.stats_.rootScope(), dispatcher.name())) {
   // If local cluster is defined then we need to initialize it first.
   if (local_cluster_params.has_value()) {
@@ -1895,6 +1915,16 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::ClusterEntry(
       override_host_statuses_(HostUtility::createOverrideHostStatus(cluster_info_->lbConfig())) {
   priority_set_.getOrCreateHostSet(0);
 
+  const auto& common_lb_config = cluster_info_->lbConfig();
+  // Only the workers load balance across subsets. The main thread keeps all the hosts.
+  if (common_lb_config.has_workers_per_host() &&
+      common_lb_config.workers_per_host().value() < parent_.parent_.worker_count_ &&
+      parent_.worker_index_.has_value() &&
+      parent_.worker_index_.value() < parent_.parent_.worker_count_) {
+    host_subset_.emplace(parent_.worker_index_.value(), parent_.parent_.worker_count_,
+                         common_lb_config.workers_per_host().value());
+  }
+
   // TODO(mattklein123): Consider converting other LBs over to thread local. All of them could
   // benefit given the healthy panic, locality, and priority calculations that take place.
   ASSERT(lb_factory_ != nullptr);
@@ -41,6 +41,7 @@
 #include "source/common/upstream/host_utility.h"
 #include "source/common/upstream/priority_conn_pool_map.h"
 #include "source/common/upstream/upstream_impl.h"
+#include "source/common/upstream/worker_host_subset.h"
 
 #include "absl/container/btree_map.h"
 
@@ -240,9 +241,10 @@ public:
   std::size_t warmingClusterCount() const { return warming_clusters_.size(); }
 
   // Upstream::ClusterManager
-  absl::StatusOr<bool> addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
-                                          const std::string& version_info,
-                                          const bool avoid_cds_removal = false) override;
+  absl::StatusOr<bool>
+  addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
+                     const std::string& version_info, const bool avoid_cds_removal = false,
+                     absl::optional<uint64_t> config_hash = absl::nullopt) override;
 
   void setPrimaryClustersInitializedCb(PrimaryClustersReadyCallback callback) override {
     init_helper_.setPrimaryClustersInitializedCb(callback);
@@ -657,6 +659,8 @@ private:
 
       ThreadLocalClusterManagerImpl& parent_;
       PrioritySetImpl priority_set_;
+      // Set if the thread only load balances across a subset of the hosts of the cluster.
+      absl::optional<WorkerHostSubset> host_subset_;
       UnitFloat drop_overload_{0};
       std::string drop_category_;
 
@@ -746,6 +750,8 @@ private:
 
     ClusterManagerImpl& parent_;
     Event::Dispatcher& thread_local_dispatcher_;
+    // The index of the worker of this thread, or nullopt on other threads.
+    const absl::optional<uint32_t> worker_index_;
     // Known clusters will exclusively exist in either `thread_local_clusters_`
     // or `thread_local_deferred_clusters_`.
     absl::flat_hash_map<std::string, ClusterEntryPtr> thread_local_clusters_;
@@ -975,6 +981,8 @@ private:
   bool initialized_{};
   bool ads_mux_initialized_{};
   std::atomic<bool> shutdown_;
+  // The number of workers, across which worker host subsets are spread.
+  const uint32_t worker_count_;
 
   // Keep all the ClusterMaps at the end, so that they get destroyed first.
   // Clusters may keep references to the cluster manager and in destructor can call
@@ -58,6 +58,7 @@
 #include "source/common/runtime/runtime_impl.h"
 #include "source/common/stats/deferred_creation.h"
 #include "source/common/stats/stats_matcher_impl.h"
+#include "source/common/upstream/cluster_config_pool.h"
 #include "source/common/upstream/cluster_factory_impl.h"
 #include "source/common/upstream/health_checker_impl.h"
 #include "source/common/upstream/locality_pool.h"
@@ -129,9 +130,15 @@ parseExtensionProtocolOptions(
     Server::Configuration::ProtocolOptionsFactoryContext& factory_context) {
   absl::flat_hash_map<std::string, ProtocolOptionsConfigConstSharedPtr> options;
 
+  // Clusters with identical typed options share them.
+  ClusterConfigPoolSharedPtr config_pool =
+      ClusterConfigPool::get(factory_context.serverFactoryContext());
   for (const auto& it : config.typed_extension_protocol_options()) {
     auto& name = it.first;
-    auto object_or_error = createProtocolOptionsConfig(name, it.second, factory_context);
+    auto object_or_error = config_pool->getOrCreate<ProtocolOptionsConfig>(
+        ClusterConfigPool::ObjectType::ProtocolOptions,
+        absl::StrCat(name, "|", it.second.type_url(), "|", it.second.value()),
+        [&]() { return createProtocolOptionsConfig(name, it.second, factory_context); });
     RETURN_IF_NOT_OK_REF(object_or_error.status());
     if (object_or_error.value() != nullptr) {
       options[name] = std::move(object_or_error.value());
@@ -1130,6 +1137,22 @@ ClusterInfoImpl::create(Init::Manager& info,
   return ret;
 }
 
+std::shared_ptr<const ClusterInfoImpl::ClusterMetadata>
+ClusterInfoImpl::createMetadata(const envoy::config::core::v3::Metadata& metadata,
+                                Server::Configuration::ServerFactoryContext& server_context) {
+  // Clusters with identical metadata share it, and the typed metadata parsed from it.
+  return ClusterConfigPool::get(server_context)
+      ->getOrCreate<ClusterMetadata>(
+          ClusterConfigPool::ObjectType::Metadata, absl::StrCat(MessageUtil::hash(metadata)),
+          [&metadata]() -> absl::StatusOr<std::shared_ptr<const ClusterMetadata>> {
+            return std::make_shared<const ClusterMetadata>(metadata);
+          },
+          [&metadata](const ClusterMetadata& interned) {
+            return Protobuf::util::MessageDifferencer::Equals(interned.metadata_, metadata);
+          })
+      .value();
+}
+
 ClusterInfoImpl::ClusterInfoImpl(
     Init::Manager& init_manager, Server::Configuration::ServerFactoryContext& server_context,
     const envoy::config::cluster::v3::Cluster& config,
@@ -1165,26 +1188,33 @@ ClusterInfoImpl::ClusterInfoImpl(
           config.preconnect_policy(), per_upstream_preconnect_ratio, 1.0)),
       peekahead_ratio_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.preconnect_policy(),
                                                        predictive_preconnect_ratio, 0)),
+      adaptive_preconnect_(
+          config.preconnect_policy().has_adaptive_preconnect()
+              ? absl::make_optional(config.preconnect_policy().adaptive_preconnect())
+              : absl::nullopt),
       socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
       traffic_stats_(generateStats(
           stats_scope_, factory_context.serverFactoryContext().clusterManager().clusterStatNames(),
           server_context.statsConfig().enableDeferredCreationStats())),
-      config_update_stats_(
+      config_update_stats_(Stats::createDeferredCompatibleStats<ClusterConfigUpdateStats>(
+          stats_scope_,
           factory_context.serverFactoryContext().clusterManager().clusterConfigUpdateStatNames(),
-          *stats_scope_),
+          server_context.statsConfig().enableDeferredCreationStats())),
       lb_stats_(factory_context.serverFactoryContext().clusterManager().clusterLbStatNames(),
                 *stats_scope_),
       endpoint_stats_(
           factory_context.serverFactoryContext().clusterManager().clusterEndpointStatNames(),
           *stats_scope_),
       load_report_stats_store_(stats_scope_->symbolTable()),
-      load_report_stats_(generateLoadReportStats(
-          *load_report_stats_store_.rootScope(),
-          factory_context.serverFactoryContext().clusterManager().clusterLoadReportStatNames())),
+      load_report_stats_(Stats::createDeferredCompatibleStats<ClusterLoadReportStats>(
+          load_report_stats_store_.rootScope(),
+          factory_context.serverFactoryContext().clusterManager().clusterLoadReportStatNames(),
+          server_context.statsConfig().enableDeferredCreationStats())),
       optional_cluster_stats_(
           (config.has_track_cluster_stats() || config.track_timeout_budgets())
               ? std::make_unique<OptionalClusterStats>(
-                    config, *stats_scope_, factory_context.serverFactoryContext().clusterManager())
+                    config, stats_scope_, factory_context.serverFactoryContext().clusterManager(),
+                    server_context.statsConfig().enableDeferredCreationStats())
               : nullptr),
       features_(ClusterInfoImpl::HttpProtocolOptionsConfigImpl::parseFeatures(
           config, *http_protocol_options_)),
@@ -1200,12 +1230,8 @@ ClusterInfoImpl::ClusterInfoImpl(
                            ? std::make_unique<envoy::config::core::v3::TypedExtensionConfig>(
                                  config.upstream_config())
                            : nullptr),
-      metadata_(config.has_metadata()
-                    ? std::make_unique<envoy::config::core::v3::Metadata>(config.metadata())
-                    : nullptr),
-      typed_metadata_(config.has_metadata()
-                          ? std::make_unique<ClusterTypedMetadata>(config.metadata())
-                          : nullptr),
+      metadata_(config.has_metadata() ? createMetadata(config.metadata(), server_context)
+                                      : nullptr),
       common_lb_config_(
           factory_context.serverFactoryContext().clusterManager().getCommonLbConfigPtr(
               config.common_lb_config())),
@@ -1985,18 +2011,18 @@ absl::Status ClusterImplBase::validateEndpoints(
 }
 
 ClusterInfoImpl::OptionalClusterStats::OptionalClusterStats(
-    const envoy::config::cluster::v3::Cluster& config, Stats::Scope& stats_scope,
-    const ClusterManager& manager)
-    : timeout_budget_stats_(
-          (config.track_cluster_stats().timeout_budgets() || config.track_timeout_budgets())
-              ? std::make_unique<ClusterTimeoutBudgetStats>(generateTimeoutBudgetStats(
-                    stats_scope, manager.clusterTimeoutBudgetStatNames()))
-              : nullptr),
-      request_response_size_stats_(
-          (config.track_cluster_stats().request_response_sizes()
-               ? std::make_unique<ClusterRequestResponseSizeStats>(generateRequestResponseSizeStats(
-                     stats_scope, manager.clusterRequestResponseSizeStatNames()))
-               : nullptr)) {}
+    const envoy::config::cluster::v3::Cluster& config, const Stats::ScopeSharedPtr& stats_scope,
+    const ClusterManager& manager, bool defer_creation) {
+  if (config.track_cluster_stats().timeout_budgets() || config.track_timeout_budgets()) {
+    timeout_budget_stats_.emplace(Stats::createDeferredCompatibleStats<ClusterTimeoutBudgetStats>(
+        stats_scope, manager.clusterTimeoutBudgetStatNames(), defer_creation));
+  }
+  if (config.track_cluster_stats().request_response_sizes()) {
+    request_response_size_stats_.emplace(
+        Stats::createDeferredCompatibleStats<ClusterRequestResponseSizeStats>(
+            stats_scope, manager.clusterRequestResponseSizeStatNames(), defer_creation));
+  }
+}
 
 ClusterInfoImpl::ResourceManagers::ResourceManagers(
     const envoy::config::cluster::v3::Cluster& config, Runtime::Loader& runtime,
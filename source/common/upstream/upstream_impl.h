@@ -892,6 +892,13 @@ public:
 
   float perUpstreamPreconnectRatio() const override { return per_upstream_preconnect_ratio_; }
   float peekaheadRatio() const override { return peekahead_ratio_; }
+  OptRef<const envoy::config::cluster::v3::Cluster::PreconnectPolicy::AdaptivePreconnect>
+  adaptivePreconnect() const override {
+    if (!adaptive_preconnect_.has_value()) {
+      return absl::nullopt;
+    }
+    return *adaptive_preconnect_;
+  }
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
   }
@@ -939,29 +946,29 @@ public:
   DeferredCreationCompatibleClusterTrafficStats& trafficStats() const override {
     return traffic_stats_;
   }
-  ClusterConfigUpdateStats& configUpdateStats() const override { return config_update_stats_; }
+  ClusterConfigUpdateStats& configUpdateStats() const override { return *config_update_stats_; }
   ClusterLbStats& lbStats() const override { return lb_stats_; }
   ClusterEndpointStats& endpointStats() const override { return endpoint_stats_; }
   Stats::Scope& statsScope() const override { return *stats_scope_; }
 
   ClusterRequestResponseSizeStatsOptRef requestResponseSizeStats() const override {
     if (optional_cluster_stats_ == nullptr ||
-        optional_cluster_stats_->request_response_size_stats_ == nullptr) {
+        !optional_cluster_stats_->request_response_size_stats_.has_value()) {
       return absl::nullopt;
     }
 
-    return std::ref(*(optional_cluster_stats_->request_response_size_stats_));
+    return std::ref(**optional_cluster_stats_->request_response_size_stats_);
   }
 
-  ClusterLoadReportStats& loadReportStats() const override { return load_report_stats_; }
+  ClusterLoadReportStats& loadReportStats() const override { return *load_report_stats_; }
 
   ClusterTimeoutBudgetStatsOptRef timeoutBudgetStats() const override {
     if (optional_cluster_stats_ == nullptr ||
-        optional_cluster_stats_->timeout_budget_stats_ == nullptr) {
+        !optional_cluster_stats_->timeout_budget_stats_.has_value()) {
       return absl::nullopt;
     }
 
-    return std::ref(*(optional_cluster_stats_->timeout_budget_stats_));
+    return std::ref(**optional_cluster_stats_->timeout_budget_stats_);
   }
 
   bool perEndpointStatsEnabled() const override { return per_endpoint_stats_; }
@@ -972,14 +979,14 @@ public:
   using DefaultMetadata = ConstSingleton<envoy::config::core::v3::Metadata>;
   const envoy::config::core::v3::Metadata& metadata() const override {
     if (metadata_ != nullptr) {
-      return *metadata_;
+      return metadata_->metadata_;
     }
     return DefaultMetadata::get();
   }
   using ClusterTypedMetadata = Envoy::Config::TypedMetadataImpl<ClusterTypedMetadataFactory>;
   const Envoy::Config::TypedMetadata& typedMetadata() const override {
-    if (typed_metadata_ != nullptr) {
-      return *typed_metadata_;
+    if (metadata_ != nullptr) {
+      return metadata_->typed_metadata_;
     }
     CONSTRUCT_ON_FIRST_USE(ClusterTypedMetadata, DefaultMetadata::get());
   }
@@ -1073,15 +1080,32 @@ private:
 
   struct OptionalClusterStats {
     OptionalClusterStats(const envoy::config::cluster::v3::Cluster& config,
-                         Stats::Scope& stats_scope, const ClusterManager& manager);
-    const ClusterTimeoutBudgetStatsPtr timeout_budget_stats_;
-    const ClusterRequestResponseSizeStatsPtr request_response_size_stats_;
+                         const Stats::ScopeSharedPtr& stats_scope, const ClusterManager& manager,
+                         bool defer_creation);
+    absl::optional<Stats::DeferredCreationCompatibleStats<ClusterTimeoutBudgetStats>>
+        timeout_budget_stats_;
+    absl::optional<Stats::DeferredCreationCompatibleStats<ClusterRequestResponseSizeStats>>
+        request_response_size_stats_;
   };
 
 #ifdef ENVOY_ENABLE_UHV
   ::Envoy::Http::HeaderValidatorStats& getHeaderValidatorStats(Http::Protocol protocol) const;
 #endif
 
+  // The metadata of a cluster and the typed metadata parsed from it, shared by the clusters with
+  // identical metadata.
+  struct ClusterMetadata {
+    explicit ClusterMetadata(const envoy::config::core::v3::Metadata& metadata)
+        : metadata_(metadata), typed_metadata_(metadata) {}
+
+    const envoy::config::core::v3::Metadata metadata_;
+    const ClusterTypedMetadata typed_metadata_;
+  };
+
+  static std::shared_ptr<const ClusterMetadata>
+  createMetadata(const envoy::config::core::v3::Metadata& metadata,
+                 Server::Configuration::ServerFactoryContext& server_context);
+
   const Runtime::Loader& runtime_;
   const std::string name_;
   const std::unique_ptr<const std::string> observability_name_;
@@ -1095,22 +1119,23 @@ private:
   OptionalTimeouts optional_timeouts_;
   const float per_upstream_preconnect_ratio_;
   const float peekahead_ratio_;
+  const absl::optional<envoy::config::cluster::v3::Cluster::PreconnectPolicy::AdaptivePreconnect>
+      adaptive_preconnect_;
   TransportSocketMatcherPtr socket_matcher_;
   Stats::ScopeSharedPtr stats_scope_;
   mutable DeferredCreationCompatibleClusterTrafficStats traffic_stats_;
-  mutable ClusterConfigUpdateStats config_update_stats_;
+  mutable Stats::DeferredCreationCompatibleStats<ClusterConfigUpdateStats> config_update_stats_;
   mutable ClusterLbStats lb_stats_;
   mutable ClusterEndpointStats endpoint_stats_;
   Stats::IsolatedStoreImpl load_report_stats_store_;
-  mutable ClusterLoadReportStats load_report_stats_;
+  mutable Stats::DeferredCreationCompatibleStats<ClusterLoadReportStats> load_report_stats_;
   const std::unique_ptr<OptionalClusterStats> optional_cluster_stats_;
   const uint64_t features_;
   mutable ResourceManagers resource_managers_;
   const std::string maintenance_mode_runtime_key_;
   const UpstreamLocalAddressSelectorConstSharedPtr upstream_local_address_selector_;
   const std::unique_ptr<const envoy::config::core::v3::TypedExtensionConfig> upstream_config_;
-  const std::unique_ptr<const envoy::config::core::v3::Metadata> metadata_;
-  const std::unique_ptr<ClusterTypedMetadata> typed_metadata_;
+  const std::shared_ptr<const ClusterMetadata> metadata_;
   LoadBalancerConfigPtr load_balancer_config_;
   TypedLoadBalancerFactory* load_balancer_factory_ = nullptr;
   const std::shared_ptr<const envoy::config::cluster::v3::Cluster::CommonLbConfig>
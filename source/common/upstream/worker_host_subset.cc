@@ -0,0 +1,95 @@
+#include "source/common/upstream/worker_host_subset.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/hash.h"
+
+#include "absl/container/flat_hash_set.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+template <class HostVectorT>
+std::shared_ptr<const HostVectorT> filterHosts(const HostVectorT& hosts,
+                                               const WorkerHostSubset& subset) {
+  auto filtered = std::make_shared<HostVectorT>();
+  for (const auto& host : hosts.get()) {
+    if (subset.contains(*host)) {
+      filtered->get().push_back(host);
+    }
+  }
+  return filtered;
+}
+
+HostsPerLocalityConstSharedPtr filterHostsPerLocality(const HostsPerLocality& hosts_per_locality,
+                                                      const WorkerHostSubset& subset) {
+  const auto in_subset = [&subset](const Host& host) { return subset.contains(host); };
+  return hosts_per_locality.filter({in_subset})[0];
+}
+
+} // namespace
+
+WorkerHostSubset::WorkerHostSubset(uint32_t thread_index, uint32_t thread_count,
+                                   uint32_t threads_per_host)
+    : thread_index_(thread_index), thread_count_(thread_count),
+      threads_per_host_(threads_per_host) {
+  ASSERT(thread_index_ < thread_count_);
+}
+
+bool WorkerHostSubset::contains(const Host& host) const {
+  const uint32_t first_thread =
+      HashUtil::xxHash64(host.address()->asStringView()) % thread_count_;
+  return (thread_index_ + thread_count_ - first_thread) % thread_count_ < threads_per_host_;
+}
+
+PrioritySet::UpdateHostsParams
+WorkerHostSubset::filter(const PrioritySet::UpdateHostsParams& params) const {
+  auto hosts = std::make_shared<HostVector>();
+  for (const HostSharedPtr& host : *params.hosts) {
+    if (contains(*host)) {
+      hosts->push_back(host);
+    }
+  }
+  if (hosts->empty()) {
+    return params;
+  }
+
+  PrioritySet::UpdateHostsParams filtered;
+  filtered.hosts = std::move(hosts);
+  filtered.healthy_hosts = filterHosts(*params.healthy_hosts, *this);
+  filtered.degraded_hosts = filterHosts(*params.degraded_hosts, *this);
+  filtered.excluded_hosts = filterHosts(*params.excluded_hosts, *this);
+  filtered.hosts_per_locality = filterHostsPerLocality(*params.hosts_per_locality, *this);
+  filtered.healthy_hosts_per_locality =
+      filterHostsPerLocality(*params.healthy_hosts_per_locality, *this);
+  filtered.degraded_hosts_per_locality =
+      filterHostsPerLocality(*params.degraded_hosts_per_locality, *this);
+  filtered.excluded_hosts_per_locality =
+      filterHostsPerLocality(*params.excluded_hosts_per_locality, *this);
+  return filtered;
+}
+
+void WorkerHostSubset::diff(const HostVector& previous_hosts, const HostVector& hosts,
+                            HostVector& hosts_added, HostVector& hosts_removed) {
+  absl::flat_hash_set<const Host*> previous;
+  previous.reserve(previous_hosts.size());
+  for (const HostSharedPtr& host : previous_hosts) {
+    previous.insert(host.get());
+  }
+  absl::flat_hash_set<const Host*> current;
+  current.reserve(hosts.size());
+  for (const HostSharedPtr& host : hosts) {
+    current.insert(host.get());
+    if (!previous.contains(host.get())) {
+      hosts_added.push_back(host);
+    }
+  }
+  for (const HostSharedPtr& host : previous_hosts) {
+    if (!current.contains(host.get())) {
+      hosts_removed.push_back(host);
+    }
+  }
+}
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+#include "envoy/upstream/upstream.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * Deterministically assigns each host of a cluster to `threads_per_host` of the `thread_count`
+ * threads, so that each thread only load balances across, and connects to, a subset of the hosts.
+ *
+ * The threads of a host are consecutive, starting at a thread chosen from a hash of the address of
+ * the host. The assignment only depends on the address, so a thread keeps its hosts across updates
+ * of the cluster and every host is used by the same number of threads.
+ */
+class WorkerHostSubset {
+public:
+  WorkerHostSubset(uint32_t thread_index, uint32_t thread_count, uint32_t threads_per_host);
+
+  /**
+   * @return whether the thread load balances to the host.
+   */
+  bool contains(const Host& host) const;
+
+  /**
+   * Restricts the hosts of a host set update to the subset of the thread. The per locality lists
+   * keep all the localities, some of which may become empty, so that they still line up with the
+   * locality weights. If none of the hosts is in the subset, the thread uses all of them.
+   * @param params the hosts of the update.
+   * @return the hosts of the update that are in the subset.
+   */
+  PrioritySet::UpdateHostsParams filter(const PrioritySet::UpdateHostsParams& params) const;
+
+  /**
+   * Computes the hosts added to and removed from a host set by an update.
+   * @param previous_hosts the hosts before the update.
+   * @param hosts the hosts after the update.
+   * @param hosts_added filled with the hosts of `hosts` that are not in `previous_hosts`.
+   * @param hosts_removed filled with the hosts of `previous_hosts` that are not in `hosts`.
+   */
+  static void diff(const HostVector& previous_hosts, const HostVector& hosts,
+                   HostVector& hosts_added, HostVector& hosts_removed);
+
+private:
+  const uint32_t thread_index_;
+  const uint32_t thread_count_;
+  const uint32_t threads_per_host_;
+};
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,210 @@
+#include "source/extensions/access_loggers/file/binary_access_log_impl.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/fmt.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/numbers.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace File {
+
+namespace {
+
+constexpr absl::string_view BlockMagic = "EALB";
+
+// The tags of number values.
+constexpr uint8_t NumberAbsent = 0;
+constexpr uint8_t NumberInteger = 1;
+constexpr uint8_t NumberDouble = 2;
+
+void appendVarint(uint64_t value, std::string& output) {
+  while (value >= 0x80) {
+    output.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<char>(value));
+}
+
+void appendLengthPrefixed(absl::string_view value, std::string& output) {
+  appendVarint(value.size(), output);
+  output.append(value);
+}
+
+void appendNumber(const Protobuf::Value& value, std::string& output) {
+  double number;
+  if (value.kind_case() == Protobuf::Value::kNumberValue) {
+    number = value.number_value();
+  } else if (value.kind_case() != Protobuf::Value::kStringValue ||
+             !absl::SimpleAtod(value.string_value(), &number)) {
+    output.push_back(NumberAbsent);
+    return;
+  }
+
+  // Most numbers are integers, which are written as varints. The bounds are exact doubles, and the
+  // upper one is excluded as it is just past the range of int64_t.
+  if (std::trunc(number) == number && number >= -0x1p63 && number < 0x1p63) {
+    const int64_t integer = static_cast<int64_t>(number);
+    output.push_back(NumberInteger);
+    appendVarint((static_cast<uint64_t>(integer) << 1) ^ static_cast<uint64_t>(integer >> 63),
+                 output);
+    return;
+  }
+  output.push_back(NumberDouble);
+  uint64_t bits;
+  static_assert(sizeof(bits) == sizeof(number));
+  memcpy(&bits, &number, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    output.push_back(static_cast<char>(bits >> (8 * i)));
+  }
+}
+
+} // namespace
+
+absl::StatusOr<std::unique_ptr<BinaryLogSchema>>
+BinaryLogSchema::create(const BinaryFormatConfig& config,
+                        const std::vector<Formatter::CommandParserPtr>& command_parsers) {
+  std::vector<Column> columns;
+  columns.reserve(config.columns_size());
+  std::string header(BlockMagic);
+  appendVarint(config.columns_size(), header);
+  for (const BinaryFormatConfig::Column& column_config : config.columns()) {
+    auto providers_or_error =
+        Formatter::SubstitutionFormatParser::parse(column_config.format(), command_parsers);
+    RETURN_IF_NOT_OK_REF(providers_or_error.status());
+    Formatter::CompiledFormat format(std::move(providers_or_error.value()));
+    if (column_config.type() == BinaryFormatConfig::Column::NUMBER &&
+        format.singleProvider() == nullptr) {
+      return absl::InvalidArgumentError(
+          fmt::format("the format '{}' of the number column '{}' is not a single command operator",
+                      column_config.format(), column_config.name()));
+    }
+    columns.push_back(Column{column_config.type(), std::move(format)});
+
+    appendLengthPrefixed(column_config.name(), header);
+    header.push_back(static_cast<char>(column_config.type()));
+  }
+  return std::unique_ptr<BinaryLogSchema>(
+      new BinaryLogSchema(std::move(columns), std::move(header)));
+}
+
+BinaryLogBlock::BinaryLogBlock(const BinaryLogSchema& schema)
+    : schema_(schema), columns_(schema.columns().size()) {}
+
+void BinaryLogBlock::add(const Formatter::Context& context,
+                         const StreamInfo::StreamInfo& stream_info) {
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    const BinaryLogSchema::Column& column = schema_.columns()[i];
+    std::string& output = columns_[i];
+    const size_t column_size = output.size();
+
+    if (column.type_ == BinaryFormatConfig::Column::NUMBER) {
+      appendNumber(column.format_.singleProvider()->formatValue(context, stream_info), output);
+    } else if (const Formatter::FormatterProvider* provider = column.format_.singleProvider();
+               provider != nullptr) {
+      value_.clear();
+      if (provider->formatTo(context, stream_info, value_)) {
+        appendVarint(value_.size() + 1, output);
+        output.append(value_);
+      } else {
+        appendVarint(0, output);
+      }
+    } else {
+      value_.clear();
+      column.format_.formatTo(context, stream_info, false, value_);
+      appendVarint(value_.size() + 1, output);
+      output.append(value_);
+    }
+
+    payload_size_ += output.size() - column_size;
+  }
+  ++entries_;
+}
+
+void BinaryLogBlock::encode(Compression::Compressor::CompressorFactory* compressor_factory,
+                            std::string& output) {
+  Buffer::OwnedImpl payload;
+  for (std::string& column : columns_) {
+    std::string column_size;
+    appendVarint(column.size(), column_size);
+    payload.add(column_size);
+    payload.add(column);
+    column.clear();
+  }
+  if (compressor_factory != nullptr) {
+    compressor_factory->createCompressor()->compress(payload,
+                                                     Compression::Compressor::State::Finish);
+  }
+
+  output.append(schema_.header());
+  appendLengthPrefixed(compressor_factory != nullptr ? compressor_factory->contentEncoding() : "",
+                       output);
+  appendVarint(entries_, output);
+  appendVarint(payload.length(), output);
+  output.append(payload.toString());
+
+  entries_ = 0;
+  payload_size_ = 0;
+}
+
+BinaryFileAccessLog::BinaryFileAccessLog(
+    const Filesystem::FilePathAndType& access_log_file_info, AccessLog::FilterPtr&& filter,
+    const BinaryFormatConfig& config, BinaryLogSchemaConstSharedPtr schema,
+    Compression::Compressor::CompressorFactoryPtr&& compressor_factory,
+    AccessLog::AccessLogManager& log_manager, ThreadLocal::SlotAllocator& tls)
+    : ImplBase(std::move(filter)), tls_slot_(tls) {
+  auto file_or_error = log_manager.createAccessLog(access_log_file_info);
+  THROW_IF_NOT_OK_REF(file_or_error.status());
+
+  SharedStateConstSharedPtr shared_state(new SharedState{
+      std::move(schema), std::move(compressor_factory), std::move(file_or_error.value()),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_block_size_bytes, 64 * 1024),
+      std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(config, max_block_delay, 1000))});
+  tls_slot_.set([shared_state](Event::Dispatcher& dispatcher) {
+    return std::make_shared<ThreadLocalBlock>(shared_state, dispatcher);
+  });
+}
+
+void BinaryFileAccessLog::emitLog(const Formatter::Context& context,
+                                  const StreamInfo::StreamInfo& stream_info) {
+  tls_slot_->log(context, stream_info);
+}
+
+BinaryFileAccessLog::ThreadLocalBlock::ThreadLocalBlock(SharedStateConstSharedPtr shared_state,
+                                                        Event::Dispatcher& dispatcher)
+    : shared_state_(std::move(shared_state)), block_(*shared_state_->schema_),
+      write_timer_(dispatcher.createTimer([this]() { write(); })) {}
+
+BinaryFileAccessLog::ThreadLocalBlock::~ThreadLocalBlock() {
+  if (block_.entries() > 0) {
+    write();
+  }
+}
+
+void BinaryFileAccessLog::ThreadLocalBlock::log(const Formatter::Context& context,
+                                                const StreamInfo::StreamInfo& stream_info) {
+  if (block_.entries() == 0) {
+    write_timer_->enableTimer(shared_state_->max_block_delay_);
+  }
+  block_.add(context, stream_info);
+  if (block_.payloadSize() >= shared_state_->max_block_size_bytes_) {
+    write();
+  }
+}
+
+void BinaryFileAccessLog::ThreadLocalBlock::write() {
+  write_timer_->disableTimer();
+  std::string encoded;
+  block_.encode(shared_state_->compressor_factory_.get(), encoded);
+  shared_state_->log_file_->write(encoded);
+}
+
+} // namespace File
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
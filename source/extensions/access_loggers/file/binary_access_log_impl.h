@@ -0,0 +1,142 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/access_log/access_log.h"
+#include "envoy/compression/compressor/factory.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/access_loggers/file/v3/file.pb.h"
+#include "envoy/thread_local/thread_local.h"
+
+#include "source/common/formatter/substitution_formatter.h"
+#include "source/extensions/access_loggers/common/access_log_base.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace File {
+
+using BinaryFormatConfig = envoy::extensions::access_loggers::file::v3::BinaryFormat;
+
+/**
+ * The columns of the binary encoding, compiled from their formats. @see BinaryFormat in file.proto
+ * for the encoding.
+ */
+class BinaryLogSchema {
+public:
+  using ColumnType = BinaryFormatConfig::Column::Type;
+
+  static absl::StatusOr<std::unique_ptr<BinaryLogSchema>>
+  create(const BinaryFormatConfig& config,
+         const std::vector<Formatter::CommandParserPtr>& command_parsers);
+
+  struct Column {
+    ColumnType type_;
+    Formatter::CompiledFormat format_;
+  };
+
+  const std::vector<Column>& columns() const { return columns_; }
+
+  /**
+   * @return the magic bytes and the schema, which start every block.
+   */
+  const std::string& header() const { return header_; }
+
+private:
+  BinaryLogSchema(std::vector<Column>&& columns, std::string&& header)
+      : columns_(std::move(columns)), header_(std::move(header)) {}
+
+  const std::vector<Column> columns_;
+  const std::string header_;
+};
+
+using BinaryLogSchemaConstSharedPtr = std::shared_ptr<const BinaryLogSchema>;
+
+/**
+ * A block of entries in the binary encoding, built column by column.
+ */
+class BinaryLogBlock {
+public:
+  explicit BinaryLogBlock(const BinaryLogSchema& schema);
+
+  /**
+   * Add an entry to the block.
+   */
+  void add(const Formatter::Context& context, const StreamInfo::StreamInfo& stream_info);
+
+  uint64_t entries() const { return entries_; }
+  uint64_t payloadSize() const { return payload_size_; }
+
+  /**
+   * Append the encoded block to the output, and clear the block.
+   * @param compressor_factory if set, creates the compressor of the payload.
+   */
+  void encode(Compression::Compressor::CompressorFactory* compressor_factory, std::string& output);
+
+private:
+  const BinaryLogSchema& schema_;
+  std::vector<std::string> columns_;
+  // The value of the current entry for a string column, reused across entries.
+  std::string value_;
+  uint64_t entries_{};
+  uint64_t payload_size_{};
+};
+
+/**
+ * Access log Instance that writes the binary encoding of logs to a file. Each thread builds its own
+ * block, which is written when it is full or when it has been held for too long.
+ */
+class BinaryFileAccessLog : public Common::ImplBase {
+public:
+  BinaryFileAccessLog(const Filesystem::FilePathAndType& access_log_file_info,
+                      AccessLog::FilterPtr&& filter, const BinaryFormatConfig& config,
+                      BinaryLogSchemaConstSharedPtr schema,
+                      Compression::Compressor::CompressorFactoryPtr&& compressor_factory,
+                      AccessLog::AccessLogManager& log_manager, ThreadLocal::SlotAllocator& tls);
+
+private:
+  /**
+   * The state shared by the blocks of all threads, which outlives the logger until the blocks are
+   * written.
+   */
+  struct SharedState {
+    const BinaryLogSchemaConstSharedPtr schema_;
+    const Compression::Compressor::CompressorFactoryPtr compressor_factory_;
+    const AccessLog::AccessLogFileSharedPtr log_file_;
+    const uint64_t max_block_size_bytes_;
+    const std::chrono::milliseconds max_block_delay_;
+  };
+  using SharedStateConstSharedPtr = std::shared_ptr<const SharedState>;
+
+  /**
+   * The block of a thread.
+   */
+  class ThreadLocalBlock : public ThreadLocal::ThreadLocalObject {
+  public:
+    ThreadLocalBlock(SharedStateConstSharedPtr shared_state, Event::Dispatcher& dispatcher);
+    ~ThreadLocalBlock() override;
+
+    void log(const Formatter::Context& context, const StreamInfo::StreamInfo& stream_info);
+
+  private:
+    void write();
+
+    const SharedStateConstSharedPtr shared_state_;
+    BinaryLogBlock block_;
+    const Event::TimerPtr write_timer_;
+  };
+
+  // Common::ImplBase
+  void emitLog(const Formatter::Context& context,
+               const StreamInfo::StreamInfo& stream_info) override;
+
+  ThreadLocal::TypedSlot<ThreadLocalBlock> tls_slot_;
+};
+
+} // namespace File
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include "envoy/compression/compressor/config.h"
 #include "envoy/extensions/access_loggers/file/v3/file.pb.h"
 #include "envoy/extensions/access_loggers/file/v3/file.pb.validate.h"
 #include "envoy/registry/registry.h"
@@ -13,6 +14,7 @@
 #include "source/common/formatter/substitution_formatter.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/extensions/access_loggers/common/file_access_log_impl.h"
+#include "source/extensions/access_loggers/file/binary_access_log_impl.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -61,6 +63,9 @@ AccessLog::InstanceSharedPtr FileAccessLogFactory::createAccessLogInstance(
                                   fal_config.log_format(), context, std::move(command_parsers)),
                               Formatter::FormatterPtr);
     break;
+  case envoy::extensions::access_loggers::file::v3::FileAccessLog::AccessLogFormatCase::
+      kBinaryFormat:
+    return createBinaryAccessLogInstance(fal_config, std::move(filter), context, command_parsers);
   case envoy::extensions::access_loggers::file::v3::FileAccessLog::AccessLogFormatCase::
       ACCESS_LOG_FORMAT_NOT_SET:
     formatter = THROW_OR_RETURN_VALUE(
@@ -74,6 +79,32 @@ AccessLog::InstanceSharedPtr FileAccessLogFactory::createAccessLogInstance(
                                          context.serverFactoryContext().accessLogManager());
 }
 
+AccessLog::InstanceSharedPtr FileAccessLogFactory::createBinaryAccessLogInstance(
+    const envoy::extensions::access_loggers::file::v3::FileAccessLog& fal_config,
+    AccessLog::FilterPtr&& filter, Server::Configuration::GenericFactoryContext& context,
+    const std::vector<Formatter::CommandParserPtr>& command_parsers) {
+  const auto& binary_format = fal_config.binary_format();
+  BinaryLogSchemaConstSharedPtr schema = THROW_OR_RETURN_VALUE(
+      BinaryLogSchema::create(binary_format, command_parsers), std::unique_ptr<BinaryLogSchema>);
+
+  Compression::Compressor::CompressorFactoryPtr compressor_factory;
+  if (binary_format.has_compressor_library()) {
+    auto& config_factory = Config::Utility::getAndCheckFactory<
+        Compression::Compressor::NamedCompressorLibraryConfigFactory>(
+        binary_format.compressor_library());
+    ProtobufTypes::MessagePtr message = Config::Utility::translateAnyToFactoryConfig(
+        binary_format.compressor_library().typed_config(), context.messageValidationVisitor(),
+        config_factory);
+    compressor_factory = config_factory.createCompressorFactoryFromProto(*message, context);
+  }
+
+  Filesystem::FilePathAndType file_info{Filesystem::DestinationType::File, fal_config.path()};
+  return std::make_shared<BinaryFileAccessLog>(
+      file_info, std::move(filter), binary_format, std::move(schema), std::move(compressor_factory),
+      context.serverFactoryContext().accessLogManager(),
+      context.serverFactoryContext().threadLocal());
+}
+
 ProtobufTypes::MessagePtr FileAccessLogFactory::createEmptyConfigProto() {
   return ProtobufTypes::MessagePtr{
       new envoy::extensions::access_loggers::file::v3::FileAccessLog()};
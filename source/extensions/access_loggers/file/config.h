@@ -1,6 +1,7 @@
 #pragma once
 
 #include "envoy/access_log/access_log_config.h"
+#include "envoy/extensions/access_loggers/file/v3/file.pb.h"
 
 namespace Envoy {
 namespace Extensions {
@@ -20,6 +21,12 @@ public:
   ProtobufTypes::MessagePtr createEmptyConfigProto() override;
 
   std::string name() const override;
+
+private:
+  AccessLog::InstanceSharedPtr createBinaryAccessLogInstance(
+      const envoy::extensions::access_loggers::file::v3::FileAccessLog& fal_config,
+      AccessLog::FilterPtr&& filter, Server::Configuration::GenericFactoryContext& context,
+      const std::vector<Formatter::CommandParserPtr>& command_parsers);
 };
 
 } // namespace File
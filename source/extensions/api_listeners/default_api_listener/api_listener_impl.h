@@ -75,6 +75,10 @@ protected:
       IS_ENVOY_BUG("Unexpected call to startUpstreamSecureTransport");
       return false;
     }
+    bool isOnlyFilter() override {
+      IS_ENVOY_BUG("Unexpected call to isOnlyFilter");
+      return false;
+    }
     Upstream::HostDescriptionConstSharedPtr upstreamHost() override { return nullptr; }
     void upstreamHost(Upstream::HostDescriptionConstSharedPtr) override {
       IS_ENVOY_BUG("Unexpected call to upstreamHost");
@@ -186,6 +190,7 @@ protected:
         IS_ENVOY_BUG("Unexpected function call");
         return false;
       }
+      bool canSpliceData() const override { return false; }
       absl::optional<std::chrono::milliseconds> lastRoundTripTime() const override { return {}; }
       void configureInitialCongestionWindow(uint64_t, std::chrono::microseconds) override {}
       absl::optional<uint64_t> congestionWindowInBytes() const override { return {}; }
@@ -0,0 +1,267 @@
+#include "source/extensions/clusters/common/dns_resolution_cache.h"
+
+#include "envoy/singleton/manager.h"
+
+#include "source/common/common/utility.h"
+#include "source/common/config/utility.h"
+#include "source/common/network/utility.h"
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_join.h"
+
+namespace Envoy {
+namespace Upstream {
+
+SINGLETON_MANAGER_REGISTRATION(dns_resolution_cache_manager);
+
+DnsResolutionCache::DnsResolutionCache(Event::Dispatcher& dispatcher,
+                                       KeyValueStorePtr key_value_store, uint32_t max_entries)
+    : dispatcher_(dispatcher), key_value_store_(std::move(key_value_store)),
+      max_entries_(max_entries) {
+  loadEntries();
+}
+
+DnsResolutionCache::~DnsResolutionCache() {
+  for (auto& [key, entry] : entries_) {
+    if (entry->active_query_ != nullptr) {
+      entry->active_query_->cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+    }
+  }
+}
+
+std::string DnsResolutionCache::entryKey(const std::string& dns_name,
+                                         Network::DnsLookupFamily dns_lookup_family) {
+  return absl::StrCat(static_cast<int>(dns_lookup_family), "|", dns_name);
+}
+
+Network::ActiveDnsQuery* DnsResolutionCache::resolve(const Network::DnsResolverSharedPtr& resolver,
+                                                     const std::string& dns_name,
+                                                     Network::DnsLookupFamily dns_lookup_family,
+                                                     Network::DnsResolver::ResolveCb callback) {
+  const std::string entry_key = entryKey(dns_name, dns_lookup_family);
+  // Callbacks invoked inline may add entries, which moves the pointers held by the map.
+  Entry* entry;
+  if (const auto it = entries_.find(entry_key); it != entries_.end()) {
+    entry = it->second.get();
+    lru_keys_.splice(lru_keys_.begin(), lru_keys_, entry->lru_position_);
+  } else {
+    evictEntries();
+    entry = &addEntry(entry_key, std::make_unique<Entry>(dns_name, dns_lookup_family));
+  }
+
+  const std::chrono::seconds ttl = std::chrono::duration_cast<std::chrono::seconds>(
+      entry->expiry_time_ - dispatcher_.timeSource().monotonicTime());
+  if (entry->persisted_ || ttl.count() > 0) {
+    // A persisted resolution is served with no TTL, so that the cluster resolves the name again at
+    // its refresh rate, by when the query started here has likely refreshed it.
+    if (entry->persisted_ && !entry->querying_) {
+      startQuery(resolver, entry_key, *entry);
+    }
+    std::list<Network::DnsResponse> responses;
+    for (const Network::DnsResponse& response : entry->responses_) {
+      responses.emplace_back(response.addrInfo().address_,
+                             entry->persisted_ ? std::chrono::seconds(0) : ttl);
+    }
+    ENVOY_LOG(trace, "DNS resolution of {} served from the cache", dns_name);
+    callback(Network::DnsResolver::ResolutionStatus::Completed, "cached", std::move(responses));
+    return nullptr;
+  }
+
+  auto pending_resolution = std::make_unique<PendingResolution>(*entry, std::move(callback));
+  PendingResolution* pending_resolution_ptr = pending_resolution.get();
+  LinkedList::moveIntoListBack(std::move(pending_resolution), entry->pending_resolutions_);
+  if (!entry->querying_) {
+    startQuery(resolver, entry_key, *entry);
+    if (entry->pending_resolutions_.empty()) {
+      // The query completed inline, and the resolution with it.
+      return nullptr;
+    }
+  }
+  return pending_resolution_ptr;
+}
+
+void DnsResolutionCache::startQuery(const Network::DnsResolverSharedPtr& resolver,
+                                    const std::string& key, Entry& entry) {
+  entry.resolver_ = resolver;
+  entry.querying_ = true;
+  Network::ActiveDnsQuery* active_query = resolver->resolve(
+      entry.dns_name_, entry.dns_lookup_family_,
+      [this, key, &entry](Network::DnsResolver::ResolutionStatus status, absl::string_view details,
+                          std::list<Network::DnsResponse>&& responses) {
+        onQueryComplete(key, entry, status, details, std::move(responses));
+      });
+  // The query may have completed inline.
+  if (entry.querying_) {
+    entry.active_query_ = active_query;
+  }
+}
+
+void DnsResolutionCache::onQueryComplete(const std::string& key, Entry& entry,
+                                         Network::DnsResolver::ResolutionStatus status,
+                                         absl::string_view details,
+                                         std::list<Network::DnsResponse>&& responses) {
+  entry.querying_ = false;
+  entry.active_query_ = nullptr;
+  entry.persisted_ = false;
+  // This may be the last reference to the resolver, which must not be destroyed from its own
+  // callback.
+  dispatcher_.post([resolver = std::move(entry.resolver_)]() {});
+
+  if (status == Network::DnsResolver::ResolutionStatus::Completed && !responses.empty()) {
+    std::chrono::seconds ttl = std::chrono::seconds::max();
+    for (const Network::DnsResponse& response : responses) {
+      ttl = std::min(ttl, response.addrInfo().ttl_);
+    }
+    entry.responses_ = std::list<Network::DnsResponse>(responses.begin(), responses.end());
+    entry.expiry_time_ = dispatcher_.timeSource().monotonicTime() + ttl;
+    if (key_value_store_ != nullptr) {
+      key_value_store_->addOrUpdate(
+          key,
+          absl::StrJoin(entry.responses_, "\n",
+                        [](std::string* out, const Network::DnsResponse& response) {
+                          absl::StrAppend(out, response.addrInfo().address_->asString(), "|",
+                                          response.addrInfo().ttl_.count());
+                        }),
+          absl::nullopt);
+    }
+  } else {
+    entry.responses_.clear();
+  }
+
+  // Only notify the resolutions pending on this query, a callback may resolve the name again. The
+  // entry must not be evicted by the resolutions of other names meanwhile.
+  entry.notifying_ = true;
+  for (size_t count = entry.pending_resolutions_.size();
+       count > 0 && !entry.pending_resolutions_.empty(); --count) {
+    PendingResolutionPtr pending_resolution =
+        entry.pending_resolutions_.front()->removeFromList(entry.pending_resolutions_);
+    pending_resolution->callback_(
+        status, details, std::list<Network::DnsResponse>(responses.begin(), responses.end()));
+  }
+  entry.notifying_ = false;
+}
+
+DnsResolutionCache::Entry& DnsResolutionCache::addEntry(const std::string& key,
+                                                        std::unique_ptr<Entry>&& entry) {
+  lru_keys_.push_front(key);
+  entry->lru_position_ = lru_keys_.begin();
+  return *entries_.emplace(key, std::move(entry)).first->second;
+}
+
+void DnsResolutionCache::evictEntries() {
+  // Entries with a query in flight or with resolutions to notify are in use, and are skipped. The
+  // cache may then go over its maximum until they complete.
+  for (auto key = lru_keys_.end(); entries_.size() >= max_entries_ && key != lru_keys_.begin();) {
+    --key;
+    const auto it = entries_.find(*key);
+    ASSERT(it != entries_.end());
+    const Entry& entry = *it->second;
+    if (entry.querying_ || entry.notifying_ || !entry.pending_resolutions_.empty()) {
+      continue;
+    }
+    ENVOY_LOG(debug, "evicting DNS resolution of {} from the cache", entry.dns_name_);
+    if (key_value_store_ != nullptr) {
+      key_value_store_->remove(*key);
+    }
+    entries_.erase(it);
+    key = lru_keys_.erase(key);
+  }
+}
+
+void DnsResolutionCache::loadEntries() {
+  if (key_value_store_ == nullptr) {
+    return;
+  }
+  // The store may hold more resolutions than the cache, e.g. if max_entries was lowered. The extra
+  // ones are removed once the iteration is done.
+  std::vector<std::string> extra_keys;
+  key_value_store_->iterate([this, &extra_keys](const std::string& key, const std::string& value) {
+    if (entries_.size() >= max_entries_) {
+      extra_keys.push_back(key);
+      return KeyValueStore::Iterate::Continue;
+    }
+    const std::vector<absl::string_view> key_parts = StringUtil::splitToken(key, "|");
+    int dns_lookup_family;
+    if (key_parts.size() != 2 || !absl::SimpleAtoi(key_parts[0], &dns_lookup_family) ||
+        dns_lookup_family < 0 ||
+        dns_lookup_family > static_cast<int>(Network::DnsLookupFamily::All)) {
+      ENVOY_LOG(warn, "Unable to parse DNS resolution cache key '{}'", key);
+      return KeyValueStore::Iterate::Continue;
+    }
+    auto entry = std::make_unique<Entry>(
+        std::string(key_parts[1]), static_cast<Network::DnsLookupFamily>(dns_lookup_family));
+    for (absl::string_view line : StringUtil::splitToken(value, "\n")) {
+      const std::vector<absl::string_view> parts = StringUtil::splitToken(line, "|");
+      Network::Address::InstanceConstSharedPtr address;
+      uint64_t ttl;
+      if (parts.size() == 2) {
+        address = Network::Utility::parseInternetAddressAndPortNoThrow(std::string(parts[0]));
+      }
+      if (address == nullptr || !absl::SimpleAtoi(parts[1], &ttl)) {
+        ENVOY_LOG(warn, "Unable to parse DNS resolution cache line '{}'", line);
+        return KeyValueStore::Iterate::Continue;
+      }
+      entry->responses_.emplace_back(address, std::chrono::seconds(ttl));
+    }
+    if (!entry->responses_.empty()) {
+      entry->persisted_ = true;
+      // Each loaded entry is more recently used than the ones loaded before it.
+      addEntry(key, std::move(entry));
+    }
+    return KeyValueStore::Iterate::Continue;
+  });
+  for (const std::string& key : extra_keys) {
+    key_value_store_->remove(key);
+  }
+  ENVOY_LOG(debug, "loaded {} DNS resolutions from the DNS resolution cache", entries_.size());
+}
+
+void DnsResolutionCache::PendingResolution::cancel(CancelReason) {
+  // The query keeps running for the other resolutions of the name and to refresh the cache.
+  removeFromList(entry_.pending_resolutions_);
+}
+
+DnsResolutionCacheManagerSharedPtr
+DnsResolutionCacheManager::get(Server::Configuration::ServerFactoryContext& context) {
+  return context.singletonManager().getTyped<DnsResolutionCacheManager>(
+      SINGLETON_MANAGER_REGISTERED_NAME(dns_resolution_cache_manager),
+      [&context] { return std::make_shared<DnsResolutionCacheManager>(context); });
+}
+
+absl::StatusOr<DnsResolutionCacheSharedPtr> DnsResolutionCacheManager::getCache(
+    const envoy::extensions::clusters::dns::v3::DnsCluster::ResolutionCache& config,
+    const envoy::config::core::v3::TypedExtensionConfig& dns_resolver_config) {
+  const auto existing_cache = caches_.find(config.name());
+  if (existing_cache != caches_.end()) {
+    if (!Protobuf::util::MessageDifferencer::Equivalent(config, existing_cache->second.config_)) {
+      return absl::InvalidArgumentError(fmt::format(
+          "config specified DNS resolution cache '{}' with different settings", config.name()));
+    }
+    if (!Protobuf::util::MessageDifferencer::Equivalent(
+            dns_resolver_config, existing_cache->second.dns_resolver_config_)) {
+      return absl::InvalidArgumentError(
+          fmt::format("config specified DNS resolution cache '{}' for clusters with different DNS "
+                      "resolvers",
+                      config.name()));
+    }
+    return existing_cache->second.cache_;
+  }
+
+  KeyValueStorePtr key_value_store;
+  if (config.has_key_value_config()) {
+    auto& factory = Config::Utility::getAndCheckFactory<KeyValueStoreFactory>(
+        config.key_value_config().config());
+    key_value_store =
+        factory.createStore(config.key_value_config(), context_.messageValidationVisitor(),
+                            context_.mainThreadDispatcher(), context_.api().fileSystem());
+  }
+  auto cache = std::make_shared<DnsResolutionCache>(
+      context_.mainThreadDispatcher(), std::move(key_value_store),
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, max_entries, DnsResolutionCache::DefaultMaxEntries));
+  caches_.emplace(config.name(), ActiveCache{config, dns_resolver_config, cache});
+  return cache;
+}
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "envoy/common/key_value_store.h"
+#include "envoy/common/time.h"
+#include "envoy/config/core/v3/extension.pb.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/extensions/clusters/dns/v3/dns_cluster.pb.h"
+#include "envoy/network/dns.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/singleton/instance.h"
+
+#include "source/common/common/linked_object.h"
+#include "source/common/common/logger.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * A cache of DNS resolutions shared by strict DNS clusters. A resolution is served from the cache
+ * until the shortest TTL of its addresses expires, and concurrent resolutions of the same name
+ * share a single DNS query. The resolutions can be persisted to a key value store, in which case
+ * the cache serves the persisted resolutions until the first DNS query of their name completes.
+ * The cache holds at most a maximum number of names, and evicts the least recently resolved name,
+ * from memory and from the key value store, to make room for a new one. Must only be used from the
+ * main thread.
+ */
+class DnsResolutionCache : Logger::Loggable<Logger::Id::upstream> {
+public:
+  static constexpr uint32_t DefaultMaxEntries = 1024;
+
+  /**
+   * @param dispatcher the main thread dispatcher.
+   * @param key_value_store the store to load and persist resolutions from and to, or nullptr.
+   * @param max_entries the maximum number of names to hold resolutions for.
+   */
+  DnsResolutionCache(Event::Dispatcher& dispatcher, KeyValueStorePtr key_value_store,
+                     uint32_t max_entries);
+  ~DnsResolutionCache();
+
+  /**
+   * Resolves a name through the cache, with the contract of Network::DnsResolver::resolve(). The
+   * callback is invoked inline, and nullptr returned, if the resolution is served from the cache.
+   * The TTL of a resolution served from the cache is the time left until it expires.
+   * @param resolver the resolver to query the name with if it is not cached. It is kept alive
+   *        until the query completes.
+   */
+  Network::ActiveDnsQuery* resolve(const Network::DnsResolverSharedPtr& resolver,
+                                   const std::string& dns_name,
+                                   Network::DnsLookupFamily dns_lookup_family,
+                                   Network::DnsResolver::ResolveCb callback);
+
+private:
+  struct Entry;
+
+  // A resolution waiting for the DNS query of its name.
+  class PendingResolution : public Network::ActiveDnsQuery,
+                            public LinkedObject<PendingResolution> {
+  public:
+    PendingResolution(Entry& entry, Network::DnsResolver::ResolveCb callback)
+        : entry_(entry), callback_(std::move(callback)) {}
+
+    // Network::ActiveDnsQuery
+    void cancel(CancelReason reason) override;
+    void addTrace(uint8_t) override {}
+    std::string getTraces() override { return {}; }
+
+    Entry& entry_;
+    const Network::DnsResolver::ResolveCb callback_;
+  };
+  using PendingResolutionPtr = std::unique_ptr<PendingResolution>;
+
+  struct Entry {
+    Entry(const std::string& dns_name, Network::DnsLookupFamily dns_lookup_family)
+        : dns_name_(dns_name), dns_lookup_family_(dns_lookup_family) {}
+
+    const std::string dns_name_;
+    const Network::DnsLookupFamily dns_lookup_family_;
+    // The addresses of the last successful resolution, with their TTL at the time of resolution.
+    std::list<Network::DnsResponse> responses_;
+    MonotonicTime expiry_time_;
+    // Whether the responses were loaded from the key value store and not refreshed since.
+    bool persisted_{};
+    // Whether a DNS query is in flight, and its resolver and handle.
+    bool querying_{};
+    Network::DnsResolverSharedPtr resolver_;
+    Network::ActiveDnsQuery* active_query_{};
+    std::list<PendingResolutionPtr> pending_resolutions_;
+    // Whether the pending resolutions are being notified of a query completion.
+    bool notifying_{};
+    // The position of the entry in lru_keys_.
+    std::list<std::string>::iterator lru_position_;
+  };
+
+  static std::string entryKey(const std::string& dns_name,
+                              Network::DnsLookupFamily dns_lookup_family);
+  void startQuery(const Network::DnsResolverSharedPtr& resolver, const std::string& key,
+                  Entry& entry);
+  void onQueryComplete(const std::string& key, Entry& entry,
+                       Network::DnsResolver::ResolutionStatus status, absl::string_view details,
+                       std::list<Network::DnsResponse>&& responses);
+  Entry& addEntry(const std::string& key, std::unique_ptr<Entry>&& entry);
+  // Evicts the least recently used entries that are not in use until there is room for one more.
+  void evictEntries();
+  void loadEntries();
+
+  Event::Dispatcher& dispatcher_;
+  const KeyValueStorePtr key_value_store_;
+  const uint32_t max_entries_;
+  absl::flat_hash_map<std::string, std::unique_ptr<Entry>> entries_;
+  // The keys of the entries, the most recently used first.
+  std::list<std::string> lru_keys_;
+};
+
+using DnsResolutionCacheSharedPtr = std::shared_ptr<DnsResolutionCache>;
+
+/**
+ * Gives the strict DNS clusters that configure a resolution cache with the same name the same
+ * cache.
+ */
+class DnsResolutionCacheManager : public Singleton::Instance {
+public:
+  DnsResolutionCacheManager(Server::Configuration::ServerFactoryContext& context)
+      : context_(context) {}
+
+  /**
+   * @return the manager of the server, created on first use.
+   */
+  static std::shared_ptr<DnsResolutionCacheManager>
+  get(Server::Configuration::ServerFactoryContext& context);
+
+  /**
+   * @param config the config of the cache.
+   * @param dns_resolver_config the config of the DNS resolver of the cluster. An empty config
+   *        stands for the default resolver of the server.
+   * @return the cache with the name of the config, created on first use, or an error if the
+   *         cache was created with a different config or for clusters with a different resolver,
+   *         whose resolutions may differ.
+   */
+  absl::StatusOr<DnsResolutionCacheSharedPtr>
+  getCache(const envoy::extensions::clusters::dns::v3::DnsCluster::ResolutionCache& config,
+           const envoy::config::core::v3::TypedExtensionConfig& dns_resolver_config);
+
+private:
+  struct ActiveCache {
+    const envoy::extensions::clusters::dns::v3::DnsCluster::ResolutionCache config_;
+    const envoy::config::core::v3::TypedExtensionConfig dns_resolver_config_;
+    const DnsResolutionCacheSharedPtr cache_;
+  };
+
+  Server::Configuration::ServerFactoryContext& context_;
+  absl::flat_hash_map<std::string, ActiveCache> caches_;
+};
+
+using DnsResolutionCacheManagerSharedPtr = std::shared_ptr<DnsResolutionCacheManager>;
+
+} // namespace Upstream
+} // namespace Envoy
@@ -44,6 +44,16 @@ StrictDnsClusterImpl::StrictDnsClusterImpl(
           Envoy::DnsUtils::getDnsLookupFamilyFromEnum(dns_cluster.dns_lookup_family())) {
   RETURN_ONLY_IF_NOT_OK_REF(creation_status);
 
+  if (dns_cluster.has_resolution_cache()) {
+    resolution_cache_manager_ = DnsResolutionCacheManager::get(context.serverFactoryContext());
+    // The resolver of the cluster comes from its typed_dns_resolver_config, or is the default
+    // resolver of the server if it has none.
+    auto cache_or_error = resolution_cache_manager_->getCache(
+        dns_cluster.resolution_cache(), dns_cluster.typed_dns_resolver_config());
+    SET_AND_RETURN_IF_NOT_OK(cache_or_error.status(), creation_status);
+    resolution_cache_ = std::move(cache_or_error.value());
+  }
+
   failure_backoff_strategy_ = Config::Utility::prepareDnsRefreshStrategy(
       dns_cluster, dns_refresh_rate_ms_.count(),
       context.serverFactoryContext().api().randomGenerator());
@@ -107,6 +117,16 @@ void StrictDnsClusterImpl::updateAllHosts(const HostVector& hosts_added,
       overprovisioning_factor_);
 }
 
+Network::ActiveDnsQuery*
+StrictDnsClusterImpl::resolve(const std::string& dns_address,
+                              Network::DnsResolver::ResolveCb callback) {
+  if (resolution_cache_ != nullptr) {
+    return resolution_cache_->resolve(dns_resolver_, dns_address, dns_lookup_family_,
+                                      std::move(callback));
+  }
+  return dns_resolver_->resolve(dns_address, dns_lookup_family_, std::move(callback));
+}
+
 StrictDnsClusterImpl::ResolveTarget::ResolveTarget(
     StrictDnsClusterImpl& parent, Event::Dispatcher& dispatcher, const std::string& dns_address,
     const uint32_t dns_port,
@@ -129,8 +149,8 @@ void StrictDnsClusterImpl::ResolveTarget::startResolve() {
   ENVOY_LOG(trace, "starting async DNS resolution for {}", dns_address_);
   parent_.info_->configUpdateStats().update_attempt_.inc();
 
-  active_query_ = parent_.dns_resolver_->resolve(
-      dns_address_, parent_.dns_lookup_family_,
+  active_query_ = parent_.resolve(
+      dns_address_,
       [this](Network::DnsResolver::ResolutionStatus status, absl::string_view details,
              std::list<Network::DnsResponse>&& response) -> void {
         active_query_ = nullptr;
@@ -7,6 +7,7 @@
 
 #include "source/common/upstream/cluster_factory_impl.h"
 #include "source/common/upstream/upstream_impl.h"
+#include "source/extensions/clusters/common/dns_resolution_cache.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -62,6 +63,8 @@ private:
 
   void updateAllHosts(const HostVector& hosts_added, const HostVector& hosts_removed,
                       uint32_t priority);
+  Network::ActiveDnsQuery* resolve(const std::string& dns_address,
+                                   Network::DnsResolver::ResolveCb callback);
 
   // ClusterImplBase
   void startPreInit() override;
@@ -71,6 +74,10 @@ private:
   const envoy::config::endpoint::v3::ClusterLoadAssignment load_assignment_;
   const LocalInfo::LocalInfo& local_info_;
   Network::DnsResolverSharedPtr dns_resolver_;
+  // Set if the resolutions go through a cache shared with other clusters. The cache must outlive
+  // the resolve targets, which may have resolutions pending on it.
+  DnsResolutionCacheManagerSharedPtr resolution_cache_manager_;
+  DnsResolutionCacheSharedPtr resolution_cache_;
   std::list<ResolveTargetPtr> resolve_targets_;
   const std::chrono::milliseconds dns_refresh_rate_ms_;
   const std::chrono::milliseconds dns_jitter_ms_;
@@ -3,6 +3,7 @@
 #include "envoy/extensions/filters/network/generic_proxy/codecs/http1/v3/http1.pb.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/character_set_validation.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/http1/balsa_parser.h"
 #include "source/common/http/http1/parser.h"
@@ -242,7 +243,7 @@ public:
 
   void completeCurrentHeader() {
     current_header_value_.rtrim();
-    current_header_field_.inlineTransform([](char c) { return absl::ascii_tolower(c); });
+    current_header_field_.inlineTransformBuffer(Http::asciiToLowerInPlace);
     headerMap().addViaMove(std::move(current_header_field_), std::move(current_header_value_));
 
     ASSERT(current_header_field_.empty());
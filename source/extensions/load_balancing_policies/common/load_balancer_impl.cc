@@ -954,6 +954,8 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
     : ZoneAwareLoadBalancerBase(priority_set, local_priority_set, stats, runtime, random,
                                 healthy_panic_threshold, locality_config),
       seed_(random_.random()),
+      build_schedulers_on_pick_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.build_edf_schedulers_on_pick")),
       slow_start_window_(slow_start_config.has_value()
                              ? std::chrono::milliseconds(DurationUtil::durationToMilliseconds(
                                    slow_start_config.value().slow_start_window()))
@@ -1061,18 +1063,14 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
       return;
     }
 
-    // Populate the scheduler with the host list with a randomized starting point.
-    // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
-    // weighted 1. This is because currently we don't refresh host sets if only weights change.
-    // We should probably change this to refresh at all times. See the comment in
-    // BaseDynamicClusterImpl::updateDynamicHostList about this.
-    scheduler.edf_ = std::make_unique<EdfScheduler<Host>>(EdfScheduler<Host>::createWithPicks(
-        hosts,
-        // We use a fixed weight here. While the weight may change without
-        // notification, this will only be stale until this host is next picked,
-        // at which point it is reinserted into the EdfScheduler with its new
-        // weight in chooseHost().
-        [this](const Host& host) { return hostWeight(host); }, seed_));
+    // The host vectors are immutable snapshots shared by all the workers, but every worker builds
+    // its own schedulers. A worker typically only picks from a few of the hosts sources, e.g. the
+    // healthy hosts of the local locality, so defer building the others until they are used.
+    if (build_schedulers_on_pick_) {
+      scheduler.build_on_pick_ = true;
+      return;
+    }
+    buildScheduler(scheduler, hosts);
   };
   // Populate EdfSchedulers for each valid HostsSource value for the host set at this priority.
   const auto& host_set = priority_set_.hostSetsPerPriority()[priority];
@@ -1095,6 +1093,22 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
   }
 }
 
+void EdfLoadBalancerBase::buildScheduler(Scheduler& scheduler, const HostVector& hosts) {
+  // Populate the scheduler with the host list with a randomized starting point.
+  // TODO(mattklein123): We must build the EDF schedule even if all of the hosts are currently
+  // weighted 1. This is because currently we don't refresh host sets if only weights change.
+  // We should probably change this to refresh at all times. See the comment in
+  // BaseDynamicClusterImpl::updateDynamicHostList about this.
+  scheduler.edf_ = std::make_unique<EdfScheduler<Host>>(EdfScheduler<Host>::createWithPicks(
+      hosts,
+      // We use a fixed weight here. While the weight may change without
+      // notification, this will only be stale until this host is next picked,
+      // at which point it is reinserted into the EdfScheduler with its new
+      // weight in chooseHost().
+      [this](const Host& host) { return hostWeight(host); }, seed_));
+  scheduler.build_on_pick_ = false;
+}
+
 bool EdfLoadBalancerBase::isSlowStartEnabled() const {
   return slow_start_window_ > std::chrono::milliseconds(0);
 }
@@ -1126,6 +1140,9 @@ HostConstSharedPtr EdfLoadBalancerBase::peekAnotherHost(LoadBalancerContext* con
   // hostSourceToUse() via the construction in refresh();
   ASSERT(scheduler_it != scheduler_.end());
   auto& scheduler = scheduler_it->second;
+  if (scheduler.build_on_pick_) {
+    buildScheduler(scheduler, hostSourceToHosts(*hosts_source));
+  }
 
   // As has been commented in both EdfLoadBalancerBase::refresh and
   // BaseDynamicClusterImpl::updateDynamicHostList, we must do a runtime pivot here to determine
@@ -1152,6 +1169,9 @@ HostConstSharedPtr EdfLoadBalancerBase::chooseHostOnce(LoadBalancerContext* cont
   // hostSourceToUse() via the construction in refresh();
   ASSERT(scheduler_it != scheduler_.end());
   auto& scheduler = scheduler_it->second;
+  if (scheduler.build_on_pick_) {
+    buildScheduler(scheduler, hostSourceToHosts(*hosts_source));
+  }
 
   // As has been commented in both EdfLoadBalancerBase::refresh and
   // BaseDynamicClusterImpl::updateDynamicHostList, we must do a runtime pivot here to determine
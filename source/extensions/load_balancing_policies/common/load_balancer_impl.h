@@ -532,6 +532,9 @@ protected:
     // host weights of 2 or more hosts differ. When not present, the
     // implementation of chooseHostOnce falls back to unweightedHostPick.
     std::unique_ptr<EdfScheduler<Host>> edf_;
+    // Whether the edf_ is needed but has not been built yet. It is built by the first pick from
+    // the hosts source.
+    bool build_on_pick_{};
   };
 
   void initialize();
@@ -560,12 +563,15 @@ private:
                                                 const HostsSource& source) PURE;
   virtual HostConstSharedPtr unweightedHostPick(const HostVector& hosts_to_use,
                                                 const HostsSource& source) PURE;
+  void buildScheduler(Scheduler& scheduler, const HostVector& hosts);
 
   // Scheduler for each valid HostsSource.
   absl::flat_hash_map<HostsSource, Scheduler, HostsSourceHash> scheduler_;
   Common::CallbackHandlePtr priority_update_cb_;
   Common::CallbackHandlePtr member_update_cb_;
   absl::flat_hash_set<uint32_t> dirty_priorities_;
+  // Whether EDF schedulers are only built for the hosts sources that are picked from.
+  const bool build_schedulers_on_pick_;
 
 protected:
   // Slow start related config
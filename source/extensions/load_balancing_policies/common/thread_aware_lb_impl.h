@@ -183,8 +183,13 @@ private:
     std::shared_ptr<DegradedLoad> degraded_per_priority_load_ ABSL_GUARDED_BY(mutex_);
   };
 
+  /**
+   * Creates the load balancer of a priority. Called on the main thread whenever the hosts change.
+   * @param priority the priority of the hosts. Implementations may keep the last load balancer of
+   *        each priority to build the next one from it.
+   */
   virtual HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double max_normalized_weight) PURE;
   void refresh();
 
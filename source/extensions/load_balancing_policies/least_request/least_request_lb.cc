@@ -1,5 +1,8 @@
 #include "source/extensions/load_balancing_policies/least_request/least_request_lb.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace Envoy {
 namespace Upstream {
 
@@ -55,15 +58,17 @@ HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPeek(const HostVector
 }
 
 HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector& hosts_to_use,
-                                                                const HostsSource&) {
+                                                                const HostsSource& source) {
   HostSharedPtr candidate_host = nullptr;
 
   switch (selection_method_) {
   case envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::FULL_SCAN:
-    candidate_host = unweightedHostPickFullScan(hosts_to_use);
+    candidate_host =
+        unweightedHostPickFullScan(hosts_to_use, activeRequestGauges(hosts_to_use, source));
     break;
   case envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest::N_CHOICES:
-    candidate_host = unweightedHostPickNChoices(hosts_to_use);
+    candidate_host =
+        unweightedHostPickNChoices(hosts_to_use, activeRequestGauges(hosts_to_use, source));
     break;
   default:
     IS_ENVOY_BUG("unknown selection method specified for least request load balancer");
@@ -72,72 +77,73 @@ HostConstSharedPtr LeastRequestLoadBalancer::unweightedHostPick(const HostVector
   return candidate_host;
 }
 
-HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVector& hosts_to_use) {
-  HostSharedPtr candidate_host = nullptr;
-
-  size_t num_hosts_known_tied_for_least = 0;
-
-  const size_t num_hosts = hosts_to_use.size();
+const LeastRequestLoadBalancer::ActiveRequestGauges&
+LeastRequestLoadBalancer::activeRequestGauges(const HostVector& hosts_to_use,
+                                              const HostsSource& source) {
+  ActiveRequestGauges& gauges = active_request_gauges_[source];
+  // The gauges are dropped whenever the hosts of the source change, the size check only guards
+  // against a pick between a host update and the refresh of the load balancer.
+  if (gauges.size() != hosts_to_use.size()) {
+    gauges.clear();
+    gauges.reserve(hosts_to_use.size());
+    for (const HostSharedPtr& host : hosts_to_use) {
+      gauges.push_back(&host->stats().rq_active_);
+    }
+  }
+  return gauges;
+}
 
+HostSharedPtr
+LeastRequestLoadBalancer::unweightedHostPickFullScan(const HostVector& hosts_to_use,
+                                                     const ActiveRequestGauges& gauges) {
+  // Read the active requests of all hosts first. The scans for the least of them and for the
+  // hosts tied for it then run over contiguous memory and can be vectorized.
+  const size_t num_hosts = gauges.size();
+  active_requests_.resize(num_hosts);
   for (size_t i = 0; i < num_hosts; ++i) {
-    const HostSharedPtr& sampled_host = hosts_to_use[i];
+    active_requests_[i] = gauges[i]->value();
+  }
 
-    if (candidate_host == nullptr) {
-      // Make a first choice to start the comparisons.
-      num_hosts_known_tied_for_least = 1;
-      candidate_host = sampled_host;
-      continue;
-    }
+  uint64_t least_active_rq = std::numeric_limits<uint64_t>::max();
+  for (const uint64_t active_rq : active_requests_) {
+    least_active_rq = std::min(least_active_rq, active_rq);
+  }
+  size_t num_hosts_tied_for_least = 0;
+  for (const uint64_t active_rq : active_requests_) {
+    num_hosts_tied_for_least += active_rq == least_active_rq;
+  }
 
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
-
-    if (sampled_active_rq < candidate_active_rq) {
-      // Reset the count of known tied hosts.
-      num_hosts_known_tied_for_least = 1;
-      candidate_host = sampled_host;
-    } else if (sampled_active_rq == candidate_active_rq) {
-      ++num_hosts_known_tied_for_least;
-
-      // Use reservoir sampling to select 1 unique sample from the total number of hosts N
-      // that will tie for least requests after processing the full hosts array.
-      //
-      // Upon each new tie encountered, replace candidate_host with sampled_host
-      // with probability (1 / num_hosts_known_tied_for_least percent).
-      // The end result is that each tied host has an equal 1 / N chance of being the
-      // candidate_host returned by this function.
-      const size_t random_tied_host_index = random_.random() % num_hosts_known_tied_for_least;
-      if (random_tied_host_index == 0) {
-        candidate_host = sampled_host;
-      }
+  // Each host tied for least requests has an equal 1 / N chance of being selected.
+  size_t tied_host_index =
+      num_hosts_tied_for_least > 1 ? random_.random() % num_hosts_tied_for_least : 0;
+  for (size_t i = 0; i < num_hosts; ++i) {
+    if (active_requests_[i] == least_active_rq && tied_host_index-- == 0) {
+      return hosts_to_use[i];
     }
   }
 
-  return candidate_host;
+  PANIC("not reached");
 }
 
-HostSharedPtr LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVector& hosts_to_use) {
-  HostSharedPtr candidate_host = nullptr;
+HostSharedPtr
+LeastRequestLoadBalancer::unweightedHostPickNChoices(const HostVector& hosts_to_use,
+                                                     const ActiveRequestGauges& gauges) {
+  // Only the index of the candidate is tracked, so that the host pointer is copied once.
+  size_t candidate_idx = 0;
+  uint64_t candidate_active_rq = 0;
 
   for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
-    const int rand_idx = random_.random() % hosts_to_use.size();
-    const HostSharedPtr& sampled_host = hosts_to_use[rand_idx];
+    const size_t rand_idx = random_.random() % hosts_to_use.size();
+    const uint64_t sampled_active_rq = gauges[rand_idx]->value();
 
-    if (candidate_host == nullptr) {
-      // Make a first choice to start the comparisons.
-      candidate_host = sampled_host;
-      continue;
-    }
-
-    const auto candidate_active_rq = candidate_host->stats().rq_active_.value();
-    const auto sampled_active_rq = sampled_host->stats().rq_active_.value();
-
-    if (sampled_active_rq < candidate_active_rq) {
-      candidate_host = sampled_host;
+    if (choice_idx == 0 || sampled_active_rq < candidate_active_rq) {
+      // The first choice starts the comparisons.
+      candidate_idx = rand_idx;
+      candidate_active_rq = sampled_active_rq;
     }
   }
 
-  return candidate_host;
+  return hosts_to_use[candidate_idx];
 }
 
 } // namespace Upstream
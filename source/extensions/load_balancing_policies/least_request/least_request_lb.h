@@ -1,7 +1,14 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
+#include "envoy/stats/primitive_stats.h"
+
 #include "source/extensions/load_balancing_policies/common/load_balancer_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -61,17 +68,37 @@ protected:
   }
 
 private:
-  void refreshHostSource(const HostsSource&) override {}
+  using ActiveRequestGauges = std::vector<const Stats::PrimitiveGauge*>;
+
+  void refreshHostSource(const HostsSource& source) override {
+    active_request_gauges_.erase(source);
+  }
   double hostWeight(const Host& host) const override;
   HostConstSharedPtr unweightedHostPeek(const HostVector& hosts_to_use,
                                         const HostsSource& source) override;
   HostConstSharedPtr unweightedHostPick(const HostVector& hosts_to_use,
                                         const HostsSource& source) override;
-  HostSharedPtr unweightedHostPickFullScan(const HostVector& hosts_to_use);
-  HostSharedPtr unweightedHostPickNChoices(const HostVector& hosts_to_use);
+  HostSharedPtr unweightedHostPickFullScan(const HostVector& hosts_to_use,
+                                           const ActiveRequestGauges& gauges);
+  HostSharedPtr unweightedHostPickNChoices(const HostVector& hosts_to_use,
+                                           const ActiveRequestGauges& gauges);
+
+  /**
+   * @return the active request gauges of the given hosts of a hosts source, in the same order.
+   * The gauges are collected at the first pick after the hosts of the source change.
+   */
+  const ActiveRequestGauges& activeRequestGauges(const HostVector& hosts_to_use,
+                                                 const HostsSource& source);
 
   const uint32_t choice_count_;
 
+  // The active request gauges of the hosts of each hosts source. Picks read the active requests
+  // of the sampled hosts through these contiguous arrays instead of through the host pointers.
+  absl::flat_hash_map<HostsSource, ActiveRequestGauges, HostsSourceHash> active_request_gauges_;
+  // The active requests of the hosts of a full scan, so that the scan for the least of them runs
+  // over contiguous memory.
+  std::vector<uint64_t> active_requests_;
+
   // The exponent used to calculate host weights can be configured via runtime. We cache it for
   // performance reasons and refresh it in `LeastRequestLoadBalancer::refresh(uint32_t priority)`
   // whenever a `HostSet` is updated.
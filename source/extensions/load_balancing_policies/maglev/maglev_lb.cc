@@ -88,12 +88,31 @@ TypedMaglevLbConfig::TypedMaglevLbConfig(const MaglevLbProto& lb_config,
       lb_config_(lb_config) {}
 
 ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr
-MaglevLoadBalancer::createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+MaglevLoadBalancer::createLoadBalancer(uint32_t priority,
+                                       const NormalizedHostWeightVector& normalized_host_weights,
                                        double /* min_normalized_weight */,
                                        double max_normalized_weight) {
-  HashingLoadBalancerSharedPtr maglev_lb =
-      MaglevFactory::createMaglevTable(normalized_host_weights, max_normalized_weight, table_size_,
-                                       use_hostname_for_hashing_, stats_);
+  if (tables_.size() <= priority) {
+    tables_.resize(priority + 1);
+  }
+  PriorityTable& priority_table = tables_[priority];
+  if (priority_table.builtFrom(normalized_host_weights, max_normalized_weight,
+                               use_hostname_for_hashing_)) {
+    ENVOY_LOG(debug, "maglev: hosts of priority {} did not change, reusing the table", priority);
+    priority_table.table_->reportStats();
+  } else {
+    priority_table.table_ =
+        MaglevFactory::createMaglevTable(normalized_host_weights, max_normalized_weight,
+                                         table_size_, use_hostname_for_hashing_, stats_);
+    priority_table.normalized_host_weights_ = normalized_host_weights;
+    priority_table.hash_keys_.clear();
+    for (const auto& host_weight : normalized_host_weights) {
+      priority_table.hash_keys_.emplace_back(
+          priority_table.table_->hashKey(host_weight.first, use_hostname_for_hashing_));
+    }
+    priority_table.max_normalized_weight_ = max_normalized_weight;
+  }
+  HashingLoadBalancerSharedPtr maglev_lb = priority_table.table_;
 
   if (hash_balance_factor_ == 0) {
     return maglev_lb;
@@ -103,6 +122,23 @@ MaglevLoadBalancer::createLoadBalancer(const NormalizedHostWeightVector& normali
       maglev_lb, std::move(normalized_host_weights), hash_balance_factor_);
 }
 
+bool MaglevLoadBalancer::PriorityTable::builtFrom(
+    const NormalizedHostWeightVector& normalized_host_weights, double max_normalized_weight,
+    bool use_hostname_for_hashing) const {
+  if (table_ == nullptr || max_normalized_weight != max_normalized_weight_ ||
+      normalized_host_weights != normalized_host_weights_) {
+    return false;
+  }
+  // The hash key of a host can change with its metadata.
+  for (size_t i = 0; i < normalized_host_weights.size(); ++i) {
+    if (table_->hashKey(normalized_host_weights[i].first, use_hostname_for_hashing) !=
+        hash_keys_[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void MaglevTable::constructMaglevTableInternal(
     const NormalizedHostWeightVector& normalized_host_weights, double max_normalized_weight,
     bool use_hostname_for_hashing) {
@@ -143,14 +179,14 @@ void MaglevTable::constructMaglevTableInternal(
   constructImplementationInternals(table_build_entries, max_normalized_weight);
 
   // Update Stats
-  uint64_t min_entries_per_host = table_size_;
-  uint64_t max_entries_per_host = 0;
+  host_count_ = table_build_entries.size();
+  min_entries_per_host_ = table_size_;
+  max_entries_per_host_ = 0;
   for (const auto& entry : table_build_entries) {
-    min_entries_per_host = std::min(entry.count_, min_entries_per_host);
-    max_entries_per_host = std::max(entry.count_, max_entries_per_host);
+    min_entries_per_host_ = std::min(entry.count_, min_entries_per_host_);
+    max_entries_per_host_ = std::max(entry.count_, max_entries_per_host_);
   }
-  stats_.min_entries_per_host_.set(min_entries_per_host);
-  stats_.max_entries_per_host_.set(max_entries_per_host);
+  reportStats();
 
   if (ENVOY_LOG_CHECK_LEVEL(trace)) {
     logMaglevTable(use_hostname_for_hashing);
@@ -308,6 +344,14 @@ void DegenerateMaglevTable::logMaglevTable(bool /*use_hostname_for_hashing*/) co
 MaglevTable::MaglevTable(uint64_t table_size, MaglevLoadBalancerStats& stats)
     : table_size_(table_size), stats_(stats) {}
 
+void MaglevTable::reportStats() const {
+  if (host_count_ == 0) {
+    return;
+  }
+  stats_.min_entries_per_host_.set(min_entries_per_host_);
+  stats_.max_entries_per_host_.set(max_entries_per_host_);
+}
+
 HostSelectionResponse OriginalMaglevTable::chooseHost(uint64_t hash, uint32_t attempt) const {
   if (table_.empty()) {
     return {nullptr};
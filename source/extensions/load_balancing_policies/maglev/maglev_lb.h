@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "envoy/common/pure.h"
 #include "envoy/common/random_generator.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -72,6 +75,11 @@ public:
    */
   virtual void logMaglevTable(bool use_hostname_for_hashing) const PURE;
 
+  /**
+   * Sets the entries per host stats to the ones of this table, if it has hosts.
+   */
+  void reportStats() const;
+
 protected:
   struct TableBuildEntry {
     TableBuildEntry(const HostConstSharedPtr& host, uint64_t offset, uint64_t skip, double weight)
@@ -96,6 +104,9 @@ protected:
 
   const uint64_t table_size_;
   MaglevLoadBalancerStats& stats_;
+  uint64_t host_count_{};
+  uint64_t min_entries_per_host_{};
+  uint64_t max_entries_per_host_{};
 
 private:
   /**
@@ -200,14 +211,28 @@ public:
 private:
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
                      double /* min_normalized_weight */, double max_normalized_weight) override;
 
+  // The table of a priority and what it was built from. The table only depends on the hosts, their
+  // hash keys and their weights, so it is reused while those do not change, e.g. when the hosts of
+  // another priority change.
+  struct PriorityTable {
+    bool builtFrom(const NormalizedHostWeightVector& normalized_host_weights,
+                   double max_normalized_weight, bool use_hostname_for_hashing) const;
+
+    MaglevTableSharedPtr table_;
+    NormalizedHostWeightVector normalized_host_weights_;
+    std::vector<std::string> hash_keys_;
+    double max_normalized_weight_{};
+  };
+
   Stats::ScopeSharedPtr scope_;
   MaglevLoadBalancerStats stats_;
   const uint64_t table_size_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  std::vector<PriorityTable> tables_;
 };
 
 } // namespace Upstream
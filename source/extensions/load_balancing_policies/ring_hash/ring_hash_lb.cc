@@ -1,7 +1,9 @@
 #include "source/extensions/load_balancing_policies/ring_hash/ring_hash_lb.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -9,7 +11,9 @@
 
 #include "source/common/common/assert.h"
 
+#include "absl/base/prefetch.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/numeric/bits.h"
 #include "absl/strings/string_view.h"
 
 namespace Envoy {
@@ -71,64 +75,126 @@ RingHashLoadBalancer::RingHashLoadBalancer(const PrioritySet& priority_set, Clus
   }
 }
 
+ThreadAwareLoadBalancerBase::HashingLoadBalancerSharedPtr RingHashLoadBalancer::createLoadBalancer(
+    uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
+    double min_normalized_weight, double /* max_normalized_weight */) {
+  if (rings_.size() <= priority) {
+    rings_.resize(priority + 1);
+  }
+  auto ring = std::make_shared<Ring>(normalized_host_weights, min_normalized_weight,
+                                     min_ring_size_, max_ring_size_, hash_function_,
+                                     use_hostname_for_hashing_, stats_, rings_[priority].get());
+  rings_[priority] = ring;
+  if (hash_balance_factor_ == 0) {
+    return ring;
+  }
+
+  return std::make_shared<BoundedLoadHashingLoadBalancer>(ring, normalized_host_weights,
+                                                          hash_balance_factor_);
+}
+
 RingHashLoadBalancerStats RingHashLoadBalancer::generateStats(Stats::Scope& scope) {
   return {ALL_RING_HASH_LOAD_BALANCER_STATS(POOL_GAUGE(scope))};
 }
 
+namespace {
+
+// The number of entries in the subtree of the entry at the given index of an Eytzinger table.
+uint64_t subtreeSize(uint64_t index, uint64_t table_size) {
+  uint64_t size = 0;
+  for (uint64_t first = index, width = 1; first <= table_size; first <<= 1, width <<= 1) {
+    size += std::min(table_size, first + width - 1) - first + 1;
+  }
+  return size;
+}
+
+} // namespace
+
 HostSelectionResponse RingHashLoadBalancer::Ring::chooseHost(uint64_t h, uint32_t attempt) const {
-  if (ring_.empty()) {
+  if (size_ == 0) {
     return {nullptr};
   }
 
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c (ketama_get_server)
-  // I've generally kept the variable names to make the code easier to compare.
-  // NOTE: The algorithm depends on using signed integers for lowp, midp, and highp. Do not
-  //       change them!
-  int64_t lowp = 0;
-  int64_t highp = ring_.size();
-  int64_t midp = 0;
-  while (true) {
-    midp = (lowp + highp) / 2;
+  // This selects the same entry as ketama
+  // (https://github.com/RJ/ketama/blob/master/libketama/ketama.c, ketama_get_server): the first
+  // entry with a hash of at least h, or the first entry of the ring if h is past the last one.
+  uint64_t index = lowerBound(h);
 
-    if (midp == static_cast<int64_t>(ring_.size())) {
-      midp = 0;
-      break;
-    }
+  // If a retry host predicate is being applied, behave as if this host was not in the ring.
+  // Note that this does not guarantee a different host: e.g., attempt == size_ or
+  // when the offset causes us to select the same host at another location in the ring.
+  if (attempt > 0) {
+    index = indexOf((positionOf(index) + attempt) % size_);
+  }
 
-    uint64_t midval = ring_[midp].hash_;
-    uint64_t midval1 = midp == 0 ? 0 : ring_[midp - 1].hash_;
+  return hosts_[hostIndex(index)];
+}
 
-    if (h <= midval && h > midval1) {
-      break;
+uint64_t RingHashLoadBalancer::Ring::lowerBound(uint64_t hash) const {
+  // Descend from the root, going right while the entry is less than the hash. The path then ends
+  // with a left turn at the entry that is searched for, followed by right turns only.
+  uint64_t index = 1;
+  while (index <= size_) {
+    // The descendants four levels down are 16 consecutive entries, fetch them ahead of time.
+    if (16 * index <= size_) {
+      absl::PrefetchToLocalCache(&hashes_[16 * index]);
     }
+    index = 2 * index + (hashes_[index] < hash);
+  }
+  index >>= absl::countr_one(index) + 1;
+  return index == 0 ? first_index_ : index;
+}
 
-    if (midval < h) {
-      lowp = midp + 1;
-    } else {
-      highp = midp - 1;
+uint64_t RingHashLoadBalancer::Ring::positionOf(uint64_t index) const {
+  // The entries before an entry are the ones of its left subtree, and for each ancestor whose right
+  // subtree it is in, the ancestor and its left subtree.
+  uint64_t position = subtreeSize(2 * index, size_);
+  for (; index > 1; index >>= 1) {
+    if (index & 1) {
+      position += subtreeSize(index - 1, size_) + 1;
     }
+  }
+  return position;
+}
 
-    if (lowp > highp) {
-      midp = 0;
-      break;
+uint64_t RingHashLoadBalancer::Ring::indexOf(uint64_t position) const {
+  uint64_t index = 1;
+  while (true) {
+    const uint64_t left_size = subtreeSize(2 * index, size_);
+    if (position == left_size) {
+      return index;
+    }
+    if (position < left_size) {
+      index = 2 * index;
+    } else {
+      position -= left_size + 1;
+      index = 2 * index + 1;
     }
   }
+}
 
-  // If a retry host predicate is being applied, behave as if this host was not in the ring.
-  // Note that this does not guarantee a different host: e.g., attempt == ring_.size() or
-  // when the offset causes us to select the same host at another location in the ring.
-  if (attempt > 0) {
-    midp = (midp + attempt) % ring_.size();
+uint64_t RingHashLoadBalancer::Ring::nextIndex(uint64_t index) const {
+  if (2 * index + 1 <= size_) {
+    // The leftmost entry of the right subtree.
+    index = 2 * index + 1;
+    while (2 * index <= size_) {
+      index = 2 * index;
+    }
+    return index;
   }
-
-  return ring_[midp].host_;
+  // The closest ancestor whose left subtree this is.
+  while (index & 1) {
+    index >>= 1;
+  }
+  return index >> 1;
 }
 
 using HashFunction = envoy::config::cluster::v3::Cluster::RingHashLbConfig::HashFunction;
 RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_host_weights,
                                  double min_normalized_weight, uint64_t min_ring_size,
                                  uint64_t max_ring_size, HashFunction hash_function,
-                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats)
+                                 bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats,
+                                 const Ring* previous)
     : stats_(stats) {
   ENVOY_LOG(trace, "ring hash: building ring");
 
@@ -148,7 +214,8 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
 
   // Reserve memory for the entire ring up front.
   const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
+  std::vector<RingEntry> ring;
+  ring.reserve(ring_size);
 
   // Populate the hash ring by walking through the (host, weight) pairs in
   // normalized_host_weights, and generating (scale * weight) hashes for each host. Since these
@@ -164,15 +231,49 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
   //     After only one run of the inner loop, current_hashes = 3, so the inner loop ends.
   //   - Likewise, the third host gets two hashes, and the fourth host gets one hash.
   //
+  // The i-th hash of a host only depends on its hash key and i, so a host that was on the previous
+  // ring with the same key keeps its first hashes there. Only the hashes past those are computed,
+  // and the hashes past the new count are removed from the previous ring.
+  //
   // For stats reporting, keep track of the minimum and maximum actual number of hashes per host.
   // Users should hopefully pay attention to these numbers and alert if min_hashes_per_host is too
   // low, since that implies an inaccurate request distribution.
 
   absl::InlinedVector<char, 196> hash_key_buffer;
+  const auto compute_hash = [&hash_key_buffer, hash_function](size_t key_size,
+                                                              uint64_t i) -> uint64_t {
+    hash_key_buffer.resize(key_size);
+    const std::string i_str = absl::StrCat("", i);
+    hash_key_buffer.insert(hash_key_buffer.end(), i_str.begin(), i_str.end());
+
+    absl::string_view hash_key(static_cast<char*>(hash_key_buffer.data()), hash_key_buffer.size());
+
+    const uint64_t hash = (hash_function == HashFunction::RingHash_HashFunction_MURMUR_HASH_2)
+                              ? MurmurHash::murmurHash2(hash_key, MurmurHash::STD_HASH_SEED)
+                              : HashUtil::xxHash64(hash_key);
+
+    ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key, hash);
+    return hash;
+  };
+
+  // The indices on this ring of the hosts of the previous ring, by their index on the previous
+  // ring, and whether some of their hashes are removed. Those hashes are counted by (hash, host
+  // index), in case a host has the same hash twice.
+  constexpr uint32_t NotOnRing = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> carried_over_indices;
+  std::vector<bool> shrunk_hosts;
+  if (previous != nullptr) {
+    carried_over_indices.assign(previous->hosts_.size(), NotOnRing);
+    shrunk_hosts.assign(previous->hosts_.size(), false);
+  }
+  absl::flat_hash_map<std::pair<uint64_t, uint32_t>, uint64_t> removed_hashes;
+  std::vector<RingEntry> added_entries;
+
   double current_hashes = 0.0;
   double target_hashes = 0.0;
   uint64_t min_hashes_per_host = ring_size;
   uint64_t max_hashes_per_host = 0;
+  host_hashes_.reserve(normalized_host_weights.size());
   for (const auto& entry : normalized_host_weights) {
     const auto& host = entry.first;
     const absl::string_view key_to_hash = hashKey(host, use_hostname_for_hashing);
@@ -180,39 +281,106 @@ RingHashLoadBalancer::Ring::Ring(const NormalizedHostWeightVector& normalized_ho
 
     hash_key_buffer.assign(key_to_hash.begin(), key_to_hash.end());
     hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
+    const size_t key_size = hash_key_buffer.size();
 
     // As noted above: maintain current_hashes and target_hashes as running sums across the entire
-    // host set. `i` is needed only to construct the hash key, and tally min/max hashes per host.
+    // host set.
     target_hashes += scale * entry.second;
-    uint64_t i = 0;
+    uint64_t count = 0;
     while (current_hashes < target_hashes) {
-      const std::string i_str = absl::StrCat("", i);
-      hash_key_buffer.insert(offset_start, i_str.begin(), i_str.end());
+      ++count;
+      ++current_hashes;
+    }
+    min_hashes_per_host = std::min(count, min_hashes_per_host);
+    max_hashes_per_host = std::max(count, max_hashes_per_host);
 
-      absl::string_view hash_key(static_cast<char*>(hash_key_buffer.data()),
-                                 hash_key_buffer.size());
+    const uint32_t host_index = hosts_.size();
+    host_hashes_[host.get()] = {std::string(key_to_hash), count, host_index};
+    if (count == 0) {
+      continue;
+    }
+    hosts_.push_back(host);
+
+    uint64_t carried_over = 0;
+    if (previous != nullptr) {
+      // Hosts without hashes on the previous ring are not referenced by it, so their pointers may
+      // have been reused by another host.
+      const auto it = previous->host_hashes_.find(host.get());
+      if (it != previous->host_hashes_.end() && it->second.count_ > 0 &&
+          it->second.key_ == key_to_hash) {
+        const uint64_t previous_count = it->second.count_;
+        carried_over = std::min(count, previous_count);
+        carried_over_indices[it->second.index_] = host_index;
+        shrunk_hosts[it->second.index_] = carried_over < previous_count;
+        for (uint64_t i = carried_over; i < previous_count; ++i) {
+          ++removed_hashes[{compute_hash(key_size, i), host_index}];
+        }
+      }
+    }
+    for (uint64_t i = carried_over; i < count; ++i) {
+      added_entries.push_back({compute_hash(key_size, i), host_index});
+    }
+  }
 
-      const uint64_t hash = (hash_function == HashFunction::RingHash_HashFunction_MURMUR_HASH_2)
-                                ? MurmurHash::murmurHash2(hash_key, MurmurHash::STD_HASH_SEED)
-                                : HashUtil::xxHash64(hash_key);
+  const auto by_hash = [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
+    return lhs.hash_ < rhs.hash_;
+  };
+  std::sort(added_entries.begin(), added_entries.end(), by_hash);
+  if (previous == nullptr) {
+    ring = std::move(added_entries);
+  } else {
+    // Merge the added entries into the sorted entries carried over from the previous ring.
+    auto next_added = added_entries.begin();
+    for (uint64_t index = previous->first_index_; index != 0; index = previous->nextIndex(index)) {
+      const uint32_t previous_host_index = previous->hostIndex(index);
+      const uint32_t host_index = carried_over_indices[previous_host_index];
+      if (host_index == NotOnRing) {
+        continue;
+      }
+      const RingEntry entry{previous->hashes_[index], host_index};
+      if (shrunk_hosts[previous_host_index]) {
+        const auto removed_it = removed_hashes.find({entry.hash_, host_index});
+        if (removed_it != removed_hashes.end() && removed_it->second > 0) {
+          --removed_it->second;
+          continue;
+        }
+      }
+      while (next_added != added_entries.end() && by_hash(*next_added, entry)) {
+        ring.push_back(*next_added++);
+      }
+      ring.push_back(entry);
+    }
+    ring.insert(ring.end(), next_added, added_entries.end());
+  }
 
-      ENVOY_LOG(trace, "ring hash: hash_key={} hash={}", hash_key, hash);
-      ring_.push_back({hash, host});
-      ++i;
-      ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
+  // Lay out the sorted ring in Eytzinger order, by walking the table in order.
+  size_ = ring.size();
+  if (size_ > 0) {
+    hashes_.resize(size_ + 1);
+    if (hosts_.size() <= std::numeric_limits<uint16_t>::max() + 1) {
+      narrow_host_indices_.resize(size_ + 1);
+    } else {
+      wide_host_indices_.resize(size_ + 1);
+    }
+    first_index_ = 1;
+    while (2 * first_index_ <= size_) {
+      first_index_ = 2 * first_index_;
+    }
+    uint64_t position = 0;
+    for (uint64_t index = first_index_; index != 0; index = nextIndex(index), ++position) {
+      hashes_[index] = ring[position].hash_;
+      if (narrow_host_indices_.empty()) {
+        wide_host_indices_[index] = ring[position].host_index_;
+      } else {
+        narrow_host_indices_[index] = ring[position].host_index_;
+      }
     }
-    min_hashes_per_host = std::min(i, min_hashes_per_host);
-    max_hashes_per_host = std::max(i, max_hashes_per_host);
   }
 
-  std::sort(ring_.begin(), ring_.end(), [](const RingEntry& lhs, const RingEntry& rhs) -> bool {
-    return lhs.hash_ < rhs.hash_;
-  });
   if (ENVOY_LOG_CHECK_LEVEL(trace)) {
-    for (const auto& entry : ring_) {
-      const absl::string_view key_to_hash = hashKey(entry.host_, use_hostname_for_hashing);
+    for (const auto& entry : ring) {
+      const absl::string_view key_to_hash =
+          hashKey(hosts_[entry.host_index_], use_hostname_for_hashing);
       ENVOY_LOG(trace, "ring hash: host={} hash={}", key_to_hash, entry.hash_);
     }
   }
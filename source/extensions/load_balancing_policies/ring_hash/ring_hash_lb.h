@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -13,6 +14,8 @@
 #include "source/common/common/logger.h"
 #include "source/extensions/load_balancing_policies/common/thread_aware_lb_impl.h"
 
+#include "absl/container/flat_hash_map.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -73,18 +76,73 @@ private:
 
   struct RingEntry {
     uint64_t hash_;
-    HostConstSharedPtr host_;
+    // The index of the host in the host table of the ring.
+    uint32_t host_index_;
   };
 
+  /**
+   * The ring is stored as a flat lookup table: the hashes are kept in one array in Eytzinger
+   * (breadth first) order, so that the first levels of every lookup share a few cache lines and
+   * the next levels can be prefetched, and each hash has a 16 or 32 bit index into a table of the
+   * distinct hosts instead of a host pointer. Entry k of the table has its children at 2k and
+   * 2k + 1, and entry 0 is unused.
+   */
   struct Ring : public HashingLoadBalancer {
+    /**
+     * Builds the ring for the given hosts. If the ring of the previous host set of the priority is
+     * given, the hashes of the hosts that are still present are carried over from it instead of
+     * being recomputed, and only the hashes of the added and removed hosts are merged into it. A
+     * small change of a large host set then costs a linear pass over the ring instead of hashing
+     * and sorting all of it. The resulting ring is the same either way.
+     */
     Ring(const NormalizedHostWeightVector& normalized_host_weights, double min_normalized_weight,
          uint64_t min_ring_size, uint64_t max_ring_size, HashFunction hash_function,
-         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats);
+         bool use_hostname_for_hashing, RingHashLoadBalancerStats& stats, const Ring* previous);
 
     // ThreadAwareLoadBalancerBase::HashingLoadBalancer
     HostSelectionResponse chooseHost(uint64_t hash, uint32_t attempt) const override;
 
-    std::vector<RingEntry> ring_;
+    /**
+     * @return the table index of the first entry with a hash of at least the given hash, or of the
+     *         first entry of the ring if there is none.
+     */
+    uint64_t lowerBound(uint64_t hash) const;
+
+    /**
+     * @return the position on the ring of the entry at the given table index, and the other way
+     *         around.
+     */
+    uint64_t positionOf(uint64_t index) const;
+    uint64_t indexOf(uint64_t position) const;
+
+    /**
+     * @return the table index of the entry that follows the given one on the ring, or 0 after the
+     *         last entry.
+     */
+    uint64_t nextIndex(uint64_t index) const;
+
+    uint32_t hostIndex(uint64_t index) const {
+      return narrow_host_indices_.empty() ? wide_host_indices_[index]
+                                          : narrow_host_indices_[index];
+    }
+
+    struct HostHashes {
+      std::string key_;
+      uint64_t count_;
+      uint32_t index_;
+    };
+
+    uint64_t size_{};
+    uint64_t first_index_{};
+    std::vector<uint64_t> hashes_;
+    // Only one of the host index tables is used, depending on the number of hosts.
+    std::vector<uint16_t> narrow_host_indices_;
+    std::vector<uint32_t> wide_host_indices_;
+    std::vector<HostConstSharedPtr> hosts_;
+    // The hash key, the number of hashes on the ring and the index in the host table of each host.
+    // The host table holds references to the hosts with hashes, so the pointers of those stay valid
+    // as long as the ring.
+    absl::flat_hash_map<const Host*, HostHashes> host_hashes_;
 
     RingHashLoadBalancerStats& stats_;
   };
@@ -92,18 +150,8 @@ private:
 
   // ThreadAwareLoadBalancerBase
   HashingLoadBalancerSharedPtr
-  createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
-                     double min_normalized_weight, double /* max_normalized_weight */) override {
-    HashingLoadBalancerSharedPtr ring_hash_lb =
-        std::make_shared<Ring>(normalized_host_weights, min_normalized_weight, min_ring_size_,
-                               max_ring_size_, hash_function_, use_hostname_for_hashing_, stats_);
-    if (hash_balance_factor_ == 0) {
-      return ring_hash_lb;
-    }
-
-    return std::make_shared<BoundedLoadHashingLoadBalancer>(
-        ring_hash_lb, std::move(normalized_host_weights), hash_balance_factor_);
-  }
+  createLoadBalancer(uint32_t priority, const NormalizedHostWeightVector& normalized_host_weights,
+                     double min_normalized_weight, double /* max_normalized_weight */) override;
 
   static RingHashLoadBalancerStats generateStats(Stats::Scope& scope);
 
@@ -117,6 +165,8 @@ private:
   const HashFunction hash_function_;
   const bool use_hostname_for_hashing_;
   const uint32_t hash_balance_factor_;
+  // The current ring of each priority, which the next ring of the priority is built from.
+  std::vector<RingConstSharedPtr> rings_;
 };
 
 } // namespace Upstream
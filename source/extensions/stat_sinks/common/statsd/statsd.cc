@@ -46,10 +46,11 @@ void UdpStatsdSink::WriterImpl::writeBuffer(Buffer::Instance& data) {
 UdpStatsdSink::UdpStatsdSink(ThreadLocal::SlotAllocator& tls,
                              Network::Address::InstanceConstSharedPtr address, const bool use_tag,
                              const std::string& prefix, absl::optional<uint64_t> buffer_size,
-                             const Statsd::TagFormat& tag_format)
+                             const Statsd::TagFormat& tag_format, bool report_changed_metrics_only)
     : tls_(tls.allocateSlot()), server_address_(std::move(address)), use_tag_(use_tag),
       prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
-      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+      buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+      report_changed_metrics_only_(report_changed_metrics_only) {
   tls_->set([this](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr {
     return std::make_shared<WriterImpl>(*this);
   });
@@ -60,18 +61,22 @@ void UdpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
   Buffer::OwnedImpl buffer;
 
   for (const auto& counter : snapshot.counters()) {
-    if (counter.counter_.get().used()) {
+    if (counter.counter_.get().used() && (counter.delta_ != 0 || !report_changed_metrics_only_)) {
       const std::string counter_str = buildMessage(counter.counter_.get(), counter.delta_, "|c");
       writeBuffer(buffer, writer, counter_str);
     }
   }
 
   for (const auto& counter : snapshot.hostCounters()) {
+    if (counter.delta() == 0 && report_changed_metrics_only_) {
+      continue;
+    }
     const std::string counter_str = buildMessage(counter, counter.delta(), "|c");
     writeBuffer(buffer, writer, counter_str);
   }
 
-  for (const auto& gauge : snapshot.gauges()) {
+  for (const auto& gauge :
+       report_changed_metrics_only_ ? snapshot.changedGauges() : snapshot.gauges()) {
     if (gauge.get().used()) {
       const std::string gauge_str = buildMessage(gauge.get(), gauge.get().value(), "|g");
       writeBuffer(buffer, writer, gauge_str);
@@ -188,8 +193,10 @@ const std::string UdpStatsdSink::buildTagStr(const std::vector<Stats::Tag>& tags
 TcpStatsdSink::TcpStatsdSink(const LocalInfo::LocalInfo& local_info,
                              const std::string& cluster_name, ThreadLocal::SlotAllocator& tls,
                              Upstream::ClusterManager& cluster_manager, Stats::Scope& scope,
-                             absl::Status& creation_status, const std::string& prefix)
-    : prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix), tls_(tls.allocateSlot()),
+                             absl::Status& creation_status, const std::string& prefix,
+                             bool report_changed_metrics_only)
+    : prefix_(prefix.empty() ? Statsd::getDefaultPrefix() : prefix),
+      report_changed_metrics_only_(report_changed_metrics_only), tls_(tls.allocateSlot()),
       cluster_manager_(cluster_manager),
       cx_overflow_stat_(scope.counterFromStatName(
           Stats::StatNameManagedStorage("statsd.cx_overflow", scope.symbolTable()).statName())) {
@@ -208,10 +215,12 @@ TcpStatsdSink::TcpStatsdSink(const LocalInfo::LocalInfo& local_info,
 absl::StatusOr<std::unique_ptr<TcpStatsdSink>>
 TcpStatsdSink::create(const LocalInfo::LocalInfo& local_info, const std::string& cluster_name,
                       ThreadLocal::SlotAllocator& tls, Upstream::ClusterManager& cluster_manager,
-                      Stats::Scope& scope, const std::string& prefix) {
+                      Stats::Scope& scope, const std::string& prefix,
+                      bool report_changed_metrics_only) {
   absl::Status creation_status;
-  auto sink = std::unique_ptr<TcpStatsdSink>(new TcpStatsdSink(
-      local_info, cluster_name, tls, cluster_manager, scope, creation_status, prefix));
+  auto sink = std::unique_ptr<TcpStatsdSink>(
+      new TcpStatsdSink(local_info, cluster_name, tls, cluster_manager, scope, creation_status,
+                        prefix, report_changed_metrics_only));
   RETURN_IF_NOT_OK_REF(creation_status);
   return sink;
 }
@@ -220,16 +229,19 @@ void TcpStatsdSink::flush(Stats::MetricSnapshot& snapshot) {
   TlsSink& tls_sink = tls_->getTyped<TlsSink>();
   tls_sink.beginFlush(true);
   for (const auto& counter : snapshot.counters()) {
-    if (counter.counter_.get().used()) {
+    if (counter.counter_.get().used() && (counter.delta_ != 0 || !report_changed_metrics_only_)) {
       tls_sink.flushCounter(counter.counter_.get().name(), counter.delta_);
     }
   }
 
   for (const auto& counter : snapshot.hostCounters()) {
-    tls_sink.flushCounter(counter.name(), counter.delta());
+    if (counter.delta() != 0 || !report_changed_metrics_only_) {
+      tls_sink.flushCounter(counter.name(), counter.delta());
+    }
   }
 
-  for (const auto& gauge : snapshot.gauges()) {
+  for (const auto& gauge :
+       report_changed_metrics_only_ ? snapshot.changedGauges() : snapshot.gauges()) {
     if (gauge.get().used()) {
       tls_sink.flushGauge(gauge.get().name(), gauge.get().value());
     }
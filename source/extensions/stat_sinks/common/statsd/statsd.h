@@ -44,15 +44,18 @@ public:
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, Network::Address::InstanceConstSharedPtr address,
                 const bool use_tag, const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
-                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat());
+                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat(),
+                bool report_changed_metrics_only = false);
   // For testing.
   UdpStatsdSink(ThreadLocal::SlotAllocator& tls, const std::shared_ptr<Writer>& writer,
                 const bool use_tag, const std::string& prefix = getDefaultPrefix(),
                 absl::optional<uint64_t> buffer_size = absl::nullopt,
-                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat())
+                const Statsd::TagFormat& tag_format = Statsd::getDefaultTagFormat(),
+                bool report_changed_metrics_only = false)
       : tls_(tls.allocateSlot()), use_tag_(use_tag),
         prefix_(prefix.empty() ? getDefaultPrefix() : prefix),
-        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format) {
+        buffer_size_(buffer_size.value_or(0)), tag_format_(tag_format),
+        report_changed_metrics_only_(report_changed_metrics_only) {
     tls_->set(
         [writer](Event::Dispatcher&) -> ThreadLocal::ThreadLocalObjectSharedPtr { return writer; });
   }
@@ -98,6 +101,8 @@ private:
   const std::string prefix_;
   const uint64_t buffer_size_;
   const Statsd::TagFormat tag_format_;
+  // Skip the counters and gauges that did not change since the previous flush.
+  const bool report_changed_metrics_only_;
 };
 
 /**
@@ -111,7 +116,8 @@ public:
   static absl::StatusOr<std::unique_ptr<TcpStatsdSink>>
   create(const LocalInfo::LocalInfo& local_info, const std::string& cluster_name,
          ThreadLocal::SlotAllocator& tls, Upstream::ClusterManager& cluster_manager,
-         Stats::Scope& scope, const std::string& prefix = getDefaultPrefix());
+         Stats::Scope& scope, const std::string& prefix = getDefaultPrefix(),
+         bool report_changed_metrics_only = false);
 
   // Stats::Sink
   void flush(Stats::MetricSnapshot& snapshot) override;
@@ -123,7 +129,8 @@ protected:
   TcpStatsdSink(const LocalInfo::LocalInfo& local_info, const std::string& cluster_name,
                 ThreadLocal::SlotAllocator& tls, Upstream::ClusterManager& cluster_manager,
                 Stats::Scope& scope, absl::Status& creation_status,
-                const std::string& prefix = getDefaultPrefix());
+                const std::string& prefix = getDefaultPrefix(),
+                bool report_changed_metrics_only = false);
 
 private:
   struct TlsSink : public ThreadLocal::ThreadLocalObject, public Network::ConnectionCallbacks {
@@ -161,6 +168,8 @@ private:
 
   // Prefix for all flushed stats.
   const std::string prefix_;
+  // Skip the counters and gauges that did not change since the previous flush.
+  const bool report_changed_metrics_only_;
 
   Upstream::ClusterInfoConstSharedPtr cluster_info_;
   ThreadLocal::SlotPtr tls_;
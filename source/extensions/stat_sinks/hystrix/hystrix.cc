@@ -90,6 +90,17 @@ uint64_t HystrixSink::getRollingValue(RollingWindow rolling_window) {
 
 void HystrixSink::updateRollingWindowMap(const Upstream::ClusterInfo& cluster_info,
                                          ClusterStatsCache& cluster_stats_cache) {
+  if (!cluster_info.trafficStats().isPresent()) {
+    // The cluster has not seen any traffic, report zeros rather than instantiating its deferred
+    // stats.
+    pushNewValue(cluster_stats_cache.timeouts_, 0);
+    pushNewValue(cluster_stats_cache.errors_, 0);
+    pushNewValue(cluster_stats_cache.success_, 0);
+    pushNewValue(cluster_stats_cache.rejected_, 0);
+    pushNewValue(cluster_stats_cache.total_, 0);
+    return;
+  }
+
   Upstream::ClusterTrafficStats& cluster_stats = *cluster_info.trafficStats();
   Stats::Scope& cluster_stats_scope = cluster_info.statsScope();
 
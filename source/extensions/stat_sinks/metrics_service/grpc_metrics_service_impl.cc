@@ -97,18 +97,25 @@ MetricsPtr MetricsFlusher::flush(Stats::MetricSnapshot& snapshot) const {
                                  snapshot.snapshotTime().time_since_epoch())
                                  .count();
   for (const auto& counter : snapshot.counters()) {
+    if (report_changed_metrics_only_ && counter.delta_ == 0) {
+      continue;
+    }
     if (predicate_(counter.counter_.get())) {
       flushCounter(*metrics->Add(), counter, snapshot_time_ms);
     }
   }
 
-  for (const auto& gauge : snapshot.gauges()) {
+  for (const auto& gauge :
+       report_changed_metrics_only_ ? snapshot.changedGauges() : snapshot.gauges()) {
     if (predicate_(gauge)) {
       flushGauge(*metrics->Add(), gauge.get(), snapshot_time_ms);
     }
   }
 
   for (const auto& histogram : snapshot.histograms()) {
+    if (report_changed_metrics_only_ && histogram.get().intervalStatistics().sampleCount() == 0) {
+      continue;
+    }
     if (predicate_(histogram.get())) {
       if (emit_summary_) {
         flushSummary(*metrics->Add(), histogram.get(), snapshot_time_ms);
@@ -97,13 +97,14 @@ public:
   MetricsFlusher(
       bool report_counters_as_deltas, bool emit_labels, HistogramEmitMode histogram_emit_mode,
       std::function<bool(const Stats::Metric&)> predicate =
-          [](const auto& metric) { return metric.used(); })
+          [](const auto& metric) { return metric.used(); },
+      bool report_changed_metrics_only = false)
       : report_counters_as_deltas_(report_counters_as_deltas), emit_labels_(emit_labels),
         emit_summary_(histogram_emit_mode == HistogramEmitMode::SUMMARY_AND_HISTOGRAM ||
                       histogram_emit_mode == HistogramEmitMode::SUMMARY),
         emit_histogram_(histogram_emit_mode == HistogramEmitMode::SUMMARY_AND_HISTOGRAM ||
                         histogram_emit_mode == HistogramEmitMode::HISTOGRAM),
-        predicate_(predicate) {}
+        report_changed_metrics_only_(report_changed_metrics_only), predicate_(predicate) {}
 
   MetricsPtr flush(Stats::MetricSnapshot& snapshot) const;
 
@@ -128,6 +129,8 @@ private:
   const bool emit_labels_;
   const bool emit_summary_;
   const bool emit_histogram_;
+  // Skip the metrics that did not change since the previous flush.
+  const bool report_changed_metrics_only_;
   const std::function<bool(const Stats::Metric&)> predicate_;
 };
 
@@ -138,10 +141,14 @@ template <class RequestProto, class ResponseProto> class MetricsServiceSink : pu
 public:
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
-      bool report_counters_as_deltas, bool emit_labels, HistogramEmitMode histogram_emit_mode)
+      bool report_counters_as_deltas, bool emit_labels, HistogramEmitMode histogram_emit_mode,
+      bool report_changed_metrics_only = false)
       : MetricsServiceSink(
             grpc_metrics_streamer,
-            MetricsFlusher(report_counters_as_deltas, emit_labels, histogram_emit_mode)) {}
+            MetricsFlusher(
+                report_counters_as_deltas, emit_labels, histogram_emit_mode,
+                [](const Stats::Metric& metric) { return metric.used(); },
+                report_changed_metrics_only)) {}
 
   MetricsServiceSink(
       const GrpcMetricsStreamerSharedPtr<RequestProto, ResponseProto>& grpc_metrics_streamer,
@@ -275,6 +275,9 @@ OtlpOptions::OtlpOptions(const SinkConfig& sink_config,
                          Server::Configuration::ServerFactoryContext& server)
     : report_counters_as_deltas_(sink_config.report_counters_as_deltas()),
       report_histograms_as_deltas_(sink_config.report_histograms_as_deltas()),
+      // Aggregated metrics are built from the values of all the stats they match.
+      report_changed_metrics_only_(sink_config.report_changed_metrics_only() &&
+                                   !sink_config.has_custom_metric_conversions()),
       emit_tags_as_attributes_(
           PROTOBUF_GET_WRAPPED_OR_DEFAULT(sink_config, emit_tags_as_attributes, true)),
       use_tag_extracted_name_(
@@ -373,8 +376,11 @@ MetricAggregator::SortedAttributesVector OtlpMetricsFlusherImpl::getCombinedAttr
 
 template <typename SinkType>
 void OtlpMetricsFlusherImpl::sinkMetrics(Stats::MetricSnapshot& snapshot, SinkType& sink) const {
+  const bool report_changed_metrics_only = config_->reportChangedMetricsOnly();
+
   // Process Gauges
-  for (const auto& gauge : snapshot.gauges()) {
+  for (const auto& gauge :
+       report_changed_metrics_only ? snapshot.changedGauges() : snapshot.gauges()) {
     const auto& g = gauge.get();
     if (predicate_(g)) {
       auto metric_config = getMetricConfig(g);
@@ -398,6 +404,9 @@ void OtlpMetricsFlusherImpl::sinkMetrics(Stats::MetricSnapshot& snapshot, SinkTy
   const bool report_counters_as_deltas = config_->reportCountersAsDeltas();
   for (const auto& counter : snapshot.counters()) {
     const auto& c = counter.counter_.get();
+    if (report_changed_metrics_only && counter.delta_ == 0) {
+      continue;
+    }
     if (predicate_(c)) {
       auto metric_config = getMetricConfig(c);
       if (metric_config.drop_stat) {
@@ -422,6 +431,9 @@ void OtlpMetricsFlusherImpl::sinkMetrics(Stats::MetricSnapshot& snapshot, SinkTy
   const bool report_histograms_as_deltas = config_->reportHistogramsAsDeltas();
   for (const auto& histogram : snapshot.histograms()) {
     const auto& h = histogram.get();
+    if (report_changed_metrics_only && h.intervalStatistics().sampleCount() == 0) {
+      continue;
+    }
     if (predicate_(h)) {
       auto metric_config = getMetricConfig(h);
       if (metric_config.drop_stat) {
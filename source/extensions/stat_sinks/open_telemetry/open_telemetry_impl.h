@@ -223,6 +223,7 @@ public:
 
   bool reportCountersAsDeltas() { return report_counters_as_deltas_; }
   bool reportHistogramsAsDeltas() { return report_histograms_as_deltas_; }
+  bool reportChangedMetricsOnly() { return report_changed_metrics_only_; }
   bool emitTagsAsAttributes() { return emit_tags_as_attributes_; }
   bool useTagExtractedName() { return use_tag_extracted_name_; }
   absl::string_view statPrefix() { return stat_prefix_; }
@@ -242,6 +243,7 @@ public:
 private:
   const bool report_counters_as_deltas_;
   const bool report_histograms_as_deltas_;
+  const bool report_changed_metrics_only_;
   const bool emit_tags_as_attributes_;
   const bool use_tag_extracted_name_;
   const std::string stat_prefix_;
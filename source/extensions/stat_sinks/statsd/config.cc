@@ -27,14 +27,16 @@ StatsdSinkFactory::createStatsSink(const Protobuf::Message& config,
     RETURN_IF_NOT_OK_REF(address_or_error.status());
     Network::Address::InstanceConstSharedPtr address = address_or_error.value();
     ENVOY_LOG(debug, "statsd UDP ip address: {}", address->asString());
-    return std::make_unique<Common::Statsd::UdpStatsdSink>(server.threadLocal(), std::move(address),
-                                                           false, statsd_sink.prefix());
+    return std::make_unique<Common::Statsd::UdpStatsdSink>(
+        server.threadLocal(), std::move(address), false, statsd_sink.prefix(), absl::nullopt,
+        Common::Statsd::getDefaultTagFormat(), statsd_sink.report_changed_metrics_only());
   }
   case envoy::config::metrics::v3::StatsdSink::StatsdSpecifierCase::kTcpClusterName:
     ENVOY_LOG(debug, "statsd TCP cluster: {}", statsd_sink.tcp_cluster_name());
-    return Common::Statsd::TcpStatsdSink::create(server.localInfo(), statsd_sink.tcp_cluster_name(),
-                                                 server.threadLocal(), server.clusterManager(),
-                                                 server.scope(), statsd_sink.prefix());
+    return Common::Statsd::TcpStatsdSink::create(
+        server.localInfo(), statsd_sink.tcp_cluster_name(), server.threadLocal(),
+        server.clusterManager(), server.scope(), statsd_sink.prefix(),
+        statsd_sink.report_changed_metrics_only());
   case envoy::config::metrics::v3::StatsdSink::StatsdSpecifierCase::STATSD_SPECIFIER_NOT_SET:
     return absl::InvalidArgumentError("unexpected statsd specifier: statsd_specifier not set");
   }
@@ -155,6 +155,17 @@ HotRestartImpl::mergeParentStatsIfAny(Stats::StoreRoot& stats_store) {
   return response;
 }
 
+void HotRestartImpl::getParentTlsSessions(const TlsSessionCb& cb) {
+  std::unique_ptr<envoy::HotRestartMessage> wrapper_msg = as_child_.getParentTlsSessions();
+  if (wrapper_msg == nullptr) {
+    return;
+  }
+  for (const auto& session : wrapper_msg->reply().tls_sessions().sessions()) {
+    cb(session.id(), session.session(),
+       SystemTime(std::chrono::seconds(session.expire_time_unix_seconds())));
+  }
+}
+
 void HotRestartImpl::shutdown() {
   as_parent_.shutdown();
   as_child_.shutdown();
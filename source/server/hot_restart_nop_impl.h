@@ -31,6 +31,7 @@ public:
   }
   void sendParentTerminateRequest() override {}
   ServerStatsFromParent mergeParentStatsIfAny(Stats::StoreRoot&) override { return {}; }
+  void getParentTlsSessions(const TlsSessionCb&) override {}
   void shutdown() override {}
   uint32_t baseId() override { return 0; }
   std::string version() override { return "disabled"; }
@@ -7,6 +7,7 @@
 #include "source/common/stats/stat_merger.h"
 #include "source/common/stats/symbol_table.h"
 #include "source/common/stats/utility.h"
+#include "source/common/tls/session_cache_impl.h"
 
 namespace Envoy {
 namespace Server {
@@ -90,6 +91,13 @@ void HotRestartingParent::onSocketEvent() {
       break;
     }
 
+    case HotRestartMessage::Request::kTlsSessions: {
+      HotRestartMessage wrapped_reply;
+      internal_->exportTlsSessionsToChild(wrapped_reply.mutable_reply()->mutable_tls_sessions());
+      main_rpc_stream_.sendHotRestartMessage(child_address_, wrapped_reply);
+      break;
+    }
+
     case HotRestartMessage::Request::kDrainListeners: {
       internal_->drainListeners();
       break;
@@ -225,6 +233,25 @@ void HotRestartingParent::Internal::recordDynamics(HotRestartMessage::Reply::Sta
   }
 }
 
+void HotRestartingParent::Internal::exportTlsSessionsToChild(
+    HotRestartMessage::Reply::TlsSessions* tls_sessions) {
+  Extensions::TransportSockets::Tls::SessionCacheImplSharedPtr session_cache =
+      Extensions::TransportSockets::Tls::SessionCacheImpl::getIfExists(
+          server_->singletonManager());
+  if (session_cache == nullptr) {
+    return;
+  }
+  session_cache->iterate(
+      [tls_sessions](absl::string_view id, absl::string_view session, SystemTime expire_time) {
+        auto* session_proto = tls_sessions->add_sessions();
+        session_proto->set_id(id);
+        session_proto->set_session(session);
+        session_proto->set_expire_time_unix_seconds(
+            std::chrono::duration_cast<std::chrono::seconds>(expire_time.time_since_epoch())
+                .count());
+      });
+}
+
 void HotRestartingParent::Internal::drainListeners() {
   Network::ExtraShutdownListenerOptions options;
   options.non_dispatched_udp_packet_handler_ = *this;
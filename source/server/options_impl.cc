@@ -77,6 +77,11 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
       " instance periodically during the draining period. This can potentially be an"
       " expensive operation; set this to true to reset all stats in child process.",
       cmd, false);
+  TCLAP::SwitchArg skip_hot_restart_tls_sessions(
+      "", "skip-hot-restart-tls-sessions",
+      "When hot restarting with a TLS session cache, by default the child instance copies the"
+      " cached TLS sessions of the parent instance. Set this to true to start with an empty cache.",
+      cmd, false);
   TCLAP::ValueArg<std::string> base_id_path(
       "", "base-id-path", "Path to which the base ID is written", false, "", "string", cmd);
   TCLAP::ValueArg<uint32_t> concurrency("", "concurrency", "# of worker threads to run", false,
@@ -141,6 +146,14 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   TCLAP::ValueArg<uint32_t> file_flush_min_size_kb("", "file-flush-min-size-kb",
                                                    "Minimum size in KB for log flushing", false, 64,
                                                    "uint32_t", cmd);
+  TCLAP::ValueArg<uint32_t> file_flush_thread_buffer_kb(
+      "", "file-flush-thread-buffer-kb",
+      "Size in KB of the buffer each thread writes each log file through, 0 to share one buffer",
+      false, 0, "uint32_t", cmd);
+  TCLAP::ValueArg<uint32_t> tls_session_cache_size_kb(
+      "", "tls-session-cache-size-kb",
+      "Size in KB of the TLS session cache shared by all listeners, 0 to cache per TLS context",
+      false, 0, "uint32_t", cmd);
   TCLAP::ValueArg<uint32_t> drain_time_s("", "drain-time-s",
                                          "Hot restart and LDS removal drain time in seconds", false,
                                          600, "uint32_t", cmd);
@@ -254,6 +267,7 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   use_dynamic_base_id_ = use_dynamic_base_id.getValue();
   skip_hot_restart_on_no_parent_ = skip_hot_restart_on_no_parent.getValue();
   skip_hot_restart_parent_stats_ = skip_hot_restart_parent_stats.getValue();
+  skip_hot_restart_tls_sessions_ = skip_hot_restart_tls_sessions.getValue();
   base_id_path_ = base_id_path.getValue();
   restart_epoch_ = restart_epoch.getValue();
 
@@ -296,6 +310,8 @@ OptionsImpl::OptionsImpl(std::vector<std::string> args,
   service_zone_ = service_zone.getValue();
   file_flush_interval_msec_ = std::chrono::milliseconds(file_flush_interval_msec.getValue());
   file_flush_min_size_kb_ = file_flush_min_size_kb.getValue();
+  file_flush_thread_buffer_kb_ = file_flush_thread_buffer_kb.getValue();
+  tls_session_cache_size_kb_ = tls_session_cache_size_kb.getValue();
   drain_time_ = std::chrono::seconds(drain_time_s.getValue());
   parent_shutdown_time_ = std::chrono::seconds(parent_shutdown_time_s.getValue());
   socket_path_ = socket_path.getValue();
@@ -404,6 +420,7 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   command_line_options->set_use_dynamic_base_id(useDynamicBaseId());
   command_line_options->set_skip_hot_restart_on_no_parent(skipHotRestartOnNoParent());
   command_line_options->set_skip_hot_restart_parent_stats(skipHotRestartParentStats());
+  command_line_options->set_skip_hot_restart_tls_sessions(skipHotRestartTlsSessions());
   command_line_options->set_base_id_path(baseIdPath());
   command_line_options->set_concurrency(concurrency());
   command_line_options->set_config_path(configPath());
@@ -437,6 +454,8 @@ Server::CommandLineOptionsPtr OptionsImpl::toCommandLineOptions() const {
   }
   command_line_options->mutable_file_flush_interval()->MergeFrom(
       Protobuf::util::TimeUtil::MillisecondsToDuration(fileFlushIntervalMsec().count()));
+  command_line_options->set_file_flush_thread_buffer_size(fileFlushThreadBufferKB());
+  command_line_options->set_tls_session_cache_size(tlsSessionCacheSizeKB());
 
   command_line_options->mutable_drain_time()->MergeFrom(
       Protobuf::util::TimeUtil::SecondsToDuration(drainTime().count()));
@@ -34,6 +34,7 @@ public:
   void setUseDynamicBaseId(bool use_dynamic_base_id) { use_dynamic_base_id_ = use_dynamic_base_id; }
   void setSkipHotRestartOnNoParent(bool skip) { skip_hot_restart_on_no_parent_ = skip; }
   void setSkipHotRestartParentStats(bool skip) { skip_hot_restart_parent_stats_ = skip; }
+  void setSkipHotRestartTlsSessions(bool skip) { skip_hot_restart_tls_sessions_ = skip; }
   void setBaseIdPath(const std::string& base_id_path) { base_id_path_ = base_id_path; }
   void setConcurrency(uint32_t concurrency) { concurrency_ = concurrency; }
   void setConfigPath(const std::string& config_path) { config_path_ = config_path; }
@@ -73,6 +74,12 @@ public:
   void setFileFlushMinSizeKB(uint64_t file_flush_min_size_kb) {
     file_flush_min_size_kb_ = file_flush_min_size_kb;
   }
+  void setFileFlushThreadBufferKB(uint64_t file_flush_thread_buffer_kb) {
+    file_flush_thread_buffer_kb_ = file_flush_thread_buffer_kb;
+  }
+  void setTlsSessionCacheSizeKB(uint64_t tls_session_cache_size_kb) {
+    tls_session_cache_size_kb_ = tls_session_cache_size_kb;
+  }
   void setServiceClusterName(const std::string& service_cluster) {
     service_cluster_ = service_cluster;
   }
@@ -109,6 +116,7 @@ public:
   bool useDynamicBaseId() const override { return use_dynamic_base_id_; }
   bool skipHotRestartOnNoParent() const override { return skip_hot_restart_on_no_parent_; }
   bool skipHotRestartParentStats() const override { return skip_hot_restart_parent_stats_; }
+  bool skipHotRestartTlsSessions() const override { return skip_hot_restart_tls_sessions_; }
   const std::string& baseIdPath() const override { return base_id_path_; }
   uint32_t concurrency() const override { return concurrency_; }
   const std::string& configPath() const override { return config_path_; }
@@ -144,6 +152,8 @@ public:
     return file_flush_interval_msec_;
   }
   uint64_t fileFlushMinSizeKB() const override { return file_flush_min_size_kb_; }
+  uint64_t fileFlushThreadBufferKB() const override { return file_flush_thread_buffer_kb_; }
+  uint64_t tlsSessionCacheSizeKB() const override { return tls_session_cache_size_kb_; }
   const std::string& serviceClusterName() const override { return service_cluster_; }
   const std::string& serviceNodeName() const override { return service_node_; }
   const std::string& serviceZone() const override { return service_zone_; }
@@ -184,6 +194,7 @@ private:
   bool use_dynamic_base_id_{false};
   bool skip_hot_restart_on_no_parent_{false};
   bool skip_hot_restart_parent_stats_{false};
+  bool skip_hot_restart_tls_sessions_{false};
   std::string base_id_path_;
   uint32_t concurrency_{1};
   std::string config_path_;
@@ -209,6 +220,8 @@ private:
   std::string service_zone_;
   std::chrono::milliseconds file_flush_interval_msec_{10000};
   uint64_t file_flush_min_size_kb_{64};
+  uint64_t file_flush_thread_buffer_kb_{0};
+  uint64_t tls_session_cache_size_kb_{0};
   std::chrono::seconds drain_time_{600};
   std::chrono::seconds parent_shutdown_time_{900};
   Server::DrainStrategy drain_strategy_{Server::DrainStrategy::Gradual};
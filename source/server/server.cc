@@ -50,6 +50,7 @@
 #include "source/common/stats/thread_local_store.h"
 #include "source/common/stats/timespan_impl.h"
 #include "source/common/tls/context_manager_impl.h"
+#include "source/common/tls/session_cache_impl.h"
 #include "source/common/upstream/cluster_manager_impl.h"
 #include "source/common/version/version.h"
 #include "source/server/configuration_impl.h"
@@ -97,7 +98,7 @@ InstanceBase::InstanceBase(Init::Manager& init_manager, const Options& options,
           watermark_factory)),
       dispatcher_(api_->allocateDispatcher("main_thread")),
       access_log_manager_(options.fileFlushIntervalMsec(), options.fileFlushMinSizeKB(), *api_,
-                          *dispatcher_, access_log_lock, store),
+                          *dispatcher_, access_log_lock, store, options.fileFlushThreadBufferKB()),
       handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks),
       mutex_tracer_(options.mutexTracingEnabled() ? &Envoy::MutexTracerImpl::getOrCreateTracer()
                                                   : nullptr),
@@ -188,6 +189,9 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
       [this](Stats::Gauge& gauge) {
         snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
         gauges_.push_back(gauge);
+        if (gauge.latchChanged()) {
+          changed_gauges_.push_back(gauge);
+        }
       });
 
   store.forEachSinkedHistogram(
@@ -284,6 +288,26 @@ void InstanceBase::updateServerStats() {
   server_stats_->state_.set(enumToInt(Utility::serverState(init_manager_.state(), !live_.load())));
   server_stats_->stats_recent_lookups_.set(
       stats_store_.symbolTable().getRecentLookups([](absl::string_view, uint64_t) {}));
+  updateSliceStorageCacheStats();
+}
+
+void InstanceBase::updateSliceStorageCacheStats() {
+  const Buffer::SliceStorageCache::Stats stats = Buffer::SliceStorageCache::totalStats();
+  const uint64_t hits = stats.hits_ - slice_storage_cache_stats_.hits_;
+  const uint64_t misses = stats.misses_ - slice_storage_cache_stats_.misses_;
+  server_stats_->buffer_slice_cache_hits_.add(hits);
+  server_stats_->buffer_slice_cache_misses_.add(misses);
+  server_stats_->buffer_slice_cache_overflows_.add(stats.overflows_ -
+                                                   slice_storage_cache_stats_.overflows_);
+  server_stats_->buffer_slice_cache_cross_thread_frees_.add(
+      stats.cross_thread_frees_ - slice_storage_cache_stats_.cross_thread_frees_);
+  // The hit rate is a percentage over the allocations since the previous update, and is left
+  // unchanged if there were none.
+  if (hits + misses > 0) {
+    server_stats_->buffer_slice_cache_hit_rate_.set(100 * hits / (hits + misses));
+  }
+  server_stats_->buffer_slice_cache_resident_bytes_.set(stats.cached_bytes_);
+  slice_storage_cache_stats_ = stats;
 }
 
 void InstanceBase::flushStatsInternal() {
@@ -813,6 +837,16 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   // Once we have runtime we can initialize the SSL context manager.
   ssl_context_manager_ =
       std::make_unique<Extensions::TransportSockets::Tls::ContextManagerImpl>(server_contexts_);
+  if (options_.tlsSessionCacheSizeKB() > 0 && !options_.skipHotRestartTlsSessions()) {
+    // The sessions of the parent are resumed by the server contexts of listeners whose certificates
+    // and server names are unchanged, as they have the same session ID contexts.
+    Extensions::TransportSockets::Tls::SessionCacheImplSharedPtr session_cache =
+        Extensions::TransportSockets::Tls::SessionCacheImpl::get(server_contexts_);
+    restarter_.getParentTlsSessions(
+        [&session_cache](absl::string_view id, absl::string_view session, SystemTime expire_time) {
+          session_cache->insert(id, session, expire_time);
+        });
+  }
 
   http_server_properties_cache_manager_ =
       std::make_unique<Http::HttpServerPropertiesCacheManagerImpl>(
@@ -25,6 +25,7 @@
 #include "envoy/tracing/tracer.h"
 
 #include "source/common/access_log/access_log_manager_impl.h"
+#include "source/common/buffer/slice_storage_cache.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/cleanup.h"
 #include "source/common/common/logger_delegates.h"
@@ -77,6 +78,12 @@ struct ServerCompilationSettingsStats {
   COUNTER(static_unknown_fields)                                                                   \
   COUNTER(wip_protos)                                                                              \
   COUNTER(dropped_stat_flushes)                                                                    \
+  COUNTER(buffer_slice_cache_cross_thread_frees)                                                   \
+  COUNTER(buffer_slice_cache_hits)                                                                 \
+  COUNTER(buffer_slice_cache_misses)                                                               \
+  COUNTER(buffer_slice_cache_overflows)                                                            \
+  GAUGE(buffer_slice_cache_hit_rate, NeverImport)                                                  \
+  GAUGE(buffer_slice_cache_resident_bytes, NeverImport)                                            \
   GAUGE(concurrency, NeverImport)                                                                  \
   GAUGE(days_until_first_cert_expiring, NeverImport)                                               \
   GAUGE(seconds_until_first_ocsp_response_expiring, NeverImport)                                   \
@@ -351,6 +358,7 @@ private:
   void flushStatsImpl();
   void flushStatsInternal();
   void updateServerStats();
+  void updateSliceStorageCacheStats();
   // This does most of the work of initialization, but can throw or return errors caught
   // by initialize().
   absl::Status initializeOrThrow(Network::Address::InstanceConstSharedPtr local_address,
@@ -389,6 +397,8 @@ private:
   time_t original_start_time_;
   Stats::StoreRoot& stats_store_;
   std::unique_ptr<ServerStats> server_stats_;
+  // The slice storage cache totals as of the previous stats update.
+  Buffer::SliceStorageCache::Stats slice_storage_cache_stats_;
   std::unique_ptr<CompilationSettings::ServerCompilationSettingsStats>
       server_compilation_settings_stats_;
   Assert::ActionRegistrationPtr assert_action_registration_;
@@ -479,6 +489,9 @@ public:
   const std::vector<std::reference_wrapper<const Stats::Gauge>>& gauges() override {
     return gauges_;
   };
+  const std::vector<std::reference_wrapper<const Stats::Gauge>>& changedGauges() override {
+    return changed_gauges_;
+  }
   const std::vector<std::reference_wrapper<const Stats::ParentHistogram>>& histograms() override {
     return histograms_;
   }
@@ -496,6 +509,7 @@ private:
   std::vector<CounterSnapshot> counters_;
   std::vector<Stats::GaugeSharedPtr> snapped_gauges_;
   std::vector<std::reference_wrapper<const Stats::Gauge>> gauges_;
+  std::vector<std::reference_wrapper<const Stats::Gauge>> changed_gauges_;
   std::vector<Stats::ParentHistogramSharedPtr> snapped_histograms_;
   std::vector<std::reference_wrapper<const Stats::ParentHistogram>> histograms_;
   std::vector<Stats::TextReadoutSharedPtr> snapped_text_readouts_;
@@ -114,7 +114,7 @@ void WorkerImpl::start(OptRef<GuardDog> guard_dog, const std::function<void()>&
 
   // In posix, thread names are limited to 15 characters, so contrive to make
   // sure all interesting data fits there. The naming occurs in
-  // ListenerManagerImpl's constructor: absl::StrCat("worker_", i). Let's say we
+  // ListenerManagerImpl's constructor: Event::workerName(i). Let's say we
   // have 9999 threads. We'd need, so we need 7 bytes for "worker_", 4 bytes
   // for the thread index, leaving us 4 bytes left to distinguish between the
   // two threads used per dispatcher. We'll call this one "dsp:" and the
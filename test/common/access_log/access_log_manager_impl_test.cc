@@ -1,5 +1,6 @@
 #include <cstdint>
 #include <memory>
+#include <string>
 
 #include "source/common/access_log/access_log_manager_impl.h"
 #include "source/common/filesystem/file_shared_impl.h"
@@ -530,6 +531,155 @@ TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
       .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+TEST(AccessLogRingTest, PushAndConsumeAcrossTheEnd) {
+  AccessLogRing ring(8);
+  EXPECT_TRUE(ring.push("abcde"));
+  EXPECT_FALSE(ring.push("fghi"));
+  EXPECT_EQ(5, ring.size());
+  EXPECT_THAT(ring.readable(), testing::ElementsAre("abcde"));
+  ring.consume(5);
+
+  // Wraps around the end of the ring.
+  EXPECT_TRUE(ring.push("fghi"));
+  EXPECT_TRUE(ring.push("jk"));
+  EXPECT_THAT(ring.readable(), testing::ElementsAre("fgh", "ijk"));
+  EXPECT_EQ(3, ring.takeWrites());
+  EXPECT_EQ(1, ring.takeDropped());
+  EXPECT_EQ(0, ring.takeWrites());
+  ring.consume(6);
+  EXPECT_EQ(0, ring.size());
+  EXPECT_TRUE(ring.readable().empty());
+}
+
+class ThreadBufferedAccessLogFileTest : public AccessLogManagerImplTest {
+protected:
+  AccessLogFileSharedPtr createAccessLog() {
+    EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+    return thread_buffered_manager_
+        .createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+        .value();
+  }
+
+  void expectWrites() {
+    EXPECT_CALL(*file_, write_(_))
+        .WillRepeatedly(Invoke([this](absl::string_view data) -> Api::IoCallSizeResult {
+          Thread::LockGuard lock(written_lock_);
+          written_.append(data);
+          return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+        }));
+  }
+
+  std::string written() {
+    Thread::LockGuard lock(written_lock_);
+    return written_;
+  }
+
+  // Each thread writes through a 1KB buffer.
+  AccessLogManagerImpl thread_buffered_manager_{timeout_40ms_, flush_size_kb_, api_, dispatcher_,
+                                                lock_,         store_,         1};
+  Thread::MutexBasicLockable written_lock_;
+  std::string written_;
+};
+
+// The writes of all threads are flushed, without a flush timer on the dispatcher.
+TEST_F(ThreadBufferedAccessLogFileTest, FlushWritesOfAllThreads) {
+  EXPECT_CALL(dispatcher_, createTimer_(_)).Times(0);
+  AccessLogFileSharedPtr log_file = createAccessLog();
+  expectWrites();
+
+  log_file->write("main\n");
+  Thread::ThreadPtr thread =
+      thread_factory_.createThread([&log_file]() { log_file->write("worker\n"); });
+  thread->join();
+  log_file->flush();
+
+  const std::string data = written();
+  EXPECT_EQ(12, data.size());
+  EXPECT_THAT(data, testing::HasSubstr("main\n"));
+  EXPECT_THAT(data, testing::HasSubstr("worker\n"));
+  EXPECT_EQ(2UL, store_.counter("filesystem.write_buffered").value());
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_dropped").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+// The flush thread flushes the buffers when the flush interval elapses.
+TEST_F(ThreadBufferedAccessLogFileTest, FlushByTimer) {
+  AccessLogFileSharedPtr log_file = createAccessLog();
+  expectWrites();
+
+  log_file->write("test");
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  EXPECT_EQ("test", written());
+  EXPECT_TRUE(waitForCounter("filesystem.flushed_by_timer", testing::Ge(1)));
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+// A write that does not fit in the buffer of its thread is dropped rather than blocking.
+TEST_F(ThreadBufferedAccessLogFileTest, DropWhenFull) {
+  AccessLogFileSharedPtr log_file = createAccessLog();
+  expectWrites();
+
+  log_file->write(std::string(2048, 'a'));
+  log_file->write("fits");
+  log_file->flush();
+
+  EXPECT_EQ("fits", written());
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_buffered").value());
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+// write_total_buffered accounts for the data left in the buffers after each flush.
+TEST_F(ThreadBufferedAccessLogFileTest, TotalBufferedUpdatedOnFlush) {
+  // The flush interval does not elapse during the test, so only the flushes below run.
+  AccessLogManagerImpl manager{std::chrono::hours(1), flush_size_kb_, api_, dispatcher_,
+                               lock_,                 store_,         1};
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file =
+      manager.createAccessLog(Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})
+          .value();
+  log_file->write("flushed");
+
+  // Data written while the buffers are being flushed is left for the next flush.
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([&log_file](absl::string_view data) -> Api::IoCallSizeResult {
+        log_file->write("left");
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }))
+      .WillRepeatedly(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->flush();
+  EXPECT_EQ(4UL,
+            store_.gauge("filesystem.write_total_buffered", Stats::Gauge::ImportMode::Accumulate)
+                .value());
+
+  log_file->flush();
+  EXPECT_EQ(0UL,
+            store_.gauge("filesystem.write_total_buffered", Stats::Gauge::ImportMode::Accumulate)
+                .value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(ThreadBufferedAccessLogFileTest, ReopenFile) {
+  AccessLogFileSharedPtr log_file = createAccessLog();
+  expectWrites();
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  log_file->reopen();
+  log_file->write("reopened");
+  log_file->flush();
+  EXPECT_EQ(2, file_->num_opens_);
+  EXPECT_EQ("reopened", written());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 } // namespace
 } // namespace AccessLog
 } // namespace Envoy
@@ -1,7 +1,11 @@
+#include <algorithm>
+#include <vector>
+
 #include "envoy/config/overload/v3/overload.pb.h"
 #include "envoy/http/stream_reset_handler.h"
 
 #include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_storage_cache.h"
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/assert.h"
 
@@ -320,6 +324,42 @@ BENCHMARK(bufferReserveCommit)
     ->Arg(64 * 1024)
     ->Arg(128 * 1024);
 
+// Test the allocation and release of slice storage blocks through the slice storage cache
+// (range(1) == 1) versus directly through the heap (range(1) == 0). Several blocks are held at
+// once, like the slices of a connection's read and write buffers.
+static void sliceStorageAllocateRelease(benchmark::State& state) {
+  const uint64_t size = state.range(0);
+  const bool use_cache = state.range(1) != 0;
+  Buffer::SliceStorageCache& cache = *Buffer::SliceStorageCache::threadLocal();
+  const Buffer::SliceStorageCache::Stats before = cache.stats();
+  std::vector<Buffer::SliceStorageCache::StoragePtr> blocks(4);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    for (auto& block : blocks) {
+      if (use_cache) {
+        block = cache.allocate(size);
+      } else {
+        block.reset(new uint8_t[size]);
+      }
+      block[0] = 0;
+    }
+    for (auto& block : blocks) {
+      if (use_cache) {
+        cache.release(std::move(block), size);
+      } else {
+        block.reset();
+      }
+    }
+  }
+  benchmark::DoNotOptimize(blocks.data());
+  const uint64_t hits = cache.stats().hits_ - before.hits_;
+  const uint64_t misses = cache.stats().misses_ - before.misses_;
+  state.counters["hit_rate"] = static_cast<double>(hits) / std::max<uint64_t>(1, hits + misses);
+  cache.clear();
+}
+BENCHMARK(sliceStorageAllocateRelease)
+    ->ArgsProduct({{4 * 1024, 16 * 1024, 64 * 1024}, {0, 1}});
+
 // Test the reserve+commit cycle, for the common case where the reserved space is
 // only partially used (and therefore the commit size is smaller than the reservation size).
 static void bufferReserveCommitPartial(benchmark::State& state) {
@@ -0,0 +1,158 @@
+#include <thread>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_storage_cache.h"
+
+#include "test/test_common/test_runtime.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SliceStorageCacheTest : public testing::Test {
+protected:
+  SliceStorageCacheTest() : cache_(*SliceStorageCache::threadLocal()) { cache_.clear(); }
+  ~SliceStorageCacheTest() override { cache_.clear(); }
+
+  SliceStorageCache& cache_;
+};
+
+TEST_F(SliceStorageCacheTest, ReusesReleasedBlocks) {
+  const SliceStorageCache::Stats before = cache_.stats();
+
+  SliceStorageCache::StoragePtr storage = cache_.allocate(SliceStorageCache::MediumBlockSize);
+  const uint8_t* block = storage.get();
+  EXPECT_EQ(before.misses_ + 1, cache_.stats().misses_);
+
+  cache_.release(std::move(storage), SliceStorageCache::MediumBlockSize);
+  EXPECT_EQ(SliceStorageCache::MediumBlockSize, cache_.stats().cached_bytes_);
+
+  // Blocks are only reused for the same size class.
+  SliceStorageCache::StoragePtr small = cache_.allocate(SliceStorageCache::SmallBlockSize);
+  EXPECT_NE(block, small.get());
+
+  storage = cache_.allocate(SliceStorageCache::MediumBlockSize);
+  EXPECT_EQ(block, storage.get());
+  EXPECT_EQ(before.hits_ + 1, cache_.stats().hits_);
+  EXPECT_EQ(0, cache_.stats().cached_bytes_);
+}
+
+TEST_F(SliceStorageCacheTest, UncachedSizesGoToTheHeap) {
+  const SliceStorageCache::Stats before = cache_.stats();
+
+  SliceStorageCache::StoragePtr storage = cache_.allocate(8 * 1024);
+  cache_.release(std::move(storage), 8 * 1024);
+
+  EXPECT_EQ(before.hits_, cache_.stats().hits_);
+  EXPECT_EQ(before.misses_, cache_.stats().misses_);
+  EXPECT_EQ(0, cache_.stats().cached_bytes_);
+}
+
+TEST_F(SliceStorageCacheTest, FreeListsAreBounded) {
+  std::vector<SliceStorageCache::StoragePtr> blocks;
+  for (uint32_t i = 0; i < 3; i++) {
+    blocks.push_back(cache_.allocate(SliceStorageCache::LargeBlockSize));
+  }
+
+  const uint64_t overflows = cache_.stats().overflows_;
+  for (auto& block : blocks) {
+    cache_.release(std::move(block), SliceStorageCache::LargeBlockSize);
+  }
+  EXPECT_EQ(overflows + 1, cache_.stats().overflows_);
+  EXPECT_EQ(2 * SliceStorageCache::LargeBlockSize, cache_.stats().cached_bytes_);
+
+  cache_.clear();
+  EXPECT_EQ(0, cache_.stats().cached_bytes_);
+}
+
+TEST_F(SliceStorageCacheTest, SlicesUseTheCache) {
+  const uint64_t hits = cache_.stats().hits_;
+  {
+    OwnedImpl buffer;
+    buffer.add(std::string(SliceStorageCache::SmallBlockSize, 'a'));
+  }
+  EXPECT_EQ(SliceStorageCache::SmallBlockSize, cache_.stats().cached_bytes_);
+
+  OwnedImpl buffer;
+  buffer.add(std::string(SliceStorageCache::SmallBlockSize, 'b'));
+  EXPECT_EQ(hits + 1, cache_.stats().hits_);
+  EXPECT_EQ(0, cache_.stats().cached_bytes_);
+}
+
+TEST_F(SliceStorageCacheTest, ReleaseOnAnotherThread) {
+  OwnedImpl buffer;
+  buffer.add(std::string(SliceStorageCache::MediumBlockSize, 'a'));
+
+  // The storage is released to the cache of the thread that destroys the slice, which counts it
+  // as a cross thread free.
+  std::thread thread([&buffer]() {
+    OwnedImpl moved;
+    moved.move(buffer);
+    const SliceStorageCache::Stats before = SliceStorageCache::threadLocal()->stats();
+    moved.drain(moved.length());
+    const SliceStorageCache::Stats after = SliceStorageCache::threadLocal()->stats();
+    EXPECT_EQ(before.cached_bytes_ + SliceStorageCache::MediumBlockSize, after.cached_bytes_);
+    EXPECT_EQ(before.cross_thread_frees_ + 1, after.cross_thread_frees_);
+
+    // Slices allocated and released on the same thread are not cross thread frees.
+    {
+      OwnedImpl local;
+      local.add(std::string(SliceStorageCache::MediumBlockSize, 'b'));
+    }
+    EXPECT_EQ(after.cross_thread_frees_,
+              SliceStorageCache::threadLocal()->stats().cross_thread_frees_);
+  });
+  thread.join();
+  EXPECT_EQ(0, cache_.stats().cached_bytes_);
+}
+
+TEST_F(SliceStorageCacheTest, TotalStatsIncludeExitedThreads) {
+  const SliceStorageCache::Stats before = SliceStorageCache::totalStats();
+
+  std::thread thread([]() {
+    SliceStorageCache& cache = *SliceStorageCache::threadLocal();
+    cache.release(cache.allocate(SliceStorageCache::SmallBlockSize),
+                  SliceStorageCache::SmallBlockSize);
+    cache.release(cache.allocate(SliceStorageCache::SmallBlockSize),
+                  SliceStorageCache::SmallBlockSize);
+  });
+  thread.join();
+
+  SliceStorageCache::StoragePtr storage = cache_.allocate(SliceStorageCache::LargeBlockSize);
+  cache_.release(std::move(storage), SliceStorageCache::LargeBlockSize);
+
+  // The cache of the exited thread returned its blocks to the heap, but its counts remain.
+  const SliceStorageCache::Stats after = SliceStorageCache::totalStats();
+  EXPECT_LE(before.hits_ + 1, after.hits_);
+  EXPECT_LE(before.misses_ + 2, after.misses_);
+  EXPECT_EQ(SliceStorageCache::LargeBlockSize, cache_.stats().cached_bytes_);
+  EXPECT_LE(SliceStorageCache::LargeBlockSize, after.cached_bytes_);
+}
+
+TEST_F(SliceStorageCacheTest, DisabledByRuntimeGuard) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.buffer_slice_storage_cache", "false"}});
+
+  // The guard is latched when the cache of a thread is created, so the cache of this thread is
+  // unaffected.
+  EXPECT_TRUE(cache_.enabled());
+
+  std::thread thread([]() {
+    SliceStorageCache& cache = *SliceStorageCache::threadLocal();
+    EXPECT_FALSE(cache.enabled());
+    for (uint32_t i = 0; i < 2; i++) {
+      OwnedImpl buffer;
+      buffer.add(std::string(SliceStorageCache::SmallBlockSize, 'a'));
+    }
+    EXPECT_EQ(0, cache.stats().hits_);
+    EXPECT_EQ(0, cache.stats().misses_);
+    EXPECT_EQ(0, cache.stats().cached_bytes_);
+  });
+  thread.join();
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
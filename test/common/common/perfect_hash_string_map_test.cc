@@ -0,0 +1,66 @@
+#include <string>
+#include <vector>
+
+#include "source/common/common/perfect_hash_string_map.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+
+using testing::IsNull;
+
+TEST(PerfectHashStringMapTest, FindsEntriesCorrectly) {
+  PerfectHashStringMap<const char*> map;
+  EXPECT_TRUE(map.compile({
+      {"key-1", "value-1"},
+      {"key-2", "value-2"},
+      {"longer-key", "value-3"},
+      {"bonger-key", "value-4"},
+      {"bonger-bey", "value-5"},
+      {"only-key-of-this-length", "value-6"},
+  }));
+  EXPECT_GE(map.slots(), 12U);
+  EXPECT_EQ(map.find("key-1"), "value-1");
+  EXPECT_EQ(map.find("key-2"), "value-2");
+  EXPECT_THAT(map.find("key-0"), IsNull());
+  EXPECT_THAT(map.find("key-3"), IsNull());
+  EXPECT_EQ(map.find("longer-key"), "value-3");
+  EXPECT_EQ(map.find("bonger-key"), "value-4");
+  EXPECT_EQ(map.find("bonger-bey"), "value-5");
+  EXPECT_EQ(map.find("only-key-of-this-length"), "value-6");
+  EXPECT_THAT(map.find("songer-key"), IsNull());
+  EXPECT_THAT(map.find("absent-length-key"), IsNull());
+  EXPECT_THAT(map.find(""), IsNull());
+}
+
+// Keys that only differ in the middle, which the first and last characters cannot tell apart.
+TEST(PerfectHashStringMapTest, KeysDifferingInTheMiddle) {
+  std::vector<std::string> keys;
+  for (char c = 'a'; c <= 'z'; ++c) {
+    keys.push_back(std::string("x-envoy-") + c + "-" + c + "-ms");
+  }
+  std::vector<PerfectHashStringMap<const std::string*>::KV> contents;
+  for (const std::string& key : keys) {
+    contents.emplace_back(key, &key);
+  }
+  PerfectHashStringMap<const std::string*> map;
+  ASSERT_TRUE(map.compile(contents));
+  for (const std::string& key : keys) {
+    EXPECT_EQ(&key, map.find(key));
+  }
+  EXPECT_THAT(map.find("x-envoy-a-b-ms"), IsNull());
+  EXPECT_THAT(map.find("x-envoy-A-A-ms"), IsNull());
+}
+
+TEST(PerfectHashStringMapTest, CompileFailures) {
+  PerfectHashStringMap<const char*> map;
+  EXPECT_FALSE(map.compile({}));
+  EXPECT_FALSE(map.compile({{"key", "value-1"}, {"key", "value-2"}}));
+  EXPECT_FALSE(map.compile({{"", "value-1"}, {"key", "value-2"}}));
+  EXPECT_FALSE(map.compile({{std::string(256, 'a'), "value-1"}}));
+  EXPECT_EQ(0U, map.slots());
+  EXPECT_THAT(map.find("key"), IsNull());
+}
+
+} // namespace Envoy
@@ -1,10 +1,15 @@
 // Note: this should be run with --compilation_mode=opt, and would benefit from
 // a quiescent system with disabled cstate power management.
 
+#include <memory>
 #include <regex>
+#include <string>
+#include <vector>
 
 #include "source/common/common/assert.h"
+#include "source/common/common/regex.h"
 
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "benchmark/benchmark.h"
 #include "re2/re2.h"
@@ -126,3 +131,51 @@ static void BM_RE2_AltPattern(benchmark::State& state) {
   RELEASE_ASSERT(passes > 0, "");
 }
 BENCHMARK(BM_RE2_AltPattern);
+
+// Route style patterns in the form of /shelves/[^/]+/route_{i}. The input matches the last one.
+static std::vector<std::string> routePatterns(int64_t count) {
+  std::vector<std::string> patterns;
+  for (int64_t i = 0; i < count; ++i) {
+    patterns.push_back(absl::StrCat("/shelves/[^/]+/route_", i));
+  }
+  return patterns;
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_RoutePatternsIndividually(benchmark::State& state) {
+  std::vector<std::unique_ptr<re2::RE2>> regexes;
+  for (const std::string& pattern : routePatterns(state.range(0))) {
+    regexes.push_back(std::make_unique<re2::RE2>(pattern));
+  }
+  const std::string input = absl::StrCat("/shelves/shelf_1/route_", state.range(0) - 1);
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    for (const auto& regex : regexes) {
+      if (re2::RE2::FullMatch(input, *regex)) {
+        ++passes;
+        break;
+      }
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_RoutePatternsIndividually)->RangeMultiplier(4)->Range(4, 4096);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_RE2_RoutePatternsSet(benchmark::State& state) {
+  Envoy::Regex::GoogleReMatcherSet set;
+  for (const std::string& pattern : routePatterns(state.range(0))) {
+    RELEASE_ASSERT(set.add(pattern).ok(), "");
+  }
+  RELEASE_ASSERT(set.compile().ok(), "");
+  const std::string input = absl::StrCat("/shelves/shelf_1/route_", state.range(0) - 1);
+  std::vector<int> matches;
+  uint32_t passes = 0;
+  for (auto _ : state) { // NOLINT
+    if (set.match(input, matches) && !matches.empty()) {
+      ++passes;
+    }
+  }
+  RELEASE_ASSERT(passes > 0, "");
+}
+BENCHMARK(BM_RE2_RoutePatternsSet)->RangeMultiplier(4)->Range(4, 4096);
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <vector>
+
 #include "envoy/common/exception.h"
 #include "envoy/type/matcher/v3/regex.pb.h"
 
@@ -140,6 +143,32 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+TEST(GoogleReMatcherSet, Match) {
+  GoogleReMatcherSet set;
+  EXPECT_EQ(0, *set.add("/foo/[0-9]+"));
+  EXPECT_EQ(1, *set.add("/foo/.*"));
+  EXPECT_EQ(2, *set.add("/bar"));
+  EXPECT_EQ(3, set.size());
+  EXPECT_TRUE(set.compile().ok());
+
+  std::vector<int> matches;
+  EXPECT_TRUE(set.match("/foo/123", matches));
+  std::sort(matches.begin(), matches.end());
+  EXPECT_EQ((std::vector<int>{0, 1}), matches);
+
+  // Patterns have to match the whole value.
+  EXPECT_TRUE(set.match("/bar/baz", matches));
+  EXPECT_TRUE(matches.empty());
+  EXPECT_TRUE(set.match("/bar", matches));
+  EXPECT_EQ((std::vector<int>{2}), matches);
+}
+
+TEST(GoogleReMatcherSet, InvalidPattern) {
+  GoogleReMatcherSet set;
+  EXPECT_FALSE(set.add("(unbalanced").ok());
+  EXPECT_EQ(0, set.size());
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
@@ -322,6 +322,20 @@ TEST(UnionStringTest, All) {
     EXPECT_EQ(5U, string.size());
     EXPECT_FALSE(string.isReference());
   }
+
+  // inlineTransformBuffer
+  {
+    UnionString string;
+    string.setCopy("HELLO");
+    string.inlineTransformBuffer([](char* data, size_t size) {
+      for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<char>(tolower(data[i]));
+      }
+    });
+    EXPECT_FALSE(string.isReference());
+    EXPECT_EQ(5U, string.size());
+    EXPECT_EQ(string.getStringView(), "hello");
+  }
 }
 
 } // namespace
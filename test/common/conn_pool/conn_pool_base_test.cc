@@ -460,6 +460,170 @@ TEST_F(ConnPoolImplDispatcherBaseTest, MaxConnectionDurationCallbackWhileConnect
   pool_.destructAllConnections();
 }
 
+TEST(StreamArrivalEstimatorTest, AnticipatedStreams) {
+  const MonotonicTime start;
+  // Without a longer peak window, only the recent rate is used.
+  StreamArrivalEstimator estimator(std::chrono::seconds(1), std::chrono::seconds(1), 15);
+  for (int i = 0; i < 100; ++i) {
+    estimator.onStream(start);
+  }
+  // Nothing is anticipated until the connect time is known.
+  EXPECT_EQ(0, estimator.anticipatedStreams(start));
+
+  // 100 streams per second for 100ms.
+  estimator.onConnected(std::chrono::milliseconds(100));
+  EXPECT_EQ(10, estimator.anticipatedStreams(start));
+  // The rate decays without streams: 100 * exp(-1) streams per second a second later.
+  EXPECT_EQ(4, estimator.anticipatedStreams(start + std::chrono::seconds(1)));
+  EXPECT_EQ(0, estimator.anticipatedStreams(start + std::chrono::seconds(10)));
+
+  // A slower connection moves the average connect time a quarter of the way, to 200ms.
+  estimator.onConnected(std::chrono::milliseconds(500));
+  EXPECT_EQ(15, estimator.anticipatedStreams(start));
+  EXPECT_EQ(7, estimator.anticipatedStreams(start + std::chrono::seconds(1)));
+}
+
+TEST(StreamArrivalEstimatorTest, PeakRateAfterIdle) {
+  const MonotonicTime start;
+  StreamArrivalEstimator estimator(std::chrono::seconds(1), std::chrono::seconds(60), 100);
+  StreamArrivalEstimator recent_rate_only(std::chrono::seconds(1), std::chrono::seconds(1), 100);
+  for (int i = 0; i < 100; ++i) {
+    estimator.onStream(start);
+    recent_rate_only.onStream(start);
+  }
+  estimator.onConnected(std::chrono::milliseconds(100));
+  recent_rate_only.onConnected(std::chrono::milliseconds(100));
+  EXPECT_EQ(10, estimator.anticipatedStreams(start));
+
+  // After ten idle seconds, the recent rate has decayed to nothing, but the peak rate of
+  // 100 * exp(-1/6) streams per second is still anticipated for the first stream of a burst.
+  const MonotonicTime burst = start + std::chrono::seconds(10);
+  recent_rate_only.onStream(burst);
+  EXPECT_EQ(0, recent_rate_only.anticipatedStreams(burst));
+  estimator.onStream(burst);
+  EXPECT_EQ(8, estimator.anticipatedStreams(burst));
+
+  // The peak is forgotten after a few peak windows without streams.
+  EXPECT_EQ(4, estimator.anticipatedStreams(burst + std::chrono::seconds(40)));
+  EXPECT_EQ(0, estimator.anticipatedStreams(burst + std::chrono::minutes(5)));
+}
+
+// With adaptive preconnect, a pool connects for the streams it expects while a connection is
+// established.
+TEST_F(ConnPoolImplDispatcherBaseTest, AdaptivePreconnect) {
+  using AdaptivePreconnect =
+      envoy::config::cluster::v3::Cluster::PreconnectPolicy::AdaptivePreconnect;
+  AdaptivePreconnect adaptive_preconnect;
+  adaptive_preconnect.mutable_rate_window()->set_seconds(1);
+  ON_CALL(*cluster_, adaptivePreconnect)
+      .WillByDefault(Return(makeOptRef<const AdaptivePreconnect>(adaptive_preconnect)));
+  ON_CALL(*cluster_, maxConnectionDuration).WillByDefault(Return(absl::nullopt));
+  TestConnPoolImplBase pool(host_, Upstream::ResourcePriority::Default, *dispatcher_, nullptr,
+                            nullptr, state_, overload_manager_);
+  std::vector<TestActiveClient*> clients;
+  ON_CALL(pool, instantiateActiveClient).WillByDefault(Invoke([&]() -> ActiveClientPtr {
+    auto ret = std::make_unique<NiceMock<TestActiveClient>>(pool, stream_limit_, 1, false);
+    clients.push_back(ret.get());
+    ret->real_host_description_ = descr_;
+    return ret;
+  }));
+  ON_CALL(pool, onPoolReady(_, _)).WillByDefault(Invoke([](ActiveClient& client, AttachContext&) {
+    TestActiveClient::incrementActiveStreams(client);
+  }));
+
+  // The connect time is not known yet, so only the pending stream gets a connection.
+  EXPECT_CALL(pool, instantiateActiveClient);
+  pool.newStreamImpl(context_, /*can_send_early_data=*/false);
+  advanceTimeAndRun(1000);
+  EXPECT_CALL(pool, onPoolReady);
+  clients[0]->onEvent(Network::ConnectionEvent::Connected);
+
+  // With a connect time of 1s and 1 + exp(-1) streams in the last second, one more stream is
+  // anticipated.
+  EXPECT_CALL(pool, instantiateActiveClient).Times(2);
+  Cancellable* cancellable = pool.newStreamImpl(context_, /*can_send_early_data=*/false);
+  ASSERT_NE(nullptr, cancellable);
+  EXPECT_EQ(3, clients.size());
+  EXPECT_EQ(2, state_.connecting_and_connected_stream_capacity_);
+
+  // Once the pending stream is cancelled, one connection is still needed for the anticipated
+  // stream.
+  cancellable->cancel(ConnectionPool::CancelPolicy::CloseExcess);
+  EXPECT_EQ(1, state_.connecting_and_connected_stream_capacity_);
+  EXPECT_EQ(ActiveClient::State::Connecting, clients[1]->state());
+
+  --clients[0]->active_streams_;
+  pool.onStreamClosed(*clients[0], false);
+  pool.destructAllConnections();
+}
+
+// With adaptive preconnect, the first stream after an idle period preconnects for the peak arrival
+// rate of the streams before the idle period.
+TEST_F(ConnPoolImplDispatcherBaseTest, AdaptivePreconnectAfterIdle) {
+  using AdaptivePreconnect =
+      envoy::config::cluster::v3::Cluster::PreconnectPolicy::AdaptivePreconnect;
+  AdaptivePreconnect adaptive_preconnect;
+  adaptive_preconnect.mutable_rate_window()->set_seconds(1);
+  adaptive_preconnect.mutable_peak_window()->set_seconds(60);
+  ON_CALL(*cluster_, adaptivePreconnect)
+      .WillByDefault(Return(makeOptRef<const AdaptivePreconnect>(adaptive_preconnect)));
+  ON_CALL(*cluster_, maxConnectionDuration).WillByDefault(Return(absl::nullopt));
+  TestConnPoolImplBase pool(host_, Upstream::ResourcePriority::Default, *dispatcher_, nullptr,
+                            nullptr, state_, overload_manager_);
+  std::vector<TestActiveClient*> clients;
+  ON_CALL(pool, instantiateActiveClient).WillByDefault(Invoke([&]() -> ActiveClientPtr {
+    auto ret = std::make_unique<NiceMock<TestActiveClient>>(pool, stream_limit_, 1, false);
+    clients.push_back(ret.get());
+    ret->real_host_description_ = descr_;
+    return ret;
+  }));
+  ON_CALL(pool, onPoolReady(_, _)).WillByDefault(Invoke([](ActiveClient& client, AttachContext&) {
+    TestActiveClient::incrementActiveStreams(client);
+  }));
+
+  // A burst of 20 streams arrives before the connect time is known, so each stream gets its own
+  // connection, which takes 100ms to establish.
+  for (int i = 0; i < 20; ++i) {
+    pool.newStreamImpl(context_, /*can_send_early_data=*/false);
+  }
+  ASSERT_EQ(20, clients.size());
+  advanceTimeAndRun(100);
+  for (int i = 0; i < 20; ++i) {
+    clients[i]->onEvent(Network::ConnectionEvent::Connected);
+  }
+  EXPECT_EQ(20, state_.active_streams_);
+
+  // The streams complete, and the connections preconnected once the connect time was known are
+  // not needed anymore.
+  for (int i = 0; i < 20; ++i) {
+    --clients[i]->active_streams_;
+    pool.onStreamClosed(*clients[i], false);
+  }
+  for (size_t i = 20; i < clients.size(); ++i) {
+    ASSERT_EQ(ActiveClient::State::Connecting, clients[i]->state());
+    clients[i]->close(Network::ConnectionCloseType::NoFlush, "");
+  }
+
+  // The upstream closes the idle connections ten seconds later.
+  advanceTimeAndRun(10000);
+  for (int i = 0; i < 20; ++i) {
+    clients[i]->onEvent(Network::ConnectionEvent::RemoteClose);
+  }
+  EXPECT_EQ(0, state_.connecting_and_connected_stream_capacity_);
+  const size_t idle_clients = clients.size();
+
+  // The recent rate anticipates no stream during a 100ms connect, but the peak rate of
+  // 20 * exp(-1/6) streams per second anticipates two, so the first stream of the next burst gets
+  // three connections.
+  Cancellable* cancellable = pool.newStreamImpl(context_, /*can_send_early_data=*/false);
+  ASSERT_NE(nullptr, cancellable);
+  EXPECT_EQ(idle_clients + 3, clients.size());
+  EXPECT_EQ(3, state_.connecting_and_connected_stream_capacity_);
+
+  cancellable->cancel(ConnectionPool::CancelPolicy::CloseExcess);
+  pool.destructAllConnections();
+}
+
 // Test the behavior of a client created with 0 zero streams available.
 TEST_F(ConnPoolImplDispatcherBaseTest, NoAvailableStreams) {
   // Start with a concurrent stream limit of 0.
@@ -0,0 +1,24 @@
+#include "source/common/event/worker_name.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+TEST(WorkerNameTest, WorkerIndexRoundTrips) {
+  for (uint32_t index : {0U, 1U, 9U, 10U, 9999U}) {
+    EXPECT_EQ(index, workerIndex(workerName(index)));
+  }
+}
+
+TEST(WorkerNameTest, NonWorkerNames) {
+  EXPECT_EQ(absl::nullopt, workerIndex("main_thread"));
+  EXPECT_EQ(absl::nullopt, workerIndex(WorkerNamePrefix));
+  EXPECT_EQ(absl::nullopt, workerIndex(absl::StrCat(WorkerNamePrefix, "x")));
+  EXPECT_EQ(absl::nullopt, workerIndex("worker"));
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -250,6 +250,11 @@ TEST(SubstitutionFormatterTest, plainStringFormatter) {
 
   EXPECT_EQ("plain", formatter.format({}, stream_info));
   EXPECT_THAT(formatter.formatValue({}, stream_info), ProtoEq(ValueUtil::stringValue("plain")));
+
+  std::string output;
+  EXPECT_TRUE(formatter.formatTo({}, stream_info, output));
+  EXPECT_TRUE(formatter.formatValueTo({}, stream_info, output));
+  EXPECT_EQ(R"(plain"plain")", output);
 }
 
 TEST(SubstitutionFormatterTest, plainNumberFormatter) {
@@ -258,6 +263,72 @@ TEST(SubstitutionFormatterTest, plainNumberFormatter) {
 
   EXPECT_EQ("400", formatter.format({}, stream_info));
   EXPECT_THAT(formatter.formatValue({}, stream_info), ProtoEq(ValueUtil::numberValue(400)));
+
+  std::string output;
+  EXPECT_TRUE(formatter.formatTo({}, stream_info, output));
+  EXPECT_TRUE(formatter.formatValueTo({}, stream_info, output));
+  EXPECT_EQ("400400", output);
+}
+
+// The providers that append their values directly append what format() and formatValue() return.
+TEST(SubstitutionFormatterTest, formatToMatchesFormat) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  EXPECT_CALL(stream_info, bytesSent()).WillRepeatedly(Return(1234));
+  Http::TestRequestHeaderMapImpl request_headers{{"x-present", "a\"b"}};
+  Http::TestResponseHeaderMapImpl response_headers{{"x-present", "value"}};
+  Context context;
+  context.setRequestHeaders(request_headers).setResponseHeaders(response_headers);
+
+  auto providers = *SubstitutionFormatParser::parse(
+      "plain %REQ(X-PRESENT)% %REQ(X-ABSENT)% %REQ(X-PRESENT):1% %RESP(X-PRESENT)% "
+      "%TRAILER(X-ABSENT)% %BYTES_SENT% %DURATION% %RESPONSE_CODE%");
+  for (const FormatterProviderPtr& provider : providers) {
+    const absl::optional<std::string> value = provider->format(context, stream_info);
+    std::string output = "prefix";
+    EXPECT_EQ(value.has_value(), provider->formatTo(context, stream_info, output));
+    EXPECT_EQ(absl::StrCat("prefix", value.value_or("")), output);
+
+    std::string json;
+    if (provider->formatValueTo(context, stream_info, json)) {
+      std::string expected_json;
+      Json::Utility::appendValueToString(provider->formatValue(context, stream_info),
+                                         expected_json);
+      EXPECT_EQ(expected_json, json);
+    }
+  }
+}
+
+TEST(SubstitutionFormatterTest, compiledFormat) {
+  NiceMock<StreamInfo::MockStreamInfo> stream_info;
+  Http::TestRequestHeaderMapImpl request_headers{{"x-present", "a\"b"}};
+  Context context;
+  context.setRequestHeaders(request_headers);
+
+  std::vector<FormatterProviderPtr> providers;
+  providers.push_back(std::make_unique<PlainStringFormatter>("a"));
+  providers.push_back(std::make_unique<PlainStringFormatter>("\\"));
+  providers.push_back(std::make_unique<RequestHeaderFormatter>("x-present", "", absl::nullopt));
+  providers.push_back(std::make_unique<RequestHeaderFormatter>("x-absent", "", absl::nullopt));
+  CompiledFormat compiled_format(std::move(providers));
+  EXPECT_EQ(nullptr, compiled_format.singleProvider());
+
+  std::string output;
+  compiled_format.formatTo(context, stream_info, false, output);
+  EXPECT_EQ(R"(a\a"b-)", output);
+  output.clear();
+  compiled_format.formatTo(context, stream_info, true, output);
+  EXPECT_EQ(R"(a\a"b)", output);
+
+  // Values are sanitized in place.
+  output.clear();
+  compiled_format.formatJsonStringTo(context, stream_info, false, output);
+  EXPECT_EQ(R"(a\\a\"b-)", output);
+
+  std::vector<FormatterProviderPtr> single_provider;
+  single_provider.push_back(
+      std::make_unique<RequestHeaderFormatter>("x-present", "", absl::nullopt));
+  const FormatterProvider* provider = single_provider.back().get();
+  EXPECT_EQ(provider, CompiledFormat(std::move(single_provider)).singleProvider());
 }
 
 TEST(SubstitutionFormatterTest, inFlightDuration) {
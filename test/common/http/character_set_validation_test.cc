@@ -1,3 +1,5 @@
+#include <string>
+
 #include "source/common/http/character_set_validation.h"
 
 #include "gtest/gtest.h"
@@ -33,5 +35,49 @@ TEST(CharacterSetValidationTest, Test) {
   }
 }
 
+TEST(CharacterSetValidationTest, HeaderValueTable) {
+  for (unsigned c = 0; c < 256; ++c) {
+    const bool valid = c == '\t' || (c >= 0x20 && c != 0x7f);
+    EXPECT_EQ(valid, testCharInTable(kGenericHeaderValueCharTable, static_cast<char>(c))) << c;
+  }
+}
+
+// Every character at every position of values that are processed a word at a time, a partial word
+// at a time, or both.
+TEST(CharacterSetValidationTest, HeaderValueCharsAreValid) {
+  EXPECT_TRUE(headerValueCharsAreValid("", 0));
+  for (unsigned c = 0; c < 256; ++c) {
+    const bool valid = testCharInTable(kGenericHeaderValueCharTable, static_cast<char>(c));
+    for (size_t size = 1; size <= 20; ++size) {
+      for (size_t position = 0; position < size; ++position) {
+        std::string value(size, 'a');
+        value[position] = static_cast<char>(c);
+        ASSERT_EQ(valid, headerValueCharsAreValid(value.data(), value.size()))
+            << c << " " << size << " " << position;
+      }
+    }
+  }
+}
+
+TEST(CharacterSetValidationTest, AsciiToLowerInPlace) {
+  for (unsigned c = 0; c < 256; ++c) {
+    const char lower = static_cast<char>(c >= 'A' && c <= 'Z' ? c + 'a' - 'A' : c);
+    for (size_t size = 1; size <= 20; ++size) {
+      for (size_t position = 0; position < size; ++position) {
+        std::string value(size, 'B');
+        value[position] = static_cast<char>(c);
+        std::string expected(size, 'b');
+        expected[position] = lower;
+        asciiToLowerInPlace(value.data(), value.size());
+        ASSERT_EQ(expected, value) << c << " " << size << " " << position;
+      }
+    }
+  }
+
+  std::string value = "X-Forwarded-For: \xC3\x89T\xC9";
+  asciiToLowerInPlace(value.data(), value.size());
+  EXPECT_EQ("x-forwarded-for: \xC3\x89t\xC9", value);
+}
+
 } // namespace Http
 } // namespace Envoy
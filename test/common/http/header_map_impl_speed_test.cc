@@ -362,5 +362,30 @@ BENCHMARK(bmHeaderMapImplResponseStaticLookupHits);
 BENCHMARK(bmHeaderMapImplRequestStaticLookupMisses);
 BENCHMARK(bmHeaderMapImplResponseStaticLookupMisses);
 
+/**
+ * Measure the speed of adding the O(1) request headers by name to a new header map and getting
+ * them back by name, as the codecs and filters do for every request.
+ */
+static void bmHeaderMapImplAddAndGetInlineByName(benchmark::State& state) {
+  std::vector<std::string> keys;
+  INLINE_REQ_HEADERS(ADD_HEADER_TO_KEYS);
+  std::vector<LowerCaseString> lower_case_keys;
+  lower_case_keys.reserve(keys.size());
+  for (const std::string& key : keys) {
+    lower_case_keys.emplace_back(key);
+  }
+  const std::string value("01234567890123456789");
+  for (auto _ : state) { // NOLINT
+    auto headers = RequestHeaderMapImpl::create();
+    for (const LowerCaseString& key : lower_case_keys) {
+      headers->addReference(key, value);
+    }
+    for (const LowerCaseString& key : lower_case_keys) {
+      benchmark::DoNotOptimize(headers->get(key));
+    }
+  }
+}
+BENCHMARK(bmHeaderMapImplAddAndGetInlineByName);
+
 } // namespace Http
 } // namespace Envoy
@@ -0,0 +1,259 @@
+// Compares echoing messages over loopback TCP connections with the event loop's epoll based file
+// events, and with io_uring sockets with and without submission batching. Each iteration sends one
+// message on every connection and waits until all of them are echoed back, so the time per
+// iteration is the round trip latency under that many concurrent connections, and the items per
+// second are round trips per second.
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "envoy/common/pure.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/io/io_uring_impl.h"
+#include "source/common/io/io_uring_worker_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Io {
+namespace {
+
+// Creates a connected pair of non-blocking loopback TCP sockets.
+std::pair<os_fd_t, os_fd_t> connectedPair() {
+  const os_fd_t listener = ::socket(AF_INET, SOCK_STREAM, 0);
+  RELEASE_ASSERT(listener >= 0, "");
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t address_len = sizeof(address);
+  RELEASE_ASSERT(::bind(listener, reinterpret_cast<sockaddr*>(&address), address_len) == 0, "");
+  RELEASE_ASSERT(::listen(listener, 1) == 0, "");
+  RELEASE_ASSERT(::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &address_len) == 0,
+                 "");
+
+  const os_fd_t client = ::socket(AF_INET, SOCK_STREAM, 0);
+  RELEASE_ASSERT(client >= 0, "");
+  RELEASE_ASSERT(::connect(client, reinterpret_cast<sockaddr*>(&address), address_len) == 0, "");
+  const os_fd_t server = ::accept(listener, nullptr, nullptr);
+  RELEASE_ASSERT(server >= 0, "");
+  ::close(listener);
+
+  for (const os_fd_t fd : {client, server}) {
+    const int one = 1;
+    RELEASE_ASSERT(::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)) == 0, "");
+    RELEASE_ASSERT(::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK) == 0, "");
+  }
+  return {client, server};
+}
+
+// Echoes messages over loopback connections. The client end of a connection sends a message, the
+// server end sends back what it reads, and a round trip is done once the whole message is back.
+class LoopbackEcho {
+public:
+  LoopbackEcho(uint32_t connection_count, uint32_t message_size)
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        message_(message_size, 'a'), connections_(connection_count) {}
+  virtual ~LoopbackEcho() = default;
+
+  // Runs one round trip on every connection.
+  void roundTrip() {
+    pending_ = connections_.size();
+    for (uint32_t i = 0; i < connections_.size(); ++i) {
+      send(i);
+    }
+    dispatcher_->run(Event::Dispatcher::RunType::Block);
+  }
+
+protected:
+  virtual void send(uint32_t connection) PURE;
+
+  // Called with the number of bytes of the echo that the client end of a connection read.
+  void onEcho(uint32_t connection, uint64_t bytes) {
+    uint64_t& received = connections_[connection];
+    received += bytes;
+    if (received < message_.size()) {
+      return;
+    }
+    RELEASE_ASSERT(received == message_.size(), "");
+    received = 0;
+    if (--pending_ == 0) {
+      dispatcher_->exit();
+    }
+  }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  const std::string message_;
+  // The bytes of the current echo received by the client end of each connection.
+  std::vector<uint64_t> connections_;
+  uint32_t pending_{};
+};
+
+// Reads and writes with system calls when the event loop reports the sockets as readable.
+class EpollLoopbackEcho : public LoopbackEcho {
+public:
+  EpollLoopbackEcho(uint32_t connection_count, uint32_t message_size)
+      : LoopbackEcho(connection_count, message_size), buffer_(message_size) {
+    for (uint32_t i = 0; i < connection_count; ++i) {
+      const auto [client, server] = connectedPair();
+      fds_.push_back(client);
+      fds_.push_back(server);
+      events_.push_back(dispatcher_->createFileEvent(
+          server,
+          [this, server = server](uint32_t) {
+            const ssize_t bytes = ::read(server, buffer_.data(), buffer_.size());
+            if (bytes > 0) {
+              RELEASE_ASSERT(::write(server, buffer_.data(), bytes) == bytes, "");
+            }
+            return absl::OkStatus();
+          },
+          Event::FileTriggerType::Level, Event::FileReadyType::Read));
+      events_.push_back(dispatcher_->createFileEvent(
+          client,
+          [this, client = client, i](uint32_t) {
+            const ssize_t bytes = ::read(client, buffer_.data(), buffer_.size());
+            if (bytes > 0) {
+              onEcho(i, bytes);
+            }
+            return absl::OkStatus();
+          },
+          Event::FileTriggerType::Level, Event::FileReadyType::Read));
+    }
+  }
+
+  ~EpollLoopbackEcho() override {
+    events_.clear();
+    for (const os_fd_t fd : fds_) {
+      ::close(fd);
+    }
+  }
+
+private:
+  void send(uint32_t connection) override {
+    RELEASE_ASSERT(::write(fds_[2 * connection], message_.data(), message_.size()) ==
+                       static_cast<ssize_t>(message_.size()),
+                   "");
+  }
+
+  std::vector<char> buffer_;
+  std::vector<os_fd_t> fds_;
+  std::vector<Event::FileEventPtr> events_;
+};
+
+// Reads and writes through the sockets of an io_uring worker.
+class IoUringLoopbackEcho : public LoopbackEcho {
+public:
+  IoUringLoopbackEcho(uint32_t connection_count, uint32_t message_size,
+                      bool enable_submission_batching)
+      : LoopbackEcho(connection_count, message_size),
+        worker_(std::make_unique<IoUringWorkerImpl>(
+            /*io_uring_size=*/1024, /*use_submission_queue_polling=*/false,
+            /*read_buffer_size=*/8192, /*write_timeout_ms=*/1000, *dispatcher_,
+            enable_submission_batching)) {
+    clients_.resize(connection_count);
+    servers_.resize(connection_count);
+    for (uint32_t i = 0; i < connection_count; ++i) {
+      const auto [client, server] = connectedPair();
+      servers_[i] = &worker_->addServerSocket(
+          server,
+          [this, i](uint32_t events) {
+            const OptRef<ReadParam>& read_param = servers_[i]->getReadParam();
+            if ((events & Event::FileReadyType::Read) && read_param->result_ > 0) {
+              Buffer::OwnedImpl echo;
+              echo.move(read_param->buf_);
+              servers_[i]->write(echo);
+            }
+            return absl::OkStatus();
+          },
+          false);
+      clients_[i] = &worker_->addServerSocket(
+          client,
+          [this, i](uint32_t events) {
+            const OptRef<ReadParam>& read_param = clients_[i]->getReadParam();
+            if ((events & Event::FileReadyType::Read) && read_param->result_ > 0) {
+              const uint64_t bytes = read_param->buf_.length();
+              read_param->buf_.drain(bytes);
+              onEcho(i, bytes);
+            }
+            return absl::OkStatus();
+          },
+          false);
+      servers_[i]->enableRead();
+      clients_[i]->enableRead();
+    }
+  }
+
+  // The worker closes its sockets, so it must go before the dispatcher.
+  ~IoUringLoopbackEcho() override { worker_.reset(); }
+
+private:
+  void send(uint32_t connection) override {
+    Buffer::OwnedImpl message(message_);
+    clients_[connection]->write(message);
+  }
+
+  std::unique_ptr<IoUringWorkerImpl> worker_;
+  std::vector<IoUringSocket*> clients_;
+  std::vector<IoUringSocket*> servers_;
+};
+
+void runLoopbackEcho(benchmark::State& state, LoopbackEcho& echo) {
+  const uint32_t connection_count = state.range(0);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    echo.roundTrip();
+  }
+  state.SetItemsProcessed(state.iterations() * connection_count);
+  state.SetBytesProcessed(state.iterations() * connection_count * state.range(1));
+}
+
+// {connections, message size}
+void loopbackEchoArgs(benchmark::internal::Benchmark* benchmark) {
+  benchmark->Args({1, 64})->Args({1, 4096})->Args({16, 64})->Args({16, 4096})->Args({64, 64});
+}
+
+} // namespace
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_EpollLoopbackEcho(benchmark::State& state) {
+  EpollLoopbackEcho echo(state.range(0), state.range(1));
+  runLoopbackEcho(state, echo);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_IoUringLoopbackEcho(benchmark::State& state) {
+  if (!isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+  IoUringLoopbackEcho echo(state.range(0), state.range(1), false);
+  runLoopbackEcho(state, echo);
+}
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_IoUringBatchedLoopbackEcho(benchmark::State& state) {
+  if (!isIoUringSupported()) {
+    state.SkipWithError("io_uring is not supported");
+    return;
+  }
+  IoUringLoopbackEcho echo(state.range(0), state.range(1), true);
+  runLoopbackEcho(state, echo);
+}
+
+BENCHMARK(BM_EpollLoopbackEcho)->Apply(loopbackEchoArgs);
+BENCHMARK(BM_IoUringLoopbackEcho)->Apply(loopbackEchoArgs);
+BENCHMARK(BM_IoUringBatchedLoopbackEcho)->Apply(loopbackEchoArgs);
+
+} // namespace Io
+} // namespace Envoy
@@ -33,8 +33,10 @@ public:
 
 class IoUringWorkerTestImpl : public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        bool enable_submission_batching = false)
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher,
+                          enable_submission_batching) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
@@ -178,6 +180,66 @@ TEST(IoUringWorkerImplTest, DelaySubmit) {
   EXPECT_CALL(dispatcher, clearDeferredDeleteList());
 }
 
+TEST(IoUringWorkerImplTest, SubmissionBatching) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  auto* submit_batch_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher);
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, true);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+  auto& io_uring_socket = worker.addTestSocket(fd);
+
+  // The requests of the same event loop iteration are submitted together.
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(*submit_batch_cb, scheduleCallbackCurrentIteration());
+  EXPECT_CALL(mock_io_uring, submit()).Times(0);
+  delete worker.submitReadRequest(io_uring_socket);
+  delete worker.submitReadRequest(io_uring_socket);
+  delete worker.submitReadRequest(io_uring_socket);
+  EXPECT_TRUE(submit_batch_cb->enabled_);
+
+  EXPECT_CALL(mock_io_uring, submit());
+  submit_batch_cb->invokeCallback();
+
+  // A full submission queue is flushed immediately.
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Failed))
+      .RetiresOnSaturation();
+  EXPECT_CALL(*submit_batch_cb, scheduleCallbackCurrentIteration());
+  delete worker.submitReadRequest(io_uring_socket);
+  EXPECT_TRUE(submit_batch_cb->enabled_);
+
+  // The completion processing submits the pending requests and cancels the batch callback.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_)).WillOnce(Invoke([&worker](CompletionCb) {
+    worker.submitForTest();
+  }));
+  EXPECT_CALL(mock_io_uring, submit());
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_FALSE(submit_batch_cb->enabled_);
+
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  dynamic_cast<IoUringSocketTestImpl*>(worker.getSockets().front().get())->cleanupForTest();
+  EXPECT_EQ(0, worker.getNumOfSockets());
+  EXPECT_CALL(mock_io_uring, submit());
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
 // This tests ensure the write request won't be override by an injected completion.
 TEST(IoUringWorkerImplTest, ServerSocketInjectAfterWrite) {
   Event::MockDispatcher dispatcher;
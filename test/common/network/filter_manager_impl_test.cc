@@ -139,6 +139,24 @@ TEST_F(NetworkFilterManagerTest, ConnectionClosedBeforeRunningFilter) {
   manager.onWrite();
 }
 
+TEST_F(NetworkFilterManagerTest, IsOnlyFilter) {
+  MockReadFilter* read_filter(new MockReadFilter());
+  MockReadFilter* other_read_filter(new MockReadFilter());
+  MockWriteFilter* write_filter(new MockWriteFilter());
+
+  FilterManagerImpl manager(connection_, socket_);
+  manager.addReadFilter(ReadFilterSharedPtr{read_filter});
+  EXPECT_TRUE(read_filter->callbacks_->isOnlyFilter());
+
+  manager.addWriteFilter(WriteFilterSharedPtr{write_filter});
+  EXPECT_FALSE(read_filter->callbacks_->isOnlyFilter());
+
+  FilterManagerImpl other_manager(connection_, socket_);
+  other_manager.addReadFilter(ReadFilterSharedPtr{other_read_filter});
+  other_manager.addReadFilter(std::make_shared<NiceMock<MockReadFilter>>());
+  EXPECT_FALSE(other_read_filter->callbacks_->isOnlyFilter());
+}
+
 TEST_F(NetworkFilterManagerTest, FilterReturnStopAndNoCallback) {
   InSequence s;
 
@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/server_factory_context.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -398,6 +399,59 @@ static void bmMixedRoutes(benchmark::State& state) {
 BENCHMARK(bmPlainRoutes)->RangeMultiplier(2)->Ranges({{64, 2 << 10}});
 BENCHMARK(bmMixedRoutes)->RangeMultiplier(2)->Ranges({{64, 2 << 10}});
 
+/**
+ * Compares route selection with and without the route path index. The route table has
+ * `state.range(0)` routes of the form:
+ * - /shelves/shelf_0/route_0
+ * - /shelves/shelf_1/route_1
+ * - etc.
+ * that are exact (`state.range(1) == 0`), prefix (`state.range(1) == 1`) or regex
+ * (`state.range(1) == 2`, as /shelves/[^/]+/route_x) matchers. The index is enabled when
+ * `state.range(2) == 1`. The request matches the last route.
+ */
+static void bmRouteTableSizeWithRoutePathIndex(benchmark::State& state) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.route_path_index", state.range(2) == 1 ? "true" : "false"}});
+
+  Api::ApiPtr api = Api::createApiForTest();
+  NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  ON_CALL(factory_context, api()).WillByDefault(ReturnRef(*api));
+
+  RouteConfiguration route_config;
+  VirtualHost* v_host = route_config.add_virtual_hosts();
+  v_host->set_name("default");
+  v_host->add_domains("*");
+  for (int i = 0; i < state.range(0); ++i) {
+    Route* route = v_host->add_routes();
+    route->mutable_direct_response()->set_status(200);
+    const std::string path = absl::StrCat("/shelves/shelf_", i, "/route_", i);
+    switch (state.range(1)) {
+    case 0:
+      route->mutable_match()->set_path(path);
+      break;
+    case 1:
+      route->mutable_match()->set_prefix(path);
+      break;
+    default:
+      route->mutable_match()->mutable_safe_regex()->set_regex(
+          absl::StrCat("/shelves/[^/]+/route_", i));
+      break;
+    }
+  }
+  std::shared_ptr<ConfigImpl> config = *ConfigImpl::create(
+      route_config, factory_context, ProtobufMessage::getNullValidationVisitor(), true);
+  const Http::TestRequestHeaderMapImpl headers = genRequestHeaders(state.range(0) - 1);
+
+  for (auto _ : state) { // NOLINT
+    config->route(headers, stream_info, 0);
+  }
+}
+
+BENCHMARK(bmRouteTableSizeWithRoutePathIndex)
+    ->ArgsProduct({{1000, 10000}, {0, 1, 2}, {0, 1}});
+
 } // namespace
 } // namespace Router
 } // namespace Envoy
@@ -1447,6 +1447,74 @@ virtual_hosts:
             config.route(genHeaders("example.com", "/", "GET"), 0)->routeEntry()->clusterName());
 }
 
+// Verifies that route selection through the route path index, which is built for large route
+// lists, preserves the first-match-wins semantics of the ordered evaluation.
+TEST_F(RouteMatcherTest, TestRoutePathIndexPreservesRouteOrder) {
+  std::string yaml = R"EOF(
+virtual_hosts:
+  - name: default
+    domains: ["*"]
+    routes:
+      - match:
+          prefix: "/api/"
+          headers:
+            - name: x-canary
+              string_match: { exact: "true" }
+        route: { cluster: "canary" }
+      - match: { safe_regex: { regex: "/api/v[0-9]+/users" } }
+        route: { cluster: "regex" }
+      - match: { path: "/api/v1/users" }
+        route: { cluster: "exact" }
+      - match: { prefix: "/API/V2/", case_sensitive: false }
+        route: { cluster: "case_insensitive" }
+      - match: { path_separated_prefix: "/static" }
+        route: { cluster: "static" }
+      - match:
+          prefix: "/api/v3/"
+          query_parameters:
+            - name: debug
+              present_match: true
+        route: { cluster: "debug" }
+)EOF";
+  std::vector<std::string> clusters = {"canary", "regex", "exact", "case_insensitive",
+                                       "static", "debug", "catch_all"};
+  for (int i = 0; i < 20; ++i) {
+    const std::string cluster = absl::StrCat("filler_", i);
+    absl::StrAppend(&yaml, "      - match: { prefix: \"/filler/", i, "/\" }\n",
+                    "        route: { cluster: \"", cluster, "\" }\n");
+    clusters.push_back(cluster);
+  }
+  absl::StrAppend(&yaml, "      - match: { prefix: \"/\" }\n",
+                  "        route: { cluster: \"catch_all\" }\n");
+
+  factory_context_.cluster_manager_.initializeClusters(clusters, {});
+  const auto proto_config = parseRouteConfigurationFromYaml(yaml);
+
+  for (const char* runtime_value : {"true", "false"}) {
+    mergeValues({{"envoy.reloadable_features.route_path_index", runtime_value}});
+    TestConfigImpl config(proto_config, factory_context_, true, creation_status_);
+
+    auto cluster = [&config](const Http::TestRequestHeaderMapImpl& headers) -> std::string {
+      return config.route(headers, 0)->routeEntry()->clusterName();
+    };
+
+    Http::TestRequestHeaderMapImpl canary = genHeaders("example.com", "/api/v1/users", "GET");
+    canary.addCopy("x-canary", "true");
+    EXPECT_EQ("canary", cluster(canary));
+    EXPECT_EQ("regex", cluster(genHeaders("example.com", "/api/v1/users", "GET")));
+    EXPECT_EQ("regex", cluster(genHeaders("example.com", "/api/v1/users?x=1", "GET")));
+    EXPECT_EQ("case_insensitive", cluster(genHeaders("example.com", "/api/v2/items", "GET")));
+    EXPECT_EQ("catch_all", cluster(genHeaders("example.com", "/api/v2", "GET")));
+    EXPECT_EQ("static", cluster(genHeaders("example.com", "/static/app.js", "GET")));
+    EXPECT_EQ("static", cluster(genHeaders("example.com", "/static?v=1", "GET")));
+    EXPECT_EQ("catch_all", cluster(genHeaders("example.com", "/staticfoo", "GET")));
+    EXPECT_EQ("debug", cluster(genHeaders("example.com", "/api/v3/x?debug", "GET")));
+    EXPECT_EQ("catch_all", cluster(genHeaders("example.com", "/api/v3/x", "GET")));
+    EXPECT_EQ("filler_7", cluster(genHeaders("example.com", "/filler/7/x", "GET")));
+    EXPECT_EQ("catch_all", cluster(genHeaders("example.com", "/filler/77/x", "GET")));
+  }
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithInvalidRegex) {
   std::string invalid_route = R"EOF(
 virtual_hosts:
@@ -0,0 +1,142 @@
+#include <vector>
+
+#include "source/common/router/route_path_index.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+std::vector<uint32_t> candidates(const RoutePathIndex& index, absl::string_view path,
+                                 absl::string_view separated_path) {
+  std::vector<uint32_t> result;
+  index.forEachCandidate(path, separated_path, [&](uint32_t i) {
+    result.push_back(i);
+    return true;
+  });
+  return result;
+}
+
+std::vector<uint32_t> candidates(const RoutePathIndex& index, absl::string_view path) {
+  return candidates(index, path, path);
+}
+
+TEST(RoutePathIndexTest, ExactAndPrefix) {
+  RoutePathIndex index;
+  index.addPrefix("/foo/", false, 0);
+  index.addExact("/foo/bar", false, 1);
+  index.addPrefix("/foo/bar", false, 2);
+  index.addPrefix("/baz", false, 3);
+  index.addExact("/foo/bar", false, 4);
+  index.addPrefix("/", false, 5);
+
+  EXPECT_EQ(6, index.indexedRoutes());
+  EXPECT_EQ(0, index.unindexedRoutes());
+  EXPECT_THAT(candidates(index, "/foo/bar"), ElementsAre(0, 1, 2, 4, 5));
+  EXPECT_THAT(candidates(index, "/foo/barbaz"), ElementsAre(0, 2, 5));
+  EXPECT_THAT(candidates(index, "/foo"), ElementsAre(5));
+  EXPECT_THAT(candidates(index, "/bazooka"), ElementsAre(3, 5));
+  EXPECT_THAT(candidates(index, "other"), IsEmpty());
+}
+
+TEST(RoutePathIndexTest, EmptyPrefixMatchesEverything) {
+  RoutePathIndex index;
+  index.addExact("/a", false, 0);
+  index.addPrefix("", false, 1);
+
+  EXPECT_THAT(candidates(index, "/a"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/b"), ElementsAre(1));
+  EXPECT_THAT(candidates(index, ""), ElementsAre(1));
+}
+
+TEST(RoutePathIndexTest, UnindexedRoutesAreMergedInOrder) {
+  RoutePathIndex index;
+  index.addUnindexed(0);
+  index.addPrefix("/a", false, 1);
+  index.addUnindexed(2);
+  index.addExact("/b", false, 3);
+  index.addPrefix("/a/b", false, 4);
+  index.addUnindexed(5);
+
+  EXPECT_EQ(3, index.indexedRoutes());
+  EXPECT_EQ(3, index.unindexedRoutes());
+  EXPECT_THAT(candidates(index, "/a/b"), ElementsAre(0, 1, 2, 4, 5));
+  EXPECT_THAT(candidates(index, "/b"), ElementsAre(0, 2, 3, 5));
+  EXPECT_THAT(candidates(index, "/c"), ElementsAre(0, 2, 5));
+}
+
+TEST(RoutePathIndexTest, CaseInsensitive) {
+  RoutePathIndex index;
+  index.addPrefix("/Foo", true, 0);
+  index.addExact("/Foo/BAR", true, 1);
+  index.addPrefix("/Foo", false, 2);
+  index.addExact("/Foo/BAR", false, 3);
+
+  EXPECT_THAT(candidates(index, "/foo/bar"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/Foo/BAR"), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(candidates(index, "/FOO/x"), ElementsAre(0));
+}
+
+TEST(RoutePathIndexTest, PathSeparatedPrefixUsesSeparatedPath) {
+  RoutePathIndex index;
+  index.addPathSeparatedPrefix("/foo", false, 0);
+  index.addPrefix("/foo", false, 1);
+  index.addPathSeparatedPrefix("/Bar", true, 2);
+
+  EXPECT_THAT(candidates(index, "/foo/x", "/foo/x"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/foox", "/foo"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/bar", "/BAR/baz"), ElementsAre(2));
+  EXPECT_THAT(candidates(index, "/bar", "/baz"), IsEmpty());
+}
+
+TEST(RoutePathIndexTest, RegexSet) {
+  RoutePathIndex index;
+  index.addRegex("/shelves/[^/]+/books", 0);
+  index.addPrefix("/shelves/", false, 1);
+  index.addRegex("/shelves/[0-9]+/books", 2);
+  index.addRegex("/other", 3);
+  index.finalize();
+
+  EXPECT_EQ(4, index.indexedRoutes());
+  EXPECT_EQ(3, index.regexSetRoutes());
+  EXPECT_EQ(0, index.unindexedRoutes());
+  EXPECT_THAT(candidates(index, "/shelves/12/books"), ElementsAre(0, 1, 2));
+  EXPECT_THAT(candidates(index, "/shelves/ab/books"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/shelves/ab/books/x"), ElementsAre(1));
+  EXPECT_THAT(candidates(index, "/other"), ElementsAre(3));
+}
+
+TEST(RoutePathIndexTest, InvalidRegexIsUnindexed) {
+  RoutePathIndex index;
+  index.addRegex("(unbalanced", 0);
+  index.addRegex("/a", 1);
+  index.finalize();
+
+  EXPECT_EQ(1, index.regexSetRoutes());
+  EXPECT_EQ(1, index.unindexedRoutes());
+  EXPECT_THAT(candidates(index, "/a"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/b"), ElementsAre(0));
+}
+
+TEST(RoutePathIndexTest, StopIteration) {
+  RoutePathIndex index;
+  index.addPrefix("/", false, 0);
+  index.addUnindexed(1);
+  index.addPrefix("/a", false, 2);
+
+  std::vector<uint32_t> visited;
+  index.forEachCandidate("/a", "/a", [&](uint32_t i) {
+    visited.push_back(i);
+    return i != 1;
+  });
+  EXPECT_THAT(visited, ElementsAre(0, 1));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -1,6 +1,7 @@
 #include <cmath>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/stats/sink.h"
 
@@ -10,6 +11,8 @@
 #include "test/test_common/logging.h"
 #include "test/test_common/thread_factory_for_test.h"
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/notification.h"
 #include "gmock/gmock-matchers.h"
 #include "gtest/gtest.h"
@@ -137,6 +140,48 @@ TEST_F(AllocatorTest, RefCountDecAllocRaceSynchronized) {
   EXPECT_FALSE(alloc_.isMutexLockedForTest());
 }
 
+// Creates distinct and shared stats from several threads, which spreads them over
+// the allocator shards, and checks that iteration sees each stat exactly once.
+TEST_F(AllocatorTest, ConcurrentCreation) {
+  const uint32_t num_threads = 8;
+  const uint32_t num_stats = 100;
+  std::vector<StatName> names;
+  for (uint32_t i = 0; i < num_stats; ++i) {
+    names.push_back(makeStat(absl::StrCat("counter.", i)));
+  }
+  StatName shared_name = makeStat("counter.shared");
+
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  std::vector<std::vector<CounterSharedPtr>> counters(num_threads);
+  std::vector<Thread::ThreadPtr> threads;
+  absl::Notification go;
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    threads.push_back(thread_factory.createThread([&, t]() {
+      go.WaitForNotification();
+      for (uint32_t i = t; i < num_stats; i += num_threads) {
+        counters[t].push_back(alloc_.makeCounter(names[i], StatName(), {}));
+      }
+      counters[t].push_back(alloc_.makeCounter(shared_name, StatName(), {}));
+    }));
+  }
+  go.Notify();
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  for (uint32_t t = 1; t < num_threads; ++t) {
+    EXPECT_EQ(counters[0].back().get(), counters[t].back().get());
+  }
+  EXPECT_EQ(num_threads, counters[0].back()->use_count());
+
+  size_t size = 0;
+  absl::flat_hash_set<Counter*> seen;
+  alloc_.forEachCounter([&size](size_t s) { size = s; },
+                        [&seen](Counter& counter) { EXPECT_TRUE(seen.insert(&counter).second); });
+  EXPECT_EQ(num_stats + 1, size);
+  EXPECT_EQ(num_stats + 1, seen.size());
+}
+
 TEST_F(AllocatorTest, HiddenGauge) {
   GaugeSharedPtr uninitialized_gauge =
       alloc_.makeGauge(makeStat("uninitialized"), StatName(), {}, Gauge::ImportMode::Uninitialized);
@@ -159,6 +204,34 @@ TEST_F(AllocatorTest, HiddenGauge) {
   EXPECT_FALSE(never_import_hidden_gauge->hidden());
 }
 
+TEST_F(AllocatorTest, GaugeLatchChanged) {
+  GaugeSharedPtr gauge =
+      alloc_.makeGauge(makeStat("gauge"), StatName(), {}, Gauge::ImportMode::Accumulate);
+  // A new gauge is reported as changed once, even if it was never updated.
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+
+  gauge->set(3);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+
+  gauge->add(2);
+  gauge->sub(1);
+  EXPECT_TRUE(gauge->latchChanged());
+
+  gauge->dec();
+  EXPECT_TRUE(gauge->latchChanged());
+
+  gauge->setParentValue(7);
+  EXPECT_TRUE(gauge->latchChanged());
+  EXPECT_FALSE(gauge->latchChanged());
+
+  // Latching does not affect the other flags of the gauge.
+  EXPECT_TRUE(gauge->used());
+  EXPECT_EQ(Gauge::ImportMode::Accumulate, gauge->importMode());
+  EXPECT_EQ(10, gauge->value());
+}
+
 TEST_F(AllocatorTest, ForEachCounter) {
   StatNameHashSet stat_names;
   std::vector<CounterSharedPtr> counters;
@@ -16,8 +16,11 @@
 #include "test/mocks/server/server_factory_context.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_time.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
+
 #include "benchmark/benchmark.h"
 
 namespace Envoy {
@@ -55,6 +58,32 @@ public:
     }
   }
 
+  // Creates num_scopes scopes holding all the sample counters, like a large CDS update creating
+  // clusters, spread over num_threads threads. The scopes are returned so that their destruction
+  // can be excluded from the measurement.
+  std::vector<std::vector<Stats::ScopeSharedPtr>> createScopesConcurrently(uint32_t num_threads,
+                                                                           uint32_t num_scopes) {
+    std::vector<std::vector<Stats::ScopeSharedPtr>> scopes(num_threads);
+    std::vector<Thread::ThreadPtr> threads;
+    for (uint32_t t = 0; t < num_threads; ++t) {
+      threads.push_back(Thread::threadFactoryForTest().createThread(
+          [this, t, num_threads, num_scopes, &thread_scopes = scopes[t]]() {
+            for (uint32_t i = t; i < num_scopes; i += num_threads) {
+              Stats::ScopeSharedPtr scope =
+                  store_.rootScope()->createScope(absl::StrCat("cluster.c", i));
+              for (auto& stat_name_storage : stat_names_) {
+                scope->counterFromStatName(stat_name_storage->statName());
+              }
+              thread_scopes.push_back(std::move(scope));
+            }
+          }));
+    }
+    for (auto& thread : threads) {
+      thread->join();
+    }
+    return scopes;
+  }
+
   void initThreading() {
     if (!Envoy::Event::Libevent::Global::initialized()) {
       Envoy::Event::Libevent::Global::initialize();
@@ -137,5 +166,25 @@ static void BM_StatsWithTlsAndRejectionsWithoutDot(benchmark::State& state) {
 }
 BENCHMARK(BM_StatsWithTlsAndRejectionsWithoutDot);
 
+// Tests the creation of stats from multiple threads, each thread creating the
+// counters of its own scopes. The argument is the number of threads.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_StatsCreationMultiThreaded(benchmark::State& state) {
+  const uint32_t num_threads = state.range(0);
+  for (auto _ : state) { // NOLINT
+    state.PauseTiming();
+    auto context = std::make_unique<Envoy::ThreadLocalStorePerf>();
+    state.ResumeTiming();
+
+    auto scopes = context->createScopesConcurrently(num_threads, 64);
+
+    state.PauseTiming();
+    scopes.clear();
+    context.reset();
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_StatsCreationMultiThreaded)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
 // TODO(jmarantz): add multi-threaded variant of this test, that aggressively
-// looks up stats in multiple threads to try to trigger contention issues.
+// looks up existing stats in multiple threads to try to trigger contention issues.
@@ -27,6 +27,7 @@
 #include "test/mocks/stats/mocks.h"
 #include "test/mocks/thread_local/mocks.h"
 #include "test/test_common/logging.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "absl/strings/str_split.h"
@@ -2194,6 +2195,40 @@ TEST_F(HistogramTest, BasicHistogramMergeSummary) {
             name_histogram_map["h1"]->cumulativeStatistics().bucketSummary());
 }
 
+// Records more values than a thread local histogram buffers, with runs of repeated values, and
+// validates that every value is merged.
+TEST_F(HistogramTest, BatchedValuesAreMerged) {
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+
+  for (size_t i = 0; i < 37; ++i) {
+    expectCallAndAccumulate(h1, i % 5 == 0 ? 7 : i);
+  }
+  EXPECT_EQ(1, validateMerge());
+
+  // Values recorded after a merge, fewer than fill the buffer, are merged in the next interval.
+  expectCallAndAccumulate(h1, 3);
+  expectCallAndAccumulate(h1, 3);
+  EXPECT_EQ(1, validateMerge());
+
+  NameHistogramMap name_histogram_map = makeHistogramMap(store_->histograms());
+  EXPECT_EQ(2, name_histogram_map["h1"]->intervalStatistics().sampleCount());
+  EXPECT_EQ(39, name_histogram_map["h1"]->cumulativeStatistics().sampleCount());
+}
+
+TEST_F(HistogramTest, BatchedValuesDisabled) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.batch_tls_histogram_values", "false"}});
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+
+  for (size_t i = 0; i < 20; ++i) {
+    expectCallAndAccumulate(h1, i % 2);
+  }
+  EXPECT_EQ(1, validateMerge());
+
+  NameHistogramMap name_histogram_map = makeHistogramMap(store_->histograms());
+  EXPECT_EQ(20, name_histogram_map["h1"]->cumulativeStatistics().sampleCount());
+}
+
 TEST_F(HistogramTest, BasicHistogramUsed) {
   ScopeSharedPtr scope1 = store_->createScope("scope1.");
 
@@ -2444,6 +2479,34 @@ TEST_F(OneWorkerThread, DeleteForEachRace) {
   wait_for_main();
 }
 
+// Changes the stats matcher while a worker is allocating a stat outside of the store lock. The
+// stat must be re-checked against the new matcher rather than added to the central cache.
+TEST_F(OneWorkerThread, SetStatsMatcherDuringMakeStatRace) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  envoy::config::metrics::v3::StatsConfig stats_config;
+  stats_config.mutable_stats_matcher()->mutable_exclusion_list()->add_patterns()->set_prefix(
+      "racy");
+
+  store_->sync().enable();
+  store_->sync().waitOn(ThreadLocalStoreImpl::MakeStatSync);
+  Counter* counter = nullptr;
+  auto wait_for_worker = runOnAllWorkers(
+      [this, &counter]() { counter = &scope_.counterFromString("racy.counter"); });
+  store_->sync().barrierOn(ThreadLocalStoreImpl::MakeStatSync);
+  runOnMainBlocking([this, &stats_config, &context]() {
+    store_->setStatsMatcher(
+        std::make_unique<StatsMatcherImpl>(stats_config, symbol_table_, context));
+  });
+  store_->sync().signal(ThreadLocalStoreImpl::MakeStatSync);
+  wait_for_worker();
+
+  ASSERT_NE(nullptr, counter);
+  EXPECT_EQ("", counter->name());
+  EXPECT_EQ(nullptr, TestUtility::findCounter(*store_, "racy.counter"));
+  runOnAllWorkersBlocking(
+      [this]() { EXPECT_EQ("", scope_.counterFromString("racy.counter").name()); });
+}
+
 class ClusterShutdownCleanupStarvationTest : public ThreadLocalRealThreadsMixin,
                                              public testing::Test {
 protected:
@@ -0,0 +1,165 @@
+#include <string>
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/network/io_socket_handle_impl.h"
+#include "source/common/tcp_proxy/splice_bridge.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace TcpProxy {
+namespace {
+
+using testing::_;
+using testing::InvokeWithoutArgs;
+using testing::Return;
+
+class MockSpliceBridgeCallbacks : public SpliceBridge::Callbacks {
+public:
+  MOCK_METHOD(void, onSplicedDownstreamData, (uint64_t bytes));
+  MOCK_METHOD(void, onSplicedUpstreamData, (uint64_t bytes));
+  MOCK_METHOD(void, onSpliceDone, (bool failed));
+};
+
+#if defined(__linux__)
+
+// The proxied sockets are one end of a socket pair each, the other end plays the peer.
+class SpliceBridgeTest : public testing::Test {
+public:
+  SpliceBridgeTest()
+      : api_(Api::createApiForTest()), dispatcher_(api_->allocateDispatcher("test_thread")),
+        os_sys_calls_(Api::OsSysCallsSingleton::get()) {}
+
+  void SetUp() override {
+    downstream_ = createSocketPair(downstream_peer_);
+    upstream_ = createSocketPair(upstream_peer_);
+  }
+
+  void TearDown() override {
+    for (const os_fd_t fd : {downstream_peer_, upstream_peer_}) {
+      if (SOCKET_VALID(fd)) {
+        os_sys_calls_.close(fd);
+      }
+    }
+  }
+
+  Network::IoHandlePtr createSocketPair(os_fd_t& peer) {
+    os_fd_t fds[2];
+    EXPECT_EQ(0, os_sys_calls_.socketpair(AF_UNIX, SOCK_STREAM, 0, fds).return_value_);
+    for (const os_fd_t fd : fds) {
+      EXPECT_EQ(0, os_sys_calls_.setsocketblocking(fd, false).return_value_);
+    }
+    peer = fds[1];
+    return std::make_unique<Network::IoSocketHandleImpl>(fds[0]);
+  }
+
+  void write(os_fd_t fd, absl::string_view data) {
+    EXPECT_EQ(static_cast<ssize_t>(data.size()),
+              os_sys_calls_.send(fd, const_cast<char*>(data.data()), data.size(), 0).return_value_);
+  }
+
+  std::string read(os_fd_t fd) {
+    char buffer[1024];
+    const Api::SysCallSizeResult result = os_sys_calls_.recv(fd, buffer, sizeof(buffer), 0);
+    return result.return_value_ > 0 ? std::string(buffer, result.return_value_) : "";
+  }
+
+  bool readEndOfStream(os_fd_t fd) {
+    char buffer[1];
+    return os_sys_calls_.recv(fd, buffer, sizeof(buffer), 0).return_value_ == 0;
+  }
+
+  // Runs the dispatcher until the callbacks stop it.
+  void run() { dispatcher_->run(Event::Dispatcher::RunType::Block); }
+  void exit() { dispatcher_->exit(); }
+
+  Api::ApiPtr api_;
+  Event::DispatcherPtr dispatcher_;
+  Api::OsSysCalls& os_sys_calls_;
+  Network::IoHandlePtr downstream_;
+  Network::IoHandlePtr upstream_;
+  os_fd_t downstream_peer_{INVALID_SOCKET};
+  os_fd_t upstream_peer_{INVALID_SOCKET};
+  testing::StrictMock<MockSpliceBridgeCallbacks> callbacks_;
+};
+
+TEST_F(SpliceBridgeTest, MovesDataInBothDirections) {
+  // Data sent before the bridge is created is picked up by the first events.
+  write(downstream_peer_, "hello");
+  SpliceBridgePtr bridge = SpliceBridge::create(*dispatcher_, *downstream_, *upstream_, callbacks_);
+  ASSERT_NE(nullptr, bridge);
+
+  EXPECT_CALL(callbacks_, onSplicedDownstreamData(5)).WillOnce(InvokeWithoutArgs([this] {
+    exit();
+  }));
+  run();
+  EXPECT_EQ("hello", read(upstream_peer_));
+
+  EXPECT_CALL(callbacks_, onSplicedUpstreamData(6)).WillOnce(InvokeWithoutArgs([this] {
+    exit();
+  }));
+  write(upstream_peer_, "world!");
+  run();
+  EXPECT_EQ("world!", read(downstream_peer_));
+
+  // The end of stream of one direction is forwarded while the other direction stays open.
+  os_sys_calls_.shutdown(downstream_peer_, ENVOY_SHUT_WR);
+  EXPECT_CALL(callbacks_, onSplicedUpstreamData(3)).WillOnce(InvokeWithoutArgs([this] {
+    exit();
+  }));
+  write(upstream_peer_, "bye");
+  run();
+  EXPECT_TRUE(readEndOfStream(upstream_peer_));
+  EXPECT_EQ("bye", read(downstream_peer_));
+
+  EXPECT_CALL(callbacks_, onSpliceDone(false)).WillOnce(InvokeWithoutArgs([this] { exit(); }));
+  os_sys_calls_.shutdown(upstream_peer_, ENVOY_SHUT_WR);
+  run();
+  EXPECT_TRUE(readEndOfStream(downstream_peer_));
+}
+
+TEST_F(SpliceBridgeTest, WriteFailure) {
+  SpliceBridgePtr bridge = SpliceBridge::create(*dispatcher_, *downstream_, *upstream_, callbacks_);
+  ASSERT_NE(nullptr, bridge);
+
+  os_sys_calls_.close(upstream_peer_);
+  upstream_peer_ = INVALID_SOCKET;
+  EXPECT_CALL(callbacks_, onSplicedDownstreamData(_)).Times(testing::AtMost(1));
+  EXPECT_CALL(callbacks_, onSpliceDone(true)).WillOnce(InvokeWithoutArgs([this, &bridge] {
+    bridge.reset();
+    exit();
+  }));
+  write(downstream_peer_, "hello");
+  run();
+}
+
+TEST_F(SpliceBridgeTest, PipeCreationFailure) {
+  Api::MockLinuxOsSysCalls linux_os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls(&linux_os_sys_calls);
+  EXPECT_CALL(linux_os_sys_calls, pipe2(_, _)).WillOnce(Return(Api::SysCallIntResult{-1, EMFILE}));
+
+  EXPECT_EQ(nullptr,
+            SpliceBridge::create(*dispatcher_, *downstream_, *upstream_, callbacks_).get());
+}
+
+#endif
+
+TEST(SpliceBridgeUnsupportedTest, InvalidSockets) {
+  Api::ApiPtr api = Api::createApiForTest();
+  Event::DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+  Network::IoSocketHandleImpl downstream;
+  Network::IoSocketHandleImpl upstream;
+  testing::StrictMock<MockSpliceBridgeCallbacks> callbacks;
+
+  EXPECT_EQ(nullptr, SpliceBridge::create(*dispatcher, downstream, upstream, callbacks).get());
+}
+
+} // namespace
+} // namespace TcpProxy
+} // namespace Envoy
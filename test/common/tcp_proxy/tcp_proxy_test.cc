@@ -15,6 +15,7 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/application_protocol.h"
+#include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/proxy_protocol_filter_state.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/transport_socket_options_impl.h"
@@ -329,6 +330,41 @@ TEST_P(TcpProxyTest, DrainCloseAfterDownstreamWrite) {
   upstream_callbacks_->onUpstreamData(buffer, false);
 }
 
+// Data is not spliced if a connection uses a transport socket that does not pass the data through
+// unmodified, e.g. TLS or PROXY protocol. It is proxied through the filter as usual.
+TEST_P(TcpProxyTest, SpliceDataIgnoredForTransportSocket) {
+  auto config = defaultConfig();
+  config.set_splice_data(true);
+  ON_CALL(filter_callbacks_, isOnlyFilter()).WillByDefault(Return(true));
+  ON_CALL(filter_callbacks_.connection_, canSpliceData()).WillByDefault(Return(true));
+  setup(1, config);
+  ON_CALL(*upstream_connections_.at(0), canSpliceData()).WillByDefault(Return(false));
+
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0, config_->stats().downstream_cx_spliced_.value());
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), false));
+  filter_->onData(buffer, false);
+}
+
+// Data is not spliced if the downstream connection has other filters, which would not see it.
+TEST_P(TcpProxyTest, SpliceDataIgnoredWithOtherFilters) {
+  auto config = defaultConfig();
+  config.set_splice_data(true);
+  ON_CALL(filter_callbacks_, isOnlyFilter()).WillByDefault(Return(false));
+  ON_CALL(filter_callbacks_.connection_, canSpliceData()).WillByDefault(Return(true));
+  setup(1, config);
+  ON_CALL(*upstream_connections_.at(0), canSpliceData()).WillByDefault(Return(true));
+
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0, config_->stats().downstream_cx_spliced_.value());
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), false));
+  filter_->onData(buffer, false);
+}
+
 // Test with an explicitly configured upstream.
 TEST_P(TcpProxyTest, ExplicitFactory) {
   // Explicitly configure an HTTP upstream, to test factory creation.
@@ -1909,7 +1945,7 @@ TEST_P(TcpProxyTest, UpstreamFlushTimeoutExpired) {
   filter_.reset();
   EXPECT_EQ(1U, config_->stats().upstream_flush_active_.value());
 
-  EXPECT_CALL(*upstream_connections_.at(0), close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(*upstream_connections_.at(0), close(Network::ConnectionCloseType::NoFlush, _));
   EXPECT_CALL(*idle_timer, disableTimer());
   idle_timer->invokeCallback();
   EXPECT_EQ(1U, config_->stats().upstream_flush_total_.value());
@@ -1934,7 +1970,7 @@ TEST_P(TcpProxyTest, UpstreamFlushReceiveUpstreamData) {
 
   // Send some bytes; no timeout configured so this should be a no-op (not a crash).
   Buffer::OwnedImpl buffer("a");
-  EXPECT_CALL(*upstream_connections_.at(0), close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(*upstream_connections_.at(0), close(Network::ConnectionCloseType::NoFlush, _));
   upstream_callbacks_->onUpstreamData(buffer, false);
 }
 
@@ -2813,6 +2849,122 @@ TEST_P(TcpProxyTest, LargeBufferScenario) {
 INSTANTIATE_TEST_SUITE_P(WithOrWithoutUpstream, TcpProxyTest,
                          ::testing::ValuesIn(TcpProxyTestBase::getRuntimeFlagsForTest()));
 
+#if defined(__linux__)
+
+// The sockets of the downstream and upstream connections are one end of a socket pair each, the
+// other end plays the peer.
+class TcpProxySpliceTest : public TcpProxyTest {
+public:
+  void SetUp() override {
+    downstream_socket_ = createSocket(downstream_peer_);
+    upstream_socket_ = createSocket(upstream_peer_);
+  }
+
+  void TearDown() override {
+    for (const os_fd_t fd : {downstream_peer_, upstream_peer_}) {
+      Api::OsSysCallsSingleton::get().close(fd);
+    }
+  }
+
+  Network::ConnectionSocketPtr createSocket(os_fd_t& peer) {
+    auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+    os_fd_t fds[2];
+    EXPECT_EQ(0, os_sys_calls.socketpair(AF_UNIX, SOCK_STREAM, 0, fds).return_value_);
+    for (const os_fd_t fd : fds) {
+      EXPECT_EQ(0, os_sys_calls.setsocketblocking(fd, false).return_value_);
+    }
+    peer = fds[1];
+    io_handles_.push_back(std::make_unique<Network::IoSocketHandleImpl>(fds[0]));
+    auto socket = std::make_unique<NiceMock<Network::MockConnectionSocket>>();
+    ON_CALL(*socket, ioHandle()).WillByDefault(ReturnRef(*io_handles_.back()));
+    return socket;
+  }
+
+  // Sets up a connection whose data is spliced once the upstream connection is established.
+  void setupSplice() {
+    auto config = defaultConfig();
+    config.set_splice_data(true);
+    ON_CALL(filter_callbacks_, isOnlyFilter()).WillByDefault(Return(true));
+    ON_CALL(filter_callbacks_.connection_, canSpliceData()).WillByDefault(Return(true));
+    ON_CALL(filter_callbacks_.connection_, getSocket())
+        .WillByDefault(ReturnRef(downstream_socket_));
+    setup(1, config);
+    ON_CALL(*upstream_connections_.at(0), canSpliceData()).WillByDefault(Return(true));
+    ON_CALL(*upstream_connections_.at(0), getSocket()).WillByDefault(ReturnRef(upstream_socket_));
+  }
+
+  void write(os_fd_t fd, absl::string_view data) {
+    EXPECT_EQ(static_cast<ssize_t>(data.size()),
+              Api::OsSysCallsSingleton::get()
+                  .send(fd, const_cast<char*>(data.data()), data.size(), 0)
+                  .return_value_);
+  }
+
+  std::string read(os_fd_t fd) {
+    char buffer[1024];
+    const Api::SysCallSizeResult result =
+        Api::OsSysCallsSingleton::get().recv(fd, buffer, sizeof(buffer), 0);
+    return result.return_value_ > 0 ? std::string(buffer, result.return_value_) : "";
+  }
+
+  std::vector<Network::IoHandlePtr> io_handles_;
+  Network::ConnectionSocketPtr downstream_socket_;
+  Network::ConnectionSocketPtr upstream_socket_;
+  os_fd_t downstream_peer_{INVALID_SOCKET};
+  os_fd_t upstream_peer_{INVALID_SOCKET};
+};
+
+TEST_P(TcpProxySpliceTest, SpliceData) {
+  setupSplice();
+  Event::FileReadyCb on_socket_event;
+  EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, createFileEvent_(_, _, _, _))
+      .Times(2)
+      .WillRepeatedly(DoAll(SaveArg<1>(&on_socket_event),
+                            InvokeWithoutArgs([]() -> Event::FileEvent* {
+                              return new NiceMock<Event::MockFileEvent>();
+                            })));
+  // The downstream connection stays read disabled, and the upstream connection is read disabled.
+  EXPECT_CALL(*upstream_connections_.at(0), readDisable(true));
+  raiseEventUpstreamConnected(0, /*expect_read_enable=*/false);
+  EXPECT_EQ(1, config_->stats().downstream_cx_spliced_.value());
+
+  write(downstream_peer_, "hello");
+  write(upstream_peer_, "world!");
+  ASSERT_TRUE(on_socket_event(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("hello", read(upstream_peer_));
+  EXPECT_EQ("world!", read(downstream_peer_));
+
+  // The spliced data is accounted for as if it was proxied through the filter.
+  EXPECT_EQ(5, config_->stats().downstream_cx_rx_bytes_total_.value());
+  EXPECT_EQ(6, config_->stats().downstream_cx_tx_bytes_total_.value());
+  const Upstream::ClusterTrafficStats& traffic_stats =
+      *upstream_hosts_.at(0)->cluster_.trafficStats();
+  EXPECT_EQ(5, traffic_stats.upstream_cx_tx_bytes_total_.value());
+  EXPECT_EQ(6, traffic_stats.upstream_cx_rx_bytes_total_.value());
+  const StreamInfo::StreamInfo& stream_info = filter_callbacks_.connection_.streamInfo();
+  EXPECT_EQ(5, stream_info.bytesReceived());
+  EXPECT_EQ(6, stream_info.bytesSent());
+  EXPECT_EQ(5, stream_info.getDownstreamBytesMeter()->wireBytesReceived());
+  EXPECT_EQ(6, stream_info.getDownstreamBytesMeter()->wireBytesSent());
+  EXPECT_EQ(5, stream_info.getUpstreamBytesMeter()->wireBytesSent());
+  EXPECT_EQ(6, stream_info.getUpstreamBytesMeter()->wireBytesReceived());
+  EXPECT_EQ(5, upstream_connections_.at(0)->streamInfo().bytesSent());
+  EXPECT_EQ(6, upstream_connections_.at(0)->streamInfo().bytesReceived());
+
+  // Once both peers reached end of stream, the connections are closed.
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  EXPECT_EQ(0, os_sys_calls.shutdown(downstream_peer_, ENVOY_SHUT_WR).return_value_);
+  EXPECT_EQ(0, os_sys_calls.shutdown(upstream_peer_, ENVOY_SHUT_WR).return_value_);
+  EXPECT_CALL(filter_callbacks_.connection_, close(Network::ConnectionCloseType::NoFlush));
+  EXPECT_CALL(*upstream_connections_.at(0), close(Network::ConnectionCloseType::NoFlush, _));
+  ASSERT_TRUE(on_socket_event(Event::FileReadyType::Read).ok());
+}
+
+INSTANTIATE_TEST_SUITE_P(WithOrWithoutUpstream, TcpProxySpliceTest,
+                         ::testing::ValuesIn(TcpProxyTestBase::getRuntimeFlagsForTest()));
+
+#endif
+
 TEST(PerConnectionCluster, ObjectFactory) {
   const std::string name = "envoy.tcp_proxy.cluster";
   auto* factory =
@@ -0,0 +1,126 @@
+#include <string>
+#include <vector>
+
+#include "source/common/common/hash.h"
+#include "source/common/tls/session_cache_impl.h"
+
+#include "test/common/stats/stat_test_utility.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace TransportSockets {
+namespace Tls {
+namespace {
+
+class SessionCacheImplTest : public testing::Test {
+public:
+  // Creates a cache whose shards each hold two sessions like those of session().
+  SessionCacheImplTest()
+      : cache_(2 * SessionCacheImpl::sizeBytes(id(0), session(0)) * SessionCacheImpl::NumShards,
+               time_system_, *store_.rootScope()) {}
+
+  // IDs and sessions all have the same size.
+  static std::string id(uint32_t i) { return absl::StrCat("id", absl::Dec(i, absl::kZeroPad4)); }
+  static std::string session(uint32_t i) {
+    return absl::StrCat("session", absl::Dec(i, absl::kZeroPad4));
+  }
+
+  static uint64_t shard(uint32_t i) {
+    return HashUtil::xxHash64(id(i)) % SessionCacheImpl::NumShards;
+  }
+
+  // @return the first `count` session numbers whose IDs are in the same shard as the first one.
+  static std::vector<uint32_t> sameShard(size_t count) {
+    std::vector<uint32_t> numbers;
+    for (uint32_t i = 0; numbers.size() < count; ++i) {
+      if (shard(i) == shard(0)) {
+        numbers.push_back(i);
+      }
+    }
+    return numbers;
+  }
+
+  SystemTime inOneHour() { return time_system_.systemTime() + std::chrono::hours(1); }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::TestUtil::TestStore store_;
+  SessionCacheImpl cache_;
+};
+
+TEST_F(SessionCacheImplTest, InsertAndLookup) {
+  cache_.insert(id(0), session(0), inOneHour());
+  EXPECT_EQ(session(0), cache_.lookup(id(0)));
+  EXPECT_FALSE(cache_.lookup(id(1)).has_value());
+  EXPECT_EQ(1, cache_.stats().hit_.value());
+  EXPECT_EQ(1, cache_.stats().miss_.value());
+
+  // A session replaces the session with the same ID.
+  cache_.insert(id(0), session(1), inOneHour());
+  EXPECT_EQ(session(1), cache_.lookup(id(0)));
+  EXPECT_EQ(1, cache_.stats().sessions_.value());
+  EXPECT_EQ(SessionCacheImpl::sizeBytes(id(0), session(1)), cache_.stats().size_bytes_.value());
+}
+
+TEST_F(SessionCacheImplTest, ExpiredSessionsAreMisses) {
+  cache_.insert(id(0), session(0), inOneHour());
+  time_system_.setSystemTime(inOneHour());
+  EXPECT_FALSE(cache_.lookup(id(0)).has_value());
+  EXPECT_EQ(1, cache_.stats().miss_.value());
+  EXPECT_EQ(0, cache_.stats().sessions_.value());
+  EXPECT_EQ(0, cache_.stats().size_bytes_.value());
+}
+
+TEST_F(SessionCacheImplTest, EvictsLeastRecentlyUsed) {
+  const std::vector<uint32_t> numbers = sameShard(3);
+  cache_.insert(id(numbers[0]), session(numbers[0]), inOneHour());
+  cache_.insert(id(numbers[1]), session(numbers[1]), inOneHour());
+  // Looking up the oldest session makes the second one the least recently used.
+  EXPECT_TRUE(cache_.lookup(id(numbers[0])).has_value());
+  cache_.insert(id(numbers[2]), session(numbers[2]), inOneHour());
+
+  EXPECT_EQ(1, cache_.stats().evicted_.value());
+  EXPECT_EQ(2, cache_.stats().sessions_.value());
+  EXPECT_TRUE(cache_.lookup(id(numbers[0])).has_value());
+  EXPECT_FALSE(cache_.lookup(id(numbers[1])).has_value());
+  EXPECT_TRUE(cache_.lookup(id(numbers[2])).has_value());
+}
+
+TEST_F(SessionCacheImplTest, SessionLargerThanShardNotInserted) {
+  cache_.insert(id(0), std::string(3 * SessionCacheImpl::sizeBytes(id(0), session(0)), 'x'),
+                inOneHour());
+  EXPECT_EQ(0, cache_.stats().sessions_.value());
+  EXPECT_FALSE(cache_.lookup(id(0)).has_value());
+}
+
+// Sessions are iterated from the least recently used, and expired sessions are skipped.
+TEST_F(SessionCacheImplTest, Iterate) {
+  const std::vector<uint32_t> numbers = sameShard(2);
+  const SystemTime expire_time = inOneHour();
+  cache_.insert(id(numbers[0]), session(numbers[0]), expire_time);
+  cache_.insert(id(numbers[1]), session(numbers[1]), expire_time);
+  EXPECT_TRUE(cache_.lookup(id(numbers[0])).has_value());
+  uint32_t expired = 1;
+  while (shard(expired) == shard(0)) {
+    ++expired;
+  }
+  cache_.insert(id(expired), session(expired), time_system_.systemTime() + std::chrono::minutes(1));
+  time_system_.setSystemTime(time_system_.systemTime() + std::chrono::minutes(1));
+
+  std::vector<std::string> ids;
+  cache_.iterate([&](absl::string_view session_id, absl::string_view data, SystemTime time) {
+    ids.emplace_back(session_id);
+    EXPECT_EQ(absl::StrCat("session", session_id.substr(2)), data);
+    EXPECT_EQ(expire_time, time);
+  });
+  EXPECT_EQ((std::vector<std::string>{id(numbers[1]), id(numbers[0])}), ids);
+}
+
+} // namespace
+} // namespace Tls
+} // namespace TransportSockets
+} // namespace Extensions
+} // namespace Envoy
@@ -4323,11 +4323,14 @@ void testTicketSessionResumption(const std::string& server_ctx_yaml1,
                                  const std::vector<std::string>& server_names2,
                                  const std::string& client_ctx_yaml, bool expect_reuse,
                                  const Network::Address::IpVersion ip_version,
-                                 const uint32_t expected_lifetime_hint = 0) {
+                                 const uint32_t expected_lifetime_hint = 0,
+                                 const uint64_t tls_session_cache_size_kb = 0) {
   Event::SimulatedTimeSystem time_system;
   NiceMock<Server::Configuration::MockTransportSocketFactoryContext>
       transport_socket_factory_context;
   NiceMock<Server::Configuration::MockServerFactoryContext> server_factory_context;
+  ON_CALL(server_factory_context.options_, tlsSessionCacheSizeKB())
+      .WillByDefault(Return(tls_session_cache_size_kb));
   ContextManagerImpl manager(server_factory_context);
 
   Stats::TestUtil::TestStore server_stats_store;
@@ -5054,6 +5057,30 @@ TEST_P(SslSocketTest, StatelessSessionResumptionDisabled) {
   testSupportForSessionResumption(server_ctx_yaml, client_ctx_yaml, false, true, version_);
 }
 
+// Sessions are resumed with their session ID by any context with the same session ID context
+// through the shared session cache.
+TEST_P(SslSocketTest, SharedSessionCacheResumption) {
+  const std::string server_ctx_yaml = R"EOF(
+  common_tls_context:
+    tls_params:
+      tls_minimum_protocol_version: TLSv1_0
+      tls_maximum_protocol_version: TLSv1_2
+    tls_certificates:
+      certificate_chain:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_cert.pem"
+      private_key:
+        filename: "{{ test_rundir }}/test/common/tls/test_data/unittest_key.pem"
+  disable_stateless_session_resumption: true
+)EOF";
+
+  const std::string client_ctx_yaml = R"EOF(
+    common_tls_context:
+  )EOF";
+
+  testTicketSessionResumption(server_ctx_yaml, {}, server_ctx_yaml, {}, client_ctx_yaml, true,
+                              version_, 0, 64);
+}
+
 TEST_P(SslSocketTest, StatefulSessionResumptionDisabled) {
   const std::string server_ctx_yaml = R"EOF(
   common_tls_context:
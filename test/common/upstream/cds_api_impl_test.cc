@@ -18,13 +18,16 @@
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/mocks/upstream/cluster_priority_set.h"
 #include "test/test_common/printers.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::Eq;
 using testing::InSequence;
+using testing::Invoke;
 using testing::Return;
 using testing::StrEq;
 using testing::Throw;
@@ -49,12 +52,12 @@ protected:
   }
 
   void expectAdd(const std::string& cluster_name, const std::string& version = std::string("")) {
-    EXPECT_CALL(cm_, addOrUpdateCluster(WithName(cluster_name), version, false))
+    EXPECT_CALL(cm_, addOrUpdateCluster(WithName(cluster_name), version, false, _))
         .WillOnce(Return(true));
   }
 
   void expectAddToThrow(const std::string& cluster_name, const std::string& exception_msg) {
-    EXPECT_CALL(cm_, addOrUpdateCluster(WithName(cluster_name), _, false))
+    EXPECT_CALL(cm_, addOrUpdateCluster(WithName(cluster_name), _, false, _))
         .WillOnce(Throw(EnvoyException(exception_msg)));
   }
 
@@ -81,6 +84,51 @@ protected:
   NiceMock<ProtobufMessage::MockValidationVisitor> validation_visitor_;
 };
 
+// Large updates hash their clusters on additional threads before applying them.
+TEST_F(CdsApiImplTest, ConfigUpdateWithManyClusters) {
+  {
+    InSequence s;
+    setup();
+  }
+
+  EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterInfoMaps({})));
+  EXPECT_CALL(initialized_, ready());
+
+  std::vector<envoy::config::cluster::v3::Cluster> clusters(1000);
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    clusters[i].set_name(absl::StrCat("cluster_", i));
+  }
+  // The hash computed ahead of time is handed to the cluster manager with its cluster.
+  EXPECT_CALL(cm_, addOrUpdateCluster(_, "", false, _))
+      .Times(clusters.size())
+      .WillRepeatedly(Invoke([](const envoy::config::cluster::v3::Cluster& cluster,
+                                const std::string&, bool,
+                                absl::optional<uint64_t> config_hash) -> absl::StatusOr<bool> {
+        EXPECT_EQ(MessageUtil::hash(cluster), config_hash);
+        return true;
+      }));
+
+  const auto decoded_resources = TestUtility::decodeResources(clusters);
+  EXPECT_TRUE(cds_callbacks_->onConfigUpdate(decoded_resources.refvec_, "").ok());
+}
+
+TEST(CdsApiHelperTest, HashClusters) {
+  std::vector<envoy::config::cluster::v3::Cluster> clusters(1000);
+  std::vector<const envoy::config::cluster::v3::Cluster*> cluster_ptrs;
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    clusters[i].set_name(absl::StrCat("cluster_", i));
+    cluster_ptrs.push_back(&clusters[i]);
+  }
+  for (const uint32_t max_threads : {1, 2, 8}) {
+    const std::vector<uint64_t> hashes =
+        CdsApiHelper::hashClusters(cluster_ptrs, Thread::threadFactoryForTest(), max_threads);
+    ASSERT_EQ(clusters.size(), hashes.size());
+    for (size_t i = 0; i < clusters.size(); ++i) {
+      EXPECT_EQ(MessageUtil::hash(clusters[i]), hashes[i]);
+    }
+  }
+}
+
 // Regression test against only updating versionInfo() if at least one cluster
 // is are added/updated even if one or more are removed.
 TEST_F(CdsApiImplTest, UpdateVersionOnClusterRemove) {
@@ -181,6 +229,25 @@ TEST_F(CdsApiImplTest, ConfigUpdateWith2ValidClusters) {
   EXPECT_TRUE(cds_callbacks_->onConfigUpdate(decoded_resources.refvec_, "").ok());
 }
 
+// Small updates leave hashing to the cluster manager.
+TEST_F(CdsApiImplTest, ConfigUpdateWithFewClustersHasNoConfigHash) {
+  {
+    InSequence s;
+    setup();
+  }
+
+  EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterInfoMaps({})));
+  EXPECT_CALL(initialized_, ready());
+
+  envoy::config::cluster::v3::Cluster cluster_1;
+  cluster_1.set_name("cluster_1");
+  EXPECT_CALL(cm_, addOrUpdateCluster(WithName("cluster_1"), "", false, Eq(absl::nullopt)))
+      .WillOnce(Return(true));
+
+  const auto decoded_resources = TestUtility::decodeResources({cluster_1});
+  EXPECT_TRUE(cds_callbacks_->onConfigUpdate(decoded_resources.refvec_, "").ok());
+}
+
 TEST_F(CdsApiImplTest, DeltaConfigUpdate) {
   {
     InSequence s;
@@ -0,0 +1,90 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/upstream/cluster_config_pool.h"
+
+#include "test/common/stats/stat_test_utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+class ClusterConfigPoolTest : public testing::Test {
+public:
+  absl::StatusOr<std::shared_ptr<const std::string>>
+  getOrCreate(const std::string& key, const std::string& value,
+              ClusterConfigPool::ObjectType type = ClusterConfigPool::ObjectType::ProtocolOptions) {
+    return pool_.getOrCreate<std::string>(
+        type, key,
+        [&]() -> absl::StatusOr<std::shared_ptr<const std::string>> {
+          ++created_;
+          return std::make_shared<const std::string>(value);
+        },
+        [&](const std::string& interned) { return interned == value; });
+  }
+
+  Stats::TestUtil::TestStore store_;
+  ClusterConfigPool pool_{*store_.rootScope()};
+  uint32_t created_{};
+};
+
+TEST_F(ClusterConfigPoolTest, SharesLiveObjects) {
+  auto first = getOrCreate("key", "value").value();
+  auto second = getOrCreate("key", "value").value();
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(1, created_);
+  EXPECT_EQ(1, pool_.stats().protocol_options_dedup_hit_.value());
+  EXPECT_EQ(1, pool_.stats().protocol_options_dedup_miss_.value());
+
+  // Objects of another type are not shared.
+  EXPECT_NE(first, getOrCreate("key", "value", ClusterConfigPool::ObjectType::Metadata).value());
+  EXPECT_EQ(1, pool_.stats().metadata_dedup_miss_.value());
+
+  first.reset();
+  second.reset();
+  getOrCreate("key", "value").value();
+  EXPECT_EQ(3, created_);
+  EXPECT_EQ(2, pool_.stats().protocol_options_dedup_miss_.value());
+}
+
+// An interned object that does not match the config, for a colliding hash, is not shared.
+TEST_F(ClusterConfigPoolTest, MismatchNotShared) {
+  auto first = getOrCreate("key", "value").value();
+  auto second = getOrCreate("key", "other value").value();
+  EXPECT_EQ("other value", *second);
+  EXPECT_EQ(2, created_);
+  EXPECT_EQ(0, pool_.stats().protocol_options_dedup_hit_.value());
+}
+
+TEST_F(ClusterConfigPoolTest, CreationFailureNotInterned) {
+  const auto failed = pool_.getOrCreate<std::string>(
+      ClusterConfigPool::ObjectType::ProtocolOptions, "key",
+      []() -> absl::StatusOr<std::shared_ptr<const std::string>> {
+        return absl::InvalidArgumentError("bad config");
+      });
+  EXPECT_EQ("bad config", failed.status().message());
+  getOrCreate("key", "value").value();
+  EXPECT_EQ(1, created_);
+}
+
+// Expired objects are removed as objects are interned.
+TEST_F(ClusterConfigPoolTest, ManyExpiredObjects) {
+  std::vector<std::shared_ptr<const std::string>> live;
+  for (int i = 0; i < 1000; ++i) {
+    auto object = getOrCreate(absl::StrCat(i), absl::StrCat(i)).value();
+    if (i % 10 == 0) {
+      live.push_back(object);
+    }
+  }
+  for (int i = 0; i < 1000; i += 10) {
+    EXPECT_EQ(live[i / 10], getOrCreate(absl::StrCat(i), absl::StrCat(i)).value());
+  }
+  EXPECT_EQ(100, pool_.stats().protocol_options_dedup_hit_.value());
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -2,7 +2,9 @@
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
 
+#include "source/common/event/worker_name.h"
 #include "source/common/upstream/load_balancer_factory_base.h"
+#include "source/common/upstream/worker_host_subset.h"
 #include "source/extensions/load_balancing_policies/subset/subset_lb.h"
 
 #include "test/common/upstream/cluster_manager_impl_test_common.h"
@@ -21,6 +23,7 @@ using ::testing::InSequence;
 using ::testing::InvokeWithoutArgs;
 using ::testing::Return;
 using ::testing::ReturnNew;
+using ::testing::UnorderedElementsAreArray;
 
 class ClusterManagerSubsetInitializationTest
     : public ClusterManagerImplTest,
@@ -1229,6 +1232,146 @@ TEST_F(PreconnectTest, PreconnectCappedByMaybePreconnect) {
   EXPECT_EQ(1, http_preconnect_calls);
 }
 
+// Tests that the thread local cluster of a worker only keeps the hosts of its worker host subset,
+// and that the main thread keeps all the hosts.
+class WorkersPerHostTest : public ClusterManagerImplTest {
+public:
+  ~WorkersPerHostTest() override {
+    // The thread local cluster manager uses the dispatcher of its thread until it is destroyed.
+    member_update_cb_.reset();
+    cluster_manager_.reset();
+  }
+
+  void initialize(const std::string& dispatcher_name) {
+    const std::string yaml = R"EOF(
+  static_resources:
+    clusters:
+    - name: cluster_1
+      connect_timeout: 0.250s
+      lb_policy: ROUND_ROBIN
+      type: STATIC
+      common_lb_config:
+        workers_per_host: 2
+  )EOF";
+
+    dispatcher_ = std::make_unique<NiceMock<Event::MockDispatcher>>(dispatcher_name);
+    factory_.tls_.setDispatcher(dispatcher_.get());
+    factory_.server_context_.options_.concurrency_ = WorkerCount;
+    create(parseBootstrapFromV3Yaml(yaml));
+    cluster_ = &cluster_manager_->activeClusters().begin()->second.get();
+
+    for (uint32_t i = 0; i < 16; ++i) {
+      hosts_.push_back(makeTestHost(cluster_->info(), fmt::format("tcp://127.0.0.1:{}", 8000 + i)));
+    }
+
+    member_update_cb_ =
+        cluster_manager_->getThreadLocalCluster("cluster_1")
+            ->prioritySet()
+            .addMemberUpdateCb([this](const HostVector& hosts_added,
+                                      const HostVector& hosts_removed) {
+              hosts_added_ = hosts_added;
+              hosts_removed_ = hosts_removed;
+            });
+  }
+
+  // Sets the hosts of the cluster to hosts_[begin, end).
+  void updateHosts(uint32_t begin, uint32_t end, const HostVector& hosts_added,
+                   const HostVector& hosts_removed) {
+    auto hosts = std::make_shared<HostVector>(hosts_.begin() + begin, hosts_.begin() + end);
+    cluster_->prioritySet().updateHosts(
+        0, HostSetImpl::partitionHosts(hosts, HostsPerLocalityImpl::empty()), nullptr,
+        hosts_added, hosts_removed, absl::nullopt, 100);
+  }
+
+  const HostVector& threadLocalHosts() {
+    return cluster_manager_->getThreadLocalCluster("cluster_1")
+        ->prioritySet()
+        .hostSetsPerPriority()[0]
+        ->hosts();
+  }
+
+  HostVector range(uint32_t begin, uint32_t end) const {
+    return HostVector(hosts_.begin() + begin, hosts_.begin() + end);
+  }
+
+  static constexpr uint32_t WorkerCount = 4;
+
+  std::unique_ptr<NiceMock<Event::MockDispatcher>> dispatcher_;
+  Cluster* cluster_{};
+  HostVector hosts_;
+  Common::CallbackHandlePtr member_update_cb_;
+  HostVector hosts_added_;
+  HostVector hosts_removed_;
+};
+
+class WorkersPerHostWorkerTest : public WorkersPerHostTest,
+                                 public testing::WithParamInterface<uint32_t> {
+public:
+  // The hosts of `hosts` in the subset of the worker.
+  static HostVector subsetOnly(const HostVector& hosts) {
+    const WorkerHostSubset worker_subset(GetParam(), WorkerCount, 2);
+    HostVector subset_hosts;
+    for (const HostSharedPtr& host : hosts) {
+      if (worker_subset.contains(*host)) {
+        subset_hosts.push_back(host);
+      }
+    }
+    return subset_hosts;
+  }
+
+  // The hosts of `hosts` in the subset of the worker, or all of them if none is.
+  static HostVector subset(const HostVector& hosts) {
+    HostVector subset_hosts = subsetOnly(hosts);
+    return subset_hosts.empty() ? hosts : subset_hosts;
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(Workers, WorkersPerHostWorkerTest,
+                         testing::Range(0u, WorkersPerHostTest::WorkerCount));
+
+TEST_P(WorkersPerHostWorkerTest, HostAddedAndRemoved) {
+  initialize(Event::workerName(GetParam()));
+
+  // Add hosts 0 to 11.
+  updateHosts(0, 12, range(0, 12), {});
+  const HostVector first_hosts = subset(range(0, 12));
+  ASSERT_FALSE(first_hosts.empty());
+  ASSERT_LT(first_hosts.size(), 12U);
+  EXPECT_THAT(threadLocalHosts(), UnorderedElementsAreArray(first_hosts));
+  EXPECT_THAT(hosts_added_, UnorderedElementsAreArray(first_hosts));
+  EXPECT_TRUE(hosts_removed_.empty());
+
+  // Remove hosts 0 to 3 and add hosts 12 to 15. Only the hosts of the subset of the worker are
+  // reported as added or removed.
+  updateHosts(4, 16, range(12, 16), range(0, 4));
+  const HostVector second_hosts = subset(range(4, 16));
+  ASSERT_LT(second_hosts.size(), 12U);
+  EXPECT_THAT(threadLocalHosts(), UnorderedElementsAreArray(second_hosts));
+  EXPECT_THAT(hosts_added_, UnorderedElementsAreArray(subsetOnly(range(12, 16))));
+  EXPECT_THAT(hosts_removed_, UnorderedElementsAreArray(subsetOnly(range(0, 4))));
+}
+
+TEST_F(WorkersPerHostTest, MainThreadUsesAllHosts) {
+  initialize("main_thread");
+
+  updateHosts(0, 12, range(0, 12), {});
+  EXPECT_THAT(threadLocalHosts(), UnorderedElementsAreArray(range(0, 12)));
+  EXPECT_THAT(hosts_added_, UnorderedElementsAreArray(range(0, 12)));
+
+  updateHosts(4, 16, range(12, 16), range(0, 4));
+  EXPECT_THAT(threadLocalHosts(), UnorderedElementsAreArray(range(4, 16)));
+  EXPECT_THAT(hosts_added_, UnorderedElementsAreArray(range(12, 16)));
+  EXPECT_THAT(hosts_removed_, UnorderedElementsAreArray(range(0, 4)));
+}
+
+// A worker index beyond the concurrency does not select a subset.
+TEST_F(WorkersPerHostTest, WorkerIndexBeyondConcurrencyUsesAllHosts) {
+  initialize(Event::workerName(WorkerCount));
+
+  updateHosts(0, 12, range(0, 12), {});
+  EXPECT_THAT(threadLocalHosts(), UnorderedElementsAreArray(range(0, 12)));
+}
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
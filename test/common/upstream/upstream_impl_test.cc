@@ -5591,6 +5591,89 @@ TEST_F(ClusterInfoImplTest, ExtensionProtocolOptionsForFilterWithOptions) {
   }
 }
 
+// Clusters with identical protocol options and metadata share them.
+TEST_F(ClusterInfoImplTest, IdenticalConfigObjectsShared) {
+  const std::string yaml_template = R"EOF(
+    name: {}
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: ROUND_ROBIN
+    metadata:
+      filter_metadata:
+        com.bar.foo: {{ baz: {} }}
+    typed_extension_protocol_options:
+      envoy.extensions.upstreams.http.v3.HttpProtocolOptions:
+        "@type": type.googleapis.com/envoy.extensions.upstreams.http.v3.HttpProtocolOptions
+        explicit_http_config:
+          http2_protocol_options: {{}}
+  )EOF";
+
+  auto first = makeCluster(fmt::format(yaml_template, "first", "meh"));
+  auto second = makeCluster(fmt::format(yaml_template, "second", "meh"));
+  auto third = makeCluster(fmt::format(yaml_template, "third", "other"));
+
+  EXPECT_EQ(&first->info()->httpProtocolOptions(), &second->info()->httpProtocolOptions());
+  EXPECT_EQ(&first->info()->httpProtocolOptions(), &third->info()->httpProtocolOptions());
+  EXPECT_EQ(&first->info()->metadata(), &second->info()->metadata());
+  EXPECT_EQ(&first->info()->typedMetadata(), &second->info()->typedMetadata());
+  EXPECT_NE(&first->info()->metadata(), &third->info()->metadata());
+  EXPECT_EQ("other", third->info()
+                         ->metadata()
+                         .filter_metadata()
+                         .at("com.bar.foo")
+                         .fields()
+                         .at("baz")
+                         .string_value());
+
+  EXPECT_EQ(1, stats_.counter("cluster_manager.config_pool.metadata_dedup_hit").value());
+  EXPECT_EQ(2, stats_.counter("cluster_manager.config_pool.metadata_dedup_miss").value());
+  EXPECT_EQ(2, stats_.counter("cluster_manager.config_pool.protocol_options_dedup_hit").value());
+  EXPECT_EQ(1, stats_.counter("cluster_manager.config_pool.protocol_options_dedup_miss").value());
+
+  // Options are no longer shared once the clusters holding them are gone.
+  first.reset();
+  second.reset();
+  third.reset();
+  makeCluster(fmt::format(yaml_template, "fourth", "meh"));
+  EXPECT_EQ(3, stats_.counter("cluster_manager.config_pool.metadata_dedup_miss").value());
+  EXPECT_EQ(2, stats_.counter("cluster_manager.config_pool.protocol_options_dedup_miss").value());
+}
+
+// With deferred creation, the optional and config update stats of a cluster are instantiated on
+// first use.
+TEST_F(ClusterInfoImplTest, DeferredCreationStats) {
+  ON_CALL(server_context_.stats_config_, enableDeferredCreationStats()).WillByDefault(Return(true));
+  const std::string yaml = R"EOF(
+    name: name
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    lb_policy: ROUND_ROBIN
+    track_cluster_stats: { timeout_budgets: true, request_response_sizes: true }
+  )EOF";
+  auto cluster = makeCluster(yaml);
+
+  EXPECT_EQ(0, stats_.gauge("cluster.name.ClusterConfigUpdateStats.initialized",
+                            Stats::Gauge::ImportMode::HiddenAccumulate)
+                   .value());
+  EXPECT_FALSE(stats_.findCounterByString("cluster.name.update_attempt").has_value());
+  EXPECT_FALSE(stats_.findHistogramByString("cluster.name.upstream_rq_timeout_budget_percent_used")
+                   .has_value());
+  EXPECT_FALSE(stats_.findHistogramByString("cluster.name.upstream_rq_headers_size").has_value());
+
+  cluster->info()->configUpdateStats().update_attempt_.inc();
+  EXPECT_EQ(1, stats_.counter("cluster.name.update_attempt").value());
+  EXPECT_EQ(1, stats_.gauge("cluster.name.ClusterConfigUpdateStats.initialized",
+                            Stats::Gauge::ImportMode::HiddenAccumulate)
+                   .value());
+
+  ASSERT_TRUE(cluster->info()->timeoutBudgetStats().has_value());
+  EXPECT_TRUE(stats_.findHistogramByString("cluster.name.upstream_rq_timeout_budget_percent_used")
+                  .has_value());
+  ASSERT_TRUE(cluster->info()->requestResponseSizeStats().has_value());
+  EXPECT_TRUE(stats_.findHistogramByString("cluster.name.upstream_rq_headers_size").has_value());
+  EXPECT_EQ(0, cluster->info()->loadReportStats().upstream_rq_dropped_.value());
+}
+
 TEST_F(ClusterInfoImplTest, UseDownstreamHttpProtocolWithDowngrade) {
   const std::string yaml = R"EOF(
   name: name
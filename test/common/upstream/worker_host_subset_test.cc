@@ -0,0 +1,130 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "source/common/upstream/upstream_impl.h"
+#include "source/common/upstream/worker_host_subset.h"
+
+#include "test/common/upstream/utility.h"
+#include "test/mocks/upstream/cluster_info.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::NiceMock;
+using testing::UnorderedElementsAreArray;
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+class WorkerHostSubsetTest : public testing::Test {
+public:
+  HostVector makeHosts(uint32_t count) {
+    HostVector hosts;
+    for (uint32_t i = 0; i < count; ++i) {
+      hosts.push_back(makeTestHost(info_, fmt::format("tcp://10.0.{}.{}:80", i / 256, i % 256)));
+    }
+    return hosts;
+  }
+
+  std::shared_ptr<MockClusterInfo> info_{new NiceMock<MockClusterInfo>()};
+};
+
+// Every host is used by exactly `threads_per_host` threads, and the threads share the hosts evenly.
+TEST_F(WorkerHostSubsetTest, EachHostUsedByThreadsPerHost) {
+  constexpr uint32_t thread_count = 8;
+  constexpr uint32_t threads_per_host = 3;
+  const HostVector hosts = makeHosts(800);
+
+  std::vector<WorkerHostSubset> subsets;
+  for (uint32_t thread_index = 0; thread_index < thread_count; ++thread_index) {
+    subsets.emplace_back(thread_index, thread_count, threads_per_host);
+  }
+  std::vector<uint32_t> hosts_per_thread(thread_count);
+  for (const HostSharedPtr& host : hosts) {
+    uint32_t threads = 0;
+    for (uint32_t thread_index = 0; thread_index < thread_count; ++thread_index) {
+      if (subsets[thread_index].contains(*host)) {
+        ++threads;
+        ++hosts_per_thread[thread_index];
+      }
+    }
+    EXPECT_EQ(threads_per_host, threads);
+  }
+  // Each thread expects 300 of the hosts.
+  for (const uint32_t count : hosts_per_thread) {
+    EXPECT_GT(count, 200);
+    EXPECT_LT(count, 400);
+  }
+}
+
+TEST_F(WorkerHostSubsetTest, Filter) {
+  const HostVector hosts = makeHosts(16);
+  const WorkerHostSubset subset(1, 4, 1);
+  HostVector expected;
+  for (const HostSharedPtr& host : hosts) {
+    if (subset.contains(*host)) {
+      expected.push_back(host);
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+
+  HostsPerLocalityConstSharedPtr hosts_per_locality = makeHostsPerLocality(
+      {HostVector(hosts.begin(), hosts.begin() + 8), HostVector(hosts.begin() + 8, hosts.end())});
+  const PrioritySet::UpdateHostsParams params =
+      HostSetImpl::partitionHosts(std::make_shared<const HostVector>(hosts), hosts_per_locality);
+  const PrioritySet::UpdateHostsParams filtered = subset.filter(params);
+
+  EXPECT_THAT(*filtered.hosts, UnorderedElementsAreArray(expected));
+  EXPECT_THAT(filtered.healthy_hosts->get(), UnorderedElementsAreArray(expected));
+  EXPECT_TRUE(filtered.degraded_hosts->get().empty());
+  EXPECT_TRUE(filtered.excluded_hosts->get().empty());
+  // The localities still line up with the locality weights.
+  ASSERT_EQ(2, filtered.hosts_per_locality->get().size());
+  EXPECT_TRUE(filtered.hosts_per_locality->hasLocalLocality());
+  HostVector filtered_per_locality;
+  for (const HostVector& locality_hosts : filtered.hosts_per_locality->get()) {
+    for (const HostSharedPtr& host : locality_hosts) {
+      EXPECT_TRUE(subset.contains(*host));
+      filtered_per_locality.push_back(host);
+    }
+  }
+  EXPECT_THAT(filtered_per_locality, UnorderedElementsAreArray(expected));
+  EXPECT_EQ(2, filtered.healthy_hosts_per_locality->get().size());
+}
+
+// A thread without any host of the update in its subset uses all the hosts.
+TEST_F(WorkerHostSubsetTest, FilterFallsBackToAllHosts) {
+  const HostVector hosts = makeHosts(64);
+  const WorkerHostSubset subset(0, 4, 1);
+  HostVector outside;
+  for (const HostSharedPtr& host : hosts) {
+    if (!subset.contains(*host)) {
+      outside.push_back(host);
+    }
+  }
+  outside.resize(1);
+
+  const PrioritySet::UpdateHostsParams params = HostSetImpl::partitionHosts(
+      std::make_shared<const HostVector>(outside), HostsPerLocalityImpl::empty());
+  const PrioritySet::UpdateHostsParams filtered = subset.filter(params);
+  EXPECT_EQ(params.hosts, filtered.hosts);
+  EXPECT_EQ(params.healthy_hosts, filtered.healthy_hosts);
+  EXPECT_EQ(params.hosts_per_locality, filtered.hosts_per_locality);
+}
+
+TEST_F(WorkerHostSubsetTest, Diff) {
+  const HostVector hosts = makeHosts(4);
+  HostVector hosts_added;
+  HostVector hosts_removed;
+  WorkerHostSubset::diff({hosts[0], hosts[1], hosts[2]}, {hosts[3], hosts[1]}, hosts_added,
+                         hosts_removed);
+  EXPECT_THAT(hosts_added, ElementsAre(hosts[3]));
+  EXPECT_THAT(hosts_removed, ElementsAre(hosts[0], hosts[2]));
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -119,7 +119,7 @@ TEST_F(XdstpOdCdsApiImplTest, SuccessfulClusterAddition) {
                                                                               cluster_name));
 
   const std::string version = "v1";
-  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false));
+  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false, _));
 
   Config::DecodedResourceImpl decoded_resource(
       std::make_unique<envoy::config::cluster::v3::Cluster>(cluster), "fake_cluster", {}, version);
@@ -149,7 +149,7 @@ TEST_F(XdstpOdCdsApiImplTest, ClusterRemoval) {
                                                                               cluster_name));
 
   const std::string version = "v1";
-  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false));
+  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false, _));
 
   Config::DecodedResourceImpl decoded_resource(
       std::make_unique<envoy::config::cluster::v3::Cluster>(cluster), "fake_cluster", {}, version);
@@ -174,7 +174,7 @@ TEST_F(XdstpOdCdsApiImplTest, SubscriptionFailure) {
 
   ASSERT_NE(odcds_callbacks_, nullptr);
 
-  EXPECT_CALL(cm_, addOrUpdateCluster(_, _, _)).Times(0);
+  EXPECT_CALL(cm_, addOrUpdateCluster(_, _, _, _)).Times(0);
   EXPECT_CALL(notifier_, notifyMissingCluster(cluster_name));
 
   EnvoyException e("rejecting update");
@@ -192,7 +192,7 @@ TEST_F(XdstpOdCdsApiImplTest, SubscriptionFailureNullException) {
 
   ASSERT_NE(odcds_callbacks_, nullptr);
 
-  EXPECT_CALL(cm_, addOrUpdateCluster(_, _, _)).Times(0);
+  EXPECT_CALL(cm_, addOrUpdateCluster(_, _, _, _)).Times(0);
   EXPECT_CALL(notifier_, notifyMissingCluster(cluster_name));
 
   odcds_callbacks_->onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason::UpdateRejected,
@@ -219,7 +219,7 @@ TEST_F(XdstpOdCdsApiImplTest, ClusterUpdate) {
                                                                               cluster_name));
 
   const std::string version = "v1";
-  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false));
+  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false, _));
 
   Config::DecodedResourceImpl decoded_resource(
       std::make_unique<envoy::config::cluster::v3::Cluster>(cluster), "fake_cluster", {}, version);
@@ -238,7 +238,7 @@ TEST_F(XdstpOdCdsApiImplTest, ClusterUpdate) {
   )EOF",
                                                                               cluster_name));
   const std::string version2 = "v2";
-  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(updated_cluster), version2, false));
+  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(updated_cluster), version2, false, _));
 
   Config::DecodedResourceImpl decoded_resource2(
       std::make_unique<envoy::config::cluster::v3::Cluster>(updated_cluster), "fake_cluster", {},
@@ -293,7 +293,7 @@ TEST_F(XdstpOdCdsApiImplTest, MultipleSubscriptions) {
   )EOF",
                                                                               cluster_name1));
   const std::string version = "v1";
-  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false));
+  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false, _));
   Config::DecodedResourceImpl decoded_resource(
       std::make_unique<envoy::config::cluster::v3::Cluster>(cluster), cluster_name1, {}, version);
   std::vector<Config::DecodedResourceRef> resources;
@@ -301,7 +301,7 @@ TEST_F(XdstpOdCdsApiImplTest, MultipleSubscriptions) {
   EXPECT_TRUE(callbacks1->onConfigUpdate(resources, version).ok());
 
   // Verify that the failed subscription works as expected.
-  EXPECT_CALL(cm_, addOrUpdateCluster(_, _, _)).Times(0);
+  EXPECT_CALL(cm_, addOrUpdateCluster(_, _, _, _)).Times(0);
   EXPECT_CALL(notifier_, notifyMissingCluster(cluster_name2));
   EnvoyException e("rejecting update");
   callbacks2->onConfigUpdateFailed(Envoy::Config::ConfigUpdateFailureReason::UpdateRejected, &e);
@@ -327,7 +327,7 @@ TEST_F(XdstpOdCdsApiImplTest, ClusterRemovalViaDeltaUpdate) {
   )EOF",
                                                                               cluster_name));
   const std::string version = "v1";
-  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false));
+  EXPECT_CALL(cm_, addOrUpdateCluster(ProtoEq(cluster), version, false, _));
   Config::DecodedResourceImpl decoded_resource(
       std::make_unique<envoy::config::cluster::v3::Cluster>(cluster), cluster_name, {}, version);
   std::vector<Config::DecodedResourceRef> resources;
@@ -0,0 +1,288 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "envoy/config/accesslog/v3/accesslog.pb.h"
+#include "envoy/extensions/access_loggers/file/v3/file.pb.h"
+
+#include "source/common/access_log/access_log_impl.h"
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/access_loggers/file/binary_access_log_impl.h"
+#include "source/extensions/access_loggers/file/config.h"
+#include "source/extensions/compression/zstd/decompressor/zstd_decompressor_impl.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace AccessLoggers {
+namespace File {
+namespace {
+
+// Decodes blocks of the binary encoding.
+class BlockDecoder {
+public:
+  explicit BlockDecoder(absl::string_view data) : data_(data) {}
+
+  bool done() const { return data_.empty(); }
+  uint64_t readVarint() { return readVarint(data_); }
+  std::string readBytes(size_t length) { return readBytes(data_, length); }
+  std::string readLengthPrefixed() { return readBytes(readVarint()); }
+
+  static uint64_t readVarint(absl::string_view& data) {
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+      EXPECT_FALSE(data.empty());
+      const uint8_t byte = data[0];
+      data.remove_prefix(1);
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+  }
+
+  static std::string readBytes(absl::string_view& data, size_t length) {
+    EXPECT_LE(length, data.size());
+    std::string bytes(data.substr(0, length));
+    data.remove_prefix(length);
+    return bytes;
+  }
+
+private:
+  absl::string_view data_;
+};
+
+class BinaryAccessLogTest : public testing::Test {
+public:
+  void createLogger(const std::string& yaml) {
+    envoy::extensions::access_loggers::file::v3::FileAccessLog fal_config;
+    TestUtility::loadFromYaml(yaml, fal_config);
+    envoy::config::accesslog::v3::AccessLog config;
+    config.mutable_typed_config()->PackFrom(fal_config);
+
+    EXPECT_CALL(context_.server_factory_context_.access_log_manager_, createAccessLog(_))
+        .WillOnce(Return(file_));
+    ON_CALL(*file_, write(_)).WillByDefault(Invoke([this](absl::string_view data) {
+      written_.emplace_back(data);
+    }));
+    logger_ = AccessLog::AccessLogFactory::fromProto(config, context_);
+  }
+
+  void log() { logger_->log({&request_headers_}, stream_info_); }
+
+  // Decodes the columns of a block written as the schema of the tests.
+  struct Block {
+    std::string content_encoding_;
+    uint64_t entries_;
+    std::string payload_;
+  };
+  static Block decodeBlock(const std::string& data) {
+    BlockDecoder decoder(data);
+    EXPECT_EQ("EALB", decoder.readBytes(4));
+    const std::vector<std::pair<std::string, uint8_t>> expected_schema = {
+        {"method", 0}, {"code", 1}, {"absent", 0}, {"line", 0}, {"ratio", 1}, {"missing", 1}};
+    EXPECT_EQ(expected_schema.size(), decoder.readVarint());
+    for (const auto& [name, type] : expected_schema) {
+      EXPECT_EQ(name, decoder.readLengthPrefixed());
+      EXPECT_EQ(std::string(1, type), decoder.readBytes(1));
+    }
+    Block block;
+    block.content_encoding_ = decoder.readLengthPrefixed();
+    block.entries_ = decoder.readVarint();
+    block.payload_ = decoder.readLengthPrefixed();
+    EXPECT_TRUE(decoder.done());
+    return block;
+  }
+
+  // Verifies the payload of a block of entries logged by log().
+  static void verifyPayload(const std::string& payload, uint64_t entries) {
+    BlockDecoder decoder(payload);
+    std::string method = decoder.readLengthPrefixed();
+    std::string code = decoder.readLengthPrefixed();
+    std::string absent = decoder.readLengthPrefixed();
+    std::string line = decoder.readLengthPrefixed();
+    std::string ratio = decoder.readLengthPrefixed();
+    std::string missing = decoder.readLengthPrefixed();
+    EXPECT_TRUE(decoder.done());
+
+    const uint64_t negative_double_bits = [] {
+      const double value = -1.5;
+      uint64_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }();
+    std::string ratio_value = "\x02";
+    for (int i = 0; i < 8; ++i) {
+      ratio_value.push_back(static_cast<char>(negative_double_bits >> (8 * i)));
+    }
+
+    for (uint64_t i = 0; i < entries; ++i) {
+      absl::string_view view = method;
+      EXPECT_EQ("GET", BlockDecoder::readBytes(view, BlockDecoder::readVarint(view) - 1));
+      method = std::string(view);
+
+      // 200 is zigzag encoded as 400.
+      EXPECT_EQ("\x01\x90\x03", code.substr(0, 3));
+      code = code.substr(3);
+
+      EXPECT_EQ(std::string(1, '\0'), absent.substr(0, 1));
+      absent = absent.substr(1);
+
+      view = line;
+      EXPECT_EQ("GET -", BlockDecoder::readBytes(view, BlockDecoder::readVarint(view) - 1));
+      line = std::string(view);
+
+      EXPECT_EQ(ratio_value, ratio.substr(0, 9));
+      ratio = ratio.substr(9);
+
+      EXPECT_EQ(std::string(1, '\0'), missing.substr(0, 1));
+      missing = missing.substr(1);
+    }
+    EXPECT_TRUE(method.empty() && code.empty() && absent.empty() && line.empty() &&
+                ratio.empty() && missing.empty());
+  }
+
+  static constexpr absl::string_view Columns = R"EOF(
+    columns:
+    - name: method
+      format: "%REQ(:METHOD)%"
+    - name: code
+      format: "%RESPONSE_CODE%"
+      type: NUMBER
+    - name: absent
+      format: "%REQ(X-ABSENT)%"
+    - name: line
+      format: "%REQ(:METHOD)% %REQ(X-ABSENT)%"
+    - name: ratio
+      format: "%REQ(X-RATIO)%"
+      type: NUMBER
+    - name: missing
+      format: "%REQ(X-ABSENT)%"
+      type: NUMBER
+  )EOF";
+
+  Http::TestRequestHeaderMapImpl request_headers_{{":method", "GET"}, {"x-ratio", "-1.5"}};
+  NiceMock<StreamInfo::MockStreamInfo> stream_info_;
+  NiceMock<Server::Configuration::MockFactoryContext> context_;
+  std::shared_ptr<NiceMock<AccessLog::MockAccessLogFile>> file_{
+      std::make_shared<NiceMock<AccessLog::MockAccessLogFile>>()};
+  std::vector<std::string> written_;
+  AccessLog::InstanceSharedPtr logger_;
+};
+
+// Blocks are written as soon as they reach their maximum size.
+TEST_F(BinaryAccessLogTest, WriteFullBlocks) {
+  stream_info_.setResponseCode(200);
+  createLogger(absl::StrCat(R"EOF(
+  path: "/foo"
+  binary_format:
+    max_block_size_bytes: 1
+  )EOF",
+                            Columns));
+
+  log();
+  log();
+  ASSERT_EQ(2, written_.size());
+  for (const std::string& data : written_) {
+    const Block block = decodeBlock(data);
+    EXPECT_EQ("", block.content_encoding_);
+    EXPECT_EQ(1, block.entries_);
+    verifyPayload(block.payload_, 1);
+  }
+}
+
+// Blocks are written when they have been held for the maximum delay, or when the logger is
+// destroyed.
+TEST_F(BinaryAccessLogTest, WriteDelayedBlocks) {
+  stream_info_.setResponseCode(200);
+  auto* timer =
+      new NiceMock<Event::MockTimer>(&context_.server_factory_context_.thread_local_.dispatcher_);
+  createLogger(absl::StrCat(R"EOF(
+  path: "/foo"
+  binary_format:
+    max_block_delay: 2s
+  )EOF",
+                            Columns));
+
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(2000), _));
+  log();
+  log();
+  EXPECT_TRUE(written_.empty());
+  timer->invokeCallback();
+  ASSERT_EQ(1, written_.size());
+  const Block block = decodeBlock(written_[0]);
+  EXPECT_EQ(2, block.entries_);
+  verifyPayload(block.payload_, 2);
+
+  EXPECT_CALL(*timer, enableTimer(std::chrono::milliseconds(2000), _));
+  log();
+  logger_.reset();
+  ASSERT_EQ(2, written_.size());
+  verifyPayload(decodeBlock(written_[1]).payload_, 1);
+}
+
+TEST_F(BinaryAccessLogTest, CompressedBlocks) {
+  stream_info_.setResponseCode(200);
+  createLogger(absl::StrCat(R"EOF(
+  path: "/foo"
+  binary_format:
+    max_block_size_bytes: 1
+    compressor_library:
+      name: zstd
+      typed_config:
+        "@type": type.googleapis.com/envoy.extensions.compression.zstd.compressor.v3.Zstd
+  )EOF",
+                            Columns));
+
+  log();
+  ASSERT_EQ(1, written_.size());
+  const Block block = decodeBlock(written_[0]);
+  EXPECT_EQ("zstd", block.content_encoding_);
+  EXPECT_EQ(1, block.entries_);
+
+  Stats::IsolatedStoreImpl stats_store;
+  Compression::Zstd::Decompressor::ZstdDDictManagerPtr ddict_manager;
+  Compression::Zstd::Decompressor::ZstdDecompressorImpl decompressor{*stats_store.rootScope(),
+                                                                     "test.", ddict_manager, 4096};
+  Buffer::OwnedImpl compressed(block.payload_);
+  Buffer::OwnedImpl decompressed;
+  decompressor.decompress(compressed, decompressed);
+  verifyPayload(decompressed.toString(), 1);
+}
+
+TEST_F(BinaryAccessLogTest, NumberColumnMustBeSingleOperator) {
+  envoy::extensions::access_loggers::file::v3::FileAccessLog fal_config;
+  TestUtility::loadFromYaml(R"EOF(
+  path: "/foo"
+  binary_format:
+    columns:
+    - name: code
+      format: "code %RESPONSE_CODE%"
+      type: NUMBER
+  )EOF",
+                            fal_config);
+  envoy::config::accesslog::v3::AccessLog config;
+  config.mutable_typed_config()->PackFrom(fal_config);
+
+  EXPECT_THROW_WITH_MESSAGE(
+      AccessLog::AccessLogFactory::fromProto(config, context_), EnvoyException,
+      "the format 'code %RESPONSE_CODE%' of the number column 'code' is not a single command "
+      "operator");
+}
+
+} // namespace
+} // namespace File
+} // namespace AccessLoggers
+} // namespace Extensions
+} // namespace Envoy
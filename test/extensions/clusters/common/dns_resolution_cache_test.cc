@@ -0,0 +1,290 @@
+#include <chrono>
+#include <list>
+#include <memory>
+#include <string>
+
+#include "source/extensions/clusters/common/dns_resolution_cache.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/server_factory_context.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::DoAll;
+using testing::Eq;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+class DnsResolutionCacheTest : public testing::Test, public Event::TestUsingSimulatedTime {
+public:
+  void createCache(KeyValueStorePtr key_value_store = nullptr,
+                   uint32_t max_entries = DnsResolutionCache::DefaultMaxEntries) {
+    cache_ = std::make_unique<DnsResolutionCache>(dispatcher_, std::move(key_value_store),
+                                                  max_entries);
+  }
+
+  // Resolves a name, example.com by default, recording the result of the resolution in `result`.
+  struct Result {
+    bool done_{};
+    Network::DnsResolver::ResolutionStatus status_;
+    std::list<Network::DnsResponse> responses_;
+  };
+  Network::ActiveDnsQuery* resolve(Result& result, const std::string& dns_name = "example.com") {
+    return cache_->resolve(
+        resolver_, dns_name, Network::DnsLookupFamily::Auto,
+        [&result](Network::DnsResolver::ResolutionStatus status, absl::string_view,
+                  std::list<Network::DnsResponse>&& response) {
+          result.done_ = true;
+          result.status_ = status;
+          result.responses_ = std::move(response);
+        });
+  }
+
+  void expectQuery(const std::string& dns_name = "example.com") {
+    EXPECT_CALL(*resolver_, resolve(dns_name, Network::DnsLookupFamily::Auto, _))
+        .WillOnce(DoAll(SaveArg<2>(&resolve_cb_), Return(&resolver_->active_query_)));
+  }
+
+  // Expects a query of the name that completes inline.
+  void expectInlineQuery(const std::string& dns_name) {
+    EXPECT_CALL(*resolver_, resolve(dns_name, Network::DnsLookupFamily::Auto, _))
+        .WillOnce([](const std::string&, Network::DnsLookupFamily,
+                     Network::DnsResolver::ResolveCb callback) -> Network::ActiveDnsQuery* {
+          callback(Network::DnsResolver::ResolutionStatus::Completed, "",
+                   TestUtility::makeDnsResponse({"10.0.0.1"}, std::chrono::seconds(30)));
+          return nullptr;
+        });
+  }
+
+  static void expectResponse(const Result& result, const std::string& address,
+                             std::chrono::seconds ttl) {
+    EXPECT_TRUE(result.done_);
+    ASSERT_EQ(1, result.responses_.size());
+    EXPECT_EQ(address, result.responses_.front().addrInfo().address_->ip()->addressAsString());
+    EXPECT_EQ(ttl, result.responses_.front().addrInfo().ttl_);
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  std::shared_ptr<Network::MockDnsResolver> resolver_{
+      std::make_shared<Network::MockDnsResolver>()};
+  Network::DnsResolver::ResolveCb resolve_cb_;
+  std::unique_ptr<DnsResolutionCache> cache_;
+};
+
+// Concurrent resolutions share a query, and later resolutions are served from the cache until the
+// TTL expires.
+TEST_F(DnsResolutionCacheTest, CoalesceAndCacheUntilTtl) {
+  createCache();
+  expectQuery();
+  Result first;
+  Result second;
+  EXPECT_NE(nullptr, resolve(first));
+  EXPECT_NE(nullptr, resolve(second));
+  EXPECT_FALSE(first.done_);
+
+  resolve_cb_(Network::DnsResolver::ResolutionStatus::Completed, "",
+              TestUtility::makeDnsResponse({"10.0.0.1"}, std::chrono::seconds(30)));
+  expectResponse(first, "10.0.0.1", std::chrono::seconds(30));
+  expectResponse(second, "10.0.0.1", std::chrono::seconds(30));
+
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+  Result cached;
+  EXPECT_EQ(nullptr, resolve(cached));
+  expectResponse(cached, "10.0.0.1", std::chrono::seconds(20));
+
+  simTime().advanceTimeWait(std::chrono::seconds(20));
+  expectQuery();
+  Result expired;
+  EXPECT_NE(nullptr, resolve(expired));
+  EXPECT_FALSE(expired.done_);
+}
+
+TEST_F(DnsResolutionCacheTest, CancelPendingResolution) {
+  createCache();
+  expectQuery();
+  Result first;
+  Result second;
+  resolve(first)->cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+  EXPECT_NE(nullptr, resolve(second));
+
+  resolve_cb_(Network::DnsResolver::ResolutionStatus::Completed, "",
+              TestUtility::makeDnsResponse({"10.0.0.1"}, std::chrono::seconds(30)));
+  EXPECT_FALSE(first.done_);
+  expectResponse(second, "10.0.0.1", std::chrono::seconds(30));
+}
+
+TEST_F(DnsResolutionCacheTest, FailureNotCached) {
+  createCache();
+  expectQuery();
+  Result failed;
+  resolve(failed);
+  resolve_cb_(Network::DnsResolver::ResolutionStatus::Failure, "", {});
+  EXPECT_TRUE(failed.done_);
+  EXPECT_EQ(Network::DnsResolver::ResolutionStatus::Failure, failed.status_);
+
+  expectQuery();
+  Result retried;
+  EXPECT_NE(nullptr, resolve(retried));
+}
+
+TEST_F(DnsResolutionCacheTest, QueryCompletesInline) {
+  createCache();
+  EXPECT_CALL(*resolver_, resolve("example.com", Network::DnsLookupFamily::Auto, _))
+      .WillOnce([](const std::string&, Network::DnsLookupFamily,
+                   Network::DnsResolver::ResolveCb callback) -> Network::ActiveDnsQuery* {
+        callback(Network::DnsResolver::ResolutionStatus::Completed, "",
+                 TestUtility::makeDnsResponse({"10.0.0.1"}, std::chrono::seconds(30)));
+        return nullptr;
+      });
+  Result result;
+  EXPECT_EQ(nullptr, resolve(result));
+  expectResponse(result, "10.0.0.1", std::chrono::seconds(30));
+}
+
+TEST_F(DnsResolutionCacheTest, DestructionCancelsQuery) {
+  createCache();
+  expectQuery();
+  Result result;
+  resolve(result)->cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned);
+  EXPECT_CALL(resolver_->active_query_,
+              cancel(Network::ActiveDnsQuery::CancelReason::QueryAbandoned));
+  cache_.reset();
+}
+
+// Persisted resolutions are served without a TTL until the name is resolved again.
+TEST_F(DnsResolutionCacheTest, PersistedResolutions) {
+  auto key_value_store = std::make_unique<NiceMock<MockKeyValueStore>>();
+  MockKeyValueStore* store = key_value_store.get();
+  EXPECT_CALL(*store, iterate(_)).WillOnce([](KeyValueStore::ConstIterateCb callback) {
+    callback("2|example.com", "10.0.0.1:0|30");
+    callback("not a key", "10.0.0.1:0|30");
+    callback("0|bad.example.com", "not an address|30");
+  });
+  createCache(std::move(key_value_store));
+
+  expectQuery();
+  Result persisted;
+  EXPECT_EQ(nullptr, resolve(persisted));
+  expectResponse(persisted, "10.0.0.1", std::chrono::seconds(0));
+  // The refresh is in flight.
+  Result also_persisted;
+  EXPECT_EQ(nullptr, resolve(also_persisted));
+  expectResponse(also_persisted, "10.0.0.1", std::chrono::seconds(0));
+
+  EXPECT_CALL(*store, addOrUpdate(Eq("2|example.com"), Eq("10.0.0.2:0|60"), Eq(absl::nullopt)));
+  resolve_cb_(Network::DnsResolver::ResolutionStatus::Completed, "",
+              TestUtility::makeDnsResponse({"10.0.0.2"}, std::chrono::seconds(60)));
+  Result refreshed;
+  EXPECT_EQ(nullptr, resolve(refreshed));
+  expectResponse(refreshed, "10.0.0.2", std::chrono::seconds(60));
+}
+
+// A full cache evicts the least recently resolved name, also from the key value store.
+TEST_F(DnsResolutionCacheTest, EvictLeastRecentlyUsed) {
+  auto key_value_store = std::make_unique<NiceMock<MockKeyValueStore>>();
+  MockKeyValueStore* store = key_value_store.get();
+  createCache(std::move(key_value_store), 2);
+
+  Result result;
+  expectInlineQuery("a.example.com");
+  resolve(result, "a.example.com");
+  expectInlineQuery("b.example.com");
+  resolve(result, "b.example.com");
+  // Served from the cache, which makes a.example.com the most recently used name.
+  EXPECT_EQ(nullptr, resolve(result, "a.example.com"));
+
+  EXPECT_CALL(*store, remove(Eq("2|b.example.com")));
+  expectInlineQuery("c.example.com");
+  resolve(result, "c.example.com");
+  EXPECT_EQ(nullptr, resolve(result, "a.example.com"));
+
+  EXPECT_CALL(*store, remove(Eq("2|c.example.com")));
+  expectInlineQuery("b.example.com");
+  resolve(result, "b.example.com");
+  expectResponse(result, "10.0.0.1", std::chrono::seconds(30));
+}
+
+// Names with a query in flight are not evicted, so the cache may go over its maximum meanwhile.
+TEST_F(DnsResolutionCacheTest, QueryingEntriesNotEvicted) {
+  createCache(nullptr, 1);
+
+  expectQuery();
+  Result pending;
+  EXPECT_NE(nullptr, resolve(pending));
+  Result result;
+  expectInlineQuery("a.example.com");
+  resolve(result, "a.example.com");
+
+  resolve_cb_(Network::DnsResolver::ResolutionStatus::Completed, "",
+              TestUtility::makeDnsResponse({"10.0.0.2"}, std::chrono::seconds(30)));
+  expectResponse(pending, "10.0.0.2", std::chrono::seconds(30));
+
+  // Both names are still cached, until another name is added.
+  EXPECT_EQ(nullptr, resolve(result));
+  EXPECT_EQ(nullptr, resolve(result, "a.example.com"));
+  expectInlineQuery("b.example.com");
+  resolve(result, "b.example.com");
+  expectQuery();
+  EXPECT_NE(nullptr, resolve(result));
+}
+
+// Persisted resolutions beyond the maximum of the cache are removed from the key value store.
+TEST_F(DnsResolutionCacheTest, LoadAtMostMaxEntries) {
+  auto key_value_store = std::make_unique<NiceMock<MockKeyValueStore>>();
+  MockKeyValueStore* store = key_value_store.get();
+  EXPECT_CALL(*store, iterate(_)).WillOnce([](KeyValueStore::ConstIterateCb callback) {
+    callback("2|example.com", "10.0.0.1:0|30");
+    callback("2|a.example.com", "10.0.0.2:0|30");
+  });
+  EXPECT_CALL(*store, remove(Eq("2|a.example.com")));
+  createCache(std::move(key_value_store), 1);
+
+  expectQuery();
+  Result persisted;
+  EXPECT_EQ(nullptr, resolve(persisted));
+  expectResponse(persisted, "10.0.0.1", std::chrono::seconds(0));
+}
+
+// Clusters share a cache only if they configure it the same way and resolve with the same
+// resolver.
+TEST(DnsResolutionCacheManagerTest, SharedCachesRequireTheSameResolver) {
+  NiceMock<Server::Configuration::MockServerFactoryContext> context;
+  DnsResolutionCacheManager manager(context);
+
+  envoy::extensions::clusters::dns::v3::DnsCluster::ResolutionCache config;
+  config.set_name("cache");
+  envoy::config::core::v3::TypedExtensionConfig default_resolver;
+  envoy::config::core::v3::TypedExtensionConfig cares_resolver;
+  cares_resolver.set_name("envoy.network.dns_resolver.cares");
+
+  auto cache = manager.getCache(config, default_resolver);
+  ASSERT_TRUE(cache.ok());
+  auto same_cache = manager.getCache(config, default_resolver);
+  ASSERT_TRUE(same_cache.ok());
+  EXPECT_EQ(*cache, *same_cache);
+
+  EXPECT_EQ(manager.getCache(config, cares_resolver).status().message(),
+            "config specified DNS resolution cache 'cache' for clusters with different DNS "
+            "resolvers");
+
+  envoy::extensions::clusters::dns::v3::DnsCluster::ResolutionCache other_config;
+  other_config.set_name("other_cache");
+  auto other_cache = manager.getCache(other_config, cares_resolver);
+  ASSERT_TRUE(other_cache.ok());
+  EXPECT_NE(*cache, *other_cache);
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
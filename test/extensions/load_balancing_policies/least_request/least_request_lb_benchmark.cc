@@ -7,11 +7,18 @@ namespace Envoy {
 namespace Upstream {
 namespace {
 
+using LeastRequestProto =
+    envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest;
+
 class LeastRequestTester : public BaseTester {
 public:
-  LeastRequestTester(uint64_t num_hosts, uint32_t choice_count) : BaseTester(num_hosts) {
-    envoy::extensions::load_balancing_policies::least_request::v3::LeastRequest lr_lb_config;
+  LeastRequestTester(uint64_t num_hosts, uint32_t choice_count,
+                     LeastRequestProto::SelectionMethod selection_method =
+                         LeastRequestProto::N_CHOICES)
+      : BaseTester(num_hosts) {
+    LeastRequestProto lr_lb_config;
     lr_lb_config.mutable_choice_count()->set_value(choice_count);
+    lr_lb_config.set_selection_method(selection_method);
     lb_ =
         std::make_unique<LeastRequestLoadBalancer>(priority_set_, &local_priority_set_, stats_,
                                                    runtime_, random_, 50, lr_lb_config, simTime());
@@ -62,6 +69,33 @@ BENCHMARK(benchmarkLeastRequestLoadBalancerChooseHost)
     ->Args({100, 100, 1000000})
     ->Unit(::benchmark::kMillisecond);
 
+// Picks from a large cluster with many choices, or with a scan of all hosts.
+void benchmarkLeastRequestLoadBalancerPickLargeCluster(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t choice_count = state.range(1);
+
+  // A choice count of 0 selects the full scan.
+  LeastRequestTester tester(num_hosts, std::max<uint64_t>(choice_count, 2),
+                            choice_count == 0 ? LeastRequestProto::FULL_SCAN
+                                              : LeastRequestProto::N_CHOICES);
+  TestLoadBalancerContext context;
+  uint64_t i = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    // Keep the active requests changing, as they would with real traffic.
+    HostConstSharedPtr host = tester.lb_->chooseHost(&context).host;
+    if (++i % 2 == 0) {
+      host->stats().rq_active_.set(i % 7);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(benchmarkLeastRequestLoadBalancerPickLargeCluster)
+    ->Args({2000, 2})
+    ->Args({2000, 10})
+    ->Args({2000, 100})
+    ->Args({2000, 0});
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -9,9 +9,11 @@ namespace {
 
 class MaglevTester : public BaseTester {
 public:
-  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0)
+  MaglevTester(uint64_t num_hosts, uint32_t weighted_subset_percent = 0, uint32_t weight = 0,
+               uint64_t table_size = MaglevTable::DefaultTableSize)
       : BaseTester(num_hosts, weighted_subset_percent, weight) {
     envoy::extensions::load_balancing_policies::maglev::v3::Maglev config;
+    config.mutable_table_size()->set_value(table_size);
     maglev_lb_ = std::make_unique<MaglevLoadBalancer>(priority_set_, stats_, stats_scope_, runtime_,
                                                       random_, 50, config, hash_policy_);
   }
@@ -53,6 +55,42 @@ BENCHMARK(benchmarkMaglevLoadBalancerChooseHost)
     ->Args({500, 100000})
     ->Unit(::benchmark::kMillisecond);
 
+void benchmarkMaglevLoadBalancerPick(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t table_size = state.range(1);
+
+  if (benchmark::skipExpensiveBenchmarks() && table_size > 65537) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  MaglevTester tester(num_hosts, 0, 0, table_size);
+  const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+  ASSERT_TRUE(tester.maglev_lb_->initialize().ok());
+  const size_t end_mem = Memory::Stats::totalCurrentlyAllocated();
+  LoadBalancerPtr lb = tester.maglev_lb_->factory()->create(tester.lb_params_);
+  TestLoadBalancerContext context;
+
+  // Random hashes, so that large tables do not fit in the caches.
+  uint64_t i = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.hash_policy_->hash_key_ = hashInt(i++);
+    ::benchmark::DoNotOptimize(lb->chooseHost(&context).host);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["memory"] = end_mem - start_mem;
+  state.counters["memory_per_entry"] = static_cast<double>(end_mem - start_mem) / table_size;
+}
+// The table size must be prime.
+BENCHMARK(benchmarkMaglevLoadBalancerPick)
+    ->Args({1000, 1031})
+    ->Args({1000, 8209})
+    ->Args({1000, 65537})
+    ->Args({1000, 524309})
+    ->Args({1000, 4194319})
+    ->Args({100000, 5000011});
+
 void benchmarkMaglevLoadBalancerBuildTable(::benchmark::State& state) {
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     state.PauseTiming();
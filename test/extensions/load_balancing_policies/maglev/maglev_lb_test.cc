@@ -393,6 +393,44 @@ TEST_F(MaglevLoadBalancerTest, BasicWithMetadataHashKey) {
   }
 }
 
+// The table is reused while the hosts do not change, and rebuilt when the hash key of a host
+// changes with its metadata.
+TEST_F(MaglevLoadBalancerTest, RebuildOnHashKeyChange) {
+  host_set_.hosts_ = {makeTestHostWithHashKey(info_, "90", "tcp://127.0.0.1:90"),
+                      makeTestHostWithHashKey(info_, "91", "tcp://127.0.0.1:91"),
+                      makeTestHostWithHashKey(info_, "92", "tcp://127.0.0.1:92"),
+                      makeTestHostWithHashKey(info_, "93", "tcp://127.0.0.1:93"),
+                      makeTestHostWithHashKey(info_, "94", "tcp://127.0.0.1:94"),
+                      makeTestHostWithHashKey(info_, "95", "tcp://127.0.0.1:95")};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  host_set_.runCallbacks({}, {});
+  init(7);
+
+  const auto check_assignments = [this](const std::vector<uint32_t>& expected_assignments) {
+    LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+    for (uint32_t i = 0; i < expected_assignments.size(); ++i) {
+      TestLoadBalancerContext context(i);
+      EXPECT_EQ(host_set_.hosts_[expected_assignments[i]], lb->chooseHost(&context).host);
+    }
+  };
+  check_assignments({2, 5, 0, 3, 4, 1, 0});
+
+  host_set_.runCallbacks({}, {});
+  check_assignments({2, 5, 0, 3, 4, 1, 0});
+
+  // Swap the hash keys of the first two hosts.
+  for (const auto& [host, hash_key] : {std::make_pair(host_set_.hosts_[0], "91"),
+                                       std::make_pair(host_set_.hosts_[1], "90")}) {
+    envoy::config::core::v3::Metadata metadata;
+    Config::Metadata::mutableMetadataValue(metadata, Config::MetadataFilters::get().ENVOY_LB,
+                                           Config::MetadataEnvoyLbKeys::get().HASH_KEY)
+        .set_string_value(hash_key);
+    host->metadata(std::make_shared<const envoy::config::core::v3::Metadata>(metadata));
+  }
+  host_set_.runCallbacks({}, {});
+  check_assignments({2, 5, 1, 3, 4, 0, 1});
+}
+
 TEST_F(MaglevLoadBalancerTest, MaglevLbWithHashPolicy) {
   host_set_.hosts_ = {makeTestHostWithHashKey(info_, "90", "tcp://127.0.0.1:90"),
                       makeTestHostWithHashKey(info_, "91", "tcp://127.0.0.1:91"),
@@ -87,6 +87,43 @@ BENCHMARK(benchmarkRingHashLoadBalancerChooseHost)
     ->Args({500, 256000, 100000})
     ->Unit(::benchmark::kMillisecond);
 
+void benchmarkRingHashLoadBalancerPick(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t min_ring_size = state.range(1);
+
+  if (benchmark::skipExpensiveBenchmarks() && min_ring_size > 65536) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  RingHashTester tester(num_hosts, min_ring_size);
+  const size_t start_mem = Memory::Stats::totalCurrentlyAllocated();
+  ASSERT_TRUE(tester.ring_hash_lb_->initialize().ok());
+  const size_t end_mem = Memory::Stats::totalCurrentlyAllocated();
+  LoadBalancerPtr lb = tester.ring_hash_lb_->factory()->create(tester.lb_params_);
+  TestLoadBalancerContext context;
+
+  // Random hashes, so that large rings do not fit in the caches.
+  uint64_t i = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.hash_policy_->hash_key_ = hashInt(i++);
+    ::benchmark::DoNotOptimize(lb->chooseHost(&context).host);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["memory"] = end_mem - start_mem;
+  state.counters["memory_per_entry"] =
+      static_cast<double>(end_mem - start_mem) / tester.ring_hash_lb_->stats().size_.value();
+}
+BENCHMARK(benchmarkRingHashLoadBalancerPick)
+    ->Args({1000, 1024})
+    ->Args({1000, 8192})
+    ->Args({1000, 65536})
+    ->Args({1000, 524288})
+    ->Args({1000, 4194304})
+    ->Args({1000, 8388608})
+    ->Args({100000, 8388608});
+
 void benchmarkRingHashLoadBalancerHostLoss(::benchmark::State& state) {
   const uint64_t num_hosts = state.range(0);
   const uint64_t min_ring_size = state.range(1);
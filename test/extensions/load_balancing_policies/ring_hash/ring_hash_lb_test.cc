@@ -1,11 +1,14 @@
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
 #include "envoy/router/router.h"
 
+#include "source/common/common/hash.h"
 #include "source/common/network/utility.h"
 #include "source/common/upstream/upstream_impl.h"
 #include "source/extensions/load_balancing_policies/ring_hash/ring_hash_lb.h"
@@ -748,6 +751,141 @@ TEST_P(RingHashLoadBalancerTest, UnevenHosts) {
   }
 }
 
+// Rings that are built from the previous ring of the priority pick the same hosts as rings that
+// are built from scratch, when hosts are added and removed and the number of hashes per host grows
+// and shrinks.
+TEST_P(RingHashLoadBalancerTest, IncrementalRebuild) {
+  HostVector hosts;
+  for (uint32_t i = 0; i < 13; ++i) {
+    hosts.push_back(makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 90 + i)));
+  }
+  hostSet().hosts_ = {hosts.begin(), hosts.begin() + 6};
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+
+  config_.mutable_minimum_ring_size()->set_value(12);
+  init();
+
+  const auto check_against_new_ring = [this]() {
+    absl::Status creation_status;
+    TypedRingHashLbConfig typed_config(config_, context_.regex_engine_, creation_status);
+    RingHashLoadBalancer new_lb(priority_set_, stats_, *stats_store_.rootScope(),
+                                context_.runtime_loader_, context_.api_.random_, 50,
+                                typed_config.lb_config_, typed_config.hash_policy_);
+    ASSERT_TRUE(new_lb.initialize().ok());
+
+    LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+    LoadBalancerPtr expected_lb = new_lb.factory()->create(lb_params_);
+    for (uint64_t hash = 0; hash < std::numeric_limits<uint64_t>::max() - (1ULL << 54);
+         hash += 1ULL << 54) {
+      TestLoadBalancerContext context(hash);
+      EXPECT_EQ(expected_lb->chooseHost(&context).host, lb->chooseHost(&context).host);
+    }
+  };
+
+  // 3 hashes per host.
+  hostSet().hosts_ = {hosts[1], hosts[3], hosts[4], hosts[6]};
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  EXPECT_EQ(3, lb_->stats().min_hashes_per_host_.value());
+  check_against_new_ring();
+
+  // 1 hash per host.
+  hostSet().hosts_ = hosts;
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  EXPECT_EQ(1, lb_->stats().max_hashes_per_host_.value());
+  check_against_new_ring();
+}
+
+// The ring entries of the hosts, in ring order, computed the way the ring computes them.
+std::vector<std::pair<uint64_t, HostConstSharedPtr>> expectedRing(const HostVector& hosts,
+                                                                  uint64_t hashes_per_host) {
+  std::vector<std::pair<uint64_t, HostConstSharedPtr>> ring;
+  for (const HostSharedPtr& host : hosts) {
+    for (uint64_t i = 0; i < hashes_per_host; ++i) {
+      ring.emplace_back(HashUtil::xxHash64(absl::StrCat(host->address()->asString(), "_", i)),
+                        host);
+    }
+  }
+  std::sort(ring.begin(), ring.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  return ring;
+}
+
+// Retries walk the ring in order from the entry of the first attempt, and wrap around it, for
+// rings of every shape of the lookup table: full, with a partial last level, and single entry.
+TEST_P(RingHashFailoverTest, RetriesWalkTheRingInOrder) {
+  for (uint32_t host_count = 1; host_count <= 33; ++host_count) {
+    SCOPED_TRACE(host_count);
+    HostVector hosts;
+    for (uint32_t i = 0; i < host_count; ++i) {
+      hosts.push_back(makeTestHost(info_, fmt::format("tcp://127.0.0.1:{}", 90 + i)));
+    }
+    hostSet().hosts_ = hosts;
+    hostSet().healthy_hosts_ = hostSet().hosts_;
+    hostSet().runCallbacks({}, {});
+    config_.mutable_minimum_ring_size()->set_value(host_count);
+    config_.mutable_maximum_ring_size()->set_value(host_count);
+    init();
+    ASSERT_EQ(lb_->stats().min_hashes_per_host_.value(),
+              lb_->stats().max_hashes_per_host_.value());
+
+    const auto ring = expectedRing(hosts, lb_->stats().min_hashes_per_host_.value());
+    ASSERT_EQ(ring.size(), lb_->stats().size_.value());
+    LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+    for (uint64_t position = 0; position < ring.size(); ++position) {
+      // Each attempt is rejected, so the host of the last attempt is returned.
+      for (uint32_t attempt = 0; attempt <= ring.size() + 1; ++attempt) {
+        TestLoadBalancerContext context(ring[position].first, attempt,
+                                        [](const Host&) { return true; });
+        EXPECT_EQ(ring[(position + attempt) % ring.size()].second, lb->chooseHost(&context).host);
+      }
+    }
+    // A hash past the last entry selects the first one.
+    if (ring.back().first < std::numeric_limits<uint64_t>::max()) {
+      TestLoadBalancerContext context(ring.back().first + 1, 1, [](const Host&) { return true; });
+      EXPECT_EQ(ring[1 % ring.size()].second, lb->chooseHost(&context).host);
+    }
+  }
+}
+
+// Rings of more than 65536 hosts index their host table with 32 bits.
+TEST_P(RingHashFailoverTest, WideHostIndices) {
+  constexpr uint32_t HostCount = 70000;
+  HostVector hosts;
+  hosts.reserve(HostCount);
+  for (uint32_t i = 0; i < HostCount; ++i) {
+    hosts.push_back(makeTestHost(
+        info_, fmt::format("tcp://10.{}.{}.{}:80", i >> 16, (i >> 8) & 0xff, i & 0xff)));
+  }
+  hostSet().hosts_ = hosts;
+  hostSet().healthy_hosts_ = hostSet().hosts_;
+  hostSet().runCallbacks({}, {});
+  config_.mutable_minimum_ring_size()->set_value(HostCount);
+  config_.mutable_maximum_ring_size()->set_value(HostCount);
+  init();
+  ASSERT_EQ(lb_->stats().min_hashes_per_host_.value(), lb_->stats().max_hashes_per_host_.value());
+
+  const auto ring = expectedRing(hosts, lb_->stats().min_hashes_per_host_.value());
+  ASSERT_EQ(ring.size(), lb_->stats().size_.value());
+  LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+  // The hash of an entry selects the entry, and retries select the entries that follow it.
+  for (uint64_t position = 0; position < ring.size(); position += 997) {
+    TestLoadBalancerContext context(ring[position].first);
+    EXPECT_EQ(ring[position].second, lb->chooseHost(&context).host);
+    TestLoadBalancerContext retry_context(ring[position].first, 3,
+                                          [](const Host&) { return true; });
+    EXPECT_EQ(ring[(position + 3) % ring.size()].second, lb->chooseHost(&retry_context).host);
+  }
+  // The hosts past the range of 16 bit indices are selected too.
+  for (uint32_t i = 65530; i < HostCount; i += 89) {
+    TestLoadBalancerContext context(
+        HashUtil::xxHash64(absl::StrCat(hosts[i]->address()->asString(), "_0")));
+    EXPECT_EQ(hosts[i], lb->chooseHost(&context).host);
+  }
+}
+
 // Given hosts with weights 1, 2 and 3, and a ring size of exactly 6, expect the correct number of
 // hashes for each host.
 TEST_P(RingHashLoadBalancerTest, HostWeightedTinyRing) {
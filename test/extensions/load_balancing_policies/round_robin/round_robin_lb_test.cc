@@ -455,6 +455,34 @@ TEST_P(RoundRobinLoadBalancerTest, WeightedSeed) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
 }
 
+// Schedulers built by the first pick give the same picks as schedulers built by the update.
+TEST_P(RoundRobinLoadBalancerTest, WeightedBuildSchedulersOnPick) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.build_edf_schedulers_on_pick", "true"}});
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", 2)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  init(false);
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+  // Add a host, the scheduler is rebuilt by the next pick.
+  hostSet().healthy_hosts_[0]->weight(2);
+  hostSet().healthy_hosts_[1]->weight(1);
+  hostSet().healthy_hosts_.push_back(makeTestHost(info_, "tcp://127.0.0.1:82", 3));
+  hostSet().hosts_.push_back(hostSet().healthy_hosts_.back());
+  hostSet().runCallbacks({hostSet().healthy_hosts_.back()}, {});
+  EXPECT_EQ(hostSet().healthy_hosts_[2], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[2], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[0], lb_->chooseHost(nullptr).host);
+  EXPECT_EQ(hostSet().healthy_hosts_[2], lb_->chooseHost(nullptr).host);
+}
+
 // Validate that low weighted hosts will be chosen when the LB is created.
 TEST_P(RoundRobinLoadBalancerTest, WeightedInitializationPicksAllHosts) {
   TestScopedRuntime scoped_runtime;
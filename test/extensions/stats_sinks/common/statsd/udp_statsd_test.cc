@@ -355,6 +355,45 @@ TEST(UdpStatsdSinkTest, CheckBufferedWritesExceedingBufferSize) {
   tls_.shutdownThread();
 }
 
+TEST(UdpStatsdSinkTest, ReportChangedMetricsOnly) {
+  NiceMock<Stats::MockMetricSnapshot> snapshot;
+  auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
+  writer_ptr->delegateBufferFake();
+  NiceMock<ThreadLocal::MockInstance> tls_;
+  UdpStatsdSink sink(tls_, writer_ptr, false, getDefaultPrefix(), 1024, getDefaultTagFormat(),
+                     true);
+
+  NiceMock<Stats::MockCounter> changed_counter;
+  changed_counter.name_ = "changed_counter";
+  changed_counter.used_ = true;
+  snapshot.counters_.push_back({2, changed_counter});
+
+  NiceMock<Stats::MockCounter> unchanged_counter;
+  unchanged_counter.name_ = "unchanged_counter";
+  unchanged_counter.used_ = true;
+  snapshot.counters_.push_back({0, unchanged_counter});
+
+  NiceMock<Stats::MockGauge> changed_gauge;
+  changed_gauge.name_ = "changed_gauge";
+  changed_gauge.value_ = 3;
+  changed_gauge.used_ = true;
+  snapshot.gauges_.push_back(changed_gauge);
+  snapshot.changed_gauges_.push_back(changed_gauge);
+
+  NiceMock<Stats::MockGauge> unchanged_gauge;
+  unchanged_gauge.name_ = "unchanged_gauge";
+  unchanged_gauge.value_ = 4;
+  unchanged_gauge.used_ = true;
+  snapshot.gauges_.push_back(unchanged_gauge);
+
+  EXPECT_CALL(*std::dynamic_pointer_cast<NiceMock<MockWriter>>(writer_ptr), writeBuffer(_));
+  sink.flush(snapshot);
+  ASSERT_EQ(writer_ptr->buffer_writes.size(), 1);
+  EXPECT_EQ(writer_ptr->buffer_writes.at(0), "envoy.changed_counter:2|c\nenvoy.changed_gauge:3|g");
+
+  tls_.shutdownThread();
+}
+
 TEST(UdpStatsdSinkTest, CheckActualStatsWithCustomPrefix) {
   NiceMock<Stats::MockMetricSnapshot> snapshot;
   auto writer_ptr = std::make_shared<NiceMock<MockWriter>>();
@@ -329,6 +329,28 @@ TEST_F(MetricsServiceSinkTest, FlushPredicate) {
   EXPECT_EQ(0, metrics->size());
 }
 
+// Test that only the metrics that changed since the previous flush are sent when configured to
+// do so.
+TEST_F(MetricsServiceSinkTest, ReportChangedMetricsOnly) {
+  MetricsServiceSink<envoy::service::metrics::v3::StreamMetricsMessage,
+                     envoy::service::metrics::v3::StreamMetricsResponse>
+      sink(streamer_, true, false, envoy::config::metrics::v3::HistogramEmitMode::SUMMARY, true);
+
+  addCounterToSnapshot("changed_counter", 1, 100);
+  addCounterToSnapshot("unchanged_counter", 0, 100);
+  addGaugeToSnapshot("changed_gauge", 1);
+  snapshot_.changed_gauges_.push_back(*gauge_storage_.back());
+  addGaugeToSnapshot("unchanged_gauge", 1);
+  addHistogramToSnapshot("unchanged_histogram");
+
+  EXPECT_CALL(*streamer_, send(_)).WillOnce(Invoke([](MetricsPtr&& metrics) {
+    ASSERT_EQ(2, metrics->size());
+    EXPECT_EQ("changed_counter", (*metrics)[0].name());
+    EXPECT_EQ("changed_gauge", (*metrics)[1].name());
+  }));
+  sink.flush(snapshot_);
+}
+
 // This test will emit summary and histogram.
 TEST_F(MetricsServiceSinkTest, HistogramEmitModeBoth) {
   addHistogramToSnapshot("test_histogram");
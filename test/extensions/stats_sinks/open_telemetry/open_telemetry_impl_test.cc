@@ -737,6 +737,36 @@ TEST_F(OtlpMetricsFlusherTests, DeltaCountersAllZeroNoExport) {
   EXPECT_EQ(requests.size(), 0);
 }
 
+TEST_F(OtlpMetricsFlusherTests, ReportChangedMetricsOnly) {
+  envoy::extensions::stat_sinks::open_telemetry::v3::SinkConfig sink_config;
+  sink_config.set_report_histograms_as_deltas(true);
+  sink_config.set_report_changed_metrics_only(true);
+  Tracers::OpenTelemetry::Resource resource;
+  auto options = std::make_shared<OtlpOptions>(sink_config, resource, server_factory_context_);
+  OtlpMetricsFlusherImpl flusher(options);
+
+  addCounterToSnapshot("changed_counter", 1, 5);
+  addCounterToSnapshot("unchanged_counter", 0, 5);
+  addGaugeToSnapshot("changed_gauge", 1);
+  snapshot_.changed_gauges_.push_back(*gauge_storage_.back());
+  addGaugeToSnapshot("unchanged_gauge", 2);
+  addHistogramToSnapshot("changed_histogram", true);
+  addHistogramToSnapshot("unchanged_histogram", true, true, {}, false);
+  addHostGaugeToSnapshot("host_gauge", 3);
+
+  auto metrics = flushToSingleRequest(flusher);
+  ASSERT_NE(metrics, nullptr);
+  expectMetricsCount(metrics, 4);
+  expectSum(*findSum(metrics, getTagExtractedName("changed_counter")),
+            getTagExtractedName("changed_counter"), /*value=*/5, /*is_delta=*/false);
+  expectGauge(*findGauge(metrics, getTagExtractedName("changed_gauge")),
+              getTagExtractedName("changed_gauge"), /*value=*/1);
+  expectGauge(*findGauge(metrics, getTagExtractedName("host_gauge")),
+              getTagExtractedName("host_gauge"), /*value=*/3);
+  expectHistogram(*findHistogram(metrics, getTagExtractedName("changed_histogram")),
+                  getTagExtractedName("changed_histogram"), /*is_delta=*/true);
+}
+
 TEST_F(OtlpMetricsFlusherTests, MaxDatapointsPerRequestWithLimits) {
   envoy::extensions::stat_sinks::open_telemetry::v3::SinkConfig sink_config;
   sink_config.set_max_data_points_per_request(2);
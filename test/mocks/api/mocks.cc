@@ -5,6 +5,8 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/lock_guard.h"
 
+#include "test/test_common/thread_factory_for_test.h"
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -17,6 +19,7 @@ namespace Api {
 
 MockApi::MockApi() {
   ON_CALL(*this, fileSystem()).WillByDefault(ReturnRef(file_system_));
+  ON_CALL(*this, threadFactory()).WillByDefault(ReturnRef(Thread::threadFactoryForTest()));
   ON_CALL(*this, rootScope()).WillByDefault(ReturnRef(*stats_store_.rootScope()));
   ON_CALL(*this, randomGenerator()).WillByDefault(ReturnRef(random_));
   ON_CALL(*this, bootstrap()).WillByDefault(ReturnRef(empty_bootstrap_));
@@ -164,6 +164,7 @@ public:
   MOCK_METHOD(Upstream::HostDescriptionConstSharedPtr, upstreamHost, ());
   MOCK_METHOD(void, upstreamHost, (Upstream::HostDescriptionConstSharedPtr host));
   MOCK_METHOD(bool, startUpstreamSecureTransport, ());
+  MOCK_METHOD(bool, isOnlyFilter, ());
   MOCK_METHOD(void, disableClose, (bool disable));
 
   testing::NiceMock<MockConnection> connection_;
@@ -19,6 +19,7 @@ public:
   MOCK_METHOD(bool, useDynamicBaseId, (), (const));
   MOCK_METHOD(bool, skipHotRestartOnNoParent, (), (const));
   MOCK_METHOD(bool, skipHotRestartParentStats, (), (const));
+  MOCK_METHOD(bool, skipHotRestartTlsSessions, (), (const));
   MOCK_METHOD(const std::string&, baseIdPath, (), (const));
   MOCK_METHOD(uint32_t, concurrency, (), (const));
   MOCK_METHOD(const std::string&, configPath, (), (const));
@@ -44,6 +45,8 @@ public:
   MOCK_METHOD(uint64_t, restartEpoch, (), (const));
   MOCK_METHOD(std::chrono::milliseconds, fileFlushIntervalMsec, (), (const));
   MOCK_METHOD(uint64_t, fileFlushMinSizeKB, (), (const));
+  MOCK_METHOD(uint64_t, fileFlushThreadBufferKB, (), (const));
+  MOCK_METHOD(uint64_t, tlsSessionCacheSizeKB, (), (const));
   MOCK_METHOD(Mode, mode, (), (const));
   MOCK_METHOD(const std::string&, serviceClusterName, (), (const));
   MOCK_METHOD(const std::string&, serviceNodeName, (), (const));
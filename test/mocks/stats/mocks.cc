@@ -67,6 +67,7 @@ MockParentHistogram::~MockParentHistogram() = default;
 MockMetricSnapshot::MockMetricSnapshot() {
   ON_CALL(*this, counters()).WillByDefault(ReturnRef(counters_));
   ON_CALL(*this, gauges()).WillByDefault(ReturnRef(gauges_));
+  ON_CALL(*this, changedGauges()).WillByDefault(ReturnRef(changed_gauges_));
   ON_CALL(*this, histograms()).WillByDefault(ReturnRef(histograms_));
   ON_CALL(*this, hostCounters()).WillByDefault(ReturnRef(host_counters_));
   ON_CALL(*this, hostGauges()).WillByDefault(ReturnRef(host_gauges_));
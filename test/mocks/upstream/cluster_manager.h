@@ -37,7 +37,7 @@ public:
   MOCK_METHOD(bool, initialized, ());
   MOCK_METHOD(absl::StatusOr<bool>, addOrUpdateCluster,
               (const envoy::config::cluster::v3::Cluster& cluster, const std::string& version_info,
-               const bool avoid_cds_removal));
+               const bool avoid_cds_removal, absl::optional<uint64_t> config_hash));
   MOCK_METHOD(void, setPrimaryClustersInitializedCb, (PrimaryClustersReadyCallback));
   MOCK_METHOD(void, setInitializedCb, (InitializationCompleteCallback));
   MOCK_METHOD(absl::Status, initializeSecondaryClusters,
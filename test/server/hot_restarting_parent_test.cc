@@ -1,12 +1,14 @@
 #include <memory>
 
 #include "source/common/network/address_impl.h"
+#include "source/common/tls/session_cache_impl.h"
 #include "source/server/hot_restarting_child.h"
 #include "source/server/hot_restarting_parent.h"
 
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/server/instance.h"
 #include "test/mocks/server/listener_manager.h"
+#include "test/mocks/server/server_factory_context.h"
 #include "test/server/utility.h"
 
 #include "gtest/gtest.h"
@@ -315,6 +317,31 @@ TEST_F(HotRestartingParentTest, GetListenSocketsForChildUnixDomainSocket) {
   EXPECT_EQ(0, message.reply().pass_listen_socket().fd());
 }
 
+TEST_F(HotRestartingParentTest, ExportTlsSessionsToChild) {
+  // Nothing is exported without a shared TLS session cache.
+  HotRestartMessage::Reply::TlsSessions tls_sessions;
+  hot_restarting_parent_.exportTlsSessionsToChild(&tls_sessions);
+  EXPECT_EQ(0, tls_sessions.sessions_size());
+
+  NiceMock<Configuration::MockServerFactoryContext> factory_context;
+  ON_CALL(factory_context, singletonManager())
+      .WillByDefault(ReturnRef(server_.singletonManager()));
+  ON_CALL(factory_context.options_, tlsSessionCacheSizeKB()).WillByDefault(Return(64));
+  auto session_cache = Extensions::TransportSockets::Tls::SessionCacheImpl::get(factory_context);
+  const uint64_t expire_time_unix_seconds =
+      std::chrono::duration_cast<std::chrono::seconds>(
+          factory_context.timeSource().systemTime().time_since_epoch() + std::chrono::hours(1))
+          .count();
+  session_cache->insert("id", "session",
+                        SystemTime(std::chrono::seconds(expire_time_unix_seconds)));
+
+  hot_restarting_parent_.exportTlsSessionsToChild(&tls_sessions);
+  ASSERT_EQ(1, tls_sessions.sessions_size());
+  EXPECT_EQ("id", tls_sessions.sessions(0).id());
+  EXPECT_EQ("session", tls_sessions.sessions(0).session());
+  EXPECT_EQ(expire_time_unix_seconds, tls_sessions.sessions(0).expire_time_unix_seconds());
+}
+
 TEST_F(HotRestartingParentTest, ExportStatsToChild) {
   Stats::TestUtil::TestStore store;
   MockListenerManager listener_manager;
@@ -106,9 +106,10 @@ TEST_F(OptionsImplTest, All) {
       "envoy --mode validate --concurrency 2 -c hello --admin-address-path path --restart-epoch 0 "
       "--local-address-ip-version v6 -l info --component-log-level upstream:debug,connection:trace "
       "--service-cluster cluster --service-node node --service-zone zone "
-      "--file-flush-interval-msec 9000 "
+      "--file-flush-interval-msec 9000 --file-flush-thread-buffer-kb 64 "
       "--skip-hot-restart-on-no-parent "
       "--skip-hot-restart-parent-stats "
+      "--skip-hot-restart-tls-sessions --tls-session-cache-size-kb 1024 "
       "--drain-time-s 60 --log-format [%v] --parent-shutdown-time-s 90 "
       "--log-path "
       "/foo/bar "
@@ -129,12 +130,15 @@ TEST_F(OptionsImplTest, All) {
   EXPECT_TRUE(options->logFormatSet());
   EXPECT_TRUE(options->skipHotRestartParentStats());
   EXPECT_TRUE(options->skipHotRestartOnNoParent());
+  EXPECT_TRUE(options->skipHotRestartTlsSessions());
+  EXPECT_EQ(1024U, options->tlsSessionCacheSizeKB());
   EXPECT_EQ("/foo/bar", options->logPath());
   EXPECT_EQ(false, options->enableFineGrainLogging());
   EXPECT_EQ("cluster", options->serviceClusterName());
   EXPECT_EQ("node", options->serviceNodeName());
   EXPECT_EQ("zone", options->serviceZone());
   EXPECT_EQ(std::chrono::milliseconds(9000), options->fileFlushIntervalMsec());
+  EXPECT_EQ(64U, options->fileFlushThreadBufferKB());
   EXPECT_EQ(std::chrono::seconds(60), options->drainTime());
   EXPECT_EQ(std::chrono::seconds(90), options->parentShutdownTime());
   EXPECT_TRUE(options->hotRestartDisabled());
@@ -202,6 +206,7 @@ TEST_F(OptionsImplTest, SetAll) {
   options->setRestartEpoch(44);
   options->setFileFlushIntervalMsec(std::chrono::milliseconds(45));
   options->setFileFlushMinSizeKB(128);
+  options->setFileFlushThreadBufferKB(256);
   options->setMode(Server::Mode::Validate);
   options->setServiceClusterName("cluster_foo");
   options->setServiceNodeName("node_foo");
@@ -236,6 +241,7 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(44, options->restartEpoch());
   EXPECT_EQ(std::chrono::milliseconds(45), options->fileFlushIntervalMsec());
   EXPECT_EQ(128U, options->fileFlushMinSizeKB());
+  EXPECT_EQ(256U, options->fileFlushThreadBufferKB());
   EXPECT_EQ(Server::Mode::Validate, options->mode());
   EXPECT_EQ("cluster_foo", options->serviceClusterName());
   EXPECT_EQ("node_foo", options->serviceNodeName());
@@ -269,6 +275,8 @@ TEST_F(OptionsImplTest, SetAll) {
   EXPECT_EQ(options->restartEpoch(), command_line_options->restart_epoch());
   EXPECT_EQ(options->fileFlushIntervalMsec().count() / 1000,
             command_line_options->file_flush_interval().seconds());
+  EXPECT_EQ(options->fileFlushThreadBufferKB(),
+            command_line_options->file_flush_thread_buffer_size());
   EXPECT_EQ(envoy::admin::v3::CommandLineOptions::Validate, command_line_options->mode());
   EXPECT_EQ(options->serviceClusterName(), command_line_options->service_cluster());
   EXPECT_EQ(options->serviceNodeName(), command_line_options->service_node());
@@ -297,6 +305,7 @@ TEST_F(OptionsImplTest, DefaultParams) {
   EXPECT_EQ(0U, options->statsTags().size());
   EXPECT_FALSE(options->hotRestartDisabled());
   EXPECT_FALSE(options->cpusetThreadsEnabled());
+  EXPECT_EQ(0U, options->fileFlushThreadBufferKB());
 
   // Validate that CommandLineOptions is constructed correctly with default params.
   Server::CommandLineOptionsPtr command_line_options = options->toCommandLineOptions();
@@ -552,6 +561,7 @@ TEST_F(OptionsImplTest, SkipHotRestartDefaults) {
   std::unique_ptr<OptionsImpl> options = createOptionsImpl({"envoy", "-c", "hello"});
   EXPECT_FALSE(options->skipHotRestartOnNoParent());
   EXPECT_FALSE(options->skipHotRestartParentStats());
+  EXPECT_FALSE(options->skipHotRestartTlsSessions());
 }
 
 TEST_F(OptionsImplTest, LogFormatOverride) {
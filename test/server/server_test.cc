@@ -8,6 +8,8 @@
 #include "envoy/server/bootstrap_extension_config.h"
 #include "envoy/server/fatal_action_config.h"
 
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_storage_cache.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/notification.h"
 #include "source/common/network/address_impl.h"
@@ -164,6 +166,43 @@ TEST(ServerInstanceUtil, flushImportModeUninitializedGauges) {
   InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
 }
 
+TEST(ServerInstanceUtil, flushChangedGauges) {
+  InSequence s;
+
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Gauge& changed = store.gauge("changed", Stats::Gauge::ImportMode::Accumulate);
+  Stats::Gauge& unchanged = store.gauge("unchanged", Stats::Gauge::ImportMode::Accumulate);
+  changed.set(5);
+  unchanged.set(10);
+
+  // The first flush reports every gauge as changed.
+  std::list<Stats::SinkPtr> sinks;
+  Stats::MockSink* sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(sink);
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+    EXPECT_EQ(snapshot.changedGauges().size(), 2);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+    ASSERT_EQ(snapshot.changedGauges().size(), 1);
+    EXPECT_EQ(snapshot.changedGauges()[0].get().name(), "changed");
+    EXPECT_EQ(snapshot.changedGauges()[0].get().value(), 4);
+  }));
+  changed.dec();
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.gauges().size(), 2);
+    EXPECT_TRUE(snapshot.changedGauges().empty());
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
+}
+
 TEST(ServerInstanceUtil, RaiseFileLimits) {
   Api::MockOsSysCalls os_sys_calls_;
   TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls{&os_sys_calls_};
@@ -938,6 +977,27 @@ TEST_P(ServerStatsTest, FlushStats) {
   EXPECT_EQ(recent_lookups.value(), strobed_recent_lookups);
 }
 
+TEST_P(ServerStatsTest, FlushSliceStorageCacheStats) {
+  initialize("test/server/test_data/server/empty_bootstrap.yaml");
+  flushStats();
+  Stats::Counter& hits = stats_store_.counterFromString("server.buffer_slice_cache_hits");
+  Stats::Gauge& hit_rate = stats_store_.gaugeFromString("server.buffer_slice_cache_hit_rate",
+                                                        Stats::Gauge::ImportMode::NeverImport);
+  Stats::Gauge& resident_bytes = stats_store_.gaugeFromString(
+      "server.buffer_slice_cache_resident_bytes", Stats::Gauge::ImportMode::NeverImport);
+  const uint64_t flushed_hits = hits.value();
+
+  // The storage of the first buffer is released to the cache of this thread, and reused by the
+  // second one.
+  for (uint32_t i = 0; i < 2; i++) {
+    Buffer::OwnedImpl buffer(std::string(Buffer::SliceStorageCache::SmallBlockSize, 'a'));
+  }
+  flushStats();
+  EXPECT_LE(flushed_hits + 1, hits.value());
+  EXPECT_LT(0, hit_rate.value());
+  EXPECT_LE(Buffer::SliceStorageCache::SmallBlockSize, resident_bytes.value());
+}
+
 TEST_P(ServerInstanceImplTest, FlushStatsOnAdmin) {
   CustomStatsSinkFactory factory;
   Registry::InjectFactory<Server::Configuration::StatsSinkFactory> registered(factory);